@@ -35,6 +35,95 @@ class ParameterHandler;
 
 namespace Algorithms
 {
+  /**
+   * The derivative of a residual operator applied to a vector, computed by
+   * a forward difference quotient
+   * @f[
+   *   F'(u)v \approx \frac{F(u+\varepsilon v) - F(u)}{\varepsilon},
+   *   \qquad
+   *   \varepsilon = \frac{\sqrt{\epsilon_{\text{mach}}}(1+\|u\|)}{\|v\|}.
+   * @f]
+   * This class is provided by Newton to its inverse derivative operator
+   * under the name <tt>"Newton Jacobian"</tt>, such that a Jacobian-free
+   * Newton-Krylov method can be set up by using the vmult() function of
+   * this class as the operator in one of the Krylov solvers of deal.II.
+   * Each call to vmult() evaluates the residual operator once.
+   */
+  template <typename VectorType>
+  class FiniteDifferenceJacobian : public Subscriptor
+  {
+  public:
+    /**
+     * Constructor. @p residual is the operator computing the residual, with
+     * the arguments described in the documentation of Newton.
+     */
+    FiniteDifferenceJacobian(OperatorBase &residual);
+
+    /**
+     * Set the point of linearization. @p u is the current iterate and @p
+     * residual_u the residual evaluated there. The vectors are stored by
+     * reference and must stay alive and unchanged while vmult() is used.
+     * The contents of @p in are handed to the residual operator.
+     */
+    void
+    reinit(const VectorType &u,
+           const VectorType &residual_u,
+           const AnyData &   in);
+
+    /**
+     * Apply the derivative of the residual at the point of linearization to
+     * @p src.
+     */
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Return the number of residual evaluations performed by vmult() since
+     * the last call to reset_counter().
+     */
+    unsigned int
+    n_residual_evaluations() const;
+
+    /**
+     * Reset the counter of residual evaluations.
+     */
+    void
+    reset_counter();
+
+  private:
+    /**
+     * The operator computing the residual.
+     */
+    SmartPointer<OperatorBase, FiniteDifferenceJacobian<VectorType>> residual;
+
+    /**
+     * The point of linearization.
+     */
+    const VectorType *u;
+
+    /**
+     * The residual at the point of linearization.
+     */
+    const VectorType *residual_u;
+
+    /**
+     * The additional data handed to the residual operator.
+     */
+    AnyData in;
+
+    /**
+     * Temporary vector holding the perturbed iterate.
+     */
+    mutable VectorType perturbed_u;
+
+    /**
+     * The counter returned by n_residual_evaluations().
+     */
+    mutable unsigned int n_evaluations;
+  };
+
+
+
   /**
    * Operator class performing Newton's iteration with standard step size
    * control and adaptive matrix generation.
@@ -66,7 +155,47 @@ namespace Algorithms
    * at this point.
    *
    * For the call to (*#inverse_derivative), the vector <tt>"Newton
-   * residual"</tt> is inserted before <tt>"Newton iterate"</tt>.
+   * residual"</tt> is inserted before <tt>"Newton iterate"</tt>. Furthermore,
+   * the following entries are appended after the contents of <tt>in</tt>:
+   * <ul>
+   * <li> <tt>"Newton Jacobian"</tt>: a pointer to a FiniteDifferenceJacobian
+   * object, which applies the derivative of the residual at the current
+   * iterate to a vector by finite differences. It allows to solve the
+   * linear system with a Krylov method without assembling the derivative,
+   * using an assembled (possibly outdated) matrix only for preconditioning.
+   * <li> <tt>"Newton forcing term"</tt>: only present if #adaptive_forcing is
+   * set, a <tt>const double *</tt> to the relative reduction of the residual
+   * the linear solver should achieve in this step, see below.
+   * </ul>
+   * The output AnyData handed to (*#inverse_derivative) contains the
+   * vector <tt>"Update"</tt> and, as second entry, an <tt>unsigned int
+   * *</tt> named <tt>"Linear iterations"</tt>, into which the operator may
+   * write the number of iterations spent by the linear solver. This value
+   * only enters the statistics returned by get_statistics().
+   *
+   * <h3>Inexact Newton method</h3>
+   *
+   * Far from the solution, the linearization is a poor model of the
+   * nonlinear residual and solving the linear system accurately is wasted
+   * effort. If #adaptive_forcing is set, the relative tolerance
+   * $\eta_k$ of the linear solver is chosen following Eisenstat and Walker
+   * (SIAM J. Sci. Comput. 17, 1996, choice 2) as
+   * @f[
+   *   \eta_k = \gamma \left(\frac{\|F(u_k)\|}{\|F(u_{k-1})\|}\right)^\alpha,
+   * @f]
+   * safeguarded against too rapid decrease by $\gamma\eta_{k-1}^\alpha$
+   * whenever this value is larger than 0.1, bounded from above by
+   * #forcing_max, and bounded from below such that the linear solver does
+   * not reduce the residual far beyond the tolerance of #control. The first
+   * step uses #forcing_max.
+   *
+   * The derivative used by (*#inverse_derivative) (or its preconditioner,
+   * if the "Newton Jacobian" operator is used in the Krylov method) is only
+   * updated when the event Algorithms::bad_derivative is received. Besides
+   * the criterion based on #threshold() described above, this event is sent
+   * if the linear solver failed to converge in the previous step and, if
+   * #max_derivative_age is positive, after the derivative has been reused
+   * for that many steps.
    *
    * @author Guido Kanschat, 2006, 2010
    */
@@ -117,6 +246,51 @@ namespace Algorithms
     double
     threshold(double new_value);
 
+    /**
+     * A structure collecting the work done in the last call to operator()().
+     */
+    struct Statistics
+    {
+      /**
+       * The number of Newton steps.
+       */
+      unsigned int n_steps = 0;
+
+      /**
+       * The number of residual evaluations by the Newton iteration itself,
+       * including those of the step size control.
+       */
+      unsigned int n_residual_evaluations = 0;
+
+      /**
+       * The number of residual evaluations for matrix-free directional
+       * derivatives, i.e., calls to FiniteDifferenceJacobian::vmult().
+       */
+      unsigned int n_jacobian_residual_evaluations = 0;
+
+      /**
+       * The sum of the linear iterations reported by the inverse derivative.
+       */
+      unsigned int n_linear_iterations = 0;
+
+      /**
+       * The number of times the event Algorithms::bad_derivative was sent.
+       */
+      unsigned int n_derivative_updates = 0;
+
+      /**
+       * The number of Newton steps after the first one in which the
+       * derivative was reused.
+       */
+      unsigned int n_derivative_reuses = 0;
+    };
+
+    /**
+     * Return the statistics of the last call to operator()().
+     */
+    const Statistics &
+    get_statistics() const;
+
     /**
      * Control object for the Newton iteration.
      */
@@ -169,7 +343,58 @@ namespace Algorithms
      */
     double assemble_threshold;
 
+    /**
+     * The operator handed to #inverse_derivative as <tt>"Newton
+     * Jacobian"</tt>.
+     */
+    FiniteDifferenceJacobian<VectorType> jacobian;
+
+    /**
+     * The statistics of the last call to operator()().
+     */
+    Statistics statistics;
+
   public:
+    /**
+     * Choose the relative tolerance of the linear solver adaptively by the
+     * Eisenstat-Walker criterion and hand it to the inverse derivative as
+     * <tt>"Newton forcing term"</tt>. Default is false.
+     *
+     * @note Controlled by <tt>Adaptive forcing</tt> in parameter file
+     */
+    bool adaptive_forcing;
+
+    /**
+     * The upper bound of the forcing term, used in the first step. Default
+     * is 0.9.
+     *
+     * @note Controlled by <tt>Maximal forcing term</tt> in parameter file
+     */
+    double forcing_max;
+
+    /**
+     * The factor $\gamma$ of the Eisenstat-Walker criterion. Default is 0.9.
+     *
+     * @note Controlled by <tt>Forcing gamma</tt> in parameter file
+     */
+    double forcing_gamma;
+
+    /**
+     * The exponent $\alpha$ of the Eisenstat-Walker criterion. Default is 2.
+     *
+     * @note Controlled by <tt>Forcing alpha</tt> in parameter file
+     */
+    double forcing_alpha;
+
+    /**
+     * The maximal number of Newton steps for which the derivative is
+     * reused before Algorithms::bad_derivative is sent regardless of the
+     * residual reduction. Zero, the default, means no limit.
+     *
+     * @note Controlled by <tt>Maximal derivative age</tt> in parameter file
+     */
+    unsigned int max_derivative_age;
+
     /**
      * Print residual, update and updated solution after each step into file
      * <tt>Newton_NNN</tt>?
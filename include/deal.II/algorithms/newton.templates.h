@@ -26,13 +26,95 @@
 
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
+#include <limits>
 
 
 DEAL_II_NAMESPACE_OPEN
 
 namespace Algorithms
 {
+  template <typename VectorType>
+  FiniteDifferenceJacobian<VectorType>::FiniteDifferenceJacobian(
+    OperatorBase &residual)
+    : residual(&residual)
+    , u(nullptr)
+    , residual_u(nullptr)
+    , n_evaluations(0)
+  {}
+
+
+  template <typename VectorType>
+  void
+  FiniteDifferenceJacobian<VectorType>::reinit(const VectorType &u,
+                                               const VectorType &residual_u,
+                                               const AnyData &   in)
+  {
+    this->u          = &u;
+    this->residual_u = &residual_u;
+    this->in         = in;
+    perturbed_u.reinit(u, true);
+  }
+
+
+  template <typename VectorType>
+  void
+  FiniteDifferenceJacobian<VectorType>::vmult(VectorType &      dst,
+                                              const VectorType &src) const
+  {
+    Assert(u != nullptr && residual_u != nullptr,
+           ExcMessage("The point of linearization has not been set. "
+                      "Call reinit() first."));
+
+    const double src_norm = src.l2_norm();
+    if (src_norm == 0.)
+      {
+        dst = typename VectorType::value_type();
+        return;
+      }
+
+    // the step size balancing truncation and rounding errors for a forward
+    // difference, relative to the size of the iterate and the direction
+    const double epsilon =
+      std::sqrt(std::numeric_limits<double>::epsilon()) * (1. + u->l2_norm()) /
+      src_norm;
+
+    perturbed_u = *u;
+    perturbed_u.add(epsilon, src);
+
+    AnyData src1;
+    src1.add<const VectorType *>(&perturbed_u, "Newton iterate");
+    src1.merge(in);
+    AnyData out1;
+    out1.add<VectorType *>(&dst, "Residual");
+
+    (*residual)(out1, src1);
+    ++n_evaluations;
+
+    dst.add(-1., *residual_u);
+    dst *= 1. / epsilon;
+  }
+
+
+  template <typename VectorType>
+  unsigned int
+  FiniteDifferenceJacobian<VectorType>::n_residual_evaluations() const
+  {
+    return n_evaluations;
+  }
+
+
+  template <typename VectorType>
+  void
+  FiniteDifferenceJacobian<VectorType>::reset_counter()
+  {
+    n_evaluations = 0;
+  }
+
+
+
   template <typename VectorType>
   Newton<VectorType>::Newton(OperatorBase &residual,
                              OperatorBase &inverse_derivative)
@@ -41,6 +123,12 @@ namespace Algorithms
     , assemble_now(false)
     , n_stepsize_iterations(21)
     , assemble_threshold(0.)
+    , jacobian(residual)
+    , adaptive_forcing(false)
+    , forcing_max(0.9)
+    , forcing_gamma(0.9)
+    , forcing_alpha(2.)
+    , max_derivative_age(0)
     , debug_vectors(false)
     , debug(0)
   {}
@@ -54,6 +142,13 @@ namespace Algorithms
     ReductionControl::declare_parameters(param);
     param.declare_entry("Assemble threshold", "0.", Patterns::Double(0.));
     param.declare_entry("Stepsize iterations", "21", Patterns::Integer(0));
+    param.declare_entry("Adaptive forcing", "false", Patterns::Bool());
+    param.declare_entry("Maximal forcing term",
+                        "0.9",
+                        Patterns::Double(0., 1.));
+    param.declare_entry("Forcing gamma", "0.9", Patterns::Double(0., 1.));
+    param.declare_entry("Forcing alpha", "2.", Patterns::Double(1., 2.));
+    param.declare_entry("Maximal derivative age", "0", Patterns::Integer(0));
     param.declare_entry("Debug level", "0", Patterns::Integer(0));
     param.declare_entry("Debug vectors", "false", Patterns::Bool());
     param.leave_subsection();
@@ -67,6 +162,11 @@ namespace Algorithms
     control.parse_parameters(param);
     assemble_threshold    = param.get_double("Assemble threshold");
     n_stepsize_iterations = param.get_integer("Stepsize iterations");
+    adaptive_forcing      = param.get_bool("Adaptive forcing");
+    forcing_max           = param.get_double("Maximal forcing term");
+    forcing_gamma         = param.get_double("Forcing gamma");
+    forcing_alpha         = param.get_double("Forcing alpha");
+    max_derivative_age    = param.get_integer("Maximal derivative age");
     debug                 = param.get_integer("Debug level");
     debug_vectors         = param.get_bool("Debug vectors");
     param.leave_subsection();
@@ -98,6 +198,14 @@ namespace Algorithms
   }
 
 
+  template <typename VectorType>
+  const typename Newton<VectorType>::Statistics &
+  Newton<VectorType>::get_statistics() const
+  {
+    return statistics;
+  }
+
+
   template <typename VectorType>
   void
   Newton<VectorType>::operator()(AnyData &out, const AnyData &in)
@@ -122,17 +230,37 @@ namespace Algorithms
     src1.merge(in);
     src2.add<const VectorType *>(res.get(), "Newton residual");
     src2.merge(src1);
+
+    statistics = Statistics();
+    jacobian.reinit(u, *res, in);
+    jacobian.reset_counter();
+    src2.add<const FiniteDifferenceJacobian<VectorType> *>(&jacobian,
+                                                           "Newton Jacobian");
+    double forcing_term = forcing_max;
+    if (adaptive_forcing)
+      src2.add<const double *>(&forcing_term, "Newton forcing term");
+
     AnyData out1;
     out1.add<VectorType *>(res.get(), "Residual");
-    AnyData out2;
+    AnyData      out2;
+    unsigned int linear_iterations = 0;
     out2.add<VectorType *>(Du.get(), "Update");
+    out2.add<unsigned int *>(&linear_iterations, "Linear iterations");
 
     unsigned int step = 0;
     // fill res with (f(u), v)
     (*residual)(out1, src1);
+    ++statistics.n_residual_evaluations;
     double resnorm      = res->l2_norm();
     double old_residual = 0.;
 
+    // the residual at which the iteration stops, used to avoid solving the
+    // linear systems more accurately than necessary in the last step
+    const double target_residual =
+      std::max(control.tolerance(), control.reduction() * resnorm);
+    bool         inner_iteration_failed = false;
+    unsigned int derivative_age         = 0;
+
     if (debug_vectors)
       {
         AnyData     tmp;
@@ -149,10 +277,45 @@ namespace Algorithms
     while (control.check(step++, resnorm) == SolverControl::iterate)
       {
         // assemble (Df(u), v)
-        if ((step > 1) && (resnorm / old_residual >= assemble_threshold))
-          inverse_derivative->notify(Events::bad_derivative);
+        if (step > 1)
+          {
+            if ((resnorm / old_residual >= assemble_threshold) ||
+                inner_iteration_failed ||
+                (max_derivative_age > 0 &&
+                 derivative_age >= max_derivative_age))
+              {
+                inverse_derivative->notify(Events::bad_derivative);
+                ++statistics.n_derivative_updates;
+                derivative_age = 0;
+              }
+            else
+              ++statistics.n_derivative_reuses;
+          }
+        ++derivative_age;
+
+        if (adaptive_forcing && step > 1)
+          {
+            // Eisenstat-Walker, choice 2, with the safeguard against
+            // decreasing the forcing term too fast
+            const double previous_forcing_term = forcing_term;
+            forcing_term =
+              forcing_gamma * std::pow(resnorm / old_residual, forcing_alpha);
+            const double safeguard =
+              forcing_gamma * std::pow(previous_forcing_term, forcing_alpha);
+            if (safeguard > 0.1)
+              forcing_term = std::max(forcing_term, safeguard);
+            forcing_term = std::min(forcing_term, forcing_max);
+            // do not oversolve in the last step
+            forcing_term =
+              std::min(std::max(forcing_term, 0.5 * target_residual / resnorm),
+                       forcing_max);
+          }
+        if (adaptive_forcing && debug > 0)
+          deallog << "Forcing term: " << forcing_term << std::endl;
 
         Du->reinit(u);
+        linear_iterations      = 0;
+        inner_iteration_failed = false;
         try
           {
             (*inverse_derivative)(out2, src2);
@@ -161,7 +324,12 @@ namespace Algorithms
           {
             deallog << "Inner iteration failed after " << e.last_step
                     << " steps with residual " << e.last_residual << std::endl;
+            inner_iteration_failed = true;
+            if (linear_iterations == 0)
+              linear_iterations = e.last_step;
           }
+        statistics.n_linear_iterations += linear_iterations;
+        ++statistics.n_steps;
 
         if (debug_vectors)
           {
@@ -179,6 +347,7 @@ namespace Algorithms
         u.add(-1., *Du);
         old_residual = resnorm;
         (*residual)(out1, src1);
+        ++statistics.n_residual_evaluations;
         resnorm = res->l2_norm();
 
         // Step size control
@@ -196,10 +365,21 @@ namespace Algorithms
                       << " since residual was " << resnorm << std::endl;
             u.add(1. / (1 << step_size), *Du);
             (*residual)(out1, src1);
+            ++statistics.n_residual_evaluations;
             resnorm = res->l2_norm();
           }
       }
 
+    statistics.n_jacobian_residual_evaluations =
+      jacobian.n_residual_evaluations();
+    if (debug > 0)
+      deallog << "Steps: " << statistics.n_steps
+              << " residual evaluations: " << statistics.n_residual_evaluations
+              << " + " << statistics.n_jacobian_residual_evaluations
+              << " linear iterations: " << statistics.n_linear_iterations
+              << " derivative updates: " << statistics.n_derivative_updates
+              << " reuses: " << statistics.n_derivative_reuses << std::endl;
+
     // in case of failure: throw exception
     if (control.last_check() != SolverControl::success)
       AssertThrow(false,
@@ -24,10 +24,13 @@
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/thread_management.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <tuple>
+#include <vector>
 
 #ifdef DEAL_II_WITH_THREADS
 #  include <tbb/blocked_range.h>
@@ -466,6 +469,85 @@ namespace parallel
 
 
 
+  /**
+   * Call the function object @p f for each of the indices
+   * <code>0,...,weights.size()-1</code> and possibly do so in %parallel,
+   * where <code>weights[i]</code> is an estimate of the cost of the call
+   * <code>f(i)</code>.
+   *
+   * This function is meant for a small number of work items of very
+   * different size, such as the block rows of a block matrix, for which the
+   * recursive subdivision of apply_to_subranges() does not balance well. The
+   * items are distributed onto at most MultithreadInfo::n_threads() groups
+   * of similar total weight by the longest-processing-time-first rule, i.e.,
+   * the items are visited by decreasing weight and each one is added to the
+   * group with the smallest weight so far. Each group is then processed by
+   * a separate task. The calls to @p f must hence be independent of each
+   * other. Within a group, the items are processed by decreasing weight.
+   *
+   * If multithreading is not enabled, if there is only one thread or one
+   * item, or if the sum of the weights is less than @p minimum_total_weight,
+   * all items are processed in the calling thread in the order of their
+   * indices.
+   */
+  template <typename Function>
+  void
+  apply_to_weighted_items(const std::vector<std::size_t> &weights,
+                          const Function &                f,
+                          const std::size_t               minimum_total_weight)
+  {
+    const unsigned int n_items = weights.size();
+#ifdef DEAL_II_WITH_THREADS
+    const unsigned int n_groups =
+      std::min<unsigned int>(MultithreadInfo::n_threads(), n_items);
+    if (n_groups > 1 &&
+        std::accumulate(weights.begin(), weights.end(), std::size_t(0)) >=
+          minimum_total_weight)
+      {
+        std::vector<unsigned int> order(n_items);
+        std::iota(order.begin(), order.end(), 0U);
+        std::stable_sort(
+          order.begin(),
+          order.end(),
+          [&weights](const unsigned int a, const unsigned int b) {
+            return weights[a] > weights[b];
+          });
+
+        std::vector<std::vector<unsigned int>> groups(n_groups);
+        std::vector<std::size_t>               group_weights(n_groups, 0);
+        for (const unsigned int item : order)
+          {
+            const unsigned int group =
+              std::min_element(group_weights.begin(), group_weights.end()) -
+              group_weights.begin();
+            groups[group].push_back(item);
+            group_weights[group] += weights[item];
+          }
+
+        // spawn tasks for all groups but the first one, which is worked on
+        // by the calling thread while the tasks run
+        Threads::TaskGroup<> tasks;
+        for (unsigned int group = 1; group < n_groups; ++group)
+          if (groups[group].size() > 0)
+            tasks += Threads::new_task([&f, &groups, group]() {
+              for (const unsigned int item : groups[group])
+                f(item);
+            });
+        for (const unsigned int item : groups[0])
+          f(item);
+        tasks.join_all();
+        return;
+      }
+#else
+    (void)minimum_total_weight;
+#endif
+
+    for (unsigned int item = 0; item < n_items; ++item)
+      f(item);
+  }
+
+
+
   /**
    * This is a class specialized to for loops with a fixed range given by
    * unsigned integers. This is an abstract base class that an actual worker
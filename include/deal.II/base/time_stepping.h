@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/index_set.h>
 #include <deal.II/base/signaling_nan.h>
 
 #include <functional>
@@ -41,6 +42,10 @@ namespace TimeStepping
    *   - FORWARD_EULER (first order)
    *   - RK_THIRD_ORDER (third order Runge-Kutta)
    *   - RK_CLASSIC_FOURTH_ORDER (classical fourth order Runge-Kutta)
+   * - Low-storage explicit methods (see LowStorageRungeKutta::initialize):
+   *   - LOW_STORAGE_RK_STAGE3_ORDER3 (three stages, third order)
+   *   - LOW_STORAGE_RK_STAGE5_ORDER4 (five stages, fourth order)
+   *   - LOW_STORAGE_RK_STAGE7_ORDER4 (seven stages, fourth order)
    * - Implicit methods (see ImplicitRungeKutta::initialize):
    *   - BACKWARD_EULER (first order)
    *   - IMPLICIT_MIDPOINT (second order)
@@ -59,6 +64,9 @@ namespace TimeStepping
     FORWARD_EULER,
     RK_THIRD_ORDER,
     RK_CLASSIC_FOURTH_ORDER,
+    LOW_STORAGE_RK_STAGE3_ORDER3,
+    LOW_STORAGE_RK_STAGE5_ORDER4,
+    LOW_STORAGE_RK_STAGE7_ORDER4,
     BACKWARD_EULER,
     IMPLICIT_MIDPOINT,
     CRANK_NICOLSON,
@@ -324,6 +332,438 @@ namespace TimeStepping
 
 
 
+  /**
+   * MultirateExplicitRungeKutta is derived from ExplicitRungeKutta and
+   * implements a local time stepping (multirate) variant of the explicit
+   * methods. It is meant for problems where the stable time step varies
+   * strongly between different parts of the domain, e.g., for explicit wave
+   * propagation on adaptively refined meshes, where a global time step
+   * dictated by the smallest cells makes the larger cells use many more
+   * evaluations of the right hand side than necessary.
+   *
+   * The unknowns are split into levels $\ell=0,\ldots,L-1$, and the unknowns
+   * on level $\ell$ are advanced with the time step $\Delta t / 2^\ell$,
+   * where $\Delta t$ is the step size passed to evolve_one_time_step(). The
+   * right hand side of level $\ell$ is thus evaluated $2^\ell$ times per time
+   * step rather than $2^{L-1}$ times as with a global time step. The
+   * partition is given in terms of one IndexSet per level, and the function
+   * evaluating the right hand side only needs to compute the entries of one
+   * level at a time. compute_levels() can be used to assign levels to cells
+   * based on their admissible time step. With MatrixFree, these levels are
+   * typically passed as
+   * MatrixFree::AdditionalData::cell_vectorization_category together with
+   * MatrixFree::AdditionalData::cell_vectorization_categories_strict, such
+   * that the evaluation of level $\ell$ can be restricted to the cell batches
+   * with MatrixFree::get_cell_category() equal to $\ell$.
+   *
+   * A step of level $\ell$ from $t$ to $t+H$ proceeds recursively:
+   * - The first stage of level $\ell$ is computed at time $t$.
+   * - The finer levels are advanced by two steps of size $H/2$. During these
+   *   steps, the unknowns of level $\ell$ and all coarser levels are
+   *   predicted linearly in time by their first stage, $y_k(\tau) \approx
+   *   y_k(t_k) + (\tau-t_k) k_{k,1}$.
+   * - The remaining stages of level $\ell$ are computed, with the unknowns of
+   *   finer levels interpolated linearly in time between the values at $t$,
+   *   $t+H/2$, and $t+H$.
+   * - The unknowns of level $\ell$ are updated with the weights of the
+   *   Runge-Kutta method.
+   *
+   * Within each level, the method has the order of the underlying Runge-Kutta
+   * method, whereas the coupling between the levels is second order accurate.
+   * With a single level, the method is identical to the one of the base class.
+   *
+   * The vector entries are accessed individually through
+   * <code>VectorType::operator()</code> with global indices, so this class can
+   * only be used with deal.II's own vector classes. By default, the vector
+   * passed to the evaluation of a level is up to date in all entries. Since
+   * the evaluation on a level usually only reads the entries of its own level
+   * and of a thin layer of neighbors, the set of entries to be kept up to date
+   * can be restricted by the second argument of reinit(), which
+   * significantly reduces the vector work for the finer levels.
+   */
+  template <typename VectorType>
+  class MultirateExplicitRungeKutta : public ExplicitRungeKutta<VectorType>
+  {
+  public:
+    using ExplicitRungeKutta<VectorType>::evolve_one_time_step;
+
+    /**
+     * Default constructor. initialize(runge_kutta_method) and
+     * reinit() need to be called before the object can be used.
+     */
+    MultirateExplicitRungeKutta() = default;
+
+    /**
+     * Constructor. This function calls initialize(runge_kutta_method). The
+     * partition of the unknowns needs to be set by reinit() before the object
+     * can be used for multirate steps.
+     */
+    MultirateExplicitRungeKutta(const runge_kutta_method method);
+
+    /**
+     * Initialize the explicit Runge-Kutta method used on each level.
+     */
+    void
+    initialize(const runge_kutta_method method) override;
+
+    /**
+     * Set the partition of the unknowns into levels. The entry
+     * @p level_dofs[l] contains the (locally owned) unknowns that are
+     * advanced with the time step $\Delta t / 2^l$. The index sets must be
+     * disjoint and their union must contain all locally owned unknowns.
+     *
+     * The optional argument @p read_dofs describes, for each level, the
+     * unknowns that the evaluation of the right hand side on that level
+     * reads, including the ones on the level itself. If it is empty, all
+     * entries of the vector are assumed to be read.
+     */
+    void
+    reinit(const std::vector<IndexSet> &level_dofs,
+           const std::vector<IndexSet> &read_dofs = std::vector<IndexSet>());
+
+    /**
+     * Advance from time @p t to t+ @p delta_t with local time steps. The
+     * function @p f is called with the time, the level, the current vector,
+     * and the destination vector, and needs to write the entries of
+     * $f(t,y)$ belonging to the given level into the destination vector. The
+     * other entries of the destination vector must not be modified.
+     * evolve_one_time_step returns the time at the end of the time step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<void(const double       t,
+                               const unsigned int level,
+                               const VectorType & y,
+                               VectorType &       dst)> &f,
+      double                                           t,
+      double                                           delta_t,
+      VectorType &                                     y);
+
+    /**
+     * Return the number of levels of the partition set by reinit().
+     */
+    unsigned int
+    n_levels() const;
+
+    /**
+     * Compute the level of each item (e.g. a cell) given its admissible time
+     * step, such that the time step $\Delta t / 2^\ell$ of the assigned level
+     * does not exceed the admissible one. Levels larger than
+     * @p max_level are clamped, i.e., the time step @p delta_t needs to be
+     * small enough for the result to be stable.
+     */
+    static std::vector<unsigned int>
+    compute_levels(const std::vector<double> &admissible_time_steps,
+                   const double               delta_t,
+                   const unsigned int         max_level);
+
+    /**
+     * Structure that stores the name of the method and the number of
+     * evaluations of the right hand side on each level, accumulated over all
+     * calls to the multirate evolve_one_time_step.
+     */
+    struct Status : public ExplicitRungeKutta<VectorType>::Status
+    {
+      std::vector<unsigned long int> n_evaluations;
+    };
+
+    /**
+     * Return the status of the current object.
+     */
+    const Status &
+    get_status() const override;
+
+  private:
+    /**
+     * Advance the unknowns of @p level and all finer levels from time @p t
+     * to t+ @p delta_t.
+     */
+    void
+    advance_level(const std::function<void(const double,
+                                           const unsigned int,
+                                           const VectorType &,
+                                           VectorType &)> &f,
+                  const unsigned int                       level,
+                  const double                             t,
+                  const double                             delta_t,
+                  VectorType &                             y);
+
+    /**
+     * Fill the entries of the vector #stage_input needed for the evaluation
+     * of stage @p stage of level @p level at time @p t.
+     */
+    void
+    fill_stage_input(const unsigned int level,
+                     const unsigned int stage,
+                     const double       t,
+                     const double       delta_t,
+                     const VectorType & y);
+
+    /**
+     * Indices of the unknowns on each level.
+     */
+    std::vector<std::vector<IndexSet::size_type>> level_indices;
+
+    /**
+     * Indices of the unknowns on level <code>k</code> that are read by the
+     * evaluation on level <code>l</code>, stored in
+     * <code>read_indices[l][k]</code>.
+     */
+    std::vector<std::vector<std::vector<IndexSet::size_type>>> read_indices;
+
+    /**
+     * Start time of the current step of each level.
+     */
+    std::vector<double> level_start_time;
+
+    /**
+     * Vector at which the right hand side is evaluated.
+     */
+    VectorType stage_input;
+
+    /**
+     * Stage values of the right hand side. Since the levels are disjoint,
+     * the entries of all levels are stored in the same vectors.
+     */
+    std::vector<VectorType> f_stages;
+
+    /**
+     * Values of the finer levels at the beginning and the middle of the
+     * current step of each level, used to interpolate them in time.
+     */
+    std::vector<VectorType> start_values;
+
+    /**
+     * @copydoc start_values
+     */
+    std::vector<VectorType> mid_values;
+
+    /**
+     * Status structure of the object.
+     */
+    Status status;
+  };
+
+
+
+  /**
+   * The LowStorageRungeKutta class is derived from RungeKutta and implements a
+   * specific class of explicit methods. The main advantages of low-storage
+   * methods are the reduced memory consumption and the reduced memory access.
+   *
+   * The methods implemented here are of the two-register (2N) type described
+   * in
+   * @code{.bib}
+   * @article{KennedyCarpenterLewis2000,
+   *   title   = {Low-storage, explicit Runge-Kutta schemes for the
+   *              compressible Navier-Stokes equations},
+   *   author  = {Kennedy, Christopher A. and Carpenter, Mark H. and
+   *              Lewis, R. Michael},
+   *   journal = {Applied Numerical Mathematics},
+   *   volume  = {35},
+   *   number  = {3},
+   *   pages   = {177--219},
+   *   year    = {2000},
+   * }
+   * @endcode
+   * Independently of the number of stages, only the solution vector and two
+   * auxiliary vectors are needed: the vector $r_i$ at which the right hand
+   * side is evaluated in stage $i$, and the result $k_i = f(t_i, r_i)$ of
+   * that evaluation. After the evaluation, the two updates
+   * @f[
+   *   r_{i+1} = y + a_i \Delta t\, k_i, \qquad y \leftarrow y + b_i \Delta t\,
+   *   k_i
+   * @f]
+   * are performed. Since both updates read the same two vectors, they can be
+   * fused into a single sweep over the data. The best way to do so is to do it
+   * directly in the loop that computes $k_i$, e.g., at the end of the cell
+   * loop of a matrix-free operator. This is what the overload of
+   * evolve_one_time_step() taking a @p perform_stage function provides: the
+   * user code gets all coefficients of a stage and is responsible for
+   * computing $k_i$ and both updates.
+   *
+   * The Butcher tableau of these methods is only determined by the
+   * coefficients $a_i$ and $b_i$, and the usual tableau entries are given by
+   * $a_{ij} = b_j$ for $j < i-1$ and $a_{i,i-1} = a_{i-1}$. This class only
+   * stores the vectors $a_i$, $b_i$, and $c_i$, which can be queried with
+   * get_coefficients().
+   */
+  template <typename VectorType>
+  class LowStorageRungeKutta : public RungeKutta<VectorType>
+  {
+  public:
+    using RungeKutta<VectorType>::evolve_one_time_step;
+
+    /**
+     * Default constructor. This constructor creates an object for which
+     * you will want to call <code>initialize(runge_kutta_method)</code>
+     * before it can be used.
+     */
+    LowStorageRungeKutta() = default;
+
+    /**
+     * Constructor. This function calls initialize(runge_kutta_method).
+     */
+    LowStorageRungeKutta(const runge_kutta_method method);
+
+    /**
+     * Initialize the low-storage explicit Runge-Kutta method. Only the
+     * methods LOW_STORAGE_RK_STAGE3_ORDER3, LOW_STORAGE_RK_STAGE5_ORDER4, and
+     * LOW_STORAGE_RK_STAGE7_ORDER4 are supported.
+     */
+    void
+    initialize(const runge_kutta_method method) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t. @p f
+     * is the function $ f(t,y) $ that should be integrated, the input
+     * parameters are the time t and the vector y and the output is value of f
+     * at this point. @p id_minus_tau_J_inverse is not used for explicit
+     * methods. evolve_one_time_step returns the time at the end of the time
+     * step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      const std::function<
+        VectorType(const double, const double, const VectorType &)>
+        &         id_minus_tau_J_inverse,
+      double      t,
+      double      delta_t,
+      VectorType &y) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t. This
+     * function is similar to the one derived from RungeKutta, but does not
+     * required id_minus_tau_J_inverse because it is not used for explicit
+     * methods. The two auxiliary vectors are allocated internally in every
+     * call. evolve_one_time_step returns the time at the end of the time
+     * step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      double                                                             t,
+      double      delta_t,
+      VectorType &y);
+
+    /**
+     * Same as the function above, but with the two auxiliary vectors @p vec_ri
+     * and @p vec_ki provided by the caller, so that no memory is allocated
+     * during the time step. Both vectors need to have the same layout as
+     * @p solution; their content on entry is ignored.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      double                                                             t,
+      double      delta_t,
+      VectorType &solution,
+      VectorType &vec_ri,
+      VectorType &vec_ki);
+
+    /**
+     * Advance from time @p t to t+ @p delta_t, leaving the evaluation of the
+     * right hand side and the vector updates of each stage to the function
+     * @p perform_stage. The arguments passed to @p perform_stage are, in this
+     * order,
+     * - the time $t + c_i \Delta t$ of the stage,
+     * - the factor $b_i \Delta t$ for the update of the solution,
+     * - the factor $a_i \Delta t$ for the update of the next stage vector,
+     * - the vector $r_i$ at which $f$ is to be evaluated,
+     * - the vector $k_i$ into which $f(t + c_i \Delta t, r_i)$ can be written,
+     * - the solution vector $y$, and
+     * - the vector $r_{i+1}$ for the next stage.
+     *
+     * @p perform_stage needs to compute
+     * @f[
+     *   k_i = f(t + c_i \Delta t, r_i), \quad
+     *   r_{i+1} = y + a_i \Delta t\, k_i, \quad
+     *   y \leftarrow y + b_i \Delta t\, k_i.
+     * @f]
+     * Note that $r_i$ and $r_{i+1}$ refer to the same vector for all stages
+     * but the first, so that $r_i$ must not be read any more once $r_{i+1}$
+     * is written. In the first stage, $r_1$ and $y$ refer to the same vector,
+     * which then must not be updated before $f$ has been evaluated. In the
+     * last stage, $r_{i+1}$ is not needed any more and the factor $a_i \Delta
+     * t$ is zero. Since the vector $k_i$ is only used within a stage, it can
+     * be ignored by implementations that compute $f$ and the updates on the
+     * fly, for instance within MatrixFree::cell_loop().
+     */
+    double
+    evolve_one_time_step(
+      const std::function<void(const double      stage_time,
+                               const double      factor_solution,
+                               const double      factor_ai,
+                               const VectorType &current_ri,
+                               VectorType &      vec_ki,
+                               VectorType &      solution,
+                               VectorType &      next_ri)> &perform_stage,
+      double                                                 t,
+      double                                                 delta_t,
+      VectorType &                                           solution,
+      VectorType &                                           vec_ri,
+      VectorType &                                           vec_ki);
+
+    /**
+     * Get the coefficients of the scheme. Note that here the vector @p a is not
+     * the conventional definition in terms of a Butcher tableau but merely
+     * the sub-diagonal. The vector @p a has one entry less than @p b and
+     * @p c.
+     */
+    void
+    get_coefficients(std::vector<double> &a,
+                     std::vector<double> &b,
+                     std::vector<double> &c) const;
+
+    /**
+     * This structure stores the name of the method used.
+     */
+    struct Status : public TimeStepping<VectorType>::Status
+    {
+      Status()
+        : method(invalid)
+      {}
+
+      runge_kutta_method method;
+    };
+
+    /**
+     * Return the status of the current object.
+     */
+    const Status &
+    get_status() const override;
+
+  private:
+    /**
+     * Compute one stage of the low-storage method, i.e., evaluate @p f at
+     * @p current_ri and update @p solution and @p next_ri.
+     */
+    void
+    compute_one_stage(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      const double      current_time,
+      const double      factor_solution,
+      const double      factor_ai,
+      const VectorType &current_ri,
+      VectorType &      vec_ki,
+      VectorType &      solution,
+      VectorType &      next_ri) const;
+
+    /**
+     * Sub-diagonal coefficients of the low-storage scheme. The remaining
+     * coefficients are stored in the vectors RungeKutta::b and RungeKutta::c.
+     */
+    std::vector<double> ai;
+
+    /**
+     * Status structure of the object.
+     */
+    Status status;
+  };
+
+
+
   /**
    * This class is derived from RungeKutta and implement the implicit methods.
    * This class works only for Diagonal Implicit Runge-Kutta (DIRK) methods.
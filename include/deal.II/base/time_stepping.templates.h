@@ -218,6 +218,523 @@ namespace TimeStepping
 
 
 
+  // ----------------------------------------------------------------------
+  // MultirateExplicitRungeKutta
+  // ----------------------------------------------------------------------
+
+  template <typename VectorType>
+  MultirateExplicitRungeKutta<VectorType>::MultirateExplicitRungeKutta(
+    const runge_kutta_method method)
+    : ExplicitRungeKutta<VectorType>(method)
+  {
+    status.method = method;
+  }
+
+
+
+  template <typename VectorType>
+  void
+  MultirateExplicitRungeKutta<VectorType>::initialize(
+    const runge_kutta_method method)
+  {
+    ExplicitRungeKutta<VectorType>::initialize(method);
+    status.method = method;
+  }
+
+
+
+  template <typename VectorType>
+  void
+  MultirateExplicitRungeKutta<VectorType>::reinit(
+    const std::vector<IndexSet> &level_dofs,
+    const std::vector<IndexSet> &read_dofs)
+  {
+    const unsigned int n_levels = level_dofs.size();
+    Assert(n_levels > 0, ExcMessage("At least one level is needed."));
+    Assert(read_dofs.empty() || read_dofs.size() == n_levels,
+           ExcDimensionMismatch(read_dofs.size(), n_levels));
+
+    level_indices.resize(n_levels);
+    for (unsigned int l = 0; l < n_levels; ++l)
+      level_dofs[l].fill_index_vector(level_indices[l]);
+
+    read_indices.clear();
+    read_indices.resize(n_levels,
+                        std::vector<std::vector<IndexSet::size_type>>(
+                          n_levels));
+    for (unsigned int l = 0; l < n_levels; ++l)
+      for (unsigned int k = 0; k < n_levels; ++k)
+        if (k != l)
+          {
+            if (read_dofs.empty())
+              read_indices[l][k] = level_indices[k];
+            else
+              (read_dofs[l] & level_dofs[k]).fill_index_vector(
+                read_indices[l][k]);
+          }
+
+    level_start_time.resize(n_levels);
+    status.n_evaluations.clear();
+    status.n_evaluations.resize(n_levels, 0);
+
+    // the vectors are set up in the first time step, when the layout of
+    // the solution vector is known
+    f_stages.clear();
+    start_values.clear();
+    mid_values.clear();
+  }
+
+
+
+  template <typename VectorType>
+  double
+  MultirateExplicitRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<void(const double,
+                             const unsigned int,
+                             const VectorType &,
+                             VectorType &)> &f,
+    double                                   t,
+    double                                   delta_t,
+    VectorType &                             y)
+  {
+    Assert(level_indices.size() > 0,
+           ExcMessage("The partition of the unknowns into levels must be set "
+                      "by reinit() before the multirate method can be used."));
+
+    if (f_stages.size() != this->n_stages)
+      {
+        stage_input = y;
+        f_stages.clear();
+        f_stages.resize(this->n_stages, y);
+        start_values.clear();
+        start_values.resize(level_indices.size() - 1, y);
+        mid_values.clear();
+        mid_values.resize(level_indices.size() - 1, y);
+      }
+
+    advance_level(f, 0, t, delta_t, y);
+
+    return (t + delta_t);
+  }
+
+
+
+  template <typename VectorType>
+  unsigned int
+  MultirateExplicitRungeKutta<VectorType>::n_levels() const
+  {
+    return level_indices.size();
+  }
+
+
+
+  template <typename VectorType>
+  std::vector<unsigned int>
+  MultirateExplicitRungeKutta<VectorType>::compute_levels(
+    const std::vector<double> &admissible_time_steps,
+    const double               delta_t,
+    const unsigned int         max_level)
+  {
+    std::vector<unsigned int> levels(admissible_time_steps.size());
+    for (unsigned int i = 0; i < admissible_time_steps.size(); ++i)
+      {
+        Assert(admissible_time_steps[i] > 0.,
+               ExcMessage("The admissible time steps must be positive."));
+        unsigned int level     = 0;
+        double       time_step = delta_t;
+        while (time_step > admissible_time_steps[i] && level < max_level)
+          {
+            time_step *= 0.5;
+            ++level;
+          }
+        levels[i] = level;
+      }
+
+    return levels;
+  }
+
+
+
+  template <typename VectorType>
+  const typename MultirateExplicitRungeKutta<VectorType>::Status &
+  MultirateExplicitRungeKutta<VectorType>::get_status() const
+  {
+    return status;
+  }
+
+
+
+  template <typename VectorType>
+  void
+  MultirateExplicitRungeKutta<VectorType>::advance_level(
+    const std::function<void(const double,
+                             const unsigned int,
+                             const VectorType &,
+                             VectorType &)> &f,
+    const unsigned int                       level,
+    const double                             t,
+    const double                             delta_t,
+    VectorType &                             y)
+  {
+    level_start_time[level] = t;
+
+    // The first stage is evaluated before the finer levels are advanced,
+    // because it is used to predict the unknowns of this level while the
+    // finer levels are integrated.
+    fill_stage_input(level, 0, t, delta_t, y);
+    f(t, level, stage_input, f_stages[0]);
+    ++status.n_evaluations[level];
+
+    if (level + 1 < level_indices.size())
+      {
+        // Store the values of the finer levels that are read on this level
+        // at the beginning and the middle of the step for the interpolation
+        // in time.
+        for (unsigned int k = level + 1; k < level_indices.size(); ++k)
+          for (const auto i : read_indices[level][k])
+            start_values[level](i) = y(i);
+
+        advance_level(f, level + 1, t, 0.5 * delta_t, y);
+
+        for (unsigned int k = level + 1; k < level_indices.size(); ++k)
+          for (const auto i : read_indices[level][k])
+            mid_values[level](i) = y(i);
+
+        advance_level(f, level + 1, t + 0.5 * delta_t, 0.5 * delta_t, y);
+      }
+
+    for (unsigned int stage = 1; stage < this->n_stages; ++stage)
+      {
+        fill_stage_input(level, stage, t, delta_t, y);
+        f(t + this->c[stage] * delta_t, level, stage_input, f_stages[stage]);
+        ++status.n_evaluations[level];
+      }
+
+    // Linear combination of the stages, only on the entries of this level
+    for (const auto i : level_indices[level])
+      {
+        typename VectorType::value_type sum = 0;
+        for (unsigned int stage = 0; stage < this->n_stages; ++stage)
+          sum += this->b[stage] * f_stages[stage](i);
+        y(i) += delta_t * sum;
+      }
+  }
+
+
+
+  template <typename VectorType>
+  void
+  MultirateExplicitRungeKutta<VectorType>::fill_stage_input(
+    const unsigned int level,
+    const unsigned int stage,
+    const double       t,
+    const double       delta_t,
+    const VectorType & y)
+  {
+    const double stage_time = t + this->c[stage] * delta_t;
+
+    // Stage values on the level itself
+    for (const auto i : level_indices[level])
+      {
+        typename VectorType::value_type value = y(i);
+        for (unsigned int j = 0; j < stage; ++j)
+          value += delta_t * this->a[stage][j] * f_stages[j](i);
+        stage_input(i) = value;
+      }
+
+    // Coarser levels are in the middle of their step: predict them with
+    // their first stage
+    for (unsigned int k = 0; k < level; ++k)
+      {
+        const double time_since_start = stage_time - level_start_time[k];
+        for (const auto i : read_indices[level][k])
+          stage_input(i) = y(i) + time_since_start * f_stages[0](i);
+      }
+
+    // Finer levels are either at the beginning of the step (first stage) or
+    // have already been advanced to its end: interpolate linearly between
+    // the values at the beginning, the middle, and the end of the step
+    if (stage == 0)
+      {
+        for (unsigned int k = level + 1; k < level_indices.size(); ++k)
+          for (const auto i : read_indices[level][k])
+            stage_input(i) = y(i);
+      }
+    else if (this->c[stage] <= 0.5)
+      {
+        const double w = 2. * this->c[stage];
+        for (unsigned int k = level + 1; k < level_indices.size(); ++k)
+          for (const auto i : read_indices[level][k])
+            stage_input(i) =
+              (1. - w) * start_values[level](i) + w * mid_values[level](i);
+      }
+    else
+      {
+        const double w = 2. * this->c[stage] - 1.;
+        for (unsigned int k = level + 1; k < level_indices.size(); ++k)
+          for (const auto i : read_indices[level][k])
+            stage_input(i) = (1. - w) * mid_values[level](i) + w * y(i);
+      }
+  }
+
+
+
+  // ----------------------------------------------------------------------
+  // LowStorageRungeKutta
+  // ----------------------------------------------------------------------
+
+  template <typename VectorType>
+  LowStorageRungeKutta<VectorType>::LowStorageRungeKutta(
+    const runge_kutta_method method)
+  {
+    // virtual functions called in constructors and destructors never use the
+    // override in a derived class
+    // for clarity be explicit on which function is called
+    LowStorageRungeKutta<VectorType>::initialize(method);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::initialize(const runge_kutta_method method)
+  {
+    status.method = method;
+
+    switch (method)
+      {
+        case (LOW_STORAGE_RK_STAGE3_ORDER3):
+          {
+            this->n_stages = 3;
+            this->b        = {0.245170287303492,
+                              0.184896052186740,
+                              0.569933660509768};
+
+            ai = {0.755726351946097, 0.386954477304099};
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE5_ORDER4):
+          {
+            this->n_stages = 5;
+            this->b        = {1153189308089. / 22510343858157.,
+                              1772645290293. / 4653164025191.,
+                              -1672844663538. / 4480602732383.,
+                              2114624349019. / 3568978502595.,
+                              5198255086312. / 14908931495163.};
+
+            ai = {970286171893. / 4311952581923.,
+                  6584761158862. / 12103376702013.,
+                  2251764453980. / 15575788980749.,
+                  26877169314380. / 34165994151039.};
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE7_ORDER4):
+          {
+            // Method by Tselios and Simos (2007), whose paper lists the
+            // differences a_i - b_i rather than a_i
+            this->n_stages = 7;
+            this->b        = {0.0941840925477795334,
+                              0.149683694803496998,
+                              0.285204742060440058,
+                              -0.122201846148053668,
+                              0.0605151571191401122,
+                              0.345986987898399296,
+                              0.186627171718797670};
+
+            ai = {0.241566650129646868 + this->b[0],
+                  0.0423866513027719953 + this->b[1],
+                  0.215602732678803776 + this->b[2],
+                  0.232328007537583987 + this->b[3],
+                  0.256223412574146438 + this->b[4],
+                  0.0978694102142697230 + this->b[5]};
+
+            break;
+          }
+        default:
+          {
+            AssertThrow(
+              false,
+              ExcMessage("Unimplemented low-storage Runge-Kutta method."));
+          }
+      }
+
+    // Stage i is evaluated at y + dt * (sum_{j<i-1} b_j k_j + a_{i-1} k_{i-1})
+    // so that the time of the stage is given by the sum of these coefficients
+    this->c.resize(this->n_stages);
+    this->c[0]   = 0.;
+    double sum_b = 0.;
+    for (unsigned int i = 1; i < this->n_stages; ++i)
+      {
+        this->c[i] = sum_b + ai[i - 1];
+        sum_b += this->b[i - 1];
+      }
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    const std::function<
+      VectorType(const double, const double, const VectorType &)>
+      & /*id_minus_tau_J_inverse*/,
+    double      t,
+    double      delta_t,
+    VectorType &y)
+  {
+    return evolve_one_time_step(f, t, delta_t, y);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    double                                                             t,
+    double                                                             delta_t,
+    VectorType &                                                       y)
+  {
+    VectorType vec_ri(y);
+    VectorType vec_ki(y);
+    return evolve_one_time_step(f, t, delta_t, y, vec_ri, vec_ki);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    double                                                             t,
+    double                                                             delta_t,
+    VectorType &solution,
+    VectorType &vec_ri,
+    VectorType &vec_ki)
+  {
+    return evolve_one_time_step(
+      [this, &f](const double      stage_time,
+                 const double      factor_solution,
+                 const double      factor_ai,
+                 const VectorType &current_ri,
+                 VectorType &      stage_ki,
+                 VectorType &      stage_solution,
+                 VectorType &      next_ri) {
+        this->compute_one_stage(f,
+                                stage_time,
+                                factor_solution,
+                                factor_ai,
+                                current_ri,
+                                stage_ki,
+                                stage_solution,
+                                next_ri);
+      },
+      t,
+      delta_t,
+      solution,
+      vec_ri,
+      vec_ki);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<void(const double,
+                             const double,
+                             const double,
+                             const VectorType &,
+                             VectorType &,
+                             VectorType &,
+                             VectorType &)> &perform_stage,
+    double                                   t,
+    double                                   delta_t,
+    VectorType &                             solution,
+    VectorType &                             vec_ri,
+    VectorType &                             vec_ki)
+  {
+    Assert(this->n_stages > 0 && ai.size() + 1 == this->n_stages,
+           ExcMessage("The low-storage Runge-Kutta method has not been "
+                      "initialized."));
+
+    // The first stage is evaluated at the old solution, which must hence be
+    // passed as the stage vector
+    perform_stage(t,
+                  this->b[0] * delta_t,
+                  ai[0] * delta_t,
+                  solution,
+                  vec_ki,
+                  solution,
+                  vec_ri);
+
+    for (unsigned int stage = 1; stage < this->n_stages; ++stage)
+      perform_stage(t + this->c[stage] * delta_t,
+                    this->b[stage] * delta_t,
+                    (stage == this->n_stages - 1 ? 0. : ai[stage] * delta_t),
+                    vec_ri,
+                    vec_ki,
+                    solution,
+                    vec_ri);
+
+    return (t + delta_t);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::get_coefficients(
+    std::vector<double> &a,
+    std::vector<double> &b,
+    std::vector<double> &c) const
+  {
+    a = ai;
+    b = this->b;
+    c = this->c;
+  }
+
+
+
+  template <typename VectorType>
+  const typename LowStorageRungeKutta<VectorType>::Status &
+  LowStorageRungeKutta<VectorType>::get_status() const
+  {
+    return status;
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::compute_one_stage(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    const double      current_time,
+    const double      factor_solution,
+    const double      factor_ai,
+    const VectorType &current_ri,
+    VectorType &      vec_ki,
+    VectorType &      solution,
+    VectorType &      next_ri) const
+  {
+    vec_ki = f(current_time, current_ri);
+
+    // The next stage vector must be computed before the solution is updated
+    // because current_ri and solution coincide in the first stage. In the
+    // last stage, next_ri is not needed.
+    if (factor_ai != 0.)
+      {
+        next_ri = solution;
+        next_ri.add(factor_ai, vec_ki);
+      }
+    solution.add(factor_solution, vec_ki);
+  }
+
+
+
   // ----------------------------------------------------------------------
   // ImplicitRungeKutta
   // ----------------------------------------------------------------------
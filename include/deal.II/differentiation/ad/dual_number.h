@@ -0,0 +1,1371 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_differentiation_ad_dual_number_h
+#define dealii_differentiation_ad_dual_number_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/table_indices.h>
+#include <deal.II/base/template_constraints.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/differentiation/ad/ad_number_traits.h>
+#include <deal.II/differentiation/ad/ad_number_types.h>
+
+#include <cmath>
+#include <type_traits>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace Differentiation
+{
+  namespace AD
+  {
+    /**
+     * A forward-mode auto-differentiable number with a fixed number
+     * @p n_derivatives of directional derivatives. The number stores its
+     * value together with the derivatives with respect to
+     * @p n_derivatives independent variables, and all arithmetic operations
+     * and mathematical functions propagate the derivatives by the chain rule.
+     *
+     * Contrary to the auto-differentiable numbers provided by ADOL-C and
+     * Sacado, this class does not depend on any external library, does not
+     * record a tape and never allocates memory, since all the derivatives are
+     * stored in a fixed-size array. The underlying @p Number can be a
+     * floating point type, a VectorizedArray, in which case the derivatives
+     * of the same function are computed for several arguments (e.g., the
+     * quadrature points of a batch of cells) at once, or another DualNumber,
+     * which gives access to second derivatives. The number can be used as the
+     * underlying type of Tensor and SymmetricTensor.
+     *
+     * The functions compute_gradient() and compute_gradient_and_hessian()
+     * below take care of setting up the independent variables for a
+     * tensor-valued argument and of extracting the derivatives of a scalar
+     * function of it, for instance the free energy of a hyperelastic
+     * material:
+     * @code
+     * const auto psi = [&](const auto &C) {
+     *   return 0.5 * mu * (trace(C) - dim) - mu * std::log(std::sqrt(
+     *            determinant(C))) + lambda * ...;
+     * };
+     *
+     * SymmetricTensor<2, dim, VectorizedArray<double>> S;
+     * SymmetricTensor<4, dim, VectorizedArray<double>> H;
+     * const VectorizedArray<double> energy =
+     *   Differentiation::AD::compute_gradient_and_hessian(psi, C, S, H);
+     * @endcode
+     *
+     * @note Since the number of derivatives is a template argument, this
+     * class is not one of the AD::NumberTypes used by the helper classes in
+     * ad_helpers.h, which determine the number of independent variables at
+     * run time.
+     *
+     * @tparam Number The type of the value and of the derivatives.
+     * @tparam n_derivatives The number of independent variables.
+     */
+    template <typename Number, int n_derivatives>
+    class DualNumber
+    {
+    public:
+      static_assert(n_derivatives > 0,
+                    "A DualNumber needs at least one derivative.");
+
+      /**
+       * The type of the value and of the derivatives.
+       */
+      using value_type = Number;
+
+      /**
+       * The number of directional derivatives.
+       */
+      static constexpr unsigned int n_directional_derivatives = n_derivatives;
+
+      /**
+       * Default constructor. Initialize the value and all derivatives to
+       * zero.
+       */
+      DualNumber();
+
+      /**
+       * Constructor for a constant with value @p value, whose derivatives
+       * are zero.
+       */
+      DualNumber(const Number &value);
+
+      /**
+       * Constructor for a constant from a floating point or integer @p value.
+       */
+      template <typename T,
+                typename = typename std::enable_if<
+                  std::is_arithmetic<T>::value &&
+                  !std::is_same<T, Number>::value>::type>
+      DualNumber(const T value);
+
+      /**
+       * Constructor for the independent variable with the index
+       * @p direction, whose derivative in this direction is one, and zero
+       * in all other directions.
+       */
+      DualNumber(const Number &value, const unsigned int direction);
+
+      /**
+       * Read access to the value.
+       */
+      const Number &
+      value() const;
+
+      /**
+       * Write access to the value.
+       */
+      Number &
+      value();
+
+      /**
+       * Read access to the derivative in the direction @p direction.
+       */
+      const Number &
+      derivative(const unsigned int direction) const;
+
+      /**
+       * Write access to the derivative in the direction @p direction.
+       */
+      Number &
+      derivative(const unsigned int direction);
+
+      /**
+       * Add another dual number.
+       */
+      DualNumber &
+      operator+=(const DualNumber &other);
+
+      /**
+       * Subtract another dual number.
+       */
+      DualNumber &
+      operator-=(const DualNumber &other);
+
+      /**
+       * Multiply by another dual number.
+       */
+      DualNumber &
+      operator*=(const DualNumber &other);
+
+      /**
+       * Divide by another dual number.
+       */
+      DualNumber &
+      operator/=(const DualNumber &other);
+
+      /**
+       * Add a constant.
+       */
+      template <typename T>
+      typename std::enable_if<!std::is_same<T, DualNumber>::value &&
+                                std::is_constructible<Number, T>::value,
+                              DualNumber &>::type
+      operator+=(const T &other);
+
+      /**
+       * Subtract a constant.
+       */
+      template <typename T>
+      typename std::enable_if<!std::is_same<T, DualNumber>::value &&
+                                std::is_constructible<Number, T>::value,
+                              DualNumber &>::type
+      operator-=(const T &other);
+
+      /**
+       * Multiply by a constant.
+       */
+      template <typename T>
+      typename std::enable_if<!std::is_same<T, DualNumber>::value &&
+                                std::is_constructible<Number, T>::value,
+                              DualNumber &>::type
+      operator*=(const T &other);
+
+      /**
+       * Divide by a constant.
+       */
+      template <typename T>
+      typename std::enable_if<!std::is_same<T, DualNumber>::value &&
+                                std::is_constructible<Number, T>::value,
+                              DualNumber &>::type
+      operator/=(const T &other);
+
+    private:
+      /**
+       * The value.
+       */
+      Number val;
+
+      /**
+       * The derivatives with respect to the independent variables.
+       */
+      Number derivatives[n_derivatives];
+    };
+
+
+
+    /**
+     * A struct to indicate whether a given @p NumberType is a DualNumber.
+     */
+    template <typename NumberType>
+    struct is_dual_number : std::false_type
+    {};
+
+
+
+    /**
+     * Specialization of the struct for DualNumber.
+     */
+    template <typename Number, int n_derivatives>
+    struct is_dual_number<DualNumber<Number, n_derivatives>> : std::true_type
+    {};
+
+
+
+    /**
+     * Compute the value and the gradient of the scalar function
+     * @p function with respect to the tensor @p x, using DualNumber objects
+     * with as many derivatives as @p x has independent components. The
+     * function object is called with a tensor of the same kind as @p x whose
+     * entries are of type DualNumber<Number, n>, and must return a
+     * DualNumber<Number, n>. For a symmetric tensor, the gradient is the
+     * derivative with respect to the symmetric tensor, i.e., the
+     * contributions of the two off-diagonal entries that share the same
+     * independent variable are accounted for.
+     *
+     * If @p Number is a VectorizedArray, the gradients at all the points
+     * stored in the lanes of @p x are computed in the same operations.
+     *
+     * @return The value of the function.
+     */
+    template <typename FunctionType, int rank, int dim, typename Number>
+    Number
+    compute_gradient(const FunctionType &             function,
+                     const Tensor<rank, dim, Number> &x,
+                     Tensor<rank, dim, Number> &      gradient);
+
+    /**
+     * Same as above, for a function of a symmetric tensor.
+     */
+    template <typename FunctionType, int dim, typename Number>
+    Number
+    compute_gradient(const FunctionType &                 function,
+                     const SymmetricTensor<2, dim, Number> &x,
+                     SymmetricTensor<2, dim, Number> &      gradient);
+
+    /**
+     * Compute the value, the gradient and the Hessian of the scalar function
+     * @p function with respect to the tensor @p x, using nested DualNumber
+     * objects. The function object is called with a tensor whose entries are
+     * of type DualNumber<DualNumber<Number, n>, n>, and must return this
+     * type. It is usually a generic lambda, so that the same code can be used
+     * with compute_gradient().
+     *
+     * @return The value of the function.
+     */
+    template <typename FunctionType, int rank, int dim, typename Number>
+    Number
+    compute_gradient_and_hessian(const FunctionType &              function,
+                                 const Tensor<rank, dim, Number> & x,
+                                 Tensor<rank, dim, Number> &       gradient,
+                                 Tensor<2 * rank, dim, Number> &   hessian);
+
+    /**
+     * Same as above, for a function of a symmetric tensor. The Hessian is the
+     * fourth order symmetric tensor of second derivatives with respect to
+     * the symmetric tensor.
+     */
+    template <typename FunctionType, int dim, typename Number>
+    Number
+    compute_gradient_and_hessian(
+      const FunctionType &                   function,
+      const SymmetricTensor<2, dim, Number> &x,
+      SymmetricTensor<2, dim, Number> &      gradient,
+      SymmetricTensor<4, dim, Number> &      hessian);
+
+  } // namespace AD
+} // namespace Differentiation
+
+
+
+/**
+ * Specialization of the EnableIfScalar type trait for DualNumber, which
+ * allows tensors to be multiplied by dual numbers.
+ */
+template <typename Number, int n_derivatives>
+struct EnableIfScalar<Differentiation::AD::DualNumber<Number, n_derivatives>>
+{
+  using type = Differentiation::AD::DualNumber<Number, n_derivatives>;
+};
+
+
+/* ----------- inline and template functions and specializations ----------- */
+
+
+#ifndef DOXYGEN
+
+namespace Differentiation
+{
+  namespace AD
+  {
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>::DualNumber()
+      : val(0.)
+    {
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] = 0.;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>::DualNumber(const Number &value)
+      : val(value)
+    {
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] = 0.;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    template <typename T, typename>
+    inline DualNumber<Number, n_derivatives>::DualNumber(const T value)
+      : val(value)
+    {
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] = 0.;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>::DualNumber(
+      const Number &     value,
+      const unsigned int direction)
+      : val(value)
+    {
+      AssertIndexRange(direction, n_derivatives);
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] = 0.;
+      derivatives[direction] = 1.;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline const Number &
+    DualNumber<Number, n_derivatives>::value() const
+    {
+      return val;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline Number &
+    DualNumber<Number, n_derivatives>::value()
+    {
+      return val;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline const Number &
+    DualNumber<Number, n_derivatives>::derivative(
+      const unsigned int direction) const
+    {
+      AssertIndexRange(direction, n_derivatives);
+      return derivatives[direction];
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline Number &
+    DualNumber<Number, n_derivatives>::derivative(const unsigned int direction)
+    {
+      AssertIndexRange(direction, n_derivatives);
+      return derivatives[direction];
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator+=(const DualNumber &other)
+    {
+      val += other.val;
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] += other.derivatives[d];
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator-=(const DualNumber &other)
+    {
+      val -= other.val;
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] -= other.derivatives[d];
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator*=(const DualNumber &other)
+    {
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] =
+          derivatives[d] * other.val + val * other.derivatives[d];
+      val *= other.val;
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives> &
+    DualNumber<Number, n_derivatives>::operator/=(const DualNumber &other)
+    {
+      // (u/v)' = (u' - (u/v) v') / v
+      const Number inverse = Number(1.) / other.val;
+      val *= inverse;
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] =
+          (derivatives[d] - val * other.derivatives[d]) * inverse;
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    template <typename T>
+    inline typename std::enable_if<
+      !std::is_same<T, DualNumber<Number, n_derivatives>>::value &&
+        std::is_constructible<Number, T>::value,
+      DualNumber<Number, n_derivatives> &>::type
+    DualNumber<Number, n_derivatives>::operator+=(const T &other)
+    {
+      val += Number(other);
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    template <typename T>
+    inline typename std::enable_if<
+      !std::is_same<T, DualNumber<Number, n_derivatives>>::value &&
+        std::is_constructible<Number, T>::value,
+      DualNumber<Number, n_derivatives> &>::type
+    DualNumber<Number, n_derivatives>::operator-=(const T &other)
+    {
+      val -= Number(other);
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    template <typename T>
+    inline typename std::enable_if<
+      !std::is_same<T, DualNumber<Number, n_derivatives>>::value &&
+        std::is_constructible<Number, T>::value,
+      DualNumber<Number, n_derivatives> &>::type
+    DualNumber<Number, n_derivatives>::operator*=(const T &other)
+    {
+      const Number factor(other);
+      val *= factor;
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] *= factor;
+      return *this;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    template <typename T>
+    inline typename std::enable_if<
+      !std::is_same<T, DualNumber<Number, n_derivatives>>::value &&
+        std::is_constructible<Number, T>::value,
+      DualNumber<Number, n_derivatives> &>::type
+    DualNumber<Number, n_derivatives>::operator/=(const T &other)
+    {
+      const Number inverse = Number(1.) / Number(other);
+      val *= inverse;
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        derivatives[d] *= inverse;
+      return *this;
+    }
+
+
+
+    namespace internal
+    {
+      /**
+       * A type trait that selects the operands other than a DualNumber of
+       * type @p DualType that can be combined with it in arithmetic
+       * operations, i.e., all types the value type of @p DualType can be
+       * constructed from.
+       */
+      template <typename T, typename DualType>
+      struct is_dual_number_operand
+        : std::integral_constant<
+            bool,
+            !std::is_same<T, DualType>::value &&
+              std::is_constructible<typename DualType::value_type, T>::value>
+      {};
+
+
+
+      /**
+       * The floating point type underlying a (possibly vectorized or nested)
+       * number type.
+       */
+      template <typename Number>
+      struct DualNumberRealType
+      {
+        using type = Number;
+      };
+
+      template <typename Number, std::size_t width>
+      struct DualNumberRealType<VectorizedArray<Number, width>>
+      {
+        using type = Number;
+      };
+
+      template <typename Number, int n_derivatives>
+      struct DualNumberRealType<DualNumber<Number, n_derivatives>>
+      {
+        using type = typename DualNumberRealType<Number>::type;
+      };
+
+
+
+      /**
+       * Return the sign of @p x, i.e., -1, 0, or 1. This is used for the
+       * derivative of the absolute value.
+       */
+      template <typename Number>
+      inline typename std::enable_if<std::is_arithmetic<Number>::value,
+                                     Number>::type
+      sign(const Number &x)
+      {
+        return (x > Number(0)) ? Number(1) :
+                                 ((x < Number(0)) ? Number(-1) : Number(0));
+      }
+
+      template <typename Number, std::size_t width>
+      inline VectorizedArray<Number, width>
+      sign(const VectorizedArray<Number, width> &x)
+      {
+        VectorizedArray<Number, width> result;
+        for (unsigned int v = 0; v < width; ++v)
+          result[v] = sign(x[v]);
+        return result;
+      }
+
+      template <typename Number, int n_derivatives>
+      inline DualNumber<Number, n_derivatives>
+      sign(const DualNumber<Number, n_derivatives> &x)
+      {
+        // The sign is piecewise constant, so all derivatives are zero
+        return DualNumber<Number, n_derivatives>(sign(x.value()));
+      }
+
+
+
+      /**
+       * Return a dual number with value @p value whose derivatives are
+       * @p derivative times the derivatives of @p x, i.e., the result of
+       * applying a function with the value @p value and the derivative
+       * @p derivative at the point <tt>x.value()</tt> to @p x.
+       */
+      template <typename Number, int n_derivatives>
+      inline DualNumber<Number, n_derivatives>
+      chain_rule(const DualNumber<Number, n_derivatives> &x,
+                 const Number &                           value,
+                 const Number &                           derivative)
+      {
+        DualNumber<Number, n_derivatives> result(value);
+        for (unsigned int d = 0; d < n_derivatives; ++d)
+          result.derivative(d) = derivative * x.derivative(d);
+        return result;
+      }
+
+
+
+      /**
+       * Information about a DualNumber in the form expected by the generic
+       * interface to auto-differentiable numbers, see ExtractData and
+       * Marking.
+       */
+      template <typename Number>
+      struct DualNumberInfo
+      {
+        static const unsigned int n_supported_derivative_levels = 0;
+      };
+
+      template <typename Number, int n_derivatives>
+      struct DualNumberInfo<DualNumber<Number, n_derivatives>>
+      {
+        using ad_type         = DualNumber<Number, n_derivatives>;
+        using scalar_type     = typename DualNumberRealType<Number>::type;
+        using value_type      = Number;
+        using derivative_type = Number;
+
+        static const unsigned int n_supported_derivative_levels =
+          1 + DualNumberInfo<Number>::n_supported_derivative_levels;
+      };
+
+
+
+      /**
+       * Specialization of the marking strategy for DualNumber objects.
+       */
+      template <typename Number, int n_derivatives>
+      struct Marking<DualNumber<Number, n_derivatives>>
+      {
+        using ad_type = DualNumber<Number, n_derivatives>;
+        using derivative_type =
+          typename DualNumberInfo<ad_type>::derivative_type;
+        using scalar_type = typename DualNumberInfo<ad_type>::scalar_type;
+
+        /*
+         * Initialize the state of an independent variable.
+         */
+        static void
+        independent_variable(const scalar_type &in,
+                             const unsigned int index,
+                             const unsigned int n_independent_variables,
+                             ad_type &          out)
+        {
+          Assert(n_independent_variables <= n_derivatives,
+                 ExcMessage("The number of independent variables exceeds the "
+                            "number of derivatives of the DualNumber type."));
+          out = ad_type(Number(0.), index);
+
+          // Initialize potential nested directional derivatives
+          Marking<derivative_type>::independent_variable(
+            in, index, n_independent_variables, out.value());
+        }
+
+        /*
+         * Initialize the state of a dependent variable.
+         */
+        static void
+        dependent_variable(ad_type &out, const ad_type &func)
+        {
+          out = func;
+        }
+      };
+
+
+
+      /**
+       * A struct to help extract certain information associated with
+       * DualNumber objects.
+       */
+      template <typename Number, int n_derivatives>
+      struct ExtractData<DualNumber<Number, n_derivatives>>
+      {
+        using derivative_type = typename DualNumberInfo<
+          DualNumber<Number, n_derivatives>>::derivative_type;
+        using scalar_type = typename DualNumberInfo<
+          DualNumber<Number, n_derivatives>>::scalar_type;
+
+        /**
+         * Extract the real scalar value.
+         */
+        static scalar_type
+        value(const DualNumber<Number, n_derivatives> &x)
+        {
+          return ExtractData<Number>::value(x.value());
+        }
+
+
+        /**
+         * Extract the number of directional derivatives.
+         */
+        static unsigned int
+        n_directional_derivatives(const DualNumber<Number, n_derivatives> &)
+        {
+          return n_derivatives;
+        }
+
+
+        /**
+         * Extract the directional derivative in the specified @p direction.
+         */
+        static derivative_type
+        directional_derivative(const DualNumber<Number, n_derivatives> &x,
+                               const unsigned int direction)
+        {
+          return x.derivative(direction);
+        }
+      };
+
+
+
+      /**
+       * Information on the tensor types supported by compute_gradient() and
+       * compute_gradient_and_hessian().
+       */
+      template <typename TensorType>
+      struct DualTensorInfo;
+
+      template <int rank, int dim, typename Number>
+      struct DualTensorInfo<Tensor<rank, dim, Number>>
+      {
+        static_assert(rank > 0, "Tensors of rank zero are not supported.");
+
+        using scalar_type = Number;
+
+        static constexpr unsigned int n_components =
+          Tensor<rank, dim>::n_independent_components;
+
+        template <typename OtherNumber>
+        using tensor_type = Tensor<rank, dim, OtherNumber>;
+
+        static TableIndices<rank>
+        component_indices(const unsigned int i)
+        {
+          return Tensor<rank, dim>::unrolled_to_component_indices(i);
+        }
+
+        static bool
+        symmetric_component(const unsigned int)
+        {
+          return false;
+        }
+      };
+
+      template <int dim, typename Number>
+      struct DualTensorInfo<SymmetricTensor<2, dim, Number>>
+      {
+        using scalar_type = Number;
+
+        static constexpr unsigned int n_components =
+          SymmetricTensor<2, dim>::n_independent_components;
+
+        template <typename OtherNumber>
+        using tensor_type = SymmetricTensor<2, dim, OtherNumber>;
+
+        static TableIndices<2>
+        component_indices(const unsigned int i)
+        {
+          return SymmetricTensor<2, dim>::unrolled_to_component_indices(i);
+        }
+
+        static bool
+        symmetric_component(const unsigned int i)
+        {
+          const TableIndices<2> indices = component_indices(i);
+          return indices[0] != indices[1];
+        }
+      };
+
+
+
+      /**
+       * Concatenate two multi-indices.
+       */
+      template <int rank>
+      inline TableIndices<2 * rank>
+      concatenate_indices(const TableIndices<rank> &i,
+                          const TableIndices<rank> &j)
+      {
+        TableIndices<2 * rank> result;
+        for (unsigned int r = 0; r < rank; ++r)
+          {
+            result[r]        = i[r];
+            result[rank + r] = j[r];
+          }
+        return result;
+      }
+
+
+
+      template <typename FunctionType, typename TensorType>
+      inline typename DualTensorInfo<TensorType>::scalar_type
+      compute_gradient(const FunctionType &function,
+                       const TensorType &  x,
+                       TensorType &        gradient)
+      {
+        using Info               = DualTensorInfo<TensorType>;
+        using Number             = typename Info::scalar_type;
+        constexpr unsigned int n = Info::n_components;
+        using ad_type            = DualNumber<Number, n>;
+        using ad_tensor_type = typename Info::template tensor_type<ad_type>;
+
+        ad_tensor_type x_ad;
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            const auto indices = Info::component_indices(i);
+            x_ad[indices]      = ad_type(x[indices], i);
+          }
+
+        const ad_type f = function(x_ad);
+
+        // The derivative with respect to an off-diagonal component of a
+        // symmetric tensor contains the contributions of both entries
+        for (unsigned int i = 0; i < n; ++i)
+          gradient[Info::component_indices(i)] =
+            Info::symmetric_component(i) ? f.derivative(i) * 0.5 :
+                                           f.derivative(i);
+
+        return f.value();
+      }
+
+
+
+      template <typename FunctionType,
+                typename TensorType,
+                typename HessianType>
+      inline typename DualTensorInfo<TensorType>::scalar_type
+      compute_gradient_and_hessian(const FunctionType &function,
+                                   const TensorType &  x,
+                                   TensorType &        gradient,
+                                   HessianType &       hessian)
+      {
+        using Info               = DualTensorInfo<TensorType>;
+        using Number             = typename Info::scalar_type;
+        constexpr unsigned int n = Info::n_components;
+        using ad_type            = DualNumber<Number, n>;
+        using ad_ad_type         = DualNumber<ad_type, n>;
+        using ad_tensor_type = typename Info::template tensor_type<ad_ad_type>;
+
+        ad_tensor_type x_ad;
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            const auto indices = Info::component_indices(i);
+            x_ad[indices]      = ad_ad_type(ad_type(x[indices], i), i);
+          }
+
+        const ad_ad_type f = function(x_ad);
+
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            const auto   indices_i = Info::component_indices(i);
+            const double scaling_i = Info::symmetric_component(i) ? 0.5 : 1.;
+            gradient[indices_i]    = f.value().derivative(i) * scaling_i;
+            for (unsigned int j = 0; j < n; ++j)
+              {
+                const double scaling_j =
+                  Info::symmetric_component(j) ? 0.5 : 1.;
+                hessian[concatenate_indices(indices_i,
+                                            Info::component_indices(j))] =
+                  f.derivative(i).derivative(j) * (scaling_i * scaling_j);
+              }
+          }
+
+        return f.value().value();
+      }
+    } // namespace internal
+
+
+
+    template <typename FunctionType, int rank, int dim, typename Number>
+    inline Number
+    compute_gradient(const FunctionType &             function,
+                     const Tensor<rank, dim, Number> &x,
+                     Tensor<rank, dim, Number> &      gradient)
+    {
+      return internal::compute_gradient(function, x, gradient);
+    }
+
+
+
+    template <typename FunctionType, int dim, typename Number>
+    inline Number
+    compute_gradient(const FunctionType &                  function,
+                     const SymmetricTensor<2, dim, Number> &x,
+                     SymmetricTensor<2, dim, Number> &      gradient)
+    {
+      return internal::compute_gradient(function, x, gradient);
+    }
+
+
+
+    template <typename FunctionType, int rank, int dim, typename Number>
+    inline Number
+    compute_gradient_and_hessian(const FunctionType &             function,
+                                 const Tensor<rank, dim, Number> &x,
+                                 Tensor<rank, dim, Number> &      gradient,
+                                 Tensor<2 * rank, dim, Number> &  hessian)
+    {
+      return internal::compute_gradient_and_hessian(function,
+                                                    x,
+                                                    gradient,
+                                                    hessian);
+    }
+
+
+
+    template <typename FunctionType, int dim, typename Number>
+    inline Number
+    compute_gradient_and_hessian(
+      const FunctionType &                   function,
+      const SymmetricTensor<2, dim, Number> &x,
+      SymmetricTensor<2, dim, Number> &      gradient,
+      SymmetricTensor<4, dim, Number> &      hessian)
+    {
+      return internal::compute_gradient_and_hessian(function,
+                                                    x,
+                                                    gradient,
+                                                    hessian);
+    }
+
+
+
+    /* ------------------------ arithmetic operators ------------------------ */
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator+(const DualNumber<Number, n_derivatives> &x)
+    {
+      return x;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator-(const DualNumber<Number, n_derivatives> &x)
+    {
+      DualNumber<Number, n_derivatives> result(-x.value());
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        result.derivative(d) = -x.derivative(d);
+      return result;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator+(const DualNumber<Number, n_derivatives> &x,
+              const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result(x);
+      return result += y;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator-(const DualNumber<Number, n_derivatives> &x,
+              const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result(x);
+      return result -= y;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator*(const DualNumber<Number, n_derivatives> &x,
+              const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result(x.value() * y.value());
+      for (unsigned int d = 0; d < n_derivatives; ++d)
+        result.derivative(d) =
+          x.derivative(d) * y.value() + x.value() * y.derivative(d);
+      return result;
+    }
+
+
+
+    template <typename Number, int n_derivatives>
+    inline DualNumber<Number, n_derivatives>
+    operator/(const DualNumber<Number, n_derivatives> &x,
+              const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result(x);
+      return result /= y;
+    }
+
+
+
+    template <typename Number, int n_derivatives, typename T>
+    inline typename std::enable_if<
+      internal::is_dual_number_operand<T, DualNumber<Number, n_derivatives>>::
+        value,
+      DualNumber<Number, n_derivatives>>::type
+    operator+(const DualNumber<Number, n_derivatives> &x, const T &y)
+    {
+      DualNumber<Number, n_derivatives> result(x);
+      return result += y;
+    }
+
+
+
+    template <typename Number, int n_derivatives, typename T>
+    inline typename std::enable_if<
+      internal::is_dual_number_operand<T, DualNumber<Number, n_derivatives>>::
+        value,
+      DualNumber<Number, n_derivatives>>::type
+    operator+(const T &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result(y);
+      return result += x;
+    }
+
+
+
+    template <typename Number, int n_derivatives, typename T>
+    inline typename std::enable_if<
+      internal::is_dual_number_operand<T, DualNumber<Number, n_derivatives>>::
+        value,
+      DualNumber<Number, n_derivatives>>::type
+    operator-(const DualNumber<Number, n_derivatives> &x, const T &y)
+    {
+      DualNumber<Number, n_derivatives> result(x);
+      return result -= y;
+    }
+
+
+
+    template <typename Number, int n_derivatives, typename T>
+    inline typename std::enable_if<
+      internal::is_dual_number_operand<T, DualNumber<Number, n_derivatives>>::
+        value,
+      DualNumber<Number, n_derivatives>>::type
+    operator-(const T &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result(-y);
+      return result += x;
+    }
+
+
+
+    template <typename Number, int n_derivatives, typename T>
+    inline typename std::enable_if<
+      internal::is_dual_number_operand<T, DualNumber<Number, n_derivatives>>::
+        value,
+      DualNumber<Number, n_derivatives>>::type
+    operator*(const DualNumber<Number, n_derivatives> &x, const T &y)
+    {
+      DualNumber<Number, n_derivatives> result(x);
+      return result *= y;
+    }
+
+
+
+    template <typename Number, int n_derivatives, typename T>
+    inline typename std::enable_if<
+      internal::is_dual_number_operand<T, DualNumber<Number, n_derivatives>>::
+        value,
+      DualNumber<Number, n_derivatives>>::type
+    operator*(const T &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      DualNumber<Number, n_derivatives> result(y);
+      return result *= x;
+    }
+
+
+
+    template <typename Number, int n_derivatives, typename T>
+    inline typename std::enable_if<
+      internal::is_dual_number_operand<T, DualNumber<Number, n_derivatives>>::
+        value,
+      DualNumber<Number, n_derivatives>>::type
+    operator/(const DualNumber<Number, n_derivatives> &x, const T &y)
+    {
+      DualNumber<Number, n_derivatives> result(x);
+      return result /= y;
+    }
+
+
+
+    template <typename Number, int n_derivatives, typename T>
+    inline typename std::enable_if<
+      internal::is_dual_number_operand<T, DualNumber<Number, n_derivatives>>::
+        value,
+      DualNumber<Number, n_derivatives>>::type
+    operator/(const T &x, const DualNumber<Number, n_derivatives> &y)
+    {
+      // (x/y)' = -x y' / y^2
+      const Number value = Number(x) / y.value();
+      return internal::chain_rule(y, value, -value / y.value());
+    }
+
+
+
+    /* ------------------------ comparison operators ------------------------ */
+
+    // Comparisons only consider the value, and are only available if the
+    // underlying number type can be compared (i.e., not for VectorizedArray)
+
+#  define DEAL_II_DUAL_NUMBER_COMPARISON(op)                                  \
+    template <typename Number, int n_derivatives>                              \
+    inline auto operator op(const DualNumber<Number, n_derivatives> &x,        \
+                            const DualNumber<Number, n_derivatives> &y)        \
+      ->decltype(x.value() op y.value())                                       \
+    {                                                                          \
+      return x.value() op y.value();                                           \
+    }                                                                          \
+                                                                               \
+    template <typename Number, int n_derivatives, typename T>                  \
+    inline auto operator op(const DualNumber<Number, n_derivatives> &x,        \
+                            const T &y)                                        \
+      ->typename std::enable_if<internal::is_dual_number_operand<              \
+                                  T,                                           \
+                                  DualNumber<Number, n_derivatives>>::value,   \
+                                decltype(x.value() op Number(y))>::type        \
+    {                                                                          \
+      return x.value() op Number(y);                                           \
+    }                                                                          \
+                                                                               \
+    template <typename Number, int n_derivatives, typename T>                  \
+    inline auto operator op(const T &x,                                        \
+                            const DualNumber<Number, n_derivatives> &y)        \
+      ->typename std::enable_if<internal::is_dual_number_operand<              \
+                                  T,                                           \
+                                  DualNumber<Number, n_derivatives>>::value,   \
+                                decltype(Number(x) op y.value())>::type        \
+    {                                                                          \
+      return Number(x) op y.value();                                           \
+    }
+
+    DEAL_II_DUAL_NUMBER_COMPARISON(==)
+    DEAL_II_DUAL_NUMBER_COMPARISON(!=)
+    DEAL_II_DUAL_NUMBER_COMPARISON(<)
+    DEAL_II_DUAL_NUMBER_COMPARISON(<=)
+    DEAL_II_DUAL_NUMBER_COMPARISON(>)
+    DEAL_II_DUAL_NUMBER_COMPARISON(>=)
+
+#  undef DEAL_II_DUAL_NUMBER_COMPARISON
+
+  } // namespace AD
+} // namespace Differentiation
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+
+
+/**
+ * Implementation of functions from cmath on DualNumber objects. The values
+ * and derivatives are computed with the functions of the underlying number
+ * type, which can itself be a VectorizedArray or a DualNumber.
+ */
+namespace std
+{
+  // Declare the functions that are called recursively for nested dual
+  // numbers before their definitions
+  template <typename Number, int n_derivatives>
+  ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  sin(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x);
+
+  template <typename Number, int n_derivatives>
+  ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  cos(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x);
+
+
+
+  /**
+   * Compute the square root of a dual number.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  sqrt(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+         &x)
+  {
+    const Number value = std::sqrt(x.value());
+    return ::dealii::Differentiation::AD::internal::chain_rule(
+      x, value, Number(0.5) / value);
+  }
+
+
+
+  /**
+   * Compute the exponential of a dual number.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  exp(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    const Number value = std::exp(x.value());
+    return ::dealii::Differentiation::AD::internal::chain_rule(x,
+                                                               value,
+                                                               value);
+  }
+
+
+
+  /**
+   * Compute the natural logarithm of a dual number.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  log(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    return ::dealii::Differentiation::AD::internal::chain_rule(
+      x, Number(std::log(x.value())), Number(Number(1.) / x.value()));
+  }
+
+
+
+  /**
+   * Raise a dual number to the power @p p.
+   */
+  template <typename Number, int n_derivatives, typename T>
+  inline typename std::enable_if<
+    std::is_arithmetic<T>::value,
+    ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>>::type
+  pow(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &     x,
+      const T p)
+  {
+    using real_type = typename ::dealii::Differentiation::AD::internal::
+      DualNumberRealType<Number>::type;
+    const real_type exponent = p;
+    return ::dealii::Differentiation::AD::internal::chain_rule(
+      x,
+      Number(std::pow(x.value(), exponent)),
+      Number(std::pow(x.value(), exponent - real_type(1.)) * exponent));
+  }
+
+
+
+  /**
+   * Raise a dual number to the power of another dual number.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  pow(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x,
+      const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &p)
+  {
+    return std::exp(p * std::log(x));
+  }
+
+
+
+  /**
+   * Compute the sine of a dual number.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  sin(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    return ::dealii::Differentiation::AD::internal::chain_rule(
+      x, Number(std::sin(x.value())), Number(std::cos(x.value())));
+  }
+
+
+
+  /**
+   * Compute the cosine of a dual number.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  cos(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    return ::dealii::Differentiation::AD::internal::chain_rule(
+      x, Number(std::cos(x.value())), Number(-std::sin(x.value())));
+  }
+
+
+
+  /**
+   * Compute the tangent of a dual number.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  tan(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    const Number value = std::tan(x.value());
+    return ::dealii::Differentiation::AD::internal::chain_rule(
+      x, value, Number(Number(1.) + value * value));
+  }
+
+
+
+  /**
+   * Compute the absolute value of a dual number. The derivative at zero is
+   * taken as zero.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  abs(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x)
+  {
+    return ::dealii::Differentiation::AD::internal::chain_rule(
+      x,
+      Number(std::abs(x.value())),
+      ::dealii::Differentiation::AD::internal::sign(x.value()));
+  }
+
+
+
+  /**
+   * Return the larger of two dual numbers. Only available if the underlying
+   * number type can be compared.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  max(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x,
+      const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &y)
+  {
+    return (x.value() < y.value()) ? y : x;
+  }
+
+
+
+  /**
+   * Return the smaller of two dual numbers. Only available if the
+   * underlying number type can be compared.
+   */
+  template <typename Number, int n_derivatives>
+  inline ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+  min(const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &x,
+      const ::dealii::Differentiation::AD::DualNumber<Number, n_derivatives>
+        &y)
+  {
+    return (y.value() < x.value()) ? y : x;
+  }
+} // namespace std
+
+#endif
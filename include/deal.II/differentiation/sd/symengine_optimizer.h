@@ -35,6 +35,7 @@ DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
 #  endif
 DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 
+#  include <deal.II/base/array_view.h>
 #  include <deal.II/base/exceptions.h>
 #  include <deal.II/base/logstream.h>
 #  include <deal.II/base/utilities.h>
@@ -51,6 +52,7 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #  include <algorithm>
 #  include <map>
 #  include <memory>
+#  include <string>
 #  include <type_traits>
 #  include <utility>
 #  include <vector>
@@ -1113,6 +1115,57 @@ namespace Differentiation
       /* -------------------- Utility functions ---------------------- */
 
 
+      /**
+       * Perform value substitution for a batch of @p n_points points,
+       * evaluating the pre-registered dependent functions at each of them.
+       * The values are stored in structure-of-arrays layout, i.e., the value
+       * of the independent symbol <tt>i</tt> at the point <tt>q</tt> is
+       * stored in <tt>substitution_values[i * n_points + q]</tt>, and the
+       * value of the dependent function <tt>j</tt> at the point <tt>q</tt> is
+       * written to <tt>output_values[j * n_points + q]</tt>.
+       *
+       * @tparam ReturnType The number type that is returned as a result
+       *         of operations performed by the optimizer.
+       * @tparam Optimizer The wrapper for the SymEngine optimizer.
+       * @param optimizer The optimizer on which to perform value substitution.
+       * @param output_values The evaluated numerical outcome of the
+       * substitution at all points.
+       * @param substitution_values The values of the independent symbols at
+       * all points.
+       * @param n_points The number of points.
+       */
+      template <typename ReturnType, typename Optimizer>
+      void
+      substitute_batch(typename Optimizer::OptimizerType *optimizer,
+                       const ArrayView<ReturnType> &      output_values,
+                       const ArrayView<const ReturnType> &substitution_values,
+                       const unsigned int                 n_points)
+      {
+        Assert(optimizer, ExcNotInitialized());
+        if (n_points == 0)
+          return;
+
+        const unsigned int n_inputs  = substitution_values.size() / n_points;
+        const unsigned int n_outputs = output_values.size() / n_points;
+
+        // Gather the values of each point into contiguous storage, which is
+        // what the optimizers expect, and scatter the results back. The
+        // buffers are reused for all points.
+        std::vector<ReturnType> inputs(n_inputs);
+        std::vector<ReturnType> outputs(n_outputs);
+        for (unsigned int q = 0; q < n_points; ++q)
+          {
+            for (unsigned int i = 0; i < n_inputs; ++i)
+              inputs[i] = substitution_values[i * n_points + q];
+            OptimizerHelper<ReturnType, Optimizer>::substitute(optimizer,
+                                                               outputs,
+                                                               inputs);
+            for (unsigned int j = 0; j < n_outputs; ++j)
+              output_values[j * n_points + q] = outputs[j];
+          }
+      }
+
+
       /**
        * A convenience function that returns the numeric equivalent of
        * an input @p symbol_tensor, computed through the @p optimizer.
@@ -1777,6 +1830,36 @@ namespace Differentiation
       bool
       optimized() const;
 
+      /**
+       * Perform the optimization of all registered dependent functions, like
+       * optimize(), but keep a copy of the optimized functions in the
+       * directory @p cache_directory for later runs of the program. The file
+       * name is derived from a hash of the optimization method and flags, the
+       * independent symbols and the dependent functions, so that a later call
+       * with the same symbolic problem finds the stored optimizer and loads it
+       * instead of repeating the optimization. Since the stored optimizer
+       * contains compiled machine code, the versions of SymEngine and LLVM as
+       * well as the name and features of the host CPU are part of the hash,
+       * so that a cache directory shared between different builds or
+       * machines never provides incompatible code.
+       *
+       * Only the LLVM optimizer stores the result of the optimization when
+       * being serialized, so for all other optimization methods this
+       * function is equivalent to optimize(). The same holds if the LLVM
+       * headers that are needed to identify the host CPU are not found when
+       * compiling deal.II. If the cache file cannot be written, the optimizer
+       * is still usable, but nothing is cached.
+       *
+       * @return Whether the optimizer was loaded from the cache.
+       *
+       * @note The same caveats as for serialization apply: After loading,
+       * the dependent functions stored in this object are the deserialized
+       * ones, which might differ in representation (but not in value) from
+       * the ones registered.
+       */
+      bool
+      optimize(const std::string &cache_directory);
+
       //@}
 
       /**
@@ -1920,6 +2003,28 @@ namespace Differentiation
       SymmetricTensor<rank, dim, ReturnType>
       evaluate(const SymmetricTensor<rank, dim, Expression> &funcs) const;
 
+      /**
+       * Evaluate all the dependent functions at @p n_points points (e.g., all
+       * the quadrature points of a cell or of a batch of cells) in one call.
+       * This avoids constructing a substitution map per point as well as the
+       * repeated dispatch to the optimizer in substitute().
+       *
+       * The values are stored in structure-of-arrays layout: The value of the
+       * <tt>i</tt>th independent symbol, in the order returned by
+       * get_independent_symbols(), at the point <tt>q</tt> is given by
+       * <tt>substitution_values[i * n_points + q]</tt>. The value of the
+       * <tt>j</tt>th dependent function, in the order returned by
+       * get_dependent_functions(), at the point <tt>q</tt> is written to
+       * <tt>output_values[j * n_points + q]</tt>.
+       *
+       * The values cached by substitute() and returned by the other
+       * evaluate() functions are not affected by this function.
+       */
+      void
+      evaluate(const ArrayView<const ReturnType> &substitution_values,
+               const ArrayView<ReturnType> &      output_values,
+               const unsigned int                 n_points) const;
+
       //@}
 
     private:
@@ -457,6 +457,33 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &                                     p) const = 0;
 
+  /**
+   * Map multiple points from the real point locations to points in reference
+   * locations. The functionality is essentially the same as looping over all
+   * points and calling the Mapping::transform_real_to_unit_cell() function
+   * for each point individually, but it can be much faster for mappings that
+   * can share the data of the cell between the points. The default
+   * implementation simply calls transform_real_to_unit_cell() for each point.
+   *
+   * Contrary to transform_real_to_unit_cell(), this function does not throw
+   * an exception of type Mapping::ExcTransformationFailed if the inverse
+   * mapping fails for a point. Instead, the first coordinate of the
+   * respective entry in @p unit_points is set to
+   * <tt>std::numeric_limits<double>::infinity()</tt>, which marks the point
+   * as lying outside the reference cell when checked with
+   * GeometryInfo::is_inside_unit_cell().
+   *
+   * @param cell Iterator to the cell that will be used to define the mapping.
+   * @param real_points Locations of the points in real space.
+   * @param unit_points The reference cell locations of the points, which must
+   * have the same size as @p real_points.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const;
+
   /**
    * Transform the point @p p on the real @p cell to the corresponding point
    * on the reference cell, and then project this point to a (dim-1)-dimensional
@@ -22,6 +22,7 @@
 #include <deal.II/base/derivative_form.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/mapping.h>
@@ -30,8 +31,11 @@
 
 #include <deal.II/matrix_free/shape_info.h>
 
+#include <boost/signals2/connection.hpp>
+
 #include <array>
 #include <cmath>
+#include <memory>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -139,11 +143,33 @@ public:
    * Constructor.  @p polynomial_degree denotes the polynomial degree of the
    * polynomials that are used to map cells from the reference to the real
    * cell.
+   *
+   * If @p cache_support_points is set to <tt>true</tt>, the support points
+   * computed by compute_mapping_support_points() are stored in an internal
+   * cache indexed by the level and index of the cell. The cache is filled
+   * lazily: whenever the support points of an active cell are requested that
+   * are not yet present, they are computed together with those of the
+   * following active cells of the same level, distributing the calls into
+   * the manifolds over several threads. Subsequent calls, e.g. from
+   * FEValues::reinit() in a second assembly loop, then simply copy the
+   * stored points. The cache is attached to the triangulation of the last
+   * cell passed to the mapping and is invalidated whenever that
+   * triangulation signals a change (refinement, mesh movement, clear). As
+   * opposed to MappingQCache, this means that the support points are only
+   * ever computed for the cells that are actually visited.
+   *
+   * The cache trades memory, namely
+   * <code>(polynomial_degree+1)<sup>dim</sup></code> points per visited
+   * cell, for the typically expensive evaluation of curved manifolds. It
+   * has no effect in classes derived from MappingQGeneric that override
+   * compute_mapping_support_points().
    */
-  MappingQGeneric(const unsigned int polynomial_degree);
+  MappingQGeneric(const unsigned int polynomial_degree,
+                  const bool         cache_support_points = false);
 
   /**
-   * Copy constructor.
+   * Copy constructor. If the support point cache is enabled in @p mapping,
+   * the new object shares the cache with @p mapping.
    */
   MappingQGeneric(const MappingQGeneric<dim, spacedim> &mapping);
 
@@ -182,6 +208,22 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &p) const override;
 
+  /**
+   * Map multiple points from the real point locations to points in reference
+   * locations, see Mapping::transform_points_real_to_unit_cell().
+   *
+   * For dim==spacedim and mappings that preserve the vertex locations, this
+   * function computes the support points of the cell only once and runs the
+   * Newton iteration of transform_real_to_unit_cell() for
+   * VectorizedArray::size() points at a time with SIMD arithmetic. All other
+   * cases fall back to the implementation of the base class.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const override;
+
   /**
    * @}
    */
@@ -724,6 +766,75 @@ protected:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     std::vector<Point<spacedim>> &                              a) const;
 
+private:
+  /**
+   * Compute the support points of the given cell from the manifolds
+   * attached to the cell and its sub-objects, bypassing the cache. This is
+   * the work horse of compute_mapping_support_points().
+   */
+  std::vector<Point<spacedim>>
+  compute_support_points_from_manifolds(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell) const;
+
+  /**
+   * Return the support points of the given cell from the cache, computing
+   * the missing entries of a batch of cells starting at @p cell first if
+   * necessary.
+   */
+  std::vector<Point<spacedim>>
+  get_cached_support_points(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell) const;
+
+  /**
+   * A structure holding the support points computed so far, together with
+   * the triangulation they belong to and the connection to its signals.
+   */
+  struct SupportPointCache
+  {
+    /**
+     * Destructor. Disconnects from the signals of the triangulation.
+     */
+    ~SupportPointCache();
+
+    /**
+     * Clear the cache and connect it to the signals of @p tria. Must be
+     * called with @p mutex locked.
+     */
+    void
+    attach(const Triangulation<dim, spacedim> &tria);
+
+    /**
+     * The triangulation the cached points belong to, or <tt>nullptr</tt> if
+     * the cache is not attached to any triangulation.
+     */
+    const Triangulation<dim, spacedim> *triangulation = nullptr;
+
+    /**
+     * The support points, indexed by the level and index of the cell. An
+     * empty vector denotes a cell not yet visited.
+     */
+    std::vector<std::vector<std::vector<Point<spacedim>>>> points;
+
+    /**
+     * The connection to Triangulation::Signals::any_change, which clears the
+     * cache.
+     */
+    boost::signals2::connection clear_signal;
+
+    /**
+     * A mutex guarding all of the fields above, since the same mapping
+     * object is typically used from several threads at once.
+     */
+    Threads::Mutex mutex;
+  };
+
+  /**
+   * The cache of support points, or an empty pointer if caching has not been
+   * requested in the constructor. Held through a shared pointer so that
+   * copies and clones of this object share the computed points.
+   */
+  std::shared_ptr<SupportPointCache> support_point_cache;
+
   // Make MappingQ a friend since it needs to call the fill_fe_values()
   // functions on its MappingQGeneric(1) sub-object.
   template <int, int>
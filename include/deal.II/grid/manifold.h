@@ -442,6 +442,43 @@ public:
                  const Table<2, double> &                weights,
                  ArrayView<Point<spacedim>>              new_points) const;
 
+  /**
+   * Compute a batch of new points, each of which interpolates between its own
+   * set of surrounding points. The arrays @p surrounding_points and
+   * @p weights are of equal length and contain the surrounding points and
+   * weights of each new point one after the other, i.e., the $i$th entry of
+   * @p new_points is computed from the entries $i n, \ldots, (i+1) n - 1$ of
+   * these two arrays, where $n$ is <code>surrounding_points.size() /
+   * new_points.size()</code>.
+   *
+   * This function is called by the Triangulation class during refinement for
+   * the manifold classes of the library that are known to be thread-safe,
+   * namely FlatManifold, SphericalManifold, PolarManifold,
+   * CylindricalManifold, and EllipticalManifold (but not classes derived from
+   * them), and for TransfiniteInterpolationManifold if all other manifolds of
+   * the triangulation are among these classes. For these, the triangulation
+   * collects the surrounding points and weights given by
+   * Manifolds::get_default_points_and_weights() for all the lines, quads, and
+   * hexes that receive a new vertex and are associated with the same
+   * manifold, and computes the new vertices in parallel in batches of
+   * moderate size. For all other manifolds, the new vertices are computed
+   * one after the other by get_new_point_on_line(), get_new_point_on_quad(),
+   * get_new_point_on_hex(), or get_new_point(), as before.
+   *
+   * In its default implementation, this function simply calls get_new_point()
+   * for each new point. Derived classes can override it to share work between
+   * the points of a batch, or to process several points at once with the
+   * vectorization capabilities of the processor. The result for a given set
+   * of surrounding points and weights must not depend on the other points in
+   * the batch, as otherwise different processes of a parallel triangulation
+   * might compute different locations for the same vertex.
+   */
+  virtual void
+  get_new_points_batched(
+    const ArrayView<const Point<spacedim>> &surrounding_points,
+    const ArrayView<const double> &         weights,
+    ArrayView<Point<spacedim>>              new_points) const;
+
   /**
    * Given a point which lies close to the given manifold, it modifies it and
    * projects it to manifold itself.
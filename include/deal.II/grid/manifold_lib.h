@@ -306,6 +306,25 @@ public:
   get_new_point(const ArrayView<const Point<spacedim>> &vertices,
                 const ArrayView<const double> &         weights) const override;
 
+  /**
+   * Compute a batch of new points, each from its own set of surrounding
+   * points, see Manifold::get_new_points_batched() for the layout of the
+   * arguments.
+   *
+   * For batches of new points between two surrounding points each, as
+   * created for the midpoints of lines during refinement, the interpolation
+   * along the great circle is evaluated for VectorizedArray::size() points at
+   * a time with SIMD arithmetic. Pairs of points that need special treatment,
+   * such as points that coincide, lie on opposite sides of the center, or
+   * coincide with the center, are passed to get_intermediate_point(). All other batches are computed point
+   * by point with get_new_point().
+   */
+  virtual void
+  get_new_points_batched(
+    const ArrayView<const Point<spacedim>> &surrounding_points,
+    const ArrayView<const double> &         weights,
+    ArrayView<Point<spacedim>>              new_points) const override;
+
   /**
    * The center of the spherical coordinate system.
    */
@@ -448,6 +467,22 @@ public:
   get_new_point(const ArrayView<const Point<spacedim>> &surrounding_points,
                 const ArrayView<const double> &         weights) const override;
 
+  /**
+   * Compute a batch of new points, each from its own set of surrounding
+   * points, see Manifold::get_new_points_batched() for the layout of the
+   * arguments.
+   *
+   * The pull-back of the surrounding points to cylindrical coordinates, the
+   * interpolation in these coordinates, and the push-forward of the result
+   * are evaluated for VectorizedArray::size() new points at a time with SIMD
+   * arithmetic. New points on the axis are treated as in get_new_point().
+   */
+  virtual void
+  get_new_points_batched(
+    const ArrayView<const Point<spacedim>> &surrounding_points,
+    const ArrayView<const double> &         weights,
+    ArrayView<Point<spacedim>>              new_points) const override;
+
 protected:
   /**
    * A vector orthogonal to the normal direction.
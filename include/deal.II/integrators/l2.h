@@ -25,6 +25,8 @@
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping.h>
 
+#include <deal.II/integrators/tensor_product.h>
+
 #include <deal.II/lac/full_matrix.h>
 
 #include <deal.II/meshworker/dof_info.h>
@@ -93,6 +95,28 @@ namespace LocalIntegrators
         }
     }
 
+    /**
+     * The mass matrix on a cell as above, computed by sum factorization with
+     * the one-dimensional data in @p data.
+     *
+     * @param M The mass matrix obtained as result.
+     * @param fe The FEValues object describing the local trial function
+     * space. It must have been initialized with the finite element and
+     * quadrature formula @p data was created with. #update_JxW_values must
+     * be set.
+     * @param data The one-dimensional shape data of the element.
+     * @param factor A constant that multiplies the mass matrix.
+     */
+    template <int dim>
+    inline void
+    mass_matrix(FullMatrix<double> &          M,
+                const FEValuesBase<dim> &     fe,
+                const TensorProductData<dim> &data,
+                const double                  factor = 1.)
+    {
+      data.cell_matrix(M, fe, factor, 0.);
+    }
+
     /**
      * The weighted mass matrix for scalar or vector values finite elements.
      * \f[ \int_Z \omega(x) uv\,dx \quad \text{or} \quad \int_Z \omega(x)
@@ -25,6 +25,8 @@
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping.h>
 
+#include <deal.II/integrators/tensor_product.h>
+
 #include <deal.II/lac/full_matrix.h>
 
 #include <deal.II/meshworker/dof_info.h>
@@ -87,6 +89,28 @@ namespace LocalIntegrators
         }
     }
 
+    /**
+     * Laplacian in weak form as above, computed by sum factorization with
+     * the one-dimensional data in @p data. This is considerably faster than
+     * the function above for elements of high polynomial degree, in
+     * particular if the mapping is a MappingCartesian.
+     *
+     * The FEValues object @p fe must have been initialized with the finite
+     * element and quadrature formula @p data was created with, and provide
+     * #update_JxW_values and #update_inverse_jacobians. The shape function
+     * values and gradients in @p fe are not used. See TensorProductData for
+     * the supported elements.
+     */
+    template <int dim>
+    inline void
+    cell_matrix(FullMatrix<double> &          M,
+                const FEValuesBase<dim> &     fe,
+                const TensorProductData<dim> &data,
+                const double                  factor = 1.)
+    {
+      data.cell_matrix(M, fe, 0., factor);
+    }
+
     /**
      * Laplacian residual operator in weak form
      *
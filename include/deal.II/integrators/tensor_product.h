@@ -0,0 +1,635 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_integrators_tensor_product_h
+#define dealii_integrators_tensor_product_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_cartesian.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <deal.II/matrix_free/shape_info.h>
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace LocalIntegrators
+{
+  /**
+   * Precomputed data for the assembly of cell matrices of tensor product
+   * finite elements by sum factorization.
+   *
+   * For elements like FE_Q and FE_DGQ, and tensor product quadrature
+   * formulas like QGauss, the shape functions and their derivatives at the
+   * quadrature points are products of one-dimensional quantities. The local
+   * integrators taking an object of this class as argument, like
+   * Laplace::cell_matrix() and L2::mass_matrix(), exploit this structure:
+   * <ul>
+   * <li> If the FEValues object uses a MappingCartesian, the cell matrix is
+   * assembled from Kronecker products of one-dimensional mass and stiffness
+   * matrices at the cost of $\mathcal O(k^{2d})$ operations, i.e., a
+   * constant amount of work per matrix entry.
+   * <li> For all other mappings, the columns of the cell matrix are computed
+   * by applying the operator to the unit vectors with the sum factorization
+   * kernels of the matrix-free framework, processing
+   * VectorizedArray<double>::size() columns at once, at the cost of
+   * $\mathcal O(k^{2d+1})$ operations instead of the $\mathcal O(k^{3d})$
+   * operations of the loops over quadrature points and pairs of shape
+   * functions.
+   * </ul>
+   * Here, $k$ is the polynomial degree plus one. The data depends only on
+   * the finite element and the quadrature formula, so a single object should
+   * be created before the loop over all cells.
+   *
+   * Vector-valued elements are supported if they consist of several copies
+   * of the same tensor product element, like FESystem(FE_Q<dim>(k), dim), in
+   * which case the operator is applied to each component separately.
+   *
+   * @ingroup Integrators
+   */
+  template <int dim>
+  class TensorProductData
+  {
+  public:
+    /**
+     * Constructor. @p fe is the finite element and @p quadrature the
+     * quadrature formula of the FEValues objects this data is later used
+     * with. The quadrature formula must be the tensor product of the same
+     * one-dimensional formula in all coordinate directions.
+     */
+    TensorProductData(const FiniteElement<dim> &fe,
+                      const Quadrature<dim> &   quadrature);
+
+    /**
+     * Add to @p M the matrix
+     * @f[
+     *   \int_Z \left(\mu\, u v + \nu \nabla u \cdot \nabla v\right) dx
+     * @f]
+     * with $\mu$ given by @p mass_factor and $\nu$ given by @p
+     * laplace_factor. The FEValues object @p fe must have been initialized
+     * with the finite element and quadrature formula passed to the
+     * constructor and must provide #update_JxW_values and, if @p
+     * laplace_factor is non-zero, #update_inverse_jacobians.
+     */
+    void
+    cell_matrix(FullMatrix<double> &     M,
+                const FEValuesBase<dim> &fe,
+                const double             mass_factor,
+                const double             laplace_factor) const;
+
+  private:
+    /**
+     * Implementation of cell_matrix() for MappingCartesian, based on
+     * Kronecker products of the one-dimensional matrices.
+     */
+    void
+    cell_matrix_cartesian(FullMatrix<double> &     M,
+                          const FEValuesBase<dim> &fe,
+                          const double             mass_factor,
+                          const double             laplace_factor) const;
+
+    /**
+     * Implementation of cell_matrix() for general mappings, computing the
+     * columns of the matrix by sum factorization.
+     */
+    void
+    cell_matrix_general(FullMatrix<double> &     M,
+                        const FEValuesBase<dim> &fe,
+                        const double             mass_factor,
+                        const double             laplace_factor) const;
+
+    /**
+     * Add @p value to the entry of @p M in row @p i and column @p j, given
+     * in lexicographic numbering of the scalar element, for all components.
+     */
+    void
+    add_to_components(FullMatrix<double> &M,
+                      const unsigned int  i,
+                      const unsigned int  j,
+                      const double        value) const;
+
+    /**
+     * The one-dimensional shape data and the lexicographic numbering of the
+     * element.
+     */
+    internal::MatrixFreeFunctions::ShapeInfo<double> shape_info;
+
+    /**
+     * The one-dimensional quadrature formula.
+     */
+    Quadrature<1> quadrature_1d;
+
+    /**
+     * The number of components of the element.
+     */
+    unsigned int n_components;
+
+    /**
+     * The one-dimensional mass matrix in lexicographic numbering.
+     */
+    FullMatrix<double> mass_matrix_1d;
+
+    /**
+     * The one-dimensional Laplace matrix in lexicographic numbering.
+     */
+    FullMatrix<double> laplace_matrix_1d;
+  };
+
+
+
+#ifndef DOXYGEN
+
+  namespace TensorProductImplementation
+  {
+    /**
+     * Evaluate the values and reference gradients of the function with
+     * coefficients @p dofs in lexicographic numbering at the quadrature
+     * points. The gradient in direction @p d is stored starting at
+     * <tt>gradients + d * n_q_points</tt>.
+     */
+    template <typename Eval, typename Number>
+    inline void
+    evaluate(const Eval &       eval,
+             const Number *     dofs,
+             Number *           values,
+             Number *           gradients,
+             const unsigned int n_q_points,
+             Number *           tmp1,
+             Number *           tmp2,
+             const std::integral_constant<int, 1> /*dim*/)
+    {
+      (void)n_q_points;
+      (void)tmp1;
+      (void)tmp2;
+      if (values != nullptr)
+        eval.template values<0, true, false>(dofs, values);
+      if (gradients != nullptr)
+        eval.template gradients<0, true, false>(dofs, gradients);
+    }
+
+    template <typename Eval, typename Number>
+    inline void
+    evaluate(const Eval &       eval,
+             const Number *     dofs,
+             Number *           values,
+             Number *           gradients,
+             const unsigned int n_q_points,
+             Number *           tmp1,
+             Number *           tmp2,
+             const std::integral_constant<int, 2> /*dim*/)
+    {
+      (void)tmp2;
+      eval.template values<0, true, false>(dofs, tmp1);
+      if (values != nullptr)
+        eval.template values<1, true, false>(tmp1, values);
+      if (gradients != nullptr)
+        {
+          eval.template gradients<1, true, false>(tmp1, gradients + n_q_points);
+          eval.template gradients<0, true, false>(dofs, tmp1);
+          eval.template values<1, true, false>(tmp1, gradients);
+        }
+    }
+
+    template <typename Eval, typename Number>
+    inline void
+    evaluate(const Eval &       eval,
+             const Number *     dofs,
+             Number *           values,
+             Number *           gradients,
+             const unsigned int n_q_points,
+             Number *           tmp1,
+             Number *           tmp2,
+             const std::integral_constant<int, 3> /*dim*/)
+    {
+      eval.template values<0, true, false>(dofs, tmp1);
+      eval.template values<1, true, false>(tmp1, tmp2);
+      if (values != nullptr)
+        eval.template values<2, true, false>(tmp2, values);
+      if (gradients != nullptr)
+        {
+          eval.template gradients<2, true, false>(tmp2,
+                                                  gradients + 2 * n_q_points);
+          eval.template gradients<1, true, false>(tmp1, tmp2);
+          eval.template values<2, true, false>(tmp2, gradients + n_q_points);
+          eval.template gradients<0, true, false>(dofs, tmp1);
+          eval.template values<1, true, false>(tmp1, tmp2);
+          eval.template values<2, true, false>(tmp2, gradients);
+        }
+    }
+
+
+
+    /**
+     * Multiply the values and reference gradients at the quadrature points
+     * by the values and reference gradients of all test functions and sum
+     * over the quadrature points, i.e., the transpose of evaluate(). Either
+     * of @p values and @p gradients may be the null pointer. The contents of
+     * @p values and @p gradients are overwritten.
+     */
+    template <typename Eval, typename Number>
+    inline void
+    integrate(const Eval &       eval,
+              Number *           values,
+              Number *           gradients,
+              Number *           dofs,
+              const unsigned int n_q_points,
+              Number *           tmp1,
+              Number *           tmp2,
+              const std::integral_constant<int, 1> /*dim*/)
+    {
+      (void)n_q_points;
+      (void)tmp1;
+      (void)tmp2;
+      if (values != nullptr)
+        eval.template values<0, false, false>(values, dofs);
+      if (gradients != nullptr)
+        {
+          if (values != nullptr)
+            eval.template gradients<0, false, true>(gradients, dofs);
+          else
+            eval.template gradients<0, false, false>(gradients, dofs);
+        }
+    }
+
+    template <typename Eval, typename Number>
+    inline void
+    integrate(const Eval &       eval,
+              Number *           values,
+              Number *           gradients,
+              Number *           dofs,
+              const unsigned int n_q_points,
+              Number *           tmp1,
+              Number *           tmp2,
+              const std::integral_constant<int, 2> /*dim*/)
+    {
+      (void)tmp2;
+      if (values != nullptr)
+        {
+          eval.template values<1, false, false>(values, tmp1);
+          if (gradients != nullptr)
+            eval.template gradients<1, false, true>(gradients + n_q_points,
+                                                    tmp1);
+        }
+      else
+        eval.template gradients<1, false, false>(gradients + n_q_points, tmp1);
+      eval.template values<0, false, false>(tmp1, dofs);
+      if (gradients != nullptr)
+        {
+          eval.template values<1, false, false>(gradients, tmp1);
+          eval.template gradients<0, false, true>(tmp1, dofs);
+        }
+    }
+
+    template <typename Eval, typename Number>
+    inline void
+    integrate(const Eval &       eval,
+              Number *           values,
+              Number *           gradients,
+              Number *           dofs,
+              const unsigned int n_q_points,
+              Number *           tmp1,
+              Number *           tmp2,
+              const std::integral_constant<int, 3> /*dim*/)
+    {
+      // contributions with values in the x direction
+      if (values != nullptr)
+        {
+          eval.template values<2, false, false>(values, tmp2);
+          if (gradients != nullptr)
+            eval.template gradients<2, false, true>(gradients + 2 * n_q_points,
+                                                    tmp2);
+        }
+      else
+        eval.template gradients<2, false, false>(gradients + 2 * n_q_points,
+                                                 tmp2);
+      eval.template values<1, false, false>(tmp2, tmp1);
+      if (gradients != nullptr)
+        {
+          eval.template values<2, false, false>(gradients + n_q_points, tmp2);
+          eval.template gradients<1, false, true>(tmp2, tmp1);
+        }
+      eval.template values<0, false, false>(tmp1, dofs);
+
+      // contribution with the gradient in the x direction
+      if (gradients != nullptr)
+        {
+          eval.template values<2, false, false>(gradients, tmp2);
+          eval.template values<1, false, false>(tmp2, tmp1);
+          eval.template gradients<0, false, true>(tmp1, dofs);
+        }
+    }
+  } // namespace TensorProductImplementation
+
+
+
+  template <int dim>
+  inline TensorProductData<dim>::TensorProductData(
+    const FiniteElement<dim> &fe,
+    const Quadrature<dim> &   quadrature)
+    : n_components(fe.n_components())
+  {
+    Assert(quadrature.is_tensor_product(),
+           ExcMessage("The quadrature formula must be a tensor product."));
+    for (unsigned int d = 1; d < dim; ++d)
+      Assert(quadrature.get_tensor_basis()[d] ==
+               quadrature.get_tensor_basis()[0],
+             ExcMessage("The quadrature formula must use the same "
+                        "one-dimensional formula in all directions."));
+    Assert(fe.n_base_elements() == 1,
+           ExcMessage("Only elements with a single base element are "
+                      "supported."));
+    quadrature_1d = quadrature.get_tensor_basis()[0];
+
+    shape_info.reinit(quadrature_1d, fe);
+    Assert(shape_info.element_type <=
+             internal::MatrixFreeFunctions::tensor_general,
+           ExcMessage("The finite element must be of tensor product type, "
+                      "like FE_Q or FE_DGQ."));
+
+    const auto &       univariate = shape_info.get_shape_data();
+    const unsigned int n_dofs_1d  = univariate.fe_degree + 1;
+    const unsigned int n_q_1d     = univariate.n_q_points_1d;
+    AssertDimension(Utilities::fixed_power<dim>(n_dofs_1d) * n_components,
+                    fe.dofs_per_cell);
+
+    mass_matrix_1d.reinit(n_dofs_1d, n_dofs_1d);
+    laplace_matrix_1d.reinit(n_dofs_1d, n_dofs_1d);
+    for (unsigned int i = 0; i < n_dofs_1d; ++i)
+      for (unsigned int j = 0; j < n_dofs_1d; ++j)
+        for (unsigned int q = 0; q < n_q_1d; ++q)
+          {
+            mass_matrix_1d(i, j) += quadrature_1d.weight(q) *
+                                    univariate.shape_values[i * n_q_1d + q] *
+                                    univariate.shape_values[j * n_q_1d + q];
+            laplace_matrix_1d(i, j) +=
+              quadrature_1d.weight(q) *
+              univariate.shape_gradients[i * n_q_1d + q] *
+              univariate.shape_gradients[j * n_q_1d + q];
+          }
+  }
+
+
+
+  template <int dim>
+  inline void
+  TensorProductData<dim>::add_to_components(FullMatrix<double> &M,
+                                            const unsigned int  i,
+                                            const unsigned int  j,
+                                            const double        value) const
+  {
+    const unsigned int n_scalar_dofs =
+      shape_info.lexicographic_numbering.size() / n_components;
+    for (unsigned int c = 0; c < n_components; ++c)
+      M(shape_info.lexicographic_numbering[c * n_scalar_dofs + i],
+        shape_info.lexicographic_numbering[c * n_scalar_dofs + j]) += value;
+  }
+
+
+
+  template <int dim>
+  inline void
+  TensorProductData<dim>::cell_matrix(FullMatrix<double> &     M,
+                                      const FEValuesBase<dim> &fe,
+                                      const double             mass_factor,
+                                      const double laplace_factor) const
+  {
+    AssertDimension(M.m(), fe.dofs_per_cell);
+    AssertDimension(M.n(), fe.dofs_per_cell);
+    AssertDimension(fe.dofs_per_cell,
+                    shape_info.lexicographic_numbering.size());
+    AssertDimension(fe.n_quadrature_points,
+                    Utilities::fixed_power<dim>(quadrature_1d.size()));
+    Assert(fe.get_update_flags() & update_JxW_values,
+           ExcMessage("The FEValues object must provide JxW values."));
+    Assert(laplace_factor == 0. ||
+             (fe.get_update_flags() & update_inverse_jacobians),
+           ExcMessage("The FEValues object must provide the inverse "
+                      "Jacobians of the mapping."));
+
+    if (dynamic_cast<const MappingCartesian<dim> *>(&fe.get_mapping()) !=
+        nullptr)
+      cell_matrix_cartesian(M, fe, mass_factor, laplace_factor);
+    else
+      cell_matrix_general(M, fe, mass_factor, laplace_factor);
+  }
+
+
+
+  template <int dim>
+  inline void
+  TensorProductData<dim>::cell_matrix_cartesian(
+    FullMatrix<double> &     M,
+    const FEValuesBase<dim> &fe,
+    const double             mass_factor,
+    const double             laplace_factor) const
+  {
+    const unsigned int n_dofs_1d     = mass_matrix_1d.m();
+    const unsigned int n_scalar_dofs = Utilities::fixed_power<dim>(n_dofs_1d);
+
+    // on an axis-parallel box, the Jacobian determinant is constant and the
+    // inverse Jacobian is diagonal
+    const double determinant =
+      fe.JxW(0) / Utilities::fixed_power<dim>(quadrature_1d.weight(0));
+    std::array<double, dim> laplace_scaling;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        laplace_scaling[d] = 0.;
+        if (laplace_factor != 0.)
+          {
+            const double inverse_h = fe.inverse_jacobian(0)[d][d];
+            laplace_scaling[d] =
+              laplace_factor * determinant * inverse_h * inverse_h;
+          }
+      }
+    const double mass_scaling = mass_factor * determinant;
+
+    std::array<unsigned int, dim> ii, jj;
+    for (unsigned int i = 0; i < n_scalar_dofs; ++i)
+      {
+        for (unsigned int d = 0, rest = i; d < dim; ++d, rest /= n_dofs_1d)
+          ii[d] = rest % n_dofs_1d;
+        for (unsigned int j = 0; j < n_scalar_dofs; ++j)
+          {
+            for (unsigned int d = 0, rest = j; d < dim; ++d, rest /= n_dofs_1d)
+              jj[d] = rest % n_dofs_1d;
+
+            double mass = 1.;
+            for (unsigned int d = 0; d < dim; ++d)
+              mass *= mass_matrix_1d(ii[d], jj[d]);
+            double value = mass_scaling * mass;
+
+            if (laplace_factor != 0.)
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  double product = laplace_scaling[d];
+                  for (unsigned int e = 0; e < dim; ++e)
+                    product *= (e == d ? laplace_matrix_1d(ii[e], jj[e]) :
+                                         mass_matrix_1d(ii[e], jj[e]));
+                  value += product;
+                }
+
+            add_to_components(M, i, j, value);
+          }
+      }
+  }
+
+
+
+  template <int dim>
+  inline void
+  TensorProductData<dim>::cell_matrix_general(FullMatrix<double> &     M,
+                                              const FEValuesBase<dim> &fe,
+                                              const double mass_factor,
+                                              const double laplace_factor) const
+  {
+    using Number                      = VectorizedArray<double>;
+    constexpr unsigned int n_lanes    = Number::size();
+    const auto &           univariate = shape_info.get_shape_data();
+    const unsigned int     n_dofs_1d  = univariate.fe_degree + 1;
+    const unsigned int     n_q_1d     = univariate.n_q_points_1d;
+    const unsigned int n_scalar_dofs  = Utilities::fixed_power<dim>(n_dofs_1d);
+    const unsigned int n_q_points     = fe.n_quadrature_points;
+    const bool         add_mass       = (mass_factor != 0.);
+    const bool         add_laplace    = (laplace_factor != 0.);
+
+    if (!add_mass && !add_laplace)
+      return;
+
+    internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                     dim,
+                                     0,
+                                     0,
+                                     Number,
+                                     double>
+      eval(univariate.shape_values,
+           univariate.shape_gradients,
+           AlignedVector<double>(),
+           n_dofs_1d,
+           n_q_1d);
+
+    // the coefficients at the quadrature points: the Laplace coefficient is
+    // the metric tensor J^{-1} J^{-T} scaled by the quadrature weight
+    std::vector<double>                                   mass_coefficient;
+    std::vector<std::array<std::array<double, dim>, dim>> laplace_coefficient;
+    if (add_mass)
+      {
+        mass_coefficient.resize(n_q_points);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          mass_coefficient[q] = mass_factor * fe.JxW(q);
+      }
+    if (add_laplace)
+      {
+        laplace_coefficient.resize(n_q_points);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            const DerivativeForm<1, dim, dim> &inv_jac = fe.inverse_jacobian(q);
+            const double factor = laplace_factor * fe.JxW(q);
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int e = 0; e < dim; ++e)
+                {
+                  double sum = 0.;
+                  for (unsigned int k = 0; k < dim; ++k)
+                    sum += inv_jac[d][k] * inv_jac[e][k];
+                  laplace_coefficient[q][d][e] = factor * sum;
+                }
+          }
+      }
+
+    const unsigned int buffer_size =
+      Utilities::fixed_power<dim>(std::max(n_dofs_1d, n_q_1d));
+    AlignedVector<Number> dofs(n_scalar_dofs);
+    AlignedVector<Number> values(add_mass ? n_q_points : 0);
+    AlignedVector<Number> gradients(add_laplace ? dim * n_q_points : 0);
+    AlignedVector<Number> tmp1(buffer_size), tmp2(buffer_size);
+    Number *const         values_ptr = add_mass ? values.begin() : nullptr;
+    Number *const gradients_ptr = add_laplace ? gradients.begin() : nullptr;
+
+    // compute the columns of the matrix in batches of the vectorization
+    // width by applying the operator to the unit vectors
+    for (unsigned int j0 = 0; j0 < n_scalar_dofs; j0 += n_lanes)
+      {
+        const unsigned int n_filled = std::min(n_lanes, n_scalar_dofs - j0);
+        for (unsigned int i = 0; i < n_scalar_dofs; ++i)
+          dofs[i] = 0.;
+        for (unsigned int v = 0; v < n_filled; ++v)
+          dofs[j0 + v][v] = 1.;
+
+        TensorProductImplementation::evaluate(
+          eval,
+          dofs.begin(),
+          values_ptr,
+          gradients_ptr,
+          n_q_points,
+          tmp1.begin(),
+          tmp2.begin(),
+          std::integral_constant<int, dim>());
+
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            if (add_mass)
+              values[q] *= mass_coefficient[q];
+            if (add_laplace)
+              {
+                Number grad[dim];
+                for (unsigned int d = 0; d < dim; ++d)
+                  grad[d] = gradients[d * n_q_points + q];
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    Number sum = laplace_coefficient[q][d][0] * grad[0];
+                    for (unsigned int e = 1; e < dim; ++e)
+                      sum += laplace_coefficient[q][d][e] * grad[e];
+                    gradients[d * n_q_points + q] = sum;
+                  }
+              }
+          }
+
+        TensorProductImplementation::integrate(
+          eval,
+          values_ptr,
+          gradients_ptr,
+          dofs.begin(),
+          n_q_points,
+          tmp1.begin(),
+          tmp2.begin(),
+          std::integral_constant<int, dim>());
+
+        for (unsigned int v = 0; v < n_filled; ++v)
+          for (unsigned int i = 0; i < n_scalar_dofs; ++i)
+            add_to_components(M, i, j0 + v, dofs[i][v]);
+      }
+  }
+
+#endif
+
+} // namespace LocalIntegrators
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,801 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_batched_full_matrix_h
+#define dealii_batched_full_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_support.h>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A container for many small dense matrices of equal size, with the
+ * operations of FullMatrix and LAPACKFullMatrix that are needed for local
+ * computations: matrix-matrix and matrix-vector products, LU and Cholesky
+ * factorizations, the solution of linear systems, and the inverse.
+ *
+ * For matrices of size below about 100, the operations of FullMatrix run
+ * at a small fraction of the arithmetic peak, since the loops are short and
+ * do not vectorize, and the overhead of calling LAPACK dominates the cost.
+ * This class instead stores VectorizedArray<Number>::size() matrices
+ * interleaved in the lanes of VectorizedArray<Number>, and performs the
+ * operations on all lanes at once. Such a group of matrices is called a
+ * batch. Entry $(i,j)$ of matrix number $k$ is lane
+ * <tt>k % VectorizedArray<Number>::size()</tt> of
+ * <tt>operator()(k / VectorizedArray<Number>::size(), i, j)</tt>.
+ *
+ * Vectors used with vmult() and solve() are stored in the same layout: an
+ * AlignedVector of VectorizedArray<Number> of size n_batches() times the
+ * number of rows (or columns), where entry <tt>b * m() + i</tt> holds the
+ * $i$th component of the vectors associated with the matrices in batch $b$.
+ *
+ * Like in LAPACKFullMatrix, the factorizations overwrite the matrix and the
+ * state of the object changes accordingly, see LAPACKSupport::State. The LU
+ * factorization uses partial pivoting, with the pivot chosen independently
+ * for each matrix. If the number of matrices is not a multiple of the
+ * vectorization width, the unused lanes of the last batch of square
+ * matrices are set to the identity, such that all operations are well
+ * defined for them.
+ *
+ * A typical use is the inversion of the diagonal blocks of a block
+ * preconditioner:
+ * @code
+ * BatchedFullMatrix<double> blocks(n_blocks, block_size, block_size);
+ * for (unsigned int k = 0; k < n_blocks; ++k)
+ *   blocks.set_matrix(k, diagonal_block[k]);
+ * blocks.invert();
+ * for (unsigned int k = 0; k < n_blocks; ++k)
+ *   blocks.get_matrix(k, inverse_diagonal_block[k]);
+ * @endcode
+ *
+ * @ingroup Matrix1
+ */
+template <typename Number>
+class BatchedFullMatrix : public Subscriptor
+{
+public:
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = Number;
+
+  /**
+   * The vectorized type that holds one entry of all matrices in a batch.
+   */
+  using VectorizedArrayType = VectorizedArray<Number>;
+
+  /**
+   * Default constructor. Creates an empty object.
+   */
+  BatchedFullMatrix();
+
+  /**
+   * Constructor. Create @p n_matrices matrices of size @p m times @p n, see
+   * reinit().
+   */
+  BatchedFullMatrix(const unsigned int n_matrices,
+                    const unsigned int m,
+                    const unsigned int n);
+
+  /**
+   * Set the size to @p n_matrices matrices of size @p m times @p n. All
+   * entries are set to zero, except for the diagonal of the unused lanes of
+   * the last batch, which is set to one for square matrices.
+   */
+  void
+  reinit(const unsigned int n_matrices,
+         const unsigned int m,
+         const unsigned int n);
+
+  /**
+   * Return the number of matrices stored.
+   */
+  unsigned int
+  n_matrices() const;
+
+  /**
+   * Return the number of batches, i.e., the number of matrices divided by
+   * the vectorization width and rounded up.
+   */
+  unsigned int
+  n_batches() const;
+
+  /**
+   * Return the number of rows of each matrix.
+   */
+  unsigned int
+  m() const;
+
+  /**
+   * Return the number of columns of each matrix.
+   */
+  unsigned int
+  n() const;
+
+  /**
+   * Return the entry $(i,j)$ of all matrices in batch @p batch.
+   */
+  VectorizedArrayType &
+  operator()(const unsigned int batch,
+             const unsigned int i,
+             const unsigned int j);
+
+  /**
+   * Return the entry $(i,j)$ of all matrices in batch @p batch.
+   */
+  const VectorizedArrayType &
+  operator()(const unsigned int batch,
+             const unsigned int i,
+             const unsigned int j) const;
+
+  /**
+   * Copy the entries of @p matrix into the matrix with index @p index and
+   * reset the state of the object to LAPACKSupport::matrix.
+   */
+  void
+  set_matrix(const unsigned int index, const FullMatrix<Number> &matrix);
+
+  /**
+   * Copy the matrix with index @p index into @p matrix, which is resized if
+   * necessary. Depending on the state of the object, this is the original
+   * matrix, its inverse, or the factors of its decomposition.
+   */
+  void
+  get_matrix(const unsigned int index, FullMatrix<Number> &matrix) const;
+
+  /**
+   * Matrix-matrix multiplication $C = A B$ for all matrices, where $A$ is
+   * this object, or $C \mathrel{+}= A B$ if @p adding is true. @p C is
+   * resized if @p adding is false.
+   */
+  void
+  mmult(BatchedFullMatrix<Number> &      C,
+        const BatchedFullMatrix<Number> &B,
+        const bool                       adding = false) const;
+
+  /**
+   * Matrix-matrix multiplication $C = A^T B$ for all matrices, where $A$ is
+   * this object, or $C \mathrel{+}= A^T B$ if @p adding is true. @p C is
+   * resized if @p adding is false.
+   */
+  void
+  Tmmult(BatchedFullMatrix<Number> &      C,
+         const BatchedFullMatrix<Number> &B,
+         const bool                       adding = false) const;
+
+  /**
+   * Matrix-vector multiplication $d = A s$ for all matrices, or $d
+   * \mathrel{+}= A s$ if @p adding is true. See the general documentation
+   * of this class for the layout of the vectors.
+   */
+  void
+  vmult(AlignedVector<VectorizedArrayType> &      dst,
+        const AlignedVector<VectorizedArrayType> &src,
+        const bool                                adding = false) const;
+
+  /**
+   * Compute the LU factorization $PA = LU$ of all matrices with partial
+   * pivoting. The factors overwrite the matrix.
+   */
+  void
+  compute_lu_factorization();
+
+  /**
+   * Compute the Cholesky factorization $A = LL^T$ of all matrices, which
+   * must be symmetric and positive definite. Only the lower triangle of the
+   * matrices is used and the factor $L$ overwrites it.
+   */
+  void
+  compute_cholesky_factorization();
+
+  /**
+   * Solve the linear systems with all matrices and the right hand sides in
+   * @p rhs, which are overwritten by the solution. See the general
+   * documentation of this class for the layout of the vector.
+   *
+   * If the object holds an LU or Cholesky factorization, the factors are
+   * used. If it holds the inverse, a matrix-vector product with the inverse
+   * is performed.
+   */
+  void
+  solve(AlignedVector<VectorizedArrayType> &rhs) const;
+
+  /**
+   * Replace all matrices by their inverse. If the object holds the matrices
+   * themselves, an LU factorization is computed first. If it already holds
+   * an LU or Cholesky factorization, that factorization is used.
+   */
+  void
+  invert();
+
+  /**
+   * Return the state of the object.
+   */
+  LAPACKSupport::State
+  get_state() const;
+
+  /**
+   * Return the memory consumption of this object in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Solve the systems with the factorized matrices of batch @p batch for
+   * the right hand sides in @p x.
+   */
+  void
+  solve_batch(const unsigned int batch, VectorizedArrayType *x) const;
+
+  /**
+   * The number of matrices.
+   */
+  unsigned int n_mat;
+
+  /**
+   * The number of rows of each matrix.
+   */
+  unsigned int n_rows;
+
+  /**
+   * The number of columns of each matrix.
+   */
+  unsigned int n_cols;
+
+  /**
+   * The entries of the matrices, with the matrices of a batch stored in
+   * the lanes of a vectorized array and the entries of each batch in
+   * row-major order.
+   */
+  AlignedVector<VectorizedArrayType> values;
+
+  /**
+   * The row interchanges of the LU factorization, with the pivot row of
+   * step $k$ in matrix number $l$ of batch $b$ stored at index
+   * <tt>(b * m() + k) * VectorizedArrayType::size() + l</tt>.
+   */
+  std::vector<unsigned int> pivots;
+
+  /**
+   * The state of the object.
+   */
+  LAPACKSupport::State state;
+};
+
+
+
+#ifndef DOXYGEN
+
+template <typename Number>
+inline BatchedFullMatrix<Number>::BatchedFullMatrix()
+  : n_mat(0)
+  , n_rows(0)
+  , n_cols(0)
+  , state(LAPACKSupport::matrix)
+{}
+
+
+
+template <typename Number>
+inline BatchedFullMatrix<Number>::BatchedFullMatrix(
+  const unsigned int n_matrices,
+  const unsigned int m,
+  const unsigned int n)
+  : BatchedFullMatrix()
+{
+  reinit(n_matrices, m, n);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::reinit(const unsigned int n_matrices,
+                                  const unsigned int m,
+                                  const unsigned int n)
+{
+  constexpr unsigned int width = VectorizedArrayType::size();
+
+  n_mat  = n_matrices;
+  n_rows = m;
+  n_cols = n;
+  state  = LAPACKSupport::matrix;
+  pivots.clear();
+
+  values.resize_fast(n_batches() * m * n);
+  values.fill(VectorizedArrayType());
+
+  if (m == n && n_mat % width != 0)
+    {
+      const unsigned int last = n_batches() - 1;
+      for (unsigned int i = 0; i < m; ++i)
+        for (unsigned int l = n_mat % width; l < width; ++l)
+          (*this)(last, i, i)[l] = Number(1.);
+    }
+}
+
+
+
+template <typename Number>
+inline unsigned int
+BatchedFullMatrix<Number>::n_matrices() const
+{
+  return n_mat;
+}
+
+
+
+template <typename Number>
+inline unsigned int
+BatchedFullMatrix<Number>::n_batches() const
+{
+  return (n_mat + VectorizedArrayType::size() - 1) /
+         VectorizedArrayType::size();
+}
+
+
+
+template <typename Number>
+inline unsigned int
+BatchedFullMatrix<Number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename Number>
+inline unsigned int
+BatchedFullMatrix<Number>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename Number>
+inline typename BatchedFullMatrix<Number>::VectorizedArrayType &
+BatchedFullMatrix<Number>::operator()(const unsigned int batch,
+                                      const unsigned int i,
+                                      const unsigned int j)
+{
+  AssertIndexRange(batch, n_batches());
+  AssertIndexRange(i, n_rows);
+  AssertIndexRange(j, n_cols);
+  return values[(batch * n_rows + i) * n_cols + j];
+}
+
+
+
+template <typename Number>
+inline const typename BatchedFullMatrix<Number>::VectorizedArrayType &
+BatchedFullMatrix<Number>::operator()(const unsigned int batch,
+                                      const unsigned int i,
+                                      const unsigned int j) const
+{
+  AssertIndexRange(batch, n_batches());
+  AssertIndexRange(i, n_rows);
+  AssertIndexRange(j, n_cols);
+  return values[(batch * n_rows + i) * n_cols + j];
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::set_matrix(const unsigned int        index,
+                                      const FullMatrix<Number> &matrix)
+{
+  AssertIndexRange(index, n_mat);
+  AssertDimension(matrix.m(), n_rows);
+  AssertDimension(matrix.n(), n_cols);
+
+  const unsigned int batch = index / VectorizedArrayType::size();
+  const unsigned int lane  = index % VectorizedArrayType::size();
+  for (unsigned int i = 0; i < n_rows; ++i)
+    for (unsigned int j = 0; j < n_cols; ++j)
+      (*this)(batch, i, j)[lane] = matrix(i, j);
+
+  state = LAPACKSupport::matrix;
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::get_matrix(const unsigned int  index,
+                                      FullMatrix<Number> &matrix) const
+{
+  AssertIndexRange(index, n_mat);
+
+  const unsigned int batch = index / VectorizedArrayType::size();
+  const unsigned int lane  = index % VectorizedArrayType::size();
+  matrix.reinit(n_rows, n_cols);
+  for (unsigned int i = 0; i < n_rows; ++i)
+    for (unsigned int j = 0; j < n_cols; ++j)
+      matrix(i, j) = (*this)(batch, i, j)[lane];
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::mmult(BatchedFullMatrix<Number> &      C,
+                                 const BatchedFullMatrix<Number> &B,
+                                 const bool adding) const
+{
+  Assert(state == LAPACKSupport::matrix ||
+           state == LAPACKSupport::inverse_matrix,
+         LAPACKSupport::ExcState(state));
+  Assert(&C != this && &C != &B, ExcMessage("Output must be a new object."));
+  AssertDimension(B.n_matrices(), n_mat);
+  AssertDimension(B.m(), n_cols);
+
+  if (adding)
+    {
+      AssertDimension(C.n_matrices(), n_mat);
+      AssertDimension(C.m(), n_rows);
+      AssertDimension(C.n(), B.n());
+    }
+  else
+    C.reinit(n_mat, n_rows, B.n());
+
+  const unsigned int n_out = B.n();
+  for (unsigned int b = 0; b < n_batches(); ++b)
+    for (unsigned int i = 0; i < n_rows; ++i)
+      {
+        VectorizedArrayType *      c_row = &C(b, i, 0);
+        const VectorizedArrayType *a_row = &(*this)(b, i, 0);
+        if (!adding)
+          for (unsigned int j = 0; j < n_out; ++j)
+            c_row[j] = VectorizedArrayType();
+        for (unsigned int k = 0; k < n_cols; ++k)
+          {
+            const VectorizedArrayType  a_ik  = a_row[k];
+            const VectorizedArrayType *b_row = &B(b, k, 0);
+            for (unsigned int j = 0; j < n_out; ++j)
+              c_row[j] += a_ik * b_row[j];
+          }
+      }
+  C.state = LAPACKSupport::matrix;
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::Tmmult(BatchedFullMatrix<Number> &      C,
+                                  const BatchedFullMatrix<Number> &B,
+                                  const bool adding) const
+{
+  Assert(state == LAPACKSupport::matrix ||
+           state == LAPACKSupport::inverse_matrix,
+         LAPACKSupport::ExcState(state));
+  Assert(&C != this && &C != &B, ExcMessage("Output must be a new object."));
+  AssertDimension(B.n_matrices(), n_mat);
+  AssertDimension(B.m(), n_rows);
+
+  if (adding)
+    {
+      AssertDimension(C.n_matrices(), n_mat);
+      AssertDimension(C.m(), n_cols);
+      AssertDimension(C.n(), B.n());
+    }
+  else
+    C.reinit(n_mat, n_cols, B.n());
+
+  const unsigned int n_out = B.n();
+  for (unsigned int b = 0; b < n_batches(); ++b)
+    {
+      if (!adding)
+        for (unsigned int i = 0; i < n_cols; ++i)
+          for (unsigned int j = 0; j < n_out; ++j)
+            C(b, i, j) = VectorizedArrayType();
+      for (unsigned int k = 0; k < n_rows; ++k)
+        {
+          const VectorizedArrayType *a_row = &(*this)(b, k, 0);
+          const VectorizedArrayType *b_row = &B(b, k, 0);
+          for (unsigned int i = 0; i < n_cols; ++i)
+            {
+              const VectorizedArrayType a_ki  = a_row[i];
+              VectorizedArrayType *     c_row = &C(b, i, 0);
+              for (unsigned int j = 0; j < n_out; ++j)
+                c_row[j] += a_ki * b_row[j];
+            }
+        }
+    }
+  C.state = LAPACKSupport::matrix;
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::vmult(
+  AlignedVector<VectorizedArrayType> &      dst,
+  const AlignedVector<VectorizedArrayType> &src,
+  const bool                                adding) const
+{
+  Assert(state == LAPACKSupport::matrix ||
+           state == LAPACKSupport::inverse_matrix,
+         LAPACKSupport::ExcState(state));
+  Assert(&dst != &src, ExcMessage("Output must be a new object."));
+  AssertDimension(src.size(), n_batches() * n_cols);
+  AssertDimension(dst.size(), n_batches() * n_rows);
+
+  for (unsigned int b = 0; b < n_batches(); ++b)
+    {
+      const VectorizedArrayType *x = src.begin() + b * n_cols;
+      for (unsigned int i = 0; i < n_rows; ++i)
+        {
+          const VectorizedArrayType *a_row = &(*this)(b, i, 0);
+          VectorizedArrayType        sum   = VectorizedArrayType();
+          for (unsigned int j = 0; j < n_cols; ++j)
+            sum += a_row[j] * x[j];
+          if (adding)
+            dst[b * n_rows + i] += sum;
+          else
+            dst[b * n_rows + i] = sum;
+        }
+    }
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::compute_lu_factorization()
+{
+  Assert(state == LAPACKSupport::matrix, LAPACKSupport::ExcState(state));
+  Assert(n_rows == n_cols, LACExceptions::ExcNotQuadratic());
+
+  constexpr unsigned int width = VectorizedArrayType::size();
+  const unsigned int     n     = n_rows;
+  pivots.resize(n_batches() * n * width);
+
+  for (unsigned int b = 0; b < n_batches(); ++b)
+    {
+      VectorizedArrayType *a = &values[b * n * n];
+      for (unsigned int k = 0; k < n; ++k)
+        {
+          // find the pivot separately for each lane and swap the rows of
+          // that lane; this is cheap compared to the elimination below
+          for (unsigned int l = 0; l < width; ++l)
+            {
+              unsigned int pivot     = k;
+              Number       max_value = std::abs(a[k * n + k][l]);
+              for (unsigned int i = k + 1; i < n; ++i)
+                if (std::abs(a[i * n + k][l]) > max_value)
+                  {
+                    max_value = std::abs(a[i * n + k][l]);
+                    pivot     = i;
+                  }
+              Assert(max_value != Number(0.), LACExceptions::ExcSingular());
+              pivots[(b * n + k) * width + l] = pivot;
+              if (pivot != k)
+                for (unsigned int j = 0; j < n; ++j)
+                  std::swap(a[k * n + j][l], a[pivot * n + j][l]);
+            }
+
+          const VectorizedArrayType inv_diagonal = Number(1.) / a[k * n + k];
+          for (unsigned int i = k + 1; i < n; ++i)
+            {
+              const VectorizedArrayType l_ik = a[i * n + k] * inv_diagonal;
+              a[i * n + k]                   = l_ik;
+              for (unsigned int j = k + 1; j < n; ++j)
+                a[i * n + j] -= l_ik * a[k * n + j];
+            }
+        }
+    }
+  state = LAPACKSupport::lu;
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::compute_cholesky_factorization()
+{
+  Assert(state == LAPACKSupport::matrix, LAPACKSupport::ExcState(state));
+  Assert(n_rows == n_cols, LACExceptions::ExcNotQuadratic());
+
+  const unsigned int n = n_rows;
+  for (unsigned int b = 0; b < n_batches(); ++b)
+    {
+      VectorizedArrayType *a = &values[b * n * n];
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          VectorizedArrayType diagonal = a[j * n + j];
+          for (unsigned int k = 0; k < j; ++k)
+            diagonal -= a[j * n + k] * a[j * n + k];
+#  ifdef DEBUG
+          for (unsigned int l = 0; l < VectorizedArrayType::size(); ++l)
+            Assert(diagonal[l] > Number(0.),
+                   ExcMessage("The matrix is not positive definite."));
+#  endif
+          diagonal                          = std::sqrt(diagonal);
+          a[j * n + j]                      = diagonal;
+          const VectorizedArrayType inverse = Number(1.) / diagonal;
+          for (unsigned int i = j + 1; i < n; ++i)
+            {
+              VectorizedArrayType sum = a[i * n + j];
+              for (unsigned int k = 0; k < j; ++k)
+                sum -= a[i * n + k] * a[j * n + k];
+              a[i * n + j] = sum * inverse;
+            }
+          // the upper triangle is not referenced by the factorization; set
+          // it to zero such that get_matrix() returns the factor L
+          for (unsigned int i = 0; i < j; ++i)
+            a[i * n + j] = VectorizedArrayType();
+        }
+    }
+  state = LAPACKSupport::cholesky;
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::solve_batch(const unsigned int   batch,
+                                       VectorizedArrayType *x) const
+{
+  const unsigned int         n = n_rows;
+  const VectorizedArrayType *a = &values[batch * n * n];
+
+  if (state == LAPACKSupport::lu)
+    {
+      constexpr unsigned int width = VectorizedArrayType::size();
+      for (unsigned int k = 0; k < n; ++k)
+        for (unsigned int l = 0; l < width; ++l)
+          {
+            const unsigned int pivot = pivots[(batch * n + k) * width + l];
+            if (pivot != k)
+              std::swap(x[k][l], x[pivot][l]);
+          }
+
+      // forward substitution with the unit lower triangle
+      for (unsigned int i = 1; i < n; ++i)
+        {
+          VectorizedArrayType sum = x[i];
+          for (unsigned int j = 0; j < i; ++j)
+            sum -= a[i * n + j] * x[j];
+          x[i] = sum;
+        }
+
+      // backward substitution with the upper triangle
+      for (unsigned int i = n; i-- > 0;)
+        {
+          VectorizedArrayType sum = x[i];
+          for (unsigned int j = i + 1; j < n; ++j)
+            sum -= a[i * n + j] * x[j];
+          x[i] = sum / a[i * n + i];
+        }
+    }
+  else
+    {
+      Assert(state == LAPACKSupport::cholesky,
+             LAPACKSupport::ExcState(state));
+
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          VectorizedArrayType sum = x[i];
+          for (unsigned int j = 0; j < i; ++j)
+            sum -= a[i * n + j] * x[j];
+          x[i] = sum / a[i * n + i];
+        }
+      for (unsigned int i = n; i-- > 0;)
+        {
+          VectorizedArrayType sum = x[i];
+          for (unsigned int j = i + 1; j < n; ++j)
+            sum -= a[j * n + i] * x[j];
+          x[i] = sum / a[i * n + i];
+        }
+    }
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::solve(AlignedVector<VectorizedArrayType> &rhs) const
+{
+  Assert(state == LAPACKSupport::lu || state == LAPACKSupport::cholesky ||
+           state == LAPACKSupport::inverse_matrix,
+         LAPACKSupport::ExcState(state));
+  Assert(n_rows == n_cols, LACExceptions::ExcNotQuadratic());
+  AssertDimension(rhs.size(), n_batches() * n_rows);
+
+  if (state == LAPACKSupport::inverse_matrix)
+    {
+      AlignedVector<VectorizedArrayType> tmp(rhs);
+      vmult(rhs, tmp);
+    }
+  else
+    for (unsigned int b = 0; b < n_batches(); ++b)
+      solve_batch(b, rhs.begin() + b * n_rows);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::invert()
+{
+  Assert(state == LAPACKSupport::matrix || state == LAPACKSupport::lu ||
+           state == LAPACKSupport::cholesky,
+         LAPACKSupport::ExcState(state));
+  if (state == LAPACKSupport::matrix)
+    compute_lu_factorization();
+
+  const unsigned int                 n = n_rows;
+  AlignedVector<VectorizedArrayType> inverse(n * n);
+  AlignedVector<VectorizedArrayType> column(n);
+  for (unsigned int b = 0; b < n_batches(); ++b)
+    {
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          for (unsigned int i = 0; i < n; ++i)
+            column[i] = VectorizedArrayType();
+          column[j] = Number(1.);
+          solve_batch(b, column.begin());
+          for (unsigned int i = 0; i < n; ++i)
+            inverse[i * n + j] = column[i];
+        }
+      std::copy(inverse.begin(), inverse.end(), &values[b * n * n]);
+    }
+
+  pivots.clear();
+  state = LAPACKSupport::inverse_matrix;
+}
+
+
+
+template <typename Number>
+inline LAPACKSupport::State
+BatchedFullMatrix<Number>::get_state() const
+{
+  return state;
+}
+
+
+
+template <typename Number>
+inline std::size_t
+BatchedFullMatrix<Number>::memory_consumption() const
+{
+  return sizeof(*this) + values.memory_consumption() +
+         pivots.capacity() * sizeof(unsigned int);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
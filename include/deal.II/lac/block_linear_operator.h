@@ -19,6 +19,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/lac/linear_operator.h>
 
@@ -79,7 +80,8 @@ block_diagonal_operator(
   const std::array<LinearOperator<typename Range::BlockType,
                                   typename Domain::BlockType,
                                   typename BlockPayload::BlockType>,
-                   m> &);
+                   m> &,
+  const bool apply_blocks_in_parallel = false);
 
 template <std::size_t m,
           typename Range  = BlockVector<double>,
@@ -523,6 +525,71 @@ namespace internal
 
 
 
+    // Replace the LinearOperator interfaces of the block diagonal operator
+    // op by variants that apply the diagonal blocks ops as concurrent tasks.
+    // The tasks are balanced by the sizes of the blocks of the source
+    // vector, as no better estimate of the cost of a LinearOperator is
+    // available.
+    template <std::size_t m,
+              typename Range,
+              typename Domain,
+              typename BlockPayload,
+              typename BlockType>
+    inline void
+    populate_parallel_block_diagonal_functions(
+      dealii::BlockLinearOperator<Range, Domain, BlockPayload> &op,
+      const std::array<BlockType, m> &                          ops)
+    {
+      const auto block_sizes = [](const auto &u) {
+        std::vector<std::size_t> sizes(u.n_blocks());
+        for (unsigned int i = 0; i < u.n_blocks(); ++i)
+          sizes[i] = u.block(i).size();
+        return sizes;
+      };
+
+      op.vmult = [ops, block_sizes](Range &v, const Domain &u) {
+        Assert(v.n_blocks() == m, ExcDimensionMismatch(v.n_blocks(), m));
+        Assert(u.n_blocks() == m, ExcDimensionMismatch(u.n_blocks(), m));
+        parallel::apply_to_weighted_items(
+          block_sizes(u),
+          [&](const unsigned int i) { ops[i].vmult(v.block(i), u.block(i)); },
+          0);
+      };
+
+      op.vmult_add = [ops, block_sizes](Range &v, const Domain &u) {
+        Assert(v.n_blocks() == m, ExcDimensionMismatch(v.n_blocks(), m));
+        Assert(u.n_blocks() == m, ExcDimensionMismatch(u.n_blocks(), m));
+        parallel::apply_to_weighted_items(
+          block_sizes(u),
+          [&](const unsigned int i) {
+            ops[i].vmult_add(v.block(i), u.block(i));
+          },
+          0);
+      };
+
+      op.Tvmult = [ops, block_sizes](Domain &v, const Range &u) {
+        Assert(v.n_blocks() == m, ExcDimensionMismatch(v.n_blocks(), m));
+        Assert(u.n_blocks() == m, ExcDimensionMismatch(u.n_blocks(), m));
+        parallel::apply_to_weighted_items(
+          block_sizes(u),
+          [&](const unsigned int i) { ops[i].Tvmult(v.block(i), u.block(i)); },
+          0);
+      };
+
+      op.Tvmult_add = [ops, block_sizes](Domain &v, const Range &u) {
+        Assert(v.n_blocks() == m, ExcDimensionMismatch(v.n_blocks(), m));
+        Assert(u.n_blocks() == m, ExcDimensionMismatch(u.n_blocks(), m));
+        parallel::apply_to_weighted_items(
+          block_sizes(u),
+          [&](const unsigned int i) {
+            ops[i].Tvmult_add(v.block(i), u.block(i));
+          },
+          0);
+      };
+    }
+
+
+
     /**
      * A dummy class for BlockLinearOperators that do not require any
      * extensions to facilitate the operations of the block matrix or its
@@ -757,6 +824,13 @@ block_diagonal_operator(const BlockMatrixType &block_matrix)
  * block_diagonal_operator<m, BlockVector<double>>({op_00, op_a1, ..., op_am});
  * @endcode
  *
+ * If @p apply_blocks_in_parallel is true, the diagonal blocks are applied
+ * as concurrent tasks, distributed onto the available threads by the sizes
+ * of the blocks with parallel::apply_to_weighted_items(). This is useful for
+ * block diagonal preconditioners with many blocks, but requires that the
+ * operators in @p ops can be applied at the same time, e.g., that inverse
+ * operators of different blocks do not share the same solver object.
+ *
  * @ingroup LAOperators
  */
 template <std::size_t m, typename Range, typename Domain, typename BlockPayload>
@@ -765,7 +839,8 @@ block_diagonal_operator(
   const std::array<LinearOperator<typename Range::BlockType,
                                   typename Domain::BlockType,
                                   typename BlockPayload::BlockType>,
-                   m> &ops)
+                   m> &ops,
+  const bool          apply_blocks_in_parallel)
 {
   static_assert(
     m > 0, "a blockdiagonal LinearOperator must consist of at least one block");
@@ -794,7 +869,11 @@ block_diagonal_operator(
           new_ops[i][j].reinit_domain_vector = ops[j].reinit_domain_vector;
         }
 
-  return block_operator<m, m, Range, Domain>(new_ops);
+  auto return_op = block_operator<m, m, Range, Domain>(new_ops);
+  if (apply_blocks_in_parallel)
+    internal::BlockLinearOperatorImplementation::
+      populate_parallel_block_diagonal_functions(return_op, ops);
+  return return_op;
 }
 
 
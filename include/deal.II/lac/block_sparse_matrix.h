@@ -19,6 +19,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/block_matrix_base.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/block_vector.h>
@@ -42,6 +44,14 @@ DEAL_II_NAMESPACE_OPEN
  * the calls to the individual blocks to the functions implemented in the base
  * class. See there also for a description of when this class is useful.
  *
+ * The matrix-vector products between block vectors work on the block rows
+ * (or, for the transpose, the block columns) concurrently, since each of them
+ * writes into a different block of the destination vector. The block rows
+ * are distributed onto the available threads by their number of nonzero
+ * entries using parallel::apply_to_weighted_items(), which keeps all threads
+ * busy also for systems with many small blocks, for which the threading
+ * within the products of the individual blocks does not pay off.
+ *
  * @see
  * @ref GlossBlockLA "Block (linear algebra)"
  * @author Wolfgang Bangerth, 2000, 2004
@@ -248,6 +258,21 @@ public:
   void
   vmult(Vector<nonblock_number> &dst, const Vector<nonblock_number> &src) const;
 
+  /**
+   * Adding matrix-vector multiplication: let $dst += M*src$ with $M$ being
+   * this matrix. The block rows are worked on concurrently like in vmult().
+   */
+  template <typename block_number>
+  void
+  vmult_add(BlockVector<block_number> &      dst,
+            const BlockVector<block_number> &src) const;
+
+  /**
+   * Make the adding matrix-vector multiplications of the base class for
+   * other vector types available.
+   */
+  using BaseClass::vmult_add;
+
   /**
    * Matrix-vector multiplication: let $dst = M^T*src$ with $M$ being this
    * matrix. This function does the same as vmult() but takes the transposed
@@ -258,6 +283,22 @@ public:
   Tvmult(BlockVector<block_number> &      dst,
          const BlockVector<block_number> &src) const;
 
+  /**
+   * Adding matrix-vector multiplication: let $dst += M^T*src$ with $M$ being
+   * this matrix. The block columns are worked on concurrently like in
+   * Tvmult().
+   */
+  template <typename block_number>
+  void
+  Tvmult_add(BlockVector<block_number> &      dst,
+             const BlockVector<block_number> &src) const;
+
+  /**
+   * Make the adding transpose matrix-vector multiplications of the base
+   * class for other vector types available.
+   */
+  using BaseClass::Tvmult_add;
+
   /**
    * Matrix-vector multiplication. Just like the previous function, but only
    * applicable if the matrix has only one block row.
@@ -359,6 +400,16 @@ public:
   //@}
 
 private:
+  /**
+   * Return the number of nonzero entries plus the number of rows of each
+   * block row of the matrix if @p block_rows is true, or the number of
+   * nonzero entries plus the number of columns of each block column
+   * otherwise. These numbers are used to distribute the matrix-vector
+   * products onto threads.
+   */
+  std::vector<std::size_t>
+  compute_block_weights(const bool block_rows) const;
+
   /**
    * Pointer to the block sparsity pattern used for this matrix. In order to
    * guarantee that it is not deleted while still in use, we subscribe to it
@@ -396,7 +447,19 @@ inline void
 BlockSparseMatrix<number>::vmult(BlockVector<block_number> &      dst,
                                  const BlockVector<block_number> &src) const
 {
-  BaseClass::vmult_block_block(dst, src);
+  Assert(dst.n_blocks() == this->n_block_rows(),
+         ExcDimensionMismatch(dst.n_blocks(), this->n_block_rows()));
+  Assert(src.n_blocks() == this->n_block_cols(),
+         ExcDimensionMismatch(src.n_blocks(), this->n_block_cols()));
+
+  parallel::apply_to_weighted_items(
+    compute_block_weights(true),
+    [this, &dst, &src](const unsigned int row) {
+      this->block(row, 0).vmult(dst.block(row), src.block(0));
+      for (unsigned int col = 1; col < this->n_block_cols(); ++col)
+        this->block(row, col).vmult_add(dst.block(row), src.block(col));
+    },
+    4 * internal::VectorImplementation::minimum_parallel_grain_size);
 }
 
 
@@ -434,13 +497,70 @@ BlockSparseMatrix<number>::vmult(Vector<nonblock_number> &      dst,
 
 
 
+template <typename number>
+template <typename block_number>
+inline void
+BlockSparseMatrix<number>::vmult_add(BlockVector<block_number> &      dst,
+                                     const BlockVector<block_number> &src) const
+{
+  Assert(dst.n_blocks() == this->n_block_rows(),
+         ExcDimensionMismatch(dst.n_blocks(), this->n_block_rows()));
+  Assert(src.n_blocks() == this->n_block_cols(),
+         ExcDimensionMismatch(src.n_blocks(), this->n_block_cols()));
+
+  parallel::apply_to_weighted_items(
+    compute_block_weights(true),
+    [this, &dst, &src](const unsigned int row) {
+      for (unsigned int col = 0; col < this->n_block_cols(); ++col)
+        this->block(row, col).vmult_add(dst.block(row), src.block(col));
+    },
+    4 * internal::VectorImplementation::minimum_parallel_grain_size);
+}
+
+
+
 template <typename number>
 template <typename block_number>
 inline void
 BlockSparseMatrix<number>::Tvmult(BlockVector<block_number> &      dst,
                                   const BlockVector<block_number> &src) const
 {
-  BaseClass::Tvmult_block_block(dst, src);
+  Assert(dst.n_blocks() == this->n_block_cols(),
+         ExcDimensionMismatch(dst.n_blocks(), this->n_block_cols()));
+  Assert(src.n_blocks() == this->n_block_rows(),
+         ExcDimensionMismatch(src.n_blocks(), this->n_block_rows()));
+
+  parallel::apply_to_weighted_items(
+    compute_block_weights(false),
+    [this, &dst, &src](const unsigned int col) {
+      this->block(0, col).Tvmult(dst.block(col), src.block(0));
+      for (unsigned int row = 1; row < this->n_block_rows(); ++row)
+        this->block(row, col).Tvmult_add(dst.block(col), src.block(row));
+    },
+    4 * internal::VectorImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <typename block_number>
+inline void
+BlockSparseMatrix<number>::Tvmult_add(
+  BlockVector<block_number> &      dst,
+  const BlockVector<block_number> &src) const
+{
+  Assert(dst.n_blocks() == this->n_block_cols(),
+         ExcDimensionMismatch(dst.n_blocks(), this->n_block_cols()));
+  Assert(src.n_blocks() == this->n_block_rows(),
+         ExcDimensionMismatch(src.n_blocks(), this->n_block_rows()));
+
+  parallel::apply_to_weighted_items(
+    compute_block_weights(false),
+    [this, &dst, &src](const unsigned int col) {
+      for (unsigned int row = 0; row < this->n_block_rows(); ++row)
+        this->block(row, col).Tvmult_add(dst.block(col), src.block(row));
+    },
+    4 * internal::VectorImplementation::minimum_parallel_grain_size);
 }
 
 
@@ -147,6 +147,25 @@ BlockSparseMatrix<number>::n_nonzero_elements() const
 
 
 
+template <typename number>
+std::vector<std::size_t>
+BlockSparseMatrix<number>::compute_block_weights(const bool block_rows) const
+{
+  std::vector<std::size_t> weights(block_rows ? this->n_block_rows() :
+                                                this->n_block_cols(),
+                                   0);
+  for (size_type i = 0; i < this->n_block_rows(); ++i)
+    for (size_type j = 0; j < this->n_block_cols(); ++j)
+      weights[block_rows ? i : j] +=
+        this->sub_objects[i][j]->n_nonzero_elements();
+  for (size_type i = 0; i < weights.size(); ++i)
+    weights[i] += block_rows ? this->block(i, 0).m() : this->block(0, i).n();
+
+  return weights;
+}
+
+
+
 template <typename number>
 typename BlockSparseMatrix<number>::size_type
 BlockSparseMatrix<number>::n_actually_nonzero_elements(
@@ -19,7 +19,9 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/linear_operator.h>
+#include <deal.II/lac/multi_vector_operations.h>
 #include <deal.II/lac/precondition.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_cg.h>
@@ -28,7 +30,9 @@
 #include <deal.II/lac/solver_minres.h>
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -190,6 +194,139 @@ protected:
   AdditionalData additional_data;
 };
 
+/**
+ * Locally optimal block preconditioned conjugate gradient method (LOBPCG)
+ * for computing the smallest eigenvalues and the associated eigenvectors of
+ * the symmetric generalized eigenvalue problem $A x = \lambda B x$ with a
+ * symmetric positive definite matrix $B$, or of the standard problem $A x =
+ * \lambda x$, following A. V. Knyazev, Toward the optimal preconditioned
+ * eigensolver: Locally optimal block preconditioned conjugate gradient
+ * method, SIAM J. Sci. Comput. 23 (2001), pp. 517-541.
+ *
+ * The method iterates on a block $X$ of as many vectors as eigenpairs are
+ * sought. In each step, the residuals $R = AX - BX\Lambda$ are
+ * preconditioned by an approximation $T \approx A^{-1}$, and the new
+ * iterates are the Ritz vectors of the Rayleigh-Ritz projection of the
+ * eigenvalue problem onto the subspace spanned by $X$, the preconditioned
+ * residuals $W = TR$, and the previous search directions $P$. The products
+ * of $A$ and $B$ with the iterates and search directions are updated by
+ * linear combinations, so every step applies $A$, $B$, and $T$ only once to
+ * each vector of the block.
+ *
+ * The matrices and the preconditioner only need to provide a function
+ * <tt>vmult(VectorType &dst, const VectorType &src)</tt>, so matrix-free
+ * operators and LinearOperator objects can be used. The dense projected
+ * problem of size at most three times the block size is solved by the
+ * Jacobi eigenvalue algorithm within this class, and no external library is
+ * needed. The vector operations on the blocks are implemented by the
+ * functions in internal::MultiVectorOperations: for Vector and
+ * LinearAlgebra::distributed::Vector, all inner products of the
+ * Rayleigh-Ritz step are computed in a single pass over the vectors with a
+ * single global reduction, and the residual norms with another one.
+ *
+ * The iteration stops when the largest $l_2$ norm of the residuals
+ * $Ax_i-\lambda_i Bx_i$ satisfies the criterion of the SolverControl
+ * object. Since the residual scales with the eigenvalues, the tolerance
+ * should be chosen relative to the magnitude of the sought eigenvalues.
+ * Convergence is usually faster if the block contains a few more vectors
+ * than eigenvalues of interest.
+ */
+template <typename VectorType = Vector<double>>
+class EigenLOBPCG : private SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type of container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double basis_tolerance = 1e-12)
+      : basis_tolerance(basis_tolerance)
+    {}
+
+    /**
+     * Relative size of the pivots in the Cholesky factorization of the
+     * projected matrix $B$ below which the trial subspace is considered
+     * linearly dependent. In that case, the search directions $P$ are
+     * dropped from the subspace for one step, which restarts the method.
+     */
+    double basis_tolerance;
+  };
+
+  /**
+   * Constructor.
+   */
+  EigenLOBPCG(SolverControl &           cn,
+              VectorMemory<VectorType> &mem,
+              const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Compute the smallest eigenvalues of the generalized eigenvalue problem
+   * $A x = \lambda B x$. The number of eigenpairs computed is the size of
+   * @p eigenvectors, whose entries must be linearly independent initial
+   * guesses on entry. On exit, @p eigenvalues contains the eigenvalues in
+   * ascending order and @p eigenvectors the associated eigenvectors,
+   * orthonormal with respect to the inner product induced by $B$. Random
+   * initial vectors are a safe choice, whereas vectors with components in
+   * only a few eigenvectors of $A$ may lead to a degenerate trial subspace
+   * and an exception.
+   *
+   * @p preconditioner is applied to the residuals and should approximate
+   * the inverse of $A$, or of a shifted matrix $A - \sigma B$ if $A$ is
+   * not positive definite. PreconditionIdentity can be used if no
+   * preconditioner is available.
+   */
+  template <typename MatrixType,
+            typename MassMatrixType,
+            typename PreconditionerType>
+  void
+  solve(const MatrixType &         A,
+        const MassMatrixType &     B,
+        const PreconditionerType & preconditioner,
+        std::vector<double> &      eigenvalues,
+        std::vector<VectorType> &  eigenvectors);
+
+  /**
+   * Same as above for the standard eigenvalue problem $A x = \lambda x$.
+   * The eigenvectors are orthonormal with respect to the $l_2$ inner
+   * product on exit.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        const PreconditionerType &preconditioner,
+        std::vector<double> &     eigenvalues,
+        std::vector<VectorType> & eigenvectors);
+
+protected:
+  /**
+   * Implementation of the solve() functions, where a null pointer @p B
+   * stands for the identity matrix.
+   */
+  template <typename MatrixType,
+            typename MassMatrixType,
+            typename PreconditionerType>
+  void
+  solve_internal(const MatrixType &        A,
+                 const MassMatrixType *    B,
+                 const PreconditionerType &preconditioner,
+                 std::vector<double> &     eigenvalues,
+                 std::vector<VectorType> & eigenvectors);
+
+  /**
+   * Flags for execution.
+   */
+  AdditionalData additional_data;
+};
+
 /*@}*/
 //---------------------------------------------------------------------------
 
@@ -390,6 +527,488 @@ EigenInverse<VectorType>::solve(double &          value,
   // otherwise exit as normal
 }
 
+//---------------------------------------------------------------------------
+
+#ifndef DOXYGEN
+namespace internal
+{
+  namespace EigenLOBPCGImplementation
+  {
+    /**
+     * Compute the Cholesky factorization $G = LL^T$ of the symmetric matrix
+     * @p G in place, storing $L$ in the lower triangle. Return false if a
+     * pivot is below @p tolerance times the largest diagonal entry.
+     */
+    inline bool
+    cholesky(FullMatrix<double> &G, const double tolerance)
+    {
+      const unsigned int n        = G.m();
+      double             max_diag = 0.;
+      for (unsigned int i = 0; i < n; ++i)
+        max_diag = std::max(max_diag, G(i, i));
+
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          double diagonal = G(j, j);
+          for (unsigned int k = 0; k < j; ++k)
+            diagonal -= G(j, k) * G(j, k);
+          if (!(diagonal > tolerance * max_diag))
+            return false;
+          G(j, j) = std::sqrt(diagonal);
+          for (unsigned int i = j + 1; i < n; ++i)
+            {
+              double sum = G(i, j);
+              for (unsigned int k = 0; k < j; ++k)
+                sum -= G(i, k) * G(j, k);
+              G(i, j) = sum / G(j, j);
+            }
+          for (unsigned int i = 0; i < j; ++i)
+            G(i, j) = 0.;
+        }
+      return true;
+    }
+
+
+
+    /**
+     * Compute all eigenvalues and eigenvectors of the symmetric matrix @p C
+     * by the cyclic Jacobi method. The eigenvalues are returned in
+     * ascending order in @p eigenvalues and the associated eigenvectors in
+     * the columns of @p Q. @p C is overwritten.
+     */
+    inline void
+    jacobi_eigensystem(FullMatrix<double> & C,
+                       std::vector<double> &eigenvalues,
+                       FullMatrix<double> & Q)
+    {
+      const unsigned int n = C.m();
+      FullMatrix<double> V(n, n);
+      for (unsigned int i = 0; i < n; ++i)
+        V(i, i) = 1.;
+
+      double norm = 0.;
+      for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int j = 0; j < n; ++j)
+          norm += C(i, j) * C(i, j);
+
+      for (unsigned int sweep = 0; sweep < 100; ++sweep)
+        {
+          double off_diagonal = 0.;
+          for (unsigned int i = 0; i < n; ++i)
+            for (unsigned int j = i + 1; j < n; ++j)
+              off_diagonal += 2. * C(i, j) * C(i, j);
+          if (off_diagonal <= 1e-30 * norm)
+            break;
+
+          for (unsigned int p = 0; p < n; ++p)
+            for (unsigned int q = p + 1; q < n; ++q)
+              {
+                if (C(p, q) == 0.)
+                  continue;
+                const double theta = (C(q, q) - C(p, p)) / (2. * C(p, q));
+                const double t =
+                  (theta >= 0. ? 1. : -1.) /
+                  (std::abs(theta) + std::sqrt(theta * theta + 1.));
+                const double c  = 1. / std::sqrt(t * t + 1.);
+                const double sn = t * c;
+
+                for (unsigned int k = 0; k < n; ++k)
+                  {
+                    const double ckp = C(k, p);
+                    const double ckq = C(k, q);
+                    C(k, p)          = c * ckp - sn * ckq;
+                    C(k, q)          = sn * ckp + c * ckq;
+                  }
+                for (unsigned int k = 0; k < n; ++k)
+                  {
+                    const double cpk = C(p, k);
+                    const double cqk = C(q, k);
+                    C(p, k)          = c * cpk - sn * cqk;
+                    C(q, k)          = sn * cpk + c * cqk;
+                  }
+                for (unsigned int k = 0; k < n; ++k)
+                  {
+                    const double vkp = V(k, p);
+                    const double vkq = V(k, q);
+                    V(k, p)          = c * vkp - sn * vkq;
+                    V(k, q)          = sn * vkp + c * vkq;
+                  }
+              }
+        }
+
+      std::vector<unsigned int> permutation(n);
+      for (unsigned int i = 0; i < n; ++i)
+        permutation[i] = i;
+      std::sort(permutation.begin(),
+                permutation.end(),
+                [&C](const unsigned int a, const unsigned int b) {
+                  return C(a, a) < C(b, b);
+                });
+
+      eigenvalues.resize(n);
+      Q.reinit(n, n);
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          eigenvalues[j] = C(permutation[j], permutation[j]);
+          for (unsigned int i = 0; i < n; ++i)
+            Q(i, j) = V(i, permutation[j]);
+        }
+    }
+
+
+
+    /**
+     * Solve the projected eigenvalue problem $G_A z = \theta G_B z$ and
+     * return the @p n_wanted smallest eigenvalues in @p eigenvalues and the
+     * associated $G_B$-orthonormal eigenvectors in the columns of @p
+     * coefficients. Return false if $G_B$ is numerically singular.
+     */
+    inline bool
+    rayleigh_ritz(const FullMatrix<double> &G_A,
+                  const FullMatrix<double> &G_B,
+                  const unsigned int        n_wanted,
+                  const double              tolerance,
+                  std::vector<double> &     eigenvalues,
+                  FullMatrix<double> &      coefficients)
+    {
+      const unsigned int n = G_A.m();
+
+      // scale the basis to unit length in the B inner product, which
+      // removes the bad scaling of the preconditioned residuals close to
+      // convergence
+      std::vector<double> scaling(n);
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          if (!(G_B(i, i) > 0.))
+            return false;
+          scaling[i] = 1. / std::sqrt(G_B(i, i));
+        }
+
+      FullMatrix<double> L(n, n), C(n, n);
+      for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int j = 0; j < n; ++j)
+          {
+            L(i, j) =
+              0.5 * (G_B(i, j) + G_B(j, i)) * scaling[i] * scaling[j];
+            C(i, j) =
+              0.5 * (G_A(i, j) + G_A(j, i)) * scaling[i] * scaling[j];
+          }
+      if (!cholesky(L, tolerance))
+        return false;
+
+      // C <- L^{-1} C L^{-T}, by two forward substitutions with the
+      // symmetric matrix C
+      for (unsigned int pass = 0; pass < 2; ++pass)
+        {
+          for (unsigned int j = 0; j < n; ++j)
+            for (unsigned int i = 0; i < n; ++i)
+              {
+                double sum = C(i, j);
+                for (unsigned int k = 0; k < i; ++k)
+                  sum -= L(i, k) * C(k, j);
+                C(i, j) = sum / L(i, i);
+              }
+          C.copy_transposed(FullMatrix<double>(C));
+        }
+
+      std::vector<double> all_eigenvalues;
+      FullMatrix<double>  Q;
+      jacobi_eigensystem(C, all_eigenvalues, Q);
+
+      // back-transform z = D L^{-T} q
+      eigenvalues.assign(all_eigenvalues.begin(),
+                         all_eigenvalues.begin() + n_wanted);
+      coefficients.reinit(n, n_wanted);
+      for (unsigned int j = 0; j < n_wanted; ++j)
+        for (unsigned int i = n; i-- > 0;)
+          {
+            double sum = Q(i, j);
+            for (unsigned int k = i + 1; k < n; ++k)
+              sum -= L(k, i) * coefficients(k, j);
+            coefficients(i, j) = sum / L(i, i);
+          }
+      for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int j = 0; j < n_wanted; ++j)
+          coefficients(i, j) *= scaling[i];
+
+      return true;
+    }
+  } // namespace EigenLOBPCGImplementation
+} // namespace internal
+#endif
+
+
+
+template <class VectorType>
+EigenLOBPCG<VectorType>::EigenLOBPCG(SolverControl &           cn,
+                                     VectorMemory<VectorType> &mem,
+                                     const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+template <typename MatrixType,
+          typename MassMatrixType,
+          typename PreconditionerType>
+void
+EigenLOBPCG<VectorType>::solve(const MatrixType &         A,
+                               const MassMatrixType &     B,
+                               const PreconditionerType & preconditioner,
+                               std::vector<double> &      eigenvalues,
+                               std::vector<VectorType> &  eigenvectors)
+{
+  solve_internal(A, &B, preconditioner, eigenvalues, eigenvectors);
+}
+
+
+
+template <class VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+EigenLOBPCG<VectorType>::solve(const MatrixType &        A,
+                               const PreconditionerType &preconditioner,
+                               std::vector<double> &     eigenvalues,
+                               std::vector<VectorType> & eigenvectors)
+{
+  solve_internal(A,
+                 static_cast<const MatrixType *>(nullptr),
+                 preconditioner,
+                 eigenvalues,
+                 eigenvectors);
+}
+
+
+
+template <class VectorType>
+template <typename MatrixType,
+          typename MassMatrixType,
+          typename PreconditionerType>
+void
+EigenLOBPCG<VectorType>::solve_internal(
+  const MatrixType &        A,
+  const MassMatrixType *    B,
+  const PreconditionerType &preconditioner,
+  std::vector<double> &     eigenvalues,
+  std::vector<VectorType> & eigenvectors)
+{
+  using Number       = typename VectorType::value_type;
+  using PointerType  = typename VectorMemory<VectorType>::Pointer;
+  using VectorBlock  = std::vector<PointerType>;
+  const unsigned int n_wanted = eigenvectors.size();
+  Assert(n_wanted > 0, ExcMessage("At least one eigenvector is needed."));
+
+  LogStream::Prefix prefix("LOBPCG");
+
+  const auto allocate = [&](VectorBlock &block) {
+    block.clear();
+    for (unsigned int i = 0; i < n_wanted; ++i)
+      {
+        block.emplace_back(this->memory);
+        block.back()->reinit(eigenvectors[0], true);
+      }
+  };
+
+  // The blocks of iterates X, preconditioned residuals W, search directions
+  // P, and a temporary block T, together with their products with A and B.
+  // For the standard eigenvalue problem, the products with B are the
+  // vectors themselves and are not stored.
+  VectorBlock X, W, P, T, AX, AW, AP, AT, BX, BW, BP, BT;
+  for (VectorBlock *block : {&X, &W, &P, &T, &AX, &AW, &AP, &AT})
+    allocate(*block);
+  if (B != nullptr)
+    for (VectorBlock *block : {&BX, &BW, &BP, &BT})
+      allocate(*block);
+
+  const auto pointers = [](const std::vector<const VectorBlock *> &blocks,
+                           const bool                              use_p) {
+    std::vector<const VectorType *> result;
+    for (unsigned int b = 0; b < blocks.size(); ++b)
+      if (b < 2 || use_p)
+        for (const auto &v : *blocks[b])
+          result.push_back(v.get());
+    return result;
+  };
+  const auto b_block = [&](const VectorBlock &block,
+                           const VectorBlock &b_product) -> const VectorBlock & {
+    return B != nullptr ? b_product : block;
+  };
+
+  // Compute the projected matrices of A and B onto the space spanned by the
+  // given blocks in a single fused reduction and solve the projected
+  // eigenvalue problem
+  std::vector<Number> dots;
+  FullMatrix<double>  coefficients;
+  const auto          project = [&](const unsigned int n_blocks,
+                           const bool         use_p,
+                           const double       tolerance) {
+    const std::vector<const VectorType *> basis =
+      pointers({&X, &W, &P}, use_p);
+    std::vector<const VectorType *> products =
+      pointers({&AX, &AW, &AP}, use_p);
+    const std::vector<const VectorType *> b_products =
+      pointers({&b_block(X, BX), &b_block(W, BW), &b_block(P, BP)}, use_p);
+    products.insert(products.end(), b_products.begin(), b_products.end());
+
+    const unsigned int n_basis = n_blocks * n_wanted;
+    std::vector<const VectorType *> left(basis.begin(),
+                                         basis.begin() + n_basis);
+    std::vector<const VectorType *> right;
+    right.insert(right.end(), products.begin(), products.begin() + n_basis);
+    right.insert(right.end(),
+                 products.begin() + basis.size(),
+                 products.begin() + basis.size() + n_basis);
+    internal::MultiVectorOperations::multi_dot(left, right, dots);
+
+    FullMatrix<double> G_A(n_basis, n_basis), G_B(n_basis, n_basis);
+    for (unsigned int i = 0; i < n_basis; ++i)
+      for (unsigned int j = 0; j < n_basis; ++j)
+        {
+          G_A(i, j) = dots[i * 2 * n_basis + j];
+          G_B(i, j) = dots[i * 2 * n_basis + n_basis + j];
+        }
+    return internal::EigenLOBPCGImplementation::rayleigh_ritz(
+      G_A, G_B, n_wanted, tolerance, eigenvalues, coefficients);
+  };
+
+  // Set dst[i] to the linear combination of the vectors in the given
+  // blocks with the coefficients in rows starting at first_row of
+  // column i of the coefficient matrix, plus the vector add[i] if given
+  std::vector<const VectorType *> vectors;
+  std::vector<Number>             factors;
+  const auto                      combine =
+    [&](VectorBlock &                          dst,
+        const std::vector<const VectorBlock *> &blocks,
+        const unsigned int                      first_row,
+        const VectorBlock *                     add) {
+      for (unsigned int i = 0; i < n_wanted; ++i)
+        {
+          vectors.clear();
+          factors.clear();
+          for (unsigned int b = 0; b < blocks.size(); ++b)
+            for (unsigned int j = 0; j < n_wanted; ++j)
+              {
+                vectors.push_back((*blocks[b])[j].get());
+                factors.push_back(
+                  coefficients(first_row + b * n_wanted + j, i));
+              }
+          if (add != nullptr)
+            {
+              vectors.push_back((*add)[i].get());
+              factors.push_back(Number(1.));
+            }
+          internal::MultiVectorOperations::multi_add(*dst[i],
+                                                     vectors,
+                                                     factors);
+        }
+    };
+
+  // initial Rayleigh-Ritz step on the given vectors
+  for (unsigned int i = 0; i < n_wanted; ++i)
+    {
+      *X[i] = eigenvectors[i];
+      A.vmult(*AX[i], *X[i]);
+      if (B != nullptr)
+        B->vmult(*BX[i], *X[i]);
+    }
+  AssertThrow(project(1, false, additional_data.basis_tolerance),
+              ExcMessage("The initial vectors are linearly dependent."));
+  combine(T, {&X}, 0, nullptr);
+  combine(AT, {&AX}, 0, nullptr);
+  if (B != nullptr)
+    combine(BT, {&BX}, 0, nullptr);
+  std::swap(X, T);
+  std::swap(AX, AT);
+  std::swap(BX, BT);
+
+  SolverControl::State conv           = SolverControl::iterate;
+  bool                 use_directions = false;
+  double               residual       = 0.;
+  std::vector<Number>  norms;
+  unsigned int         iter = 0;
+  for (; conv == SolverControl::iterate; ++iter)
+    {
+      // residuals R = AX - BX Lambda, stored in W
+      for (unsigned int i = 0; i < n_wanted; ++i)
+        {
+          *W[i] = *AX[i];
+          W[i]->add(-eigenvalues[i], *b_block(X, BX)[i]);
+        }
+      const std::vector<const VectorType *> residuals =
+        pointers({&W}, false);
+      internal::MultiVectorOperations::pairwise_dot(residuals,
+                                                    residuals,
+                                                    norms);
+      residual = 0.;
+      for (const Number norm : norms)
+        residual = std::max<double>(residual, std::sqrt(std::abs(norm)));
+
+      conv = this->iteration_status(iter, residual, *X[0]);
+      if (conv != SolverControl::iterate)
+        break;
+
+      // preconditioned residuals and their products with A and B
+      for (unsigned int i = 0; i < n_wanted; ++i)
+        {
+          preconditioner.vmult(*T[i], *W[i]);
+          std::swap(T[i], W[i]);
+          A.vmult(*AW[i], *W[i]);
+          if (B != nullptr)
+            B->vmult(*BW[i], *W[i]);
+        }
+
+      // Rayleigh-Ritz step on [X, W, P], restarting without the search
+      // directions if the basis is degenerate
+      if (use_directions &&
+          !project(3, true, additional_data.basis_tolerance))
+        use_directions = false;
+      if (!use_directions)
+        AssertThrow(project(2, false, additional_data.basis_tolerance),
+                    ExcMessage("The LOBPCG trial subspace is degenerate. "
+                               "Try a different preconditioner or "
+                               "initial vectors."));
+
+      // new search directions P = W C_W + P C_P into T, and new iterates
+      // X = X C_X + P into W
+      if (use_directions)
+        {
+          combine(T, {&W, &P}, n_wanted, nullptr);
+          combine(AT, {&AW, &AP}, n_wanted, nullptr);
+          if (B != nullptr)
+            combine(BT, {&BW, &BP}, n_wanted, nullptr);
+        }
+      else
+        {
+          combine(T, {&W}, n_wanted, nullptr);
+          combine(AT, {&AW}, n_wanted, nullptr);
+          if (B != nullptr)
+            combine(BT, {&BW}, n_wanted, nullptr);
+        }
+      combine(W, {&X}, 0, &T);
+      combine(AW, {&AX}, 0, &AT);
+      if (B != nullptr)
+        combine(BW, {&BX}, 0, &BT);
+
+      std::swap(X, W);
+      std::swap(AX, AW);
+      std::swap(BX, BW);
+      std::swap(P, T);
+      std::swap(AP, AT);
+      std::swap(BP, BT);
+      use_directions = true;
+    }
+
+  for (unsigned int i = 0; i < n_wanted; ++i)
+    eigenvectors[i] = *X[i];
+
+  // in case of failure: throw exception
+  AssertThrow(conv == SolverControl::success,
+              SolverControl::NoConvergence(iter, residual));
+  // otherwise exit as normal
+}
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
@@ -0,0 +1,1219 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_linear_operator_expression_h
+#define dealii_linear_operator_expression_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+
+#include <deal.II/lac/linear_operator.h>
+
+#include <memory>
+#include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations:
+#ifndef DOXYGEN
+namespace internal
+{
+  namespace LinearOperatorExpressionImplementation
+  {
+    class ExpressionTag
+    {};
+  } // namespace LinearOperatorExpressionImplementation
+} // namespace internal
+#endif
+
+
+/**
+ * Base class of the expression templates that represent compositions of
+ * linear operators with static types.
+ *
+ * The LinearOperator class stores its operations in
+ * <code>std::function</code> objects, and the products and sums of
+ * LinearOperator objects obtain the vectors for intermediate results from a
+ * GrowingVectorMemory in every call of <code>vmult</code>. For nested
+ * operators, such as the Schur complement
+ * $S=B\,A^{-1}\,B^T$ used inside an outer solver, whose <code>vmult</code> is
+ * called many times, these indirections and vector setups can become
+ * noticeable. The classes derived from this base class describe the same
+ * operations, but encode the structure of the composition in their type:
+ * @code
+ * SparseMatrix<double> A, B, BT;
+ * SolverCG<Vector<double>> solver_A(...);
+ * PreconditionJacobi<SparseMatrix<double>> preconditioner_A;
+ * ...
+ * const auto op_A  = linear_operator_expression<Vector<double>>(A);
+ * const auto op_B  = linear_operator_expression<Vector<double>>(B);
+ * const auto op_BT = linear_operator_expression<Vector<double>>(BT);
+ *
+ * const auto op_S =
+ *   op_B * inverse_operator(op_A, solver_A, preconditioner_A) * op_BT;
+ * @endcode
+ * Here, <code>op_S</code> is an object of a class composed of the classes
+ * for a product, an inverse operator, and three matrix operators. Its
+ * member functions <code>vmult</code>, <code>vmult_add</code>,
+ * <code>Tvmult</code>, and <code>Tvmult_add</code> are ordinary (inlinable)
+ * functions, and the object can be passed to the iterative solvers as a
+ * matrix or preconditioner like any other matrix.
+ *
+ * The expression objects differ from LinearOperator in the following
+ * respects:
+ * <ul>
+ * <li> Each product, sum, scaled, and inverse operator owns the vectors it
+ * needs for intermediate results. They are set up on the first application
+ * of the operator and reused afterwards, so repeated applications neither
+ * allocate memory nor set up vectors. As a consequence, an expression must
+ * be created anew if the sizes of the underlying matrices change, and an
+ * expression object must not be applied from several threads at the same
+ * time.
+ * <li> Scalar factors are merged into sums: the expression
+ * <code>a * op_A + b * op_B</code> is applied as $v=A\,u$, $t=B\,u$,
+ * followed by the single vector update $v \leftarrow a\,v + b\,t$, and the
+ * sum of two unscaled operators uses the <code>vmult_add</code> function of
+ * the second one without any intermediate vector.
+ * <li> Expressions store copies of their operands, which in turn store
+ * references to the matrices, solvers, and preconditioners they were
+ * created from. These objects must therefore outlive the expression.
+ * </ul>
+ *
+ * When an operator of the type-erased LinearOperator class is needed, for
+ * example to store operators of different structure in the same variable,
+ * to_linear_operator() converts an expression into a LinearOperator.
+ * Conversely, an existing LinearOperator can be used as an operand of an
+ * expression by passing it to linear_operator_expression().
+ *
+ * The template arguments @p Range and @p Domain denote the vector types of
+ * the range and domain space, and @p Derived is the class derived from this
+ * base class (the "curiously recurring template pattern"). The vector types
+ * must provide the <code>add()</code>, <code>sadd()</code>, and
+ * <code>reinit()</code> functions of the deal.II vector classes.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range, typename Domain, typename Derived>
+class LinearOperatorExpression
+  : public internal::LinearOperatorExpressionImplementation::ExpressionTag
+{
+public:
+  /**
+   * The vector type of the range space.
+   */
+  using range_type = Range;
+
+  /**
+   * The vector type of the domain space.
+   */
+  using domain_type = Domain;
+
+  /**
+   * Return a reference to the derived object this base class belongs to.
+   */
+  const Derived &
+  derived() const
+  {
+    return static_cast<const Derived &>(*this);
+  }
+
+  /**
+   * Return a LinearOperator that applies a copy of this expression. The
+   * copy, including its intermediate vectors, is shared between all copies
+   * of the returned LinearOperator.
+   */
+  LinearOperator<Range, Domain>
+  to_linear_operator() const;
+};
+
+
+
+namespace internal
+{
+  namespace LinearOperatorExpressionImplementation
+  {
+    /**
+     * A trait that is true if @p T is an expression derived from
+     * LinearOperatorExpression.
+     */
+    template <typename T>
+    struct is_expression : std::is_base_of<ExpressionTag, T>
+    {};
+
+
+
+    /**
+     * An expression that applies a matrix or preconditioner object stored
+     * by reference. The vectors of the range and domain space are set up by
+     * means of the ReinitHelper class and the @p exemplar object, like in
+     * linear_operator().
+     */
+    template <typename Range,
+              typename Domain,
+              typename Exemplar,
+              typename Matrix>
+    class MatrixOperator
+      : public LinearOperatorExpression<
+          Range,
+          Domain,
+          MatrixOperator<Range, Domain, Exemplar, Matrix>>
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      MatrixOperator(const Exemplar &exemplar, const Matrix &matrix)
+        : exemplar(&exemplar)
+        , matrix(&matrix)
+      {}
+
+      void
+      reinit_range_vector(Range &v, const bool omit_zeroing_entries) const
+      {
+        LinearOperatorImplementation::ReinitHelper<Range>::reinit_range_vector(
+          *exemplar, v, omit_zeroing_entries);
+      }
+
+      void
+      reinit_domain_vector(Domain &v, const bool omit_zeroing_entries) const
+      {
+        LinearOperatorImplementation::ReinitHelper<
+          Domain>::reinit_domain_vector(*exemplar, v, omit_zeroing_entries);
+      }
+
+      void
+      vmult(Range &v, const Domain &u) const
+      {
+        Assert(!PointerComparison::equal(&v, &u),
+               ExcMessage("The source and destination vectors of an "
+                          "expression operator must be different."));
+        matrix->vmult(v, u);
+      }
+
+      void
+      vmult_add(Range &v, const Domain &u) const
+      {
+        Assert(!PointerComparison::equal(&v, &u),
+               ExcMessage("The source and destination vectors of an "
+                          "expression operator must be different."));
+        do_vmult_add(v, u, has_vmult_add());
+      }
+
+      void
+      Tvmult(Domain &v, const Range &u) const
+      {
+        Assert(!PointerComparison::equal(&v, &u),
+               ExcMessage("The source and destination vectors of an "
+                          "expression operator must be different."));
+        matrix->Tvmult(v, u);
+      }
+
+      void
+      Tvmult_add(Domain &v, const Range &u) const
+      {
+        Assert(!PointerComparison::equal(&v, &u),
+               ExcMessage("The source and destination vectors of an "
+                          "expression operator must be different."));
+        do_Tvmult_add(v, u, has_vmult_add());
+      }
+
+    private:
+      using has_vmult_add = typename LinearOperatorImplementation::
+        has_vmult_add_and_Tvmult_add<Range, Domain, Matrix>::type;
+
+      void
+      do_vmult_add(Range &v, const Domain &u, std::true_type) const
+      {
+        matrix->vmult_add(v, u);
+      }
+
+      void
+      do_vmult_add(Range &v, const Domain &u, std::false_type) const
+      {
+        tmp_range.reinit(v, /*omit_zeroing_entries =*/true);
+        matrix->vmult(tmp_range, u);
+        v += tmp_range;
+      }
+
+      void
+      do_Tvmult_add(Domain &v, const Range &u, std::true_type) const
+      {
+        matrix->Tvmult_add(v, u);
+      }
+
+      void
+      do_Tvmult_add(Domain &v, const Range &u, std::false_type) const
+      {
+        tmp_domain.reinit(v, /*omit_zeroing_entries =*/true);
+        matrix->Tvmult(tmp_domain, u);
+        v += tmp_domain;
+      }
+
+      const Exemplar *exemplar;
+      const Matrix *  matrix;
+
+      /**
+       * Intermediate vectors, only used if @p Matrix does not provide
+       * <code>vmult_add</code> and <code>Tvmult_add</code>.
+       */
+      mutable Range  tmp_range;
+      mutable Domain tmp_domain;
+    };
+
+
+
+    /**
+     * An expression that applies a (copy of a) LinearOperator.
+     */
+    template <typename Range, typename Domain, typename Payload>
+    class TypeErasedOperator
+      : public LinearOperatorExpression<
+          Range,
+          Domain,
+          TypeErasedOperator<Range, Domain, Payload>>
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      TypeErasedOperator(const LinearOperator<Range, Domain, Payload> &op)
+        : op(op)
+      {}
+
+      void
+      reinit_range_vector(Range &v, const bool omit_zeroing_entries) const
+      {
+        op.reinit_range_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      reinit_domain_vector(Domain &v, const bool omit_zeroing_entries) const
+      {
+        op.reinit_domain_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      vmult(Range &v, const Domain &u) const
+      {
+        op.vmult(v, u);
+      }
+
+      void
+      vmult_add(Range &v, const Domain &u) const
+      {
+        op.vmult_add(v, u);
+      }
+
+      void
+      Tvmult(Domain &v, const Range &u) const
+      {
+        op.Tvmult(v, u);
+      }
+
+      void
+      Tvmult_add(Domain &v, const Range &u) const
+      {
+        op.Tvmult_add(v, u);
+      }
+
+    private:
+      const LinearOperator<Range, Domain, Payload> op;
+    };
+
+
+
+    /**
+     * An expression for the operator @p op multiplied by a scalar factor.
+     */
+    template <typename Range, typename Domain, typename Op>
+    class ScaledOperator
+      : public LinearOperatorExpression<Range,
+                                        Domain,
+                                        ScaledOperator<Range, Domain, Op>>
+    {
+    public:
+      using value_type = typename Range::value_type;
+
+      /**
+       * Constructor.
+       */
+      ScaledOperator(const value_type factor, const Op &op)
+        : factor(factor)
+        , op(op)
+      {}
+
+      void
+      reinit_range_vector(Range &v, const bool omit_zeroing_entries) const
+      {
+        op.reinit_range_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      reinit_domain_vector(Domain &v, const bool omit_zeroing_entries) const
+      {
+        op.reinit_domain_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      vmult(Range &v, const Domain &u) const
+      {
+        op.vmult(v, u);
+        v *= factor;
+      }
+
+      void
+      vmult_add(Range &v, const Domain &u) const
+      {
+        tmp_range.reinit(v, /*omit_zeroing_entries =*/true);
+        op.vmult(tmp_range, u);
+        v.add(factor, tmp_range);
+      }
+
+      void
+      Tvmult(Domain &v, const Range &u) const
+      {
+        op.Tvmult(v, u);
+        v *= factor;
+      }
+
+      void
+      Tvmult_add(Domain &v, const Range &u) const
+      {
+        tmp_domain.reinit(v, /*omit_zeroing_entries =*/true);
+        op.Tvmult(tmp_domain, u);
+        v.add(factor, tmp_domain);
+      }
+
+      /**
+       * The scalar factor.
+       */
+      const value_type factor;
+
+      /**
+       * The operator that is scaled.
+       */
+      const Op op;
+
+    private:
+      mutable Range  tmp_range;
+      mutable Domain tmp_domain;
+    };
+
+
+
+    /**
+     * An expression for the linear combination
+     * $\mathrm{factor\_1}\,\mathrm{op\_1} + \mathrm{factor\_2}\,
+     * \mathrm{op\_2}$. If both factors are one, the second operator is
+     * applied by its <code>vmult_add</code> function. Otherwise, the results
+     * of both operators are combined in a single vector update.
+     */
+    template <typename Range, typename Domain, typename Op1, typename Op2>
+    class SumOperator
+      : public LinearOperatorExpression<Range,
+                                        Domain,
+                                        SumOperator<Range, Domain, Op1, Op2>>
+    {
+    public:
+      using value_type = typename Range::value_type;
+
+      /**
+       * Constructor.
+       */
+      SumOperator(const value_type factor_1,
+                  const Op1 &      op_1,
+                  const value_type factor_2,
+                  const Op2 &      op_2)
+        : factor_1(factor_1)
+        , op_1(op_1)
+        , factor_2(factor_2)
+        , op_2(op_2)
+      {}
+
+      void
+      reinit_range_vector(Range &v, const bool omit_zeroing_entries) const
+      {
+        op_1.reinit_range_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      reinit_domain_vector(Domain &v, const bool omit_zeroing_entries) const
+      {
+        op_1.reinit_domain_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      vmult(Range &v, const Domain &u) const
+      {
+        op_1.vmult(v, u);
+        if (factor_1 == value_type(1.) && factor_2 == value_type(1.))
+          op_2.vmult_add(v, u);
+        else
+          {
+            tmp_range_1.reinit(v, /*omit_zeroing_entries =*/true);
+            op_2.vmult(tmp_range_1, u);
+            v.sadd(factor_1, factor_2, tmp_range_1);
+          }
+      }
+
+      void
+      vmult_add(Range &v, const Domain &u) const
+      {
+        if (factor_1 == value_type(1.) && factor_2 == value_type(1.))
+          {
+            op_1.vmult_add(v, u);
+            op_2.vmult_add(v, u);
+          }
+        else
+          {
+            tmp_range_1.reinit(v, /*omit_zeroing_entries =*/true);
+            tmp_range_2.reinit(v, /*omit_zeroing_entries =*/true);
+            op_1.vmult(tmp_range_1, u);
+            op_2.vmult(tmp_range_2, u);
+            v.add(factor_1, tmp_range_1, factor_2, tmp_range_2);
+          }
+      }
+
+      void
+      Tvmult(Domain &v, const Range &u) const
+      {
+        op_1.Tvmult(v, u);
+        if (factor_1 == value_type(1.) && factor_2 == value_type(1.))
+          op_2.Tvmult_add(v, u);
+        else
+          {
+            tmp_domain_1.reinit(v, /*omit_zeroing_entries =*/true);
+            op_2.Tvmult(tmp_domain_1, u);
+            v.sadd(factor_1, factor_2, tmp_domain_1);
+          }
+      }
+
+      void
+      Tvmult_add(Domain &v, const Range &u) const
+      {
+        if (factor_1 == value_type(1.) && factor_2 == value_type(1.))
+          {
+            op_1.Tvmult_add(v, u);
+            op_2.Tvmult_add(v, u);
+          }
+        else
+          {
+            tmp_domain_1.reinit(v, /*omit_zeroing_entries =*/true);
+            tmp_domain_2.reinit(v, /*omit_zeroing_entries =*/true);
+            op_1.Tvmult(tmp_domain_1, u);
+            op_2.Tvmult(tmp_domain_2, u);
+            v.add(factor_1, tmp_domain_1, factor_2, tmp_domain_2);
+          }
+      }
+
+      const value_type factor_1;
+      const Op1        op_1;
+      const value_type factor_2;
+      const Op2        op_2;
+
+    private:
+      mutable Range  tmp_range_1;
+      mutable Range  tmp_range_2;
+      mutable Domain tmp_domain_1;
+      mutable Domain tmp_domain_2;
+    };
+
+
+
+    /**
+     * An expression for the composition $\mathrm{op\_1}\,\mathrm{op\_2}$,
+     * where the result of @p op_2 is stored in an intermediate vector owned
+     * by this object.
+     */
+    template <typename Range,
+              typename Intermediate,
+              typename Domain,
+              typename Op1,
+              typename Op2>
+    class ProductOperator
+      : public LinearOperatorExpression<
+          Range,
+          Domain,
+          ProductOperator<Range, Intermediate, Domain, Op1, Op2>>
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      ProductOperator(const Op1 &op_1, const Op2 &op_2)
+        : op_1(op_1)
+        , op_2(op_2)
+      {}
+
+      void
+      reinit_range_vector(Range &v, const bool omit_zeroing_entries) const
+      {
+        op_1.reinit_range_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      reinit_domain_vector(Domain &v, const bool omit_zeroing_entries) const
+      {
+        op_2.reinit_domain_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      vmult(Range &v, const Domain &u) const
+      {
+        if (tmp.size() == 0)
+          op_2.reinit_range_vector(tmp, /*omit_zeroing_entries =*/true);
+        op_2.vmult(tmp, u);
+        op_1.vmult(v, tmp);
+      }
+
+      void
+      vmult_add(Range &v, const Domain &u) const
+      {
+        if (tmp.size() == 0)
+          op_2.reinit_range_vector(tmp, /*omit_zeroing_entries =*/true);
+        op_2.vmult(tmp, u);
+        op_1.vmult_add(v, tmp);
+      }
+
+      void
+      Tvmult(Domain &v, const Range &u) const
+      {
+        if (tmp.size() == 0)
+          op_1.reinit_domain_vector(tmp, /*omit_zeroing_entries =*/true);
+        op_1.Tvmult(tmp, u);
+        op_2.Tvmult(v, tmp);
+      }
+
+      void
+      Tvmult_add(Domain &v, const Range &u) const
+      {
+        if (tmp.size() == 0)
+          op_1.reinit_domain_vector(tmp, /*omit_zeroing_entries =*/true);
+        op_1.Tvmult(tmp, u);
+        op_2.Tvmult_add(v, tmp);
+      }
+
+    private:
+      const Op1 op_1;
+      const Op2 op_2;
+
+      /**
+       * The intermediate vector, set up on first use.
+       */
+      mutable Intermediate tmp;
+    };
+
+
+
+    /**
+     * An expression for the transpose of @p op.
+     */
+    template <typename Range, typename Domain, typename Op>
+    class TransposeOperator
+      : public LinearOperatorExpression<Range,
+                                        Domain,
+                                        TransposeOperator<Range, Domain, Op>>
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      TransposeOperator(const Op &op)
+        : op(op)
+      {}
+
+      void
+      reinit_range_vector(Range &v, const bool omit_zeroing_entries) const
+      {
+        op.reinit_domain_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      reinit_domain_vector(Domain &v, const bool omit_zeroing_entries) const
+      {
+        op.reinit_range_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      vmult(Range &v, const Domain &u) const
+      {
+        op.Tvmult(v, u);
+      }
+
+      void
+      vmult_add(Range &v, const Domain &u) const
+      {
+        op.Tvmult_add(v, u);
+      }
+
+      void
+      Tvmult(Domain &v, const Range &u) const
+      {
+        op.vmult(v, u);
+      }
+
+      void
+      Tvmult_add(Domain &v, const Range &u) const
+      {
+        op.vmult_add(v, u);
+      }
+
+    private:
+      const Op op;
+    };
+
+
+
+    /**
+     * A lightweight object that applies the transpose of an object stored by
+     * reference. It is used to pass the transpose of an operator to a solver
+     * without copying it.
+     */
+    template <typename Op>
+    class TransposeView
+    {
+    public:
+      TransposeView(const Op &op)
+        : op(op)
+      {}
+
+      template <typename VectorType1, typename VectorType2>
+      void
+      vmult(VectorType1 &v, const VectorType2 &u) const
+      {
+        op.Tvmult(v, u);
+      }
+
+      template <typename VectorType1, typename VectorType2>
+      void
+      Tvmult(VectorType1 &v, const VectorType2 &u) const
+      {
+        op.vmult(v, u);
+      }
+
+    private:
+      const Op &op;
+    };
+
+
+
+    /**
+     * The identity as a preconditioner, used by the variant of
+     * inverse_operator() without preconditioner argument.
+     */
+    class IdentityPreconditioner
+    {
+    public:
+      template <typename VectorType>
+      void
+      vmult(VectorType &v, const VectorType &u) const
+      {
+        v = u;
+      }
+
+      template <typename VectorType>
+      void
+      Tvmult(VectorType &v, const VectorType &u) const
+      {
+        v = u;
+      }
+    };
+
+
+
+    /**
+     * An expression for the inverse of the square operator @p op, applied by
+     * running @p solver with the given preconditioner. The solution of
+     * <code>vmult</code> starts from a zero vector. The type @p
+     * PreconditionerStorage is either a reference to the preconditioner
+     * type or, for expressions and the identity, the preconditioner type
+     * itself, in which case a copy is stored.
+     */
+    template <typename Range,
+              typename Domain,
+              typename Op,
+              typename Solver,
+              typename PreconditionerStorage>
+    class InverseOperator
+      : public LinearOperatorExpression<
+          Domain,
+          Range,
+          InverseOperator<Range, Domain, Op, Solver, PreconditionerStorage>>
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      InverseOperator(const Op &             op,
+                      Solver &               solver,
+                      PreconditionerStorage &preconditioner)
+        : op(op)
+        , solver(&solver)
+        , preconditioner(preconditioner)
+      {}
+
+      void
+      reinit_range_vector(Domain &v, const bool omit_zeroing_entries) const
+      {
+        op.reinit_domain_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      reinit_domain_vector(Range &v, const bool omit_zeroing_entries) const
+      {
+        op.reinit_range_vector(v, omit_zeroing_entries);
+      }
+
+      void
+      vmult(Domain &v, const Range &u) const
+      {
+        v = 0.;
+        solver->solve(op, v, u, preconditioner);
+      }
+
+      void
+      vmult_add(Domain &v, const Range &u) const
+      {
+        tmp_domain.reinit(v, /*omit_zeroing_entries =*/false);
+        solver->solve(op, tmp_domain, u, preconditioner);
+        v += tmp_domain;
+      }
+
+      void
+      Tvmult(Range &v, const Domain &u) const
+      {
+        v = 0.;
+        solver->solve(TransposeView<Op>(op),
+                      v,
+                      u,
+                      TransposeView<typename std::remove_cv<
+                        typename std::remove_reference<PreconditionerStorage>::
+                          type>::type>(preconditioner));
+      }
+
+      void
+      Tvmult_add(Range &v, const Domain &u) const
+      {
+        tmp_range.reinit(v, /*omit_zeroing_entries =*/false);
+        solver->solve(TransposeView<Op>(op),
+                      tmp_range,
+                      u,
+                      TransposeView<typename std::remove_cv<
+                        typename std::remove_reference<PreconditionerStorage>::
+                          type>::type>(preconditioner));
+        v += tmp_range;
+      }
+
+    private:
+      const Op              op;
+      Solver *              solver;
+      PreconditionerStorage preconditioner;
+
+      mutable Domain tmp_domain;
+      mutable Range  tmp_range;
+    };
+
+
+
+    /**
+     * Split an expression into a scalar factor and the unscaled operand,
+     * which for all expressions but ScaledOperator are one and the
+     * expression itself.
+     */
+    template <typename Op>
+    struct Unscaled
+    {
+      using type = Op;
+
+      template <typename Number>
+      static Number
+      factor(const Op &)
+      {
+        return Number(1.);
+      }
+
+      static const Op &
+      operand(const Op &op)
+      {
+        return op;
+      }
+    };
+
+    template <typename Range, typename Domain, typename Op>
+    struct Unscaled<ScaledOperator<Range, Domain, Op>>
+    {
+      using type = Op;
+
+      template <typename Number>
+      static Number
+      factor(const ScaledOperator<Range, Domain, Op> &op)
+      {
+        return op.factor;
+      }
+
+      static const Op &
+      operand(const ScaledOperator<Range, Domain, Op> &op)
+      {
+        return op.op;
+      }
+    };
+
+
+
+    /**
+     * Return the expression @p op scaled by @p number. Scalings of scaled
+     * operators and of sums are merged into the existing factors.
+     */
+    template <typename Number, typename Op>
+    ScaledOperator<typename Op::range_type, typename Op::domain_type, Op>
+    scale(const Number number, const Op &op)
+    {
+      return {number, op};
+    }
+
+    template <typename Number, typename Range, typename Domain, typename Op>
+    ScaledOperator<Range, Domain, Op>
+    scale(const Number number, const ScaledOperator<Range, Domain, Op> &op)
+    {
+      return {number * op.factor, op.op};
+    }
+
+    template <typename Number,
+              typename Range,
+              typename Domain,
+              typename Op1,
+              typename Op2>
+    SumOperator<Range, Domain, Op1, Op2>
+    scale(const Number number, const SumOperator<Range, Domain, Op1, Op2> &op)
+    {
+      return {number * op.factor_1, op.op_1, number * op.factor_2, op.op_2};
+    }
+  } // namespace LinearOperatorExpressionImplementation
+} // namespace internal
+
+
+
+/**
+ * @name Creation of and operations on a LinearOperatorExpression
+ */
+//@{
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Return an expression that applies @p matrix, which is stored by
+ * reference. The requirements on @p matrix are the same as for
+ * linear_operator(): it must provide <code>vmult</code> and
+ * <code>Tvmult</code>, and <code>vmult_add</code> and
+ * <code>Tvmult_add</code> are used if available.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range = Vector<double>,
+          typename Domain = Range,
+          typename Matrix>
+internal::LinearOperatorExpressionImplementation::
+  MatrixOperator<Range, Domain, Matrix, Matrix>
+  linear_operator_expression(const Matrix &matrix)
+{
+  return {matrix, matrix};
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Variant of above function that takes an object @p operator_exemplar used
+ * to set up the vectors of the range and domain space. This is useful to
+ * wrap preconditioners, which usually do not provide information about the
+ * size of their vectors.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range = Vector<double>,
+          typename Domain = Range,
+          typename OperatorExemplar,
+          typename Matrix>
+internal::LinearOperatorExpressionImplementation::
+  MatrixOperator<Range, Domain, OperatorExemplar, Matrix>
+  linear_operator_expression(const OperatorExemplar &operator_exemplar,
+                             const Matrix &          matrix)
+{
+  return {operator_exemplar, matrix};
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Return an expression that applies a copy of the LinearOperator @p op.
+ * This allows to use type-erased operators within expressions.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range, typename Domain, typename Payload>
+internal::LinearOperatorExpressionImplementation::
+  TypeErasedOperator<Range, Domain, Payload>
+  linear_operator_expression(const LinearOperator<Range, Domain, Payload> &op)
+{
+  return {op};
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Sum of two expressions. Scalar factors of the operands are merged into
+ * the sum, such that it is applied with a single vector update.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range, typename Domain, typename Derived1, typename Derived2>
+internal::LinearOperatorExpressionImplementation::SumOperator<
+  Range,
+  Domain,
+  typename internal::LinearOperatorExpressionImplementation::Unscaled<
+    Derived1>::type,
+  typename internal::LinearOperatorExpressionImplementation::Unscaled<
+    Derived2>::type>
+operator+(const LinearOperatorExpression<Range, Domain, Derived1> &first_op,
+          const LinearOperatorExpression<Range, Domain, Derived2> &second_op)
+{
+  using namespace internal::LinearOperatorExpressionImplementation;
+  using Number = typename Range::value_type;
+  return {Unscaled<Derived1>::template factor<Number>(first_op.derived()),
+          Unscaled<Derived1>::operand(first_op.derived()),
+          Unscaled<Derived2>::template factor<Number>(second_op.derived()),
+          Unscaled<Derived2>::operand(second_op.derived())};
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Difference of two expressions, see operator+().
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range, typename Domain, typename Derived1, typename Derived2>
+internal::LinearOperatorExpressionImplementation::SumOperator<
+  Range,
+  Domain,
+  typename internal::LinearOperatorExpressionImplementation::Unscaled<
+    Derived1>::type,
+  typename internal::LinearOperatorExpressionImplementation::Unscaled<
+    Derived2>::type>
+operator-(const LinearOperatorExpression<Range, Domain, Derived1> &first_op,
+          const LinearOperatorExpression<Range, Domain, Derived2> &second_op)
+{
+  using namespace internal::LinearOperatorExpressionImplementation;
+  using Number = typename Range::value_type;
+  return {Unscaled<Derived1>::template factor<Number>(first_op.derived()),
+          Unscaled<Derived1>::operand(first_op.derived()),
+          -Unscaled<Derived2>::template factor<Number>(second_op.derived()),
+          Unscaled<Derived2>::operand(second_op.derived())};
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Scalar multiplication of an expression with @p number from the left.
+ * Factors of scaled operators and sums are multiplied by @p number instead
+ * of adding another level to the expression.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range, typename Domain, typename Derived>
+auto operator*(const typename Range::value_type                   number,
+               const LinearOperatorExpression<Range, Domain, Derived> &op)
+  -> decltype(
+    internal::LinearOperatorExpressionImplementation::scale(number,
+                                                            op.derived()))
+{
+  return internal::LinearOperatorExpressionImplementation::scale(number,
+                                                                 op.derived());
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Scalar multiplication of an expression with @p number from the right.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range, typename Domain, typename Derived>
+auto operator*(const LinearOperatorExpression<Range, Domain, Derived> &op,
+               const typename Range::value_type                       number)
+  -> decltype(number * op)
+{
+  return number * op;
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Composition of two expressions, $(\mathrm{first\_op}*\mathrm{second\_op})x
+ * \dealcoloneq \mathrm{first\_op}(\mathrm{second\_op}(x))$. The intermediate
+ * result is stored in a vector owned by the returned object.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range,
+          typename Intermediate,
+          typename Domain,
+          typename Derived1,
+          typename Derived2>
+internal::LinearOperatorExpressionImplementation::
+  ProductOperator<Range, Intermediate, Domain, Derived1, Derived2>
+  operator*(
+    const LinearOperatorExpression<Range, Intermediate, Derived1> & first_op,
+    const LinearOperatorExpression<Intermediate, Domain, Derived2> &second_op)
+{
+  return {first_op.derived(), second_op.derived()};
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Return an expression for the transpose of @p op.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range, typename Domain, typename Derived>
+internal::LinearOperatorExpressionImplementation::
+  TransposeOperator<Domain, Range, Derived>
+  transpose_operator(const LinearOperatorExpression<Range, Domain, Derived> &op)
+{
+  return {op.derived()};
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Return an expression for the inverse of @p op, which is applied by
+ * calling <code>solver.solve()</code> with the given @p preconditioner. In
+ * contrast to the inverse_operator() functions for LinearOperator objects,
+ * the solver is called with the expression @p op itself rather than a
+ * type-erased wrapper.
+ *
+ * The expression stores a reference to @p solver. If @p preconditioner is
+ * an expression, a copy of it is stored, otherwise a reference, which must
+ * remain valid for the lifetime of the returned object.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range,
+          typename Domain,
+          typename Derived,
+          typename Solver,
+          typename Preconditioner>
+internal::LinearOperatorExpressionImplementation::InverseOperator<
+  Range,
+  Domain,
+  Derived,
+  Solver,
+  typename std::conditional<
+    internal::LinearOperatorExpressionImplementation::is_expression<
+      Preconditioner>::value,
+    const Preconditioner,
+    const Preconditioner &>::type>
+inverse_operator(const LinearOperatorExpression<Range, Domain, Derived> &op,
+                 Solver &                                                solver,
+                 const Preconditioner &preconditioner)
+{
+  return {op.derived(), solver, preconditioner};
+}
+
+
+/**
+ * @relatesalso LinearOperatorExpression
+ *
+ * Variant of above function without a preconditioner, i.e., using the
+ * identity as preconditioner.
+ *
+ * @ingroup LAOperators
+ */
+template <typename Range, typename Domain, typename Derived, typename Solver>
+internal::LinearOperatorExpressionImplementation::InverseOperator<
+  Range,
+  Domain,
+  Derived,
+  Solver,
+  const internal::LinearOperatorExpressionImplementation::
+    IdentityPreconditioner>
+inverse_operator(const LinearOperatorExpression<Range, Domain, Derived> &op,
+                 Solver &                                                solver)
+{
+  const internal::LinearOperatorExpressionImplementation::IdentityPreconditioner
+    identity;
+  return {op.derived(), solver, identity};
+}
+
+//@}
+
+
+
+#ifndef DOXYGEN
+
+template <typename Range, typename Domain, typename Derived>
+LinearOperator<Range, Domain>
+LinearOperatorExpression<Range, Domain, Derived>::to_linear_operator() const
+{
+  // store the expression in a shared pointer, such that all copies of the
+  // LinearOperator refer to the same expression and intermediate vectors
+  const auto expression = std::make_shared<const Derived>(derived());
+
+  LinearOperator<Range, Domain> return_op;
+
+  return_op.reinit_range_vector = [expression](Range &v,
+                                               bool   omit_zeroing_entries) {
+    expression->reinit_range_vector(v, omit_zeroing_entries);
+  };
+
+  return_op.reinit_domain_vector = [expression](Domain &v,
+                                                bool    omit_zeroing_entries) {
+    expression->reinit_domain_vector(v, omit_zeroing_entries);
+  };
+
+  return_op.vmult = [expression](Range &v, const Domain &u) {
+    expression->vmult(v, u);
+  };
+
+  return_op.vmult_add = [expression](Range &v, const Domain &u) {
+    expression->vmult_add(v, u);
+  };
+
+  return_op.Tvmult = [expression](Domain &v, const Range &u) {
+    expression->Tvmult(v, u);
+  };
+
+  return_op.Tvmult_add = [expression](Domain &v, const Range &u) {
+    expression->Tvmult_add(v, u);
+  };
+
+  return return_op;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
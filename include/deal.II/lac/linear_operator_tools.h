@@ -25,6 +25,7 @@
 #include <deal.II/lac/block_linear_operator.h>
 #include <deal.II/lac/constrained_linear_operator.h>
 #include <deal.II/lac/linear_operator.h>
+#include <deal.II/lac/linear_operator_expression.h>
 #include <deal.II/lac/packaged_operation.h>
 #include <deal.II/lac/schur_complement.h>
 #include <deal.II/lac/trilinos_linear_operator.h>
@@ -0,0 +1,389 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_multi_vector_operations_h
+#define dealii_multi_vector_operations_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  /**
+   * Kernels operating on blocks of vectors at once, as used by block solvers
+   * like SolverBFGS and EigenLOBPCG. Each function has a generic version for
+   * all vector types that calls the operations of the vectors one by one, and
+   * specializations for Vector and LinearAlgebra::distributed::Vector that
+   * read every vector from memory only once and combine all global reductions
+   * of one call into a single collective operation.
+   */
+  namespace MultiVectorOperations
+  {
+    /**
+     * Compute the inner products of all vectors in @p left with all vectors
+     * in @p right and store them in @p result, with the product of
+     * <tt>left[i]</tt> and <tt>right[j]</tt> at position
+     * <tt>i*right.size()+j</tt>. This generic version simply calls the inner
+     * product of the vectors one by one.
+     */
+    template <typename VectorType>
+    void
+    multi_dot(const std::vector<const VectorType *> &left,
+              const std::vector<const VectorType *> &right,
+              std::vector<typename VectorType::value_type> &result)
+    {
+      result.resize(left.size() * right.size());
+      for (unsigned int i = 0; i < left.size(); ++i)
+        for (unsigned int j = 0; j < right.size(); ++j)
+          result[i * right.size() + j] = (*left[i]) * (*right[j]);
+    }
+
+
+
+    /**
+     * Set @p dst to the linear combination of @p vectors with the given
+     * @p coefficients. This generic version adds the vectors one by one.
+     */
+    template <typename VectorType>
+    void
+    multi_add(VectorType &                                       dst,
+              const std::vector<const VectorType *> &            vectors,
+              const std::vector<typename VectorType::value_type> &coefficients)
+    {
+      AssertDimension(vectors.size(), coefficients.size());
+      Assert(vectors.size() > 0, ExcInternalError());
+      dst.equ(coefficients[0], *vectors[0]);
+      for (unsigned int i = 1; i < vectors.size(); ++i)
+        dst.add(coefficients[i], *vectors[i]);
+    }
+
+
+
+    /**
+     * Fused kernel behind multi_dot() for vectors with contiguous storage of
+     * the @p size locally owned elements. The elements are processed in
+     * chunks small enough to stay in cache, such that every vector is read
+     * from main memory only once.
+     */
+    template <typename Number>
+    void
+    local_multi_dot(const std::vector<const Number *> &left,
+                    const std::vector<const Number *> &right,
+                    const std::size_t                  size,
+                    std::vector<Number> &              result)
+    {
+      const std::size_t chunk_size = 512;
+      const std::size_t n_right    = right.size();
+      result.assign(left.size() * n_right, Number());
+      for (std::size_t begin = 0; begin < size; begin += chunk_size)
+        {
+          const std::size_t end = std::min(size, begin + chunk_size);
+          for (unsigned int i = 0; i < left.size(); ++i)
+            for (unsigned int j = 0; j < n_right; ++j)
+              {
+                const Number *l   = left[i];
+                const Number *r   = right[j];
+                Number        sum = Number();
+                DEAL_II_OPENMP_SIMD_PRAGMA
+                for (std::size_t k = begin; k < end; ++k)
+                  sum += l[k] * r[k];
+                result[i * n_right + j] += sum;
+              }
+        }
+    }
+
+
+
+    /**
+     * Fused kernel behind multi_add() for vectors with contiguous storage of
+     * the @p size locally owned elements.
+     */
+    template <typename Number>
+    void
+    local_multi_add(Number *                           dst,
+                    const std::vector<const Number *> &vectors,
+                    const std::vector<Number> &        coefficients,
+                    const std::size_t                  size)
+    {
+      const std::size_t chunk_size = 512;
+      for (std::size_t begin = 0; begin < size; begin += chunk_size)
+        {
+          const std::size_t end = std::min(size, begin + chunk_size);
+          const Number *    v   = vectors[0];
+          const Number      c   = coefficients[0];
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (std::size_t k = begin; k < end; ++k)
+            dst[k] = c * v[k];
+          for (unsigned int i = 1; i < vectors.size(); ++i)
+            {
+              const Number *v = vectors[i];
+              const Number  c = coefficients[i];
+              DEAL_II_OPENMP_SIMD_PRAGMA
+              for (std::size_t k = begin; k < end; ++k)
+                dst[k] += c * v[k];
+            }
+        }
+    }
+
+
+
+    /**
+     * Specialization of multi_dot() for serial vectors.
+     */
+    template <typename Number>
+    void
+    multi_dot(const std::vector<const Vector<Number> *> &left,
+              const std::vector<const Vector<Number> *> &right,
+              std::vector<Number> &                      result)
+    {
+      std::vector<const Number *> left_data(left.size());
+      std::vector<const Number *> right_data(right.size());
+      for (unsigned int i = 0; i < left.size(); ++i)
+        left_data[i] = left[i]->begin();
+      for (unsigned int j = 0; j < right.size(); ++j)
+        {
+          AssertDimension(right[j]->size(), right[0]->size());
+          right_data[j] = right[j]->begin();
+        }
+      for (unsigned int i = 0; i < left.size(); ++i)
+        AssertDimension(left[i]->size(), right[0]->size());
+
+      local_multi_dot(left_data,
+                      right_data,
+                      right.empty() ? 0 : right[0]->size(),
+                      result);
+    }
+
+
+
+    /**
+     * Specialization of multi_dot() for distributed vectors, which sums the
+     * local contributions of all inner products in a single reduction.
+     */
+    template <typename Number>
+    void
+    multi_dot(
+      const std::vector<const LinearAlgebra::distributed::Vector<Number> *>
+        &left,
+      const std::vector<const LinearAlgebra::distributed::Vector<Number> *>
+        &                  right,
+      std::vector<Number> &result)
+    {
+      if (right.empty())
+        {
+          result.clear();
+          return;
+        }
+
+      std::vector<const Number *> left_data(left.size());
+      std::vector<const Number *> right_data(right.size());
+      for (unsigned int i = 0; i < left.size(); ++i)
+        {
+          Assert(left[i]->partitioners_are_compatible(
+                   *right[0]->get_partitioner()),
+                 ExcMessage("The vectors must have the same layout."));
+          left_data[i] = left[i]->begin();
+        }
+      for (unsigned int j = 0; j < right.size(); ++j)
+        {
+          Assert(right[j]->partitioners_are_compatible(
+                   *right[0]->get_partitioner()),
+                 ExcMessage("The vectors must have the same layout."));
+          right_data[j] = right[j]->begin();
+        }
+
+      local_multi_dot(left_data, right_data, right[0]->local_size(), result);
+      Utilities::MPI::sum(result, right[0]->get_mpi_communicator(), result);
+    }
+
+
+
+    /**
+     * Specialization of multi_add() for serial vectors.
+     */
+    template <typename Number>
+    void
+    multi_add(Vector<Number> &                           dst,
+              const std::vector<const Vector<Number> *> &vectors,
+              const std::vector<Number> &                coefficients)
+    {
+      AssertDimension(vectors.size(), coefficients.size());
+      Assert(vectors.size() > 0, ExcInternalError());
+      std::vector<const Number *> data(vectors.size());
+      for (unsigned int i = 0; i < vectors.size(); ++i)
+        {
+          AssertDimension(vectors[i]->size(), dst.size());
+          data[i] = vectors[i]->begin();
+        }
+      local_multi_add(dst.begin(), data, coefficients, dst.size());
+    }
+
+
+
+    /**
+     * Specialization of multi_add() for distributed vectors. Only the
+     * locally owned elements are touched, so no communication is necessary
+     * unless @p dst has ghost values, which are then updated.
+     */
+    template <typename Number>
+    void
+    multi_add(
+      LinearAlgebra::distributed::Vector<Number> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<Number> *>
+        &                        vectors,
+      const std::vector<Number> &coefficients)
+    {
+      AssertDimension(vectors.size(), coefficients.size());
+      Assert(vectors.size() > 0, ExcInternalError());
+      std::vector<const Number *> data(vectors.size());
+      for (unsigned int i = 0; i < vectors.size(); ++i)
+        {
+          Assert(vectors[i]->partitioners_are_compatible(
+                   *dst.get_partitioner()),
+                 ExcMessage("The vectors must have the same layout."));
+          data[i] = vectors[i]->begin();
+        }
+      local_multi_add(dst.begin(), data, coefficients, dst.local_size());
+      if (dst.has_ghost_elements())
+        dst.update_ghost_values();
+    }
+
+
+
+    /**
+     * Compute the inner products of <tt>left[i]</tt> with <tt>right[i]</tt>
+     * for all @p i, e.g., the norms of a block of vectors. This generic
+     * version simply calls the inner product of the vectors one by one.
+     */
+    template <typename VectorType>
+    void
+    pairwise_dot(const std::vector<const VectorType *> &       left,
+                 const std::vector<const VectorType *> &       right,
+                 std::vector<typename VectorType::value_type> &result)
+    {
+      AssertDimension(left.size(), right.size());
+      result.resize(left.size());
+      for (unsigned int i = 0; i < left.size(); ++i)
+        result[i] = (*left[i]) * (*right[i]);
+    }
+
+
+
+    /**
+     * Fused kernel behind pairwise_dot() for vectors with contiguous storage
+     * of the @p size locally owned elements.
+     */
+    template <typename Number>
+    void
+    local_pairwise_dot(const std::vector<const Number *> &left,
+                       const std::vector<const Number *> &right,
+                       const std::size_t                  size,
+                       std::vector<Number> &              result)
+    {
+      result.resize(left.size());
+      for (unsigned int i = 0; i < left.size(); ++i)
+        {
+          const Number *l   = left[i];
+          const Number *r   = right[i];
+          Number        sum = Number();
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (std::size_t k = 0; k < size; ++k)
+            sum += l[k] * r[k];
+          result[i] = sum;
+        }
+    }
+
+
+
+    /**
+     * Specialization of pairwise_dot() for serial vectors.
+     */
+    template <typename Number>
+    void
+    pairwise_dot(const std::vector<const Vector<Number> *> &left,
+                 const std::vector<const Vector<Number> *> &right,
+                 std::vector<Number> &                      result)
+    {
+      AssertDimension(left.size(), right.size());
+      std::vector<const Number *> left_data(left.size());
+      std::vector<const Number *> right_data(right.size());
+      for (unsigned int i = 0; i < left.size(); ++i)
+        {
+          AssertDimension(left[i]->size(), left[0]->size());
+          AssertDimension(right[i]->size(), left[0]->size());
+          left_data[i]  = left[i]->begin();
+          right_data[i] = right[i]->begin();
+        }
+      local_pairwise_dot(left_data,
+                         right_data,
+                         left.empty() ? 0 : left[0]->size(),
+                         result);
+    }
+
+
+
+    /**
+     * Specialization of pairwise_dot() for distributed vectors, which sums
+     * the local contributions of all inner products in a single reduction.
+     */
+    template <typename Number>
+    void
+    pairwise_dot(
+      const std::vector<const LinearAlgebra::distributed::Vector<Number> *>
+        &left,
+      const std::vector<const LinearAlgebra::distributed::Vector<Number> *>
+        &                  right,
+      std::vector<Number> &result)
+    {
+      AssertDimension(left.size(), right.size());
+      if (left.empty())
+        {
+          result.clear();
+          return;
+        }
+
+      std::vector<const Number *> left_data(left.size());
+      std::vector<const Number *> right_data(right.size());
+      for (unsigned int i = 0; i < left.size(); ++i)
+        {
+          Assert(left[i]->partitioners_are_compatible(
+                   *left[0]->get_partitioner()) &&
+                   right[i]->partitioners_are_compatible(
+                     *left[0]->get_partitioner()),
+                 ExcMessage("The vectors must have the same layout."));
+          left_data[i]  = left[i]->begin();
+          right_data[i] = right[i]->begin();
+        }
+
+      local_pairwise_dot(left_data, right_data, left[0]->local_size(), result);
+      Utilities::MPI::sum(result, left[0]->get_mpi_communicator(), result);
+    }
+  } // namespace MultiVectorOperations
+} // namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -26,6 +26,7 @@
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/householder.h>
 #include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/multi_vector_operations.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/vector.h>
@@ -172,6 +173,24 @@ namespace internal
  * will then be called from the solver with the estimates as argument.
  *
  *
+ * <h3>Orthogonalization of the Arnoldi basis</h3>
+ *
+ * By default, each new Arnoldi vector is orthogonalized against the previous
+ * ones with the modified Gram-Schmidt algorithm, which computes one inner
+ * product at a time. In parallel, iteration $k$ thus needs $k$ global
+ * reductions, which dominates the cost of GMRES on large processor counts.
+ * Setting AdditionalData::orthogonalization_strategy to
+ * AdditionalData::classical_gram_schmidt selects the classical Gram-Schmidt
+ * algorithm with selective re-orthogonalization (CGS2) instead: all inner
+ * products of an orthogonalization pass, including the norm of the new
+ * vector, are computed in one sweep over the vectors with a single global
+ * reduction, and a second pass is only done if the first one removed most of
+ * the vector, i.e., if cancellation may have spoiled orthogonality. This
+ * needs one or two reductions per iteration independent of $k$, and the
+ * resulting basis is orthogonal to machine precision like the one of
+ * modified Gram-Schmidt with re-orthogonalization.
+ *
+ *
  * @author Wolfgang Bangerth, Guido Kanschat, Ralf Hartmann.
  */
 template <class VectorType = Vector<double>>
@@ -183,16 +202,38 @@ public:
    */
   struct AdditionalData
   {
+    /**
+     * Algorithms to orthogonalize a new vector against the Arnoldi basis.
+     * See the documentation of the SolverGMRES class for details.
+     */
+    enum OrthogonalizationStrategy
+    {
+      /**
+       * Modified Gram-Schmidt, with one inner product and one global
+       * reduction per basis vector.
+       */
+      modified_gram_schmidt,
+      /**
+       * Classical Gram-Schmidt with selective re-orthogonalization (CGS2),
+       * with one global reduction per orthogonalization pass.
+       */
+      classical_gram_schmidt
+    };
+
     /**
      * Constructor. By default, set the number of temporary vectors to 30,
      * i.e. do a restart every 28 iterations. Also set preconditioning from
      * left, the residual of the stopping criterion to the default residual,
-     * and re-orthogonalization only if necessary.
+     * re-orthogonalization only if necessary, and orthogonalization by the
+     * modified Gram-Schmidt algorithm.
      */
-    explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
-                            const bool         right_preconditioning = false,
-                            const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+    explicit AdditionalData(
+      const unsigned int              max_n_tmp_vectors          = 30,
+      const bool                      right_preconditioning      = false,
+      const bool                      use_default_residual       = true,
+      const bool                      force_re_orthogonalization = false,
+      const OrthogonalizationStrategy orthogonalization_strategy =
+        modified_gram_schmidt);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -223,6 +264,11 @@ public:
      * if necessary.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * Algorithm used to orthogonalize the Arnoldi basis.
+     */
+    OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -411,6 +457,28 @@ protected:
     const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
       boost::signals2::signal<void(int)>());
 
+  /**
+   * Same as modified_gram_schmidt(), but using the classical Gram-Schmidt
+   * algorithm with selective re-orthogonalization. The inner products of @p
+   * vv with all @p dim vectors and the norm of @p vv are computed together,
+   * with a single global reduction. A second orthogonalization pass is done
+   * if the norm of @p vv dropped below $1/\sqrt{2}$ of its initial value in
+   * the first pass, or in every step once @p re_orthogonalize is set. The
+   * flag is set, and the signal called, under the same conditions as in
+   * modified_gram_schmidt().
+   */
+  static double
+  classical_gram_schmidt(
+    const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+      &                                       orthogonal_vectors,
+    const unsigned int                        dim,
+    const unsigned int                        accumulated_iterations,
+    VectorType &                              vv,
+    Vector<double> &                          h,
+    bool &                                    re_orthogonalize,
+    const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
+      boost::signals2::signal<void(int)>());
+
   /**
    * Estimates the eigenvalues from the Hessenberg matrix, H_orig, generated
    * during the inner iterations. Uses these estimate to compute the condition
@@ -605,14 +673,16 @@ namespace internal
 
 template <class VectorType>
 inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
-  const unsigned int max_n_tmp_vectors,
-  const bool         right_preconditioning,
-  const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const unsigned int              max_n_tmp_vectors,
+  const bool                      right_preconditioning,
+  const bool                      use_default_residual,
+  const bool                      force_re_orthogonalization,
+  const OrthogonalizationStrategy orthogonalization_strategy)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , orthogonalization_strategy(orthogonalization_strategy)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
@@ -741,6 +811,81 @@ SolverGMRES<VectorType>::modified_gram_schmidt(
 
 
 
+template <class VectorType>
+inline double
+SolverGMRES<VectorType>::classical_gram_schmidt(
+  const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+    &                                       orthogonal_vectors,
+  const unsigned int                        dim,
+  const unsigned int                        accumulated_iterations,
+  VectorType &                              vv,
+  Vector<double> &                          h,
+  bool &                                    reorthogonalize,
+  const boost::signals2::signal<void(int)> &reorthogonalize_signal)
+{
+  Assert(dim > 0, ExcInternalError());
+  using Number                       = typename VectorType::value_type;
+  const unsigned int inner_iteration = dim - 1;
+
+  // Each pass computes the products of vv with the basis vectors and with
+  // itself in one sweep and one global reduction, then subtracts the
+  // projection in a second sweep. The norm of the result follows from
+  // Pythagoras, which is accurate as long as not most of vv was removed;
+  // otherwise, the next pass is done anyway and computes the norm afresh.
+  std::vector<const VectorType *> left(dim + 1);
+  for (unsigned int i = 0; i < dim; ++i)
+    left[i] = &orthogonal_vectors[i];
+  left[dim] = &vv;
+  const std::vector<const VectorType *> right(1, &vv);
+  std::vector<const VectorType *>       vectors(dim + 1);
+  vectors[0] = &vv;
+  for (unsigned int i = 0; i < dim; ++i)
+    vectors[i + 1] = &orthogonal_vectors[i];
+
+  std::vector<Number> dots;
+  std::vector<Number> coefficients(dim + 1);
+  coefficients[0] = Number(1.);
+
+  const auto orthogonalize = [&](const bool first_pass) {
+    internal::MultiVectorOperations::multi_dot(left, right, dots);
+    double norm_square = dots[dim];
+    for (unsigned int i = 0; i < dim; ++i)
+      {
+        if (first_pass)
+          h(i) = dots[i];
+        else
+          h(i) += dots[i];
+        coefficients[i + 1] = -dots[i];
+        norm_square -= static_cast<double>(dots[i]) * dots[i];
+      }
+    internal::MultiVectorOperations::multi_add(vv, vectors, coefficients);
+    return std::make_pair(std::sqrt(static_cast<double>(dots[dim])),
+                          std::sqrt(std::max(norm_square, 0.)));
+  };
+
+  const std::pair<double, double> norms         = orthogonalize(true);
+  const double                    norm_vv_start = norms.first;
+  double                          norm_vv       = norms.second;
+
+  // Re-orthogonalization if loss of orthogonality detected, using the same
+  // test as in modified_gram_schmidt().
+  if ((reorthogonalize == false) && (inner_iteration % 5 == 4) &&
+      !(norm_vv > 10. * norm_vv_start *
+                    std::sqrt(std::numeric_limits<Number>::epsilon())))
+    {
+      reorthogonalize = true;
+      if (!reorthogonalize_signal.empty())
+        reorthogonalize_signal(accumulated_iterations);
+    }
+
+  if (reorthogonalize == true || norm_vv < norm_vv_start * std::sqrt(0.5))
+    norm_vv = orthogonalize(false).second;
+
+  return norm_vv;
+}
+
+
+
 template <class VectorType>
 inline void
 SolverGMRES<VectorType>::compute_eigs_and_cond(
@@ -959,13 +1104,23 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           dim = inner_iteration + 1;
 
-          const double s         = modified_gram_schmidt(tmp_vectors,
-                                                 dim,
-                                                 accumulated_iterations,
-                                                 vv,
-                                                 h,
-                                                 re_orthogonalize,
-                                                 re_orthogonalize_signal);
+          const double s =
+            (additional_data.orthogonalization_strategy ==
+                 AdditionalData::classical_gram_schmidt ?
+               classical_gram_schmidt(tmp_vectors,
+                                      dim,
+                                      accumulated_iterations,
+                                      vv,
+                                      h,
+                                      re_orthogonalize,
+                                      re_orthogonalize_signal) :
+               modified_gram_schmidt(tmp_vectors,
+                                     dim,
+                                     accumulated_iterations,
+                                     vv,
+                                     h,
+                                     re_orthogonalize,
+                                     re_orthogonalize_signal));
           h(inner_iteration + 1) = s;
 
           // s=0 is a lucky breakdown, the solver will reach convergence,
@@ -0,0 +1,517 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_direct_cholesky_h
+#define dealii_sparse_direct_cholesky_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A sparse direct solver for symmetric matrices that computes either a
+ * Cholesky factorization $A = P^T U^T U P$ of a symmetric positive definite
+ * matrix, or a factorization $A = P^T U^T D U P$ with a unit upper triangular
+ * matrix $U$ and a diagonal matrix $D$ of a symmetric matrix whose leading
+ * principal minors are all nonzero (for example a symmetric quasi-definite
+ * matrix as it results from a stabilized saddle point problem). In contrast
+ * to SparseDirectUMFPACK, which computes an LU factorization of a general
+ * matrix, this class exploits the symmetry of the matrix: It only needs to
+ * store one triangular factor, and it requires about half the number of
+ * operations.
+ *
+ * The solver is implemented without external dependencies beyond BLAS and
+ * LAPACK, and works in three stages:
+ * <ol>
+ * <li> The <i>symbolic factorization</i>, computed by analyze(), only
+ * depends on the sparsity pattern of the matrix. It first computes a fill
+ * reducing permutation $P$ of the rows and columns of the matrix, by default
+ * using a nested dissection ordering as computed by
+ * SparsityTools::reorder_nested_dissection(). It then determines the
+ * elimination tree and the sparsity pattern of the factor $U$, and groups
+ * consecutive columns of $U$ with the same sparsity pattern into
+ * <i>supernodes</i>. Supernodes that differ only slightly are merged
+ * (relaxed amalgamation), at the price of storing a few explicit zeros. The
+ * factor is stored as one dense block per supernode.
+ * <li> The <i>numeric factorization</i>, computed by factorize(), uses the
+ * multifrontal method: For each supernode, a dense frontal matrix is
+ * assembled from the entries of the matrix and the update matrices of the
+ * child supernodes, the columns of the supernode are eliminated with dense
+ * blocked kernels (calling BLAS for the bulk of the work), and the remaining
+ * Schur complement is passed on as update matrix to the parent supernode.
+ * Since the subtrees of the elimination tree are independent of each other,
+ * they are processed as concurrent tasks if deal.II was configured with
+ * threads. The nested dissection ordering produces a well balanced tree with
+ * large independent subtrees for this purpose.
+ * <li> The triangular solves in solve() traverse the tree of supernodes
+ * twice, again processing independent subtrees concurrently. All right hand
+ * sides passed to a single call of solve() are treated together with matrix
+ * matrix products, so solving for many right hand sides at once is
+ * considerably faster than solving for them one after the other.
+ * </ol>
+ *
+ * The symbolic factorization is kept when factorize() is called again for a
+ * matrix that uses the same sparsity pattern, as is typical for Newton
+ * iterations and time stepping schemes with changing coefficients. To this
+ * end, analyze() stores a copy of the row lengths and column indices of the
+ * sparsity pattern, and factorize() compares the pattern of the matrix
+ * against this copy. The symbolic factorization is recomputed automatically
+ * if the structure differs, including the case of a SparsityPattern object
+ * that was reinitialized in place with the same number of entries.
+ *
+ * Only the entries $a_{ij}$ of the matrix with $i\le j$ in the permuted
+ * numbering are read, i.e., the matrix is assumed to be symmetric, and its
+ * sparsity pattern has to be structurally symmetric (as all sparsity
+ * patterns generated from finite element discretizations of symmetric
+ * problems are).
+ *
+ * This class implements the usual interface of preconditioners, i.e., the
+ * functions initialize() and vmult() that applies the inverse of the matrix,
+ * so that objects of this class can be used with LinearOperator and
+ * inverse_operator(), or as a preconditioner.
+ *
+ * @code
+ *   SparseDirectCholesky solver;
+ *   solver.analyze(sparsity_pattern);
+ *
+ *   for (unsigned int step = 0; step < n_steps; ++step)
+ *     {
+ *       assemble_system(system_matrix, system_rhs);
+ *       solver.factorize(system_matrix);
+ *       solver.solve(system_rhs);
+ *       ...
+ *     }
+ * @endcode
+ *
+ * <h4>Instantiations</h4>
+ *
+ * There are instantiations of the member function templates of this class
+ * for SparseMatrix<double> and SparseMatrix<float>. The factorization is
+ * always computed and stored in double precision.
+ *
+ * @ingroup Solvers Preconditioners
+ */
+class SparseDirectCholesky : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * The kinds of factorization this class can compute.
+   */
+  enum class Factorization
+  {
+    /**
+     * Compute the Cholesky factorization $A = U^T U$ of a symmetric positive
+     * definite matrix.
+     */
+    cholesky,
+    /**
+     * Compute the factorization $A = U^T D U$ with a unit upper triangular
+     * matrix $U$ and a diagonal matrix $D$ whose entries may have either
+     * sign. No pivoting is done, so the factorization exists only if all
+     * leading principal minors of the permuted matrix are nonzero, as is the
+     * case for symmetric positive or negative definite and symmetric
+     * quasi-definite matrices.
+     */
+    ldlt
+  };
+
+  /**
+   * The fill reducing orderings this class can apply to the matrix before
+   * factorizing it.
+   */
+  enum class Ordering
+  {
+    /**
+     * Use the nested dissection ordering computed by
+     * SparsityTools::reorder_nested_dissection().
+     */
+    nested_dissection,
+    /**
+     * Factorize the matrix in the numbering given, for example if the
+     * degrees of freedom have already been renumbered suitably.
+     */
+    natural
+  };
+
+  /**
+   * Parameters of the factorization.
+   */
+  class AdditionalData
+  {
+  public:
+    /**
+     * Constructor. Set the kind of factorization and the ordering.
+     */
+    AdditionalData(
+      const Factorization factorization = Factorization::cholesky,
+      const Ordering      ordering      = Ordering::nested_dissection);
+
+    /**
+     * The kind of factorization to compute.
+     */
+    Factorization factorization;
+
+    /**
+     * The ordering used for the symbolic factorization.
+     */
+    Ordering ordering;
+  };
+
+  /**
+   * Constructor.
+   */
+  SparseDirectCholesky(
+    const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * @name Setting up a sparse factorization
+   */
+  /**
+   * @{
+   */
+
+  /**
+   * Compute the symbolic factorization for matrices with the sparsity
+   * pattern @p sparsity_pattern, see the general documentation of this
+   * class. This function only needs to be called explicitly if the symbolic
+   * factorization should be computed ahead of the first call to
+   * factorize().
+   */
+  void
+  analyze(const SparsityPattern &sparsity_pattern);
+
+  /**
+   * Compute the numeric factorization of @p matrix. If the symbolic
+   * factorization has not been computed yet or was computed for a sparsity
+   * pattern with a different structure, analyze() is called first.
+   *
+   * If the matrix is not positive definite in case of a Cholesky
+   * factorization, or a zero pivot is encountered in case of an $LDL^T$
+   * factorization, an exception is thrown.
+   */
+  template <typename number>
+  void
+  factorize(const SparseMatrix<number> &matrix);
+
+  /**
+   * Set the parameters of the factorization to @p additional_data and call
+   * factorize(). This function provides the interface common to
+   * preconditioners.
+   */
+  template <typename number>
+  void
+  initialize(const SparseMatrix<number> &matrix,
+             const AdditionalData &      additional_data = AdditionalData());
+
+  /**
+   * Free the memory of the numeric and the symbolic factorization.
+   */
+  void
+  clear();
+
+  /**
+   * @}
+   */
+
+  /**
+   * @name Functions that represent the inverse of a matrix
+   */
+  /**
+   * @{
+   */
+
+  /**
+   * Apply the inverse of the factorized matrix to @p src and store the
+   * result in @p dst.
+   */
+  void
+  vmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Same as vmult(), since the matrix is symmetric.
+   */
+  void
+  Tvmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Return the dimension of the codomain (or range) space. Note that the
+   * matrix is square, so this is the same as n().
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space. Note that the matrix is
+   * square, so this is the same as m().
+   */
+  size_type
+  n() const;
+
+  /**
+   * @}
+   */
+
+  /**
+   * @name Functions that solve linear systems
+   */
+  /**
+   * @{
+   */
+
+  /**
+   * Solve for a single right hand side. The right hand side is passed in
+   * @p rhs_and_solution and is overwritten by the solution.
+   *
+   * @pre You need to call factorize() before this function can be called.
+   */
+  void
+  solve(Vector<double> &rhs_and_solution) const;
+
+  /**
+   * Solve for several right hand sides at once. Each column of
+   * @p rhs_and_solution is one right hand side, and is overwritten by the
+   * corresponding solution.
+   *
+   * @pre You need to call factorize() before this function can be called.
+   */
+  void
+  solve(FullMatrix<double> &rhs_and_solution) const;
+
+  /**
+   * Same as above, but for right hand sides given as a vector of vectors.
+   */
+  void
+  solve(std::vector<Vector<double>> &rhs_and_solution) const;
+
+  /**
+   * @}
+   */
+
+  /**
+   * Return the number of entries stored in the factor, including the
+   * explicit zeros introduced by the merging of supernodes.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of supernodes of the symbolic factorization.
+   */
+  unsigned int
+  n_supernodes() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * @addtogroup Exceptions
+   * @{
+   */
+
+  /**
+   * Exception.
+   */
+  DeclException1(
+    ExcNotPositiveDefinite,
+    size_type,
+    << "The Cholesky factorization broke down at the pivot belonging to "
+    << "row " << arg1 << " of the matrix, which means that the matrix "
+    << "is not positive definite (or is not symmetric). If the matrix "
+    << "is symmetric but indefinite, consider using the LDL^T "
+    << "factorization instead.");
+
+  /**
+   * Exception.
+   */
+  DeclException1(ExcZeroPivot,
+                 size_type,
+                 << "The LDL^T factorization encountered a zero pivot at the "
+                 << "row " << arg1 << " of the matrix. The matrix is singular, "
+                 << "or it cannot be factorized without pivoting.");
+
+  //@}
+
+private:
+  /**
+   * Traverse the tree of supernodes from the leaves to the root, calling
+   * @p worker for a supernode after it has been called for all of its
+   * children. Independent subtrees are processed as concurrent tasks.
+   */
+  template <typename Worker>
+  void
+  traverse_bottom_up(const unsigned int supernode, const Worker &worker) const;
+
+  /**
+   * Traverse the tree of supernodes from the root to the leaves, calling
+   * @p worker for a supernode before it is called for any of its children.
+   */
+  template <typename Worker>
+  void
+  traverse_top_down(const unsigned int supernode, const Worker &worker) const;
+
+  /**
+   * Return whether the symbolic factorization was computed with the current
+   * ordering for a sparsity pattern with the same structure as
+   * @p sparsity_pattern.
+   */
+  bool
+  analysis_matches(const SparsityPattern &sparsity_pattern) const;
+
+  /**
+   * Solve for the @p n_rhs right hand sides stored column by column in
+   * @p values, which use the permuted numbering.
+   */
+  void
+  solve_permuted(std::vector<double> &values, const unsigned int n_rhs) const;
+
+  /**
+   * The parameters of the factorization.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The size of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * A copy of the structure of the sparsity pattern the symbolic
+   * factorization was computed for, in compressed row storage: the column
+   * indices of row <code>i</code> are stored in the entries
+   * <code>analyzed_row_start[i]</code> to
+   * <code>analyzed_row_start[i+1]</code> of analyzed_column_indices. Only
+   * used to detect whether analyze() needs to be called again.
+   */
+  std::vector<std::size_t> analyzed_row_start;
+  std::vector<size_type>   analyzed_column_indices;
+
+  /**
+   * The ordering the symbolic factorization was computed with.
+   */
+  Ordering analyzed_ordering;
+
+  /**
+   * The permutation of the matrix: <code>permutation[i]</code> is the
+   * original index of the row and column that is eliminated as the
+   * <code>i</code>th one.
+   */
+  std::vector<size_type> permutation;
+
+  /**
+   * The first column of each supernode in the permuted numbering, with an
+   * additional entry for the end of the last supernode.
+   */
+  std::vector<size_type> supernode_start;
+
+  /**
+   * The parent of each supernode in the tree of supernodes, or
+   * numbers::invalid_unsigned_int for the roots. Supernodes are numbered in
+   * a postorder of this tree.
+   */
+  std::vector<unsigned int> supernode_parent;
+
+  /**
+   * The children of each supernode in compressed row storage. The children
+   * of the roots are stored as children of an additional supernode with
+   * number n_supernodes().
+   */
+  std::vector<unsigned int> child_start;
+  std::vector<unsigned int> children;
+
+  /**
+   * The first supernode of the subtree rooted at each supernode. Due to the
+   * postorder, the subtree of supernode <code>s</code> consists of the
+   * supernodes from <code>first_descendant[s]</code> to <code>s</code>.
+   */
+  std::vector<unsigned int> first_descendant;
+
+  /**
+   * An estimate of the number of floating point operations for the
+   * factorization of the subtree rooted at each supernode, used to decide
+   * which subtrees are worth a task of their own.
+   */
+  std::vector<double> subtree_work;
+
+  /**
+   * The rows of the factor below the diagonal block of each supernode, in
+   * the permuted numbering and sorted, stored in compressed row storage.
+   */
+  std::vector<std::size_t> row_start;
+  std::vector<size_type>   rows;
+
+  /**
+   * For each row in #rows, its position in the frontal matrix of the
+   * parent supernode.
+   */
+  std::vector<unsigned int> parent_positions;
+
+  /**
+   * For each entry of the sparsity pattern, in the order of the rows of
+   * the permuted matrix that belong to the columns of each supernode, the
+   * position in the frontal matrix of the supernode the entry is assembled
+   * into, or an invalid value if the entry is in the lower triangle and is
+   * skipped. The entries of supernode <code>s</code> start
+   * at <code>assembly_start[s]</code>.
+   */
+  std::vector<std::size_t> assembly_start;
+  std::vector<std::size_t> assembly_positions;
+
+  /**
+   * The offsets of the dense blocks of the supernodes in #factor_values.
+   */
+  std::vector<std::size_t> factor_start;
+
+  /**
+   * The numeric factorization. The block of supernode <code>s</code> with
+   * <code>nc</code> columns and <code>nr</code> rows below the diagonal
+   * block holds the rows of $U$ belonging to the supernode as a column
+   * major <code>nc</code> by <code>nc+nr</code> matrix.
+   */
+  std::vector<double> factor_values;
+
+  /**
+   * The diagonal matrix $D$ of an $LDL^T$ factorization, in the permuted
+   * numbering.
+   */
+  std::vector<double> diagonal;
+
+  /**
+   * Whether factor_values holds a valid numeric factorization.
+   */
+  bool is_factorized;
+};
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // dealii_sparse_direct_cholesky_h
@@ -242,6 +242,50 @@ namespace SparsityTools
     const DynamicSparsityPattern &                  sparsity,
     std::vector<DynamicSparsityPattern::size_type> &new_indices);
 
+  /**
+   * For a given sparsity pattern, compute a re-enumeration of row/column
+   * indices that reduces the fill-in of a sparse Cholesky or $LDL^T$
+   * factorization of a symmetric matrix with this sparsity pattern, using
+   * the nested dissection algorithm.
+   *
+   * Nested dissection views the sparsity pattern as a graph, finds a small
+   * set of nodes (a separator) whose removal splits the graph into two parts
+   * of similar size, numbers the nodes of the two parts first and the
+   * separator last, and then applies the same procedure recursively to the
+   * two parts. In a factorization, the two parts can then be eliminated
+   * independently of each other, and the fill-in is confined to the blocks
+   * that couple each part with its separator.
+   *
+   * If deal.II was configured with METIS, this function calls METIS'
+   * implementation of the algorithm (<code>METIS_NodeND</code>). Otherwise,
+   * a simpler implementation is used that takes the middle level of a
+   * breadth-first search from a pseudo-peripheral node as separator, and
+   * that stops the recursion for parts with no more than 64 nodes.
+   *
+   * The sparsity pattern does not need to be symmetric; the graph used is
+   * that of the symmetrized pattern, and entries on the diagonal are
+   * ignored. Unconnected components of the graph are numbered one after the
+   * other.
+   *
+   * As for the other functions in this namespace, the array @p new_indices
+   * must have the size of the number of rows of the sparsity pattern, and
+   * <code>new_indices[i]</code> is the new number of index <code>i</code>
+   * upon return.
+   */
+  void
+  reorder_nested_dissection(
+    const SparsityPattern &                  sparsity,
+    std::vector<SparsityPattern::size_type> &new_indices);
+
+  /**
+   * Same as above, but for a DynamicSparsityPattern, which has to store all
+   * of its rows.
+   */
+  void
+  reorder_nested_dissection(
+    const DynamicSparsityPattern &                  sparsity,
+    std::vector<DynamicSparsityPattern::size_type> &new_indices);
+
 #ifdef DEAL_II_WITH_MPI
   /**
    * Communicate rows in a dynamic sparsity pattern over MPI.
@@ -20,12 +20,15 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/lapack_full_matrix.h>
 
 #include <deal.II/matrix_free/tensor_product_kernels.h>
 
+#include <map>
+
 DEAL_II_NAMESPACE_OPEN
 
 // Forward declarations
@@ -34,6 +37,15 @@ template <typename>
 class Vector;
 template <typename>
 class FullMatrix;
+
+namespace internal
+{
+  namespace TensorProductMatrix
+  {
+    template <typename Number>
+    struct MatrixPairComparator;
+  }
+} // namespace internal
 #endif
 
 /**
@@ -109,6 +121,13 @@ public:
    * described in the main documentation of TensorProductMatrixSymmetricSum.
    * This function is operating on ArrayView to allow checks of
    * array bounds with respect to @p dst and @p src.
+   *
+   * The size of the vectors may also be a multiple of m(). In that case,
+   * the vectors are interpreted as the components of a vector-valued
+   * problem, like the vector Laplacian, stored one after the other, and the
+   * matrix is applied to each component. This corresponds to a
+   * block-diagonal system with the same tensor product matrix on each
+   * diagonal block.
    */
   void
   vmult(const ArrayView<Number> &dst, const ArrayView<const Number> &src) const;
@@ -118,6 +137,9 @@ public:
    * described in the main documentation of TensorProductMatrixSymmetricSum.
    * This function is operating on ArrayView to allow checks of
    * array bounds with respect to @p dst and @p src.
+   *
+   * Like for vmult(), the size of the vectors may be a multiple of m(), in
+   * which case the inverse is applied to each component separately.
    */
   void
   apply_inverse(const ArrayView<Number> &      dst,
@@ -212,6 +234,11 @@ private:
  *
  * This class requires LAPACK support.
  *
+ * If the inverses of many such matrices are needed, e.g., one per cell in a
+ * fast diagonalization smoother, the class
+ * TensorProductMatrixSymmetricSumCollection avoids storing and decomposing
+ * the same 1D matrices for cells of the same shape.
+ *
  * Note that this class allows for two modes of usage. The first is a use case
  * with run time constants for the matrix dimensions that is achieved by
  * setting the optional template parameter <tt>n_rows_1d</tt> to -1. The second
@@ -405,6 +432,196 @@ private:
 };
 
 
+/**
+ * A collection of the inverses of tensor product matrices of the form
+ * represented by TensorProductMatrixSymmetricSum for many cells (or cell
+ * batches in case of VectorizedArray), as needed by fast diagonalization
+ * smoothers and element-wise inverse preconditioners.
+ *
+ * On typical meshes, most cells have the same 1D matrices up to a small
+ * number of geometry classes, e.g., all cells of a uniformly refined
+ * Cartesian mesh. Rather than storing the 1D matrices and computing the
+ * generalized eigendecomposition for every cell, this class identifies
+ * equal pairs of 1D mass and derivative matrices and computes and stores
+ * the eigendecomposition only once for each of them. For VectorizedArray
+ * types, the comparison is done for all lanes at once, i.e., cell batches
+ * with the same cell shapes in all lanes share the data, and the different
+ * shapes in the lanes of a batch are represented by different 1D matrices
+ * per lane. The matrices are compared exactly, so they should be computed
+ * in the same way for cells of the same shape.
+ *
+ * The class is set up by calling reserve() with the number of cells, then
+ * insert() for each cell, and finally finalize(), which computes the
+ * eigendecompositions. insert() must not be called concurrently from
+ * several threads. After finalize(), the functions vmult() and
+ * apply_inverse() can be called concurrently. Like the functions of
+ * TensorProductMatrixSymmetricSumBase, they accept vectors of several
+ * components stored one after the other, which allows for block-diagonal
+ * systems like the vector Laplacian. Block systems where the components use
+ * different matrices can be represented by inserting one entry per cell and
+ * component.
+ *
+ * @tparam dim Dimension of the problem.
+ *
+ * @tparam Number Arithmetic type of the underlying array elements, either
+ * float or double or the respective VectorizedArray types.
+ *
+ * @tparam n_rows_1d Compile-time number of rows of 1D matrices, or -1 to
+ * determine the size at run time.
+ */
+template <int dim, typename Number, int n_rows_1d = -1>
+class TensorProductMatrixSymmetricSumCollection
+{
+public:
+  /**
+   * Type of matrix entries.
+   */
+  using value_type = Number;
+
+  /**
+   * Collects the options of this class.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const bool compress_matrices = true);
+
+    /**
+     * If true, equal pairs of 1D matrices are stored and decomposed only
+     * once. If false, the data is stored separately for each entry.
+     */
+    bool compress_matrices;
+  };
+
+  /**
+   * Constructor.
+   */
+  TensorProductMatrixSymmetricSumCollection(
+    const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Clear the object and set the number of entries to @p n_entries.
+   */
+  void
+  reserve(const unsigned int n_entries);
+
+  /**
+   * Set the 1D mass and derivative matrices of entry @p index, with the
+   * same requirements as in TensorProductMatrixSymmetricSum::reinit().
+   */
+  void
+  insert(const unsigned int                       index,
+         const std::array<Table<2, Number>, dim> &mass_matrices,
+         const std::array<Table<2, Number>, dim> &derivative_matrices);
+
+  /**
+   * Compute the generalized eigendecompositions of all distinct pairs of 1D
+   * matrices inserted so far.
+   */
+  void
+  finalize();
+
+  /**
+   * Apply the tensor product matrix of entry @p index to @p src.
+   */
+  void
+  vmult(const unsigned int             index,
+        const ArrayView<Number> &      dst,
+        const ArrayView<const Number> &src) const;
+
+  /**
+   * Apply the inverse of the tensor product matrix of entry @p index to @p
+   * src by the fast diagonalization method.
+   */
+  void
+  apply_inverse(const unsigned int             index,
+                const ArrayView<Number> &      dst,
+                const ArrayView<const Number> &src) const;
+
+  /**
+   * Return the number of rows of the tensor product matrix of entry @p
+   * index.
+   */
+  unsigned int
+  m(const unsigned int index) const;
+
+  /**
+   * Return the number of entries.
+   */
+  std::size_t
+  size() const;
+
+  /**
+   * Return the number of distinct pairs of 1D matrices stored, which is at
+   * most dim times size().
+   */
+  std::size_t
+  storage_size() const;
+
+  /**
+   * Return the memory consumption of this object in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Return the index of the stored pair of 1D matrices equal to the given
+   * one, adding it if it is new.
+   */
+  unsigned int
+  find_or_add(const Table<2, Number> &mass_matrix,
+              const Table<2, Number> &derivative_matrix);
+
+  /**
+   * The options of this class.
+   */
+  const AdditionalData additional_data;
+
+  /**
+   * For each entry and direction, the index into the arrays of 1D data
+   * below.
+   */
+  std::vector<std::array<unsigned int, dim>> indices;
+
+  /**
+   * Map from the pairs of 1D matrices to their index in the arrays below,
+   * used during setup and cleared by finalize().
+   */
+  std::map<std::pair<Table<2, Number>, Table<2, Number>>,
+           unsigned int,
+           internal::TensorProductMatrix::MatrixPairComparator<Number>>
+    cache;
+
+  /**
+   * The distinct 1D mass matrices.
+   */
+  std::vector<Table<2, Number>> mass_matrices;
+
+  /**
+   * The distinct 1D derivative matrices.
+   */
+  std::vector<Table<2, Number>> derivative_matrices;
+
+  /**
+   * The generalized eigenvalues of the distinct pairs of 1D matrices.
+   */
+  std::vector<AlignedVector<Number>> eigenvalues;
+
+  /**
+   * The generalized eigenvectors of the distinct pairs of 1D matrices.
+   */
+  std::vector<Table<2, Number>> eigenvectors;
+
+  /**
+   * Temporary arrays for vmult() and apply_inverse(), one per thread.
+   */
+  mutable Threads::ThreadLocalStorage<AlignedVector<Number>> tmp_array;
+};
+
+
 /*----------------------- Inline functions ----------------------------------*/
 
 #ifndef DOXYGEN
@@ -458,6 +675,427 @@ namespace internal
       for (unsigned int i = 0; i < n_rows; ++i, ++eigenvalues)
         *eigenvalues = deriv_copy.eigenvalue(i).real();
     }
+
+
+
+    /**
+     * Compute the generalized eigenvalues and eigenvectors of the 1D
+     * matrices @p mass_matrix and @p derivative_matrix.
+     */
+    template <typename Number>
+    inline void
+    setup_eigendecomposition(const Table<2, Number> &mass_matrix,
+                             const Table<2, Number> &derivative_matrix,
+                             AlignedVector<Number> & eigenvalues,
+                             Table<2, Number> &      eigenvectors)
+    {
+      const unsigned int n_rows = mass_matrix.n_rows();
+      const unsigned int n_cols = mass_matrix.n_cols();
+      eigenvectors.reinit(n_cols, n_rows);
+      eigenvalues.resize(n_cols);
+      spectral_assembly<Number>(&mass_matrix(0, 0),
+                                &derivative_matrix(0, 0),
+                                n_rows,
+                                n_cols,
+                                eigenvalues.begin(),
+                                &eigenvectors(0, 0));
+    }
+
+
+
+    /**
+     * Same as above for vectorized matrices, where the eigenvalue problem is
+     * solved separately for each lane. Lanes that hold the same matrices as
+     * a previous lane, like cells of the same shape, reuse the result of
+     * that lane.
+     */
+    template <typename Number>
+    inline void
+    setup_eigendecomposition(
+      const Table<2, VectorizedArray<Number>> &mass_matrix,
+      const Table<2, VectorizedArray<Number>> &derivative_matrix,
+      AlignedVector<VectorizedArray<Number>> & eigenvalues,
+      Table<2, VectorizedArray<Number>> &      eigenvectors)
+    {
+      constexpr unsigned int macro_size = VectorizedArray<Number>::size();
+      const unsigned int     n_rows     = mass_matrix.n_rows();
+      const unsigned int     n_cols     = mass_matrix.n_cols();
+      const unsigned int     nm         = n_rows * n_cols;
+
+      std::vector<Number> mass_matrix_flat(nm * macro_size);
+      std::vector<Number> deriv_matrix_flat(nm * macro_size);
+      std::vector<Number> eigenvalues_flat(n_rows * macro_size);
+      std::vector<Number> eigenvectors_flat(nm * macro_size);
+      std::array<unsigned int, macro_size> offsets_nm;
+      std::array<unsigned int, macro_size> offsets_n;
+      for (unsigned int vv = 0; vv < macro_size; ++vv)
+        {
+          offsets_nm[vv] = nm * vv;
+          offsets_n[vv]  = n_rows * vv;
+        }
+
+      vectorized_transpose_and_store(false,
+                                     nm,
+                                     &(mass_matrix(0, 0)),
+                                     offsets_nm.cbegin(),
+                                     mass_matrix_flat.data());
+      vectorized_transpose_and_store(false,
+                                     nm,
+                                     &(derivative_matrix(0, 0)),
+                                     offsets_nm.cbegin(),
+                                     deriv_matrix_flat.data());
+
+      for (unsigned int lane = 0; lane < macro_size; ++lane)
+        {
+          const Number *mass  = mass_matrix_flat.data() + nm * lane;
+          const Number *deriv = deriv_matrix_flat.data() + nm * lane;
+
+          unsigned int same_lane = lane;
+          for (unsigned int other = 0; other < lane; ++other)
+            if (std::equal(mass, mass + nm, &mass_matrix_flat[nm * other]) &&
+                std::equal(deriv, deriv + nm, &deriv_matrix_flat[nm * other]))
+              {
+                same_lane = other;
+                break;
+              }
+
+          if (same_lane < lane)
+            {
+              std::copy_n(&eigenvalues_flat[n_rows * same_lane],
+                          n_rows,
+                          &eigenvalues_flat[n_rows * lane]);
+              std::copy_n(&eigenvectors_flat[nm * same_lane],
+                          nm,
+                          &eigenvectors_flat[nm * lane]);
+            }
+          else
+            spectral_assembly<Number>(mass,
+                                      deriv,
+                                      n_rows,
+                                      n_cols,
+                                      &eigenvalues_flat[n_rows * lane],
+                                      &eigenvectors_flat[nm * lane]);
+        }
+
+      eigenvalues.resize(n_rows);
+      eigenvectors.reinit(n_rows, n_cols);
+      vectorized_load_and_transpose(n_rows,
+                                    eigenvalues_flat.data(),
+                                    offsets_n.cbegin(),
+                                    eigenvalues.begin());
+      vectorized_load_and_transpose(nm,
+                                    eigenvectors_flat.data(),
+                                    offsets_nm.cbegin(),
+                                    &(eigenvectors(0, 0)));
+    }
+
+
+
+    /**
+     * Return whether the entries @p a and @p b are exactly equal.
+     */
+    template <typename Number>
+    inline bool
+    entries_equal(const Number &a, const Number &b)
+    {
+      return a == b;
+    }
+
+
+
+    template <typename Number>
+    inline bool
+    entries_equal(const VectorizedArray<Number> &a,
+                  const VectorizedArray<Number> &b)
+    {
+      for (unsigned int v = 0; v < VectorizedArray<Number>::size(); ++v)
+        if (a[v] != b[v])
+          return false;
+      return true;
+    }
+
+
+
+    /**
+     * Return whether entry @p a is smaller than entry @p b in the
+     * lexicographic order of the vectorization lanes.
+     */
+    template <typename Number>
+    inline bool
+    entry_less(const Number &a, const Number &b)
+    {
+      return a < b;
+    }
+
+
+
+    template <typename Number>
+    inline bool
+    entry_less(const VectorizedArray<Number> &a,
+               const VectorizedArray<Number> &b)
+    {
+      for (unsigned int v = 0; v < VectorizedArray<Number>::size(); ++v)
+        if (a[v] != b[v])
+          return a[v] < b[v];
+      return false;
+    }
+
+
+
+    /**
+     * Return whether the matrices @p a and @p b have the same size and
+     * exactly the same entries.
+     */
+    template <typename Number>
+    inline bool
+    matrices_equal(const Table<2, Number> &a, const Table<2, Number> &b)
+    {
+      if (a.n_rows() != b.n_rows() || a.n_cols() != b.n_cols())
+        return false;
+      for (unsigned int i = 0; i < a.n_rows(); ++i)
+        for (unsigned int j = 0; j < a.n_cols(); ++j)
+          if (!entries_equal(a(i, j), b(i, j)))
+            return false;
+      return true;
+    }
+
+
+
+    /**
+     * A strict weak ordering of pairs of mass and derivative matrices, used
+     * to identify the 1D matrices of cells of the same shape.
+     */
+    template <typename Number>
+    struct MatrixPairComparator
+    {
+      using MatrixPairType = std::pair<Table<2, Number>, Table<2, Number>>;
+
+      bool
+      operator()(const MatrixPairType &left, const MatrixPairType &right) const
+      {
+        const auto less = [](const Table<2, Number> &a,
+                             const Table<2, Number> &b) -> int {
+          if (a.n_rows() != b.n_rows())
+            return a.n_rows() < b.n_rows() ? -1 : 1;
+          if (a.n_cols() != b.n_cols())
+            return a.n_cols() < b.n_cols() ? -1 : 1;
+          for (unsigned int i = 0; i < a.n_rows(); ++i)
+            for (unsigned int j = 0; j < a.n_cols(); ++j)
+              if (entry_less(a(i, j), b(i, j)))
+                return -1;
+              else if (entry_less(b(i, j), a(i, j)))
+                return 1;
+          return 0;
+        };
+
+        const int first = less(left.first, right.first);
+        if (first != 0)
+          return first < 0;
+        return less(left.second, right.second) < 0;
+      }
+    };
+
+
+
+    /**
+     * Compute the generalized eigendecompositions of the 1D matrices in all
+     * directions. Directions with the same matrices as a previous direction
+     * reuse the result of that direction.
+     */
+    template <int n_rows_1d, int dim, typename Number>
+    inline void
+    setup_eigendecompositions(
+      const std::array<Table<2, Number>, dim> &mass_matrices,
+      const std::array<Table<2, Number>, dim> &derivative_matrices,
+      std::array<AlignedVector<Number>, dim> & eigenvalues,
+      std::array<Table<2, Number>, dim> &      eigenvectors)
+    {
+      for (int dir = 0; dir < dim; ++dir)
+        {
+          Assert(n_rows_1d == -1 ||
+                   (n_rows_1d > 0 && static_cast<unsigned int>(n_rows_1d) ==
+                                       mass_matrices[dir].n_rows()),
+                 ExcDimensionMismatch(n_rows_1d, mass_matrices[dir].n_rows()));
+          AssertDimension(mass_matrices[dir].n_rows(),
+                          mass_matrices[dir].n_cols());
+          AssertDimension(mass_matrices[dir].n_rows(),
+                          derivative_matrices[dir].n_rows());
+          AssertDimension(mass_matrices[dir].n_rows(),
+                          derivative_matrices[dir].n_cols());
+          AssertDimension(mass_matrices[dir].n_rows(),
+                          mass_matrices[0].n_rows());
+
+          int same_dir = dir;
+          for (int other = 0; other < dir; ++other)
+            if (matrices_equal(mass_matrices[dir], mass_matrices[other]) &&
+                matrices_equal(derivative_matrices[dir],
+                               derivative_matrices[other]))
+              {
+                same_dir = other;
+                break;
+              }
+
+          if (same_dir < dir)
+            {
+              eigenvalues[dir]  = eigenvalues[same_dir];
+              eigenvectors[dir] = eigenvectors[same_dir];
+            }
+          else
+            setup_eigendecomposition(mass_matrices[dir],
+                                     derivative_matrices[dir],
+                                     eigenvalues[dir],
+                                     eigenvectors[dir]);
+        }
+    }
+
+
+
+    /**
+     * Apply the tensor product matrix with the 1D mass and derivative
+     * matrices of size @p n in all directions, given in row-major order, to
+     * @p src and write the result into @p dst. The array @p tmp must provide
+     * space for 2 n<sup>dim</sup> entries.
+     */
+    template <int n_rows_1d, int dim, typename Number>
+    inline void
+    vmult(const std::array<const Number *, dim> &mass_matrices,
+          const std::array<const Number *, dim> &derivative_matrices,
+          const unsigned int                     n,
+          Number *                               dst,
+          const Number *                         src,
+          Number *                               tmp)
+    {
+      const unsigned int n_dofs      = Utilities::fixed_power<dim>(n);
+      constexpr int      kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
+      internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                       dim,
+                                       kernel_size,
+                                       kernel_size,
+                                       Number>
+              eval(AlignedVector<Number>{},
+             AlignedVector<Number>{},
+             AlignedVector<Number>{},
+             n,
+             n);
+      Number *t = tmp;
+
+      if (dim == 1)
+        {
+          const Number *A = derivative_matrices[0];
+          eval.template apply<0, false, false>(A, src, dst);
+        }
+
+      else if (dim == 2)
+        {
+          const Number *A0 = derivative_matrices[0];
+          const Number *M0 = mass_matrices[0];
+          const Number *A1 = derivative_matrices[1];
+          const Number *M1 = mass_matrices[1];
+          eval.template apply<0, false, false>(M0, src, t);
+          eval.template apply<1, false, false>(A1, t, dst);
+          eval.template apply<0, false, false>(A0, src, t);
+          eval.template apply<1, false, true>(M1, t, dst);
+        }
+
+      else if (dim == 3)
+        {
+          const Number *A0 = derivative_matrices[0];
+          const Number *M0 = mass_matrices[0];
+          const Number *A1 = derivative_matrices[1];
+          const Number *M1 = mass_matrices[1];
+          const Number *A2 = derivative_matrices[2];
+          const Number *M2 = mass_matrices[2];
+          eval.template apply<0, false, false>(M0, src, t + n_dofs);
+          eval.template apply<1, false, false>(M1, t + n_dofs, t);
+          eval.template apply<2, false, false>(A2, t, dst);
+          eval.template apply<1, false, false>(A1, t + n_dofs, t);
+          eval.template apply<0, false, false>(A0, src, t + n_dofs);
+          eval.template apply<1, false, true>(M1, t + n_dofs, t);
+          eval.template apply<2, false, true>(M2, t, dst);
+        }
+
+      else
+        AssertThrow(false, ExcNotImplemented());
+    }
+
+
+
+    /**
+     * Apply the inverse of the tensor product matrix with the 1D
+     * eigenvectors and eigenvalues of size @p n in all directions to @p src
+     * and write the result into @p dst. The array @p tmp must provide space
+     * for n<sup>dim</sup> entries.
+     */
+    template <int n_rows_1d, int dim, typename Number>
+    inline void
+    apply_inverse(const std::array<const Number *, dim> &eigenvectors,
+                  const std::array<const Number *, dim> &eigenvalues,
+                  const unsigned int                     n,
+                  Number *                               dst,
+                  const Number *                         src,
+                  Number *                               tmp)
+    {
+      constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
+      internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                       dim,
+                                       kernel_size,
+                                       kernel_size,
+                                       Number>
+              eval(AlignedVector<Number>(),
+             AlignedVector<Number>(),
+             AlignedVector<Number>(),
+             n,
+             n);
+      Number *t = tmp;
+
+      // NOTE: dof_to_quad has to be interpreted as 'dof to eigenvalue index'
+      //       --> apply<.,true,.> (S,src,dst) calculates dst = S^T * src,
+      //       --> apply<.,false,.> (S,src,dst) calculates dst = S * src,
+      //       while the eigenvectors are stored column-wise in S, i.e.
+      //       rows correspond to dofs whereas columns to eigenvalue indices!
+      if (dim == 1)
+        {
+          const Number *S = eigenvectors[0];
+          eval.template apply<0, true, false>(S, src, t);
+          for (unsigned int i = 0; i < n; ++i)
+            t[i] /= eigenvalues[0][i];
+          eval.template apply<0, false, false>(S, t, dst);
+        }
+
+      else if (dim == 2)
+        {
+          const Number *S0 = eigenvectors[0];
+          const Number *S1 = eigenvectors[1];
+          eval.template apply<0, true, false>(S0, src, t);
+          eval.template apply<1, true, false>(S1, t, dst);
+          for (unsigned int i1 = 0, c = 0; i1 < n; ++i1)
+            for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
+              dst[c] /= (eigenvalues[1][i1] + eigenvalues[0][i0]);
+          eval.template apply<0, false, false>(S0, dst, t);
+          eval.template apply<1, false, false>(S1, t, dst);
+        }
+
+      else if (dim == 3)
+        {
+          const Number *S0 = eigenvectors[0];
+          const Number *S1 = eigenvectors[1];
+          const Number *S2 = eigenvectors[2];
+          eval.template apply<0, true, false>(S0, src, t);
+          eval.template apply<1, true, false>(S1, t, dst);
+          eval.template apply<2, true, false>(S2, dst, t);
+          for (unsigned int i2 = 0, c = 0; i2 < n; ++i2)
+            for (unsigned int i1 = 0; i1 < n; ++i1)
+              for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
+                t[c] /= (eigenvalues[2][i2] + eigenvalues[1][i1] +
+                         eigenvalues[0][i0]);
+          eval.template apply<0, false, false>(S0, t, dst);
+          eval.template apply<1, false, false>(S1, dst, t);
+          eval.template apply<2, false, false>(S2, t, dst);
+        }
+
+      else
+        Assert(false, ExcNotImplemented());
+    }
   } // namespace TensorProductMatrix
 } // namespace internal
 
@@ -492,64 +1130,27 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::vmult(
   const ArrayView<Number> &      dst_view,
   const ArrayView<const Number> &src_view) const
 {
-  AssertDimension(dst_view.size(), this->m());
-  AssertDimension(src_view.size(), this->n());
+  const unsigned int n_dofs = this->m();
+  Assert(n_dofs > 0 && dst_view.size() % n_dofs == 0,
+         ExcDimensionMismatch(dst_view.size(), n_dofs));
+  AssertDimension(src_view.size(), dst_view.size());
   std::lock_guard<std::mutex> lock(this->mutex);
-  const unsigned int          n = Utilities::fixed_power<dim>(
-    n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size());
-  tmp_array.resize_fast(n * 2);
-  constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
-  internal::EvaluatorTensorProduct<internal::evaluate_general,
-                                   dim,
-                                   kernel_size,
-                                   kernel_size,
-                                   Number>
-                eval(AlignedVector<Number>{},
-         AlignedVector<Number>{},
-         AlignedVector<Number>{},
-         mass_matrix[0].n_rows(),
-         mass_matrix[0].n_rows());
-  Number *      t   = tmp_array.begin();
-  const Number *src = src_view.begin();
-  Number *      dst = dst_view.data();
-
-  if (dim == 1)
-    {
-      const Number *A = &derivative_matrix[0](0, 0);
-      eval.template apply<0, false, false>(A, src, dst);
-    }
+  tmp_array.resize_fast(n_dofs * 2);
 
-  else if (dim == 2)
+  std::array<const Number *, dim> mass, derivative;
+  for (unsigned int d = 0; d < dim; ++d)
     {
-      const Number *A0 = &derivative_matrix[0](0, 0);
-      const Number *M0 = &mass_matrix[0](0, 0);
-      const Number *A1 = &derivative_matrix[1](0, 0);
-      const Number *M1 = &mass_matrix[1](0, 0);
-      eval.template apply<0, false, false>(M0, src, t);
-      eval.template apply<1, false, false>(A1, t, dst);
-      eval.template apply<0, false, false>(A0, src, t);
-      eval.template apply<1, false, true>(M1, t, dst);
+      mass[d]       = &mass_matrix[d](0, 0);
+      derivative[d] = &derivative_matrix[d](0, 0);
     }
-
-  else if (dim == 3)
-    {
-      const Number *A0 = &derivative_matrix[0](0, 0);
-      const Number *M0 = &mass_matrix[0](0, 0);
-      const Number *A1 = &derivative_matrix[1](0, 0);
-      const Number *M1 = &mass_matrix[1](0, 0);
-      const Number *A2 = &derivative_matrix[2](0, 0);
-      const Number *M2 = &mass_matrix[2](0, 0);
-      eval.template apply<0, false, false>(M0, src, t + n);
-      eval.template apply<1, false, false>(M1, t + n, t);
-      eval.template apply<2, false, false>(A2, t, dst);
-      eval.template apply<1, false, false>(A1, t + n, t);
-      eval.template apply<0, false, false>(A0, src, t + n);
-      eval.template apply<1, false, true>(M1, t + n, t);
-      eval.template apply<2, false, true>(M2, t, dst);
-    }
-
-  else
-    AssertThrow(false, ExcNotImplemented());
+  for (unsigned int c = 0; c < dst_view.size(); c += n_dofs)
+    internal::TensorProductMatrix::vmult<n_rows_1d, dim>(
+      mass,
+      derivative,
+      mass_matrix[0].n_rows(),
+      dst_view.data() + c,
+      src_view.data() + c,
+      tmp_array.begin());
 }
 
 
@@ -560,73 +1161,27 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::apply_inverse(
   const ArrayView<Number> &      dst_view,
   const ArrayView<const Number> &src_view) const
 {
-  AssertDimension(dst_view.size(), this->n());
-  AssertDimension(src_view.size(), this->m());
+  const unsigned int n_dofs = this->n();
+  Assert(n_dofs > 0 && dst_view.size() % n_dofs == 0,
+         ExcDimensionMismatch(dst_view.size(), n_dofs));
+  AssertDimension(src_view.size(), dst_view.size());
   std::lock_guard<std::mutex> lock(this->mutex);
-  const unsigned int n = n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size();
-  tmp_array.resize_fast(Utilities::fixed_power<dim>(n));
-  constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
-  internal::EvaluatorTensorProduct<internal::evaluate_general,
-                                   dim,
-                                   kernel_size,
-                                   kernel_size,
-                                   Number>
-                eval(AlignedVector<Number>(),
-         AlignedVector<Number>(),
-         AlignedVector<Number>(),
-         mass_matrix[0].n_rows(),
-         mass_matrix[0].n_rows());
-  Number *      t   = tmp_array.begin();
-  const Number *src = src_view.data();
-  Number *      dst = dst_view.data();
-
-  // NOTE: dof_to_quad has to be interpreted as 'dof to eigenvalue index'
-  //       --> apply<.,true,.> (S,src,dst) calculates dst = S^T * src,
-  //       --> apply<.,false,.> (S,src,dst) calculates dst = S * src,
-  //       while the eigenvectors are stored column-wise in S, i.e.
-  //       rows correspond to dofs whereas columns to eigenvalue indices!
-  if (dim == 1)
-    {
-      const Number *S = &eigenvectors[0](0, 0);
-      eval.template apply<0, true, false>(S, src, t);
-      for (unsigned int i = 0; i < n; ++i)
-        t[i] /= eigenvalues[0][i];
-      eval.template apply<0, false, false>(S, t, dst);
-    }
-
-  else if (dim == 2)
-    {
-      const Number *S0 = &(eigenvectors[0](0, 0));
-      const Number *S1 = &(eigenvectors[1](0, 0));
-      eval.template apply<0, true, false>(S0, src, t);
-      eval.template apply<1, true, false>(S1, t, dst);
-      for (unsigned int i1 = 0, c = 0; i1 < n; ++i1)
-        for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
-          dst[c] /= (eigenvalues[1][i1] + eigenvalues[0][i0]);
-      eval.template apply<0, false, false>(S0, dst, t);
-      eval.template apply<1, false, false>(S1, t, dst);
-    }
+  tmp_array.resize_fast(n_dofs);
 
-  else if (dim == 3)
+  std::array<const Number *, dim> vectors, values;
+  for (unsigned int d = 0; d < dim; ++d)
     {
-      const Number *S0 = &eigenvectors[0](0, 0);
-      const Number *S1 = &eigenvectors[1](0, 0);
-      const Number *S2 = &eigenvectors[2](0, 0);
-      eval.template apply<0, true, false>(S0, src, t);
-      eval.template apply<1, true, false>(S1, t, dst);
-      eval.template apply<2, true, false>(S2, dst, t);
-      for (unsigned int i2 = 0, c = 0; i2 < n; ++i2)
-        for (unsigned int i1 = 0; i1 < n; ++i1)
-          for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
-            t[c] /=
-              (eigenvalues[2][i2] + eigenvalues[1][i1] + eigenvalues[0][i0]);
-      eval.template apply<0, false, false>(S0, t, dst);
-      eval.template apply<1, false, false>(S1, dst, t);
-      eval.template apply<2, false, false>(S2, t, dst);
+      vectors[d] = &eigenvectors[d](0, 0);
+      values[d]  = eigenvalues[d].begin();
     }
-
-  else
-    Assert(false, ExcNotImplemented());
+  for (unsigned int c = 0; c < dst_view.size(); c += n_dofs)
+    internal::TensorProductMatrix::apply_inverse<n_rows_1d, dim>(
+      vectors,
+      values,
+      n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size(),
+      dst_view.data() + c,
+      src_view.data() + c,
+      tmp_array.begin());
 }
 
 
@@ -676,29 +1231,11 @@ TensorProductMatrixSymmetricSum<dim, Number, n_rows_1d>::reinit_impl(
   this->mass_matrix          = mass_matrices;
   this->derivative_matrix    = derivative_matrices;
 
-  for (int dir = 0; dir < dim; ++dir)
-    {
-      Assert(n_rows_1d == -1 ||
-               (n_rows_1d > 0 && static_cast<unsigned int>(n_rows_1d) ==
-                                   mass_matrices[dir].n_rows()),
-             ExcDimensionMismatch(n_rows_1d, mass_matrices[dir].n_rows()));
-      AssertDimension(mass_matrices[dir].n_rows(), mass_matrices[dir].n_cols());
-      AssertDimension(mass_matrices[dir].n_rows(),
-                      derivative_matrices[dir].n_rows());
-      AssertDimension(mass_matrices[dir].n_rows(),
-                      derivative_matrices[dir].n_cols());
-
-      this->eigenvectors[dir].reinit(mass_matrices[dir].n_cols(),
-                                     mass_matrices[dir].n_rows());
-      this->eigenvalues[dir].resize(mass_matrices[dir].n_cols());
-      internal::TensorProductMatrix::spectral_assembly<Number>(
-        &(mass_matrices[dir](0, 0)),
-        &(derivative_matrices[dir](0, 0)),
-        mass_matrices[dir].n_rows(),
-        mass_matrices[dir].n_cols(),
-        this->eigenvalues[dir].begin(),
-        &(this->eigenvectors[dir](0, 0)));
-    }
+  internal::TensorProductMatrix::setup_eigendecompositions<n_rows_1d, dim>(
+    this->mass_matrix,
+    this->derivative_matrix,
+    this->eigenvalues,
+    this->eigenvectors);
 }
 
 
@@ -799,79 +1336,11 @@ TensorProductMatrixSymmetricSum<dim, VectorizedArray<Number>, n_rows_1d>::
   this->mass_matrix        = mass_matrix;
   this->derivative_matrix  = derivative_matrix;
 
-  constexpr unsigned int macro_size = VectorizedArray<Number>::size();
-  std::size_t            n_rows_max = (n_rows_1d > 0) ? n_rows_1d : 0;
-  if (n_rows_1d == -1)
-    for (unsigned int d = 0; d < dim; ++d)
-      n_rows_max = std::max(n_rows_max, mass_matrix[d].n_rows());
-  const std::size_t nm_flat_size_max = n_rows_max * n_rows_max * macro_size;
-  const std::size_t n_flat_size_max  = n_rows_max * macro_size;
-
-  std::vector<Number> mass_matrix_flat;
-  std::vector<Number> deriv_matrix_flat;
-  std::vector<Number> eigenvalues_flat;
-  std::vector<Number> eigenvectors_flat;
-  mass_matrix_flat.resize(nm_flat_size_max);
-  deriv_matrix_flat.resize(nm_flat_size_max);
-  eigenvalues_flat.resize(n_flat_size_max);
-  eigenvectors_flat.resize(nm_flat_size_max);
-  std::array<unsigned int, macro_size> offsets_nm;
-  std::array<unsigned int, macro_size> offsets_n;
-  for (int dir = 0; dir < dim; ++dir)
-    {
-      Assert(n_rows_1d == -1 ||
-               (n_rows_1d > 0 && static_cast<unsigned int>(n_rows_1d) ==
-                                   mass_matrix[dir].n_rows()),
-             ExcDimensionMismatch(n_rows_1d, mass_matrix[dir].n_rows()));
-      AssertDimension(mass_matrix[dir].n_rows(), mass_matrix[dir].n_cols());
-      AssertDimension(mass_matrix[dir].n_rows(),
-                      derivative_matrix[dir].n_rows());
-      AssertDimension(mass_matrix[dir].n_rows(),
-                      derivative_matrix[dir].n_cols());
-
-      const unsigned int n_rows = mass_matrix[dir].n_rows();
-      const unsigned int n_cols = mass_matrix[dir].n_cols();
-      const unsigned int nm     = n_rows * n_cols;
-      for (unsigned int vv = 0; vv < macro_size; ++vv)
-        offsets_nm[vv] = nm * vv;
-
-      vectorized_transpose_and_store(false,
-                                     nm,
-                                     &(mass_matrix[dir](0, 0)),
-                                     offsets_nm.cbegin(),
-                                     mass_matrix_flat.data());
-      vectorized_transpose_and_store(false,
-                                     nm,
-                                     &(derivative_matrix[dir](0, 0)),
-                                     offsets_nm.cbegin(),
-                                     deriv_matrix_flat.data());
-
-      const Number *mass_cbegin    = mass_matrix_flat.data();
-      const Number *deriv_cbegin   = deriv_matrix_flat.data();
-      Number *      eigenvec_begin = eigenvectors_flat.data();
-      Number *      eigenval_begin = eigenvalues_flat.data();
-      for (unsigned int lane = 0; lane < macro_size; ++lane)
-        internal::TensorProductMatrix::spectral_assembly<Number>(
-          mass_cbegin + nm * lane,
-          deriv_cbegin + nm * lane,
-          n_rows,
-          n_cols,
-          eigenval_begin + n_rows * lane,
-          eigenvec_begin + nm * lane);
-
-      this->eigenvalues[dir].resize(n_rows);
-      this->eigenvectors[dir].reinit(n_rows, n_cols);
-      for (unsigned int vv = 0; vv < macro_size; ++vv)
-        offsets_n[vv] = n_rows * vv;
-      vectorized_load_and_transpose(n_rows,
-                                    eigenvalues_flat.data(),
-                                    offsets_n.cbegin(),
-                                    this->eigenvalues[dir].begin());
-      vectorized_load_and_transpose(nm,
-                                    eigenvectors_flat.data(),
-                                    offsets_nm.cbegin(),
-                                    &(this->eigenvectors[dir](0, 0)));
-    }
+  internal::TensorProductMatrix::setup_eigendecompositions<n_rows_1d, dim>(
+    this->mass_matrix,
+    this->derivative_matrix,
+    this->eigenvalues,
+    this->eigenvectors);
 }
 
 
@@ -907,6 +1376,231 @@ TensorProductMatrixSymmetricSum<dim, VectorizedArray<Number>, n_rows_1d>::
 
 
 
+//---------------- TensorProductMatrixSymmetricSumCollection -----------------
+
+template <int dim, typename Number, int n_rows_1d>
+inline TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  AdditionalData::AdditionalData(const bool compress_matrices)
+  : compress_matrices(compress_matrices)
+{}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  TensorProductMatrixSymmetricSumCollection(
+    const AdditionalData &additional_data)
+  : additional_data(additional_data)
+{}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::reserve(
+  const unsigned int n_entries)
+{
+  std::array<unsigned int, dim> invalid;
+  invalid.fill(numbers::invalid_unsigned_int);
+  indices.clear();
+  indices.resize(n_entries, invalid);
+  cache.clear();
+  mass_matrices.clear();
+  derivative_matrices.clear();
+  eigenvalues.clear();
+  eigenvectors.clear();
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline unsigned int
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::find_or_add(
+  const Table<2, Number> &mass_matrix,
+  const Table<2, Number> &derivative_matrix)
+{
+  const unsigned int next_index = mass_matrices.size();
+  if (additional_data.compress_matrices)
+    {
+      const auto inserted =
+        cache.emplace(std::make_pair(mass_matrix, derivative_matrix),
+                      next_index);
+      if (inserted.second == false)
+        return inserted.first->second;
+    }
+
+  mass_matrices.push_back(mass_matrix);
+  derivative_matrices.push_back(derivative_matrix);
+  return next_index;
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::insert(
+  const unsigned int                       index,
+  const std::array<Table<2, Number>, dim> &mass_matrices,
+  const std::array<Table<2, Number>, dim> &derivative_matrices)
+{
+  AssertIndexRange(index, indices.size());
+  Assert(eigenvalues.empty(),
+         ExcMessage("Entries cannot be inserted after finalize()."));
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      Assert(n_rows_1d == -1 ||
+               (n_rows_1d > 0 && static_cast<unsigned int>(n_rows_1d) ==
+                                   mass_matrices[d].n_rows()),
+             ExcDimensionMismatch(n_rows_1d, mass_matrices[d].n_rows()));
+      AssertDimension(mass_matrices[d].n_rows(), mass_matrices[d].n_cols());
+      AssertDimension(mass_matrices[d].n_rows(),
+                      derivative_matrices[d].n_rows());
+      AssertDimension(mass_matrices[d].n_rows(),
+                      derivative_matrices[d].n_cols());
+      AssertDimension(mass_matrices[d].n_rows(), mass_matrices[0].n_rows());
+
+      indices[index][d] = find_or_add(mass_matrices[d], derivative_matrices[d]);
+    }
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::finalize()
+{
+  cache.clear();
+  eigenvalues.resize(mass_matrices.size());
+  eigenvectors.resize(mass_matrices.size());
+  for (unsigned int i = 0; i < mass_matrices.size(); ++i)
+    internal::TensorProductMatrix::setup_eigendecomposition(
+      mass_matrices[i],
+      derivative_matrices[i],
+      eigenvalues[i],
+      eigenvectors[i]);
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::vmult(
+  const unsigned int             index,
+  const ArrayView<Number> &      dst,
+  const ArrayView<const Number> &src) const
+{
+  AssertIndexRange(index, indices.size());
+  Assert(indices[index][0] != numbers::invalid_unsigned_int,
+         ExcMessage("No matrices have been inserted for this index."));
+  const unsigned int n_dofs = m(index);
+  Assert(dst.size() % n_dofs == 0, ExcDimensionMismatch(dst.size(), n_dofs));
+  AssertDimension(src.size(), dst.size());
+
+  std::array<const Number *, dim> mass, derivative;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      mass[d]       = &mass_matrices[indices[index][d]](0, 0);
+      derivative[d] = &derivative_matrices[indices[index][d]](0, 0);
+    }
+
+  AlignedVector<Number> &tmp = tmp_array.get();
+  tmp.resize_fast(2 * n_dofs);
+  for (unsigned int c = 0; c < dst.size(); c += n_dofs)
+    internal::TensorProductMatrix::vmult<n_rows_1d, dim>(
+      mass,
+      derivative,
+      mass_matrices[indices[index][0]].n_rows(),
+      dst.data() + c,
+      src.data() + c,
+      tmp.begin());
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  apply_inverse(const unsigned int             index,
+                const ArrayView<Number> &      dst,
+                const ArrayView<const Number> &src) const
+{
+  AssertIndexRange(index, indices.size());
+  Assert(indices[index][0] != numbers::invalid_unsigned_int,
+         ExcMessage("No matrices have been inserted for this index."));
+  Assert(eigenvalues.size() == mass_matrices.size(),
+         ExcMessage("finalize() must be called before apply_inverse()."));
+  const unsigned int n_dofs = m(index);
+  Assert(dst.size() % n_dofs == 0, ExcDimensionMismatch(dst.size(), n_dofs));
+  AssertDimension(src.size(), dst.size());
+
+  std::array<const Number *, dim> vectors, values;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      vectors[d] = &eigenvectors[indices[index][d]](0, 0);
+      values[d]  = eigenvalues[indices[index][d]].begin();
+    }
+
+  AlignedVector<Number> &tmp = tmp_array.get();
+  tmp.resize_fast(n_dofs);
+  for (unsigned int c = 0; c < dst.size(); c += n_dofs)
+    internal::TensorProductMatrix::apply_inverse<n_rows_1d, dim>(
+      vectors,
+      values,
+      mass_matrices[indices[index][0]].n_rows(),
+      dst.data() + c,
+      src.data() + c,
+      tmp.begin());
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline unsigned int
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::m(
+  const unsigned int index) const
+{
+  AssertIndexRange(index, indices.size());
+  return Utilities::fixed_power<dim>(mass_matrices[indices[index][0]].n_rows());
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline std::size_t
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::size() const
+{
+  return indices.size();
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline std::size_t
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  storage_size() const
+{
+  return mass_matrices.size();
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline std::size_t
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  memory_consumption() const
+{
+  std::size_t memory = sizeof(*this) + indices.capacity() * sizeof(indices[0]);
+  for (unsigned int i = 0; i < mass_matrices.size(); ++i)
+    memory += mass_matrices[i].memory_consumption() +
+              derivative_matrices[i].memory_consumption();
+  for (unsigned int i = 0; i < eigenvalues.size(); ++i)
+    memory += eigenvalues[i].memory_consumption() +
+              eigenvectors[i].memory_consumption();
+  return memory;
+}
+
+
+
 #endif
 
 DEAL_II_NAMESPACE_CLOSE
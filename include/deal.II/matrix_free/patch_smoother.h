@@ -0,0 +1,576 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_patch_smoother_h
+#define dealii_matrix_free_patch_smoother_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/tensor_product_matrix.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <array>
+#include <functional>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace MatrixFreeOperators
+{
+  /**
+   * An additive Schwarz preconditioner on cell patches for operators
+   * represented by a MatrixFree object. For every cell, the local problem is
+   * approximated by a separable operator of the form represented by
+   * TensorProductMatrixSymmetricSum, i.e., $L_K = A_1 \otimes M_0 + M_1
+   * \otimes A_0$ in 2D and analogously in 1D and 3D, whose inverse is applied
+   * with the fast diagonalization method. The action of the preconditioner
+   * is
+   * @f{align*}{
+   *   P^{-1} = \omega \sum_{K} R_K^\mathrm T L_K^{-1} R_K,
+   * @f}
+   * where $R_K$ restricts a global vector to the degrees of freedom of cell
+   * $K$ and $\omega$ is a relaxation parameter.
+   *
+   * The local inverses are set up for batches of cells at once: the 1D
+   * matrices of all lanes of a cell batch are collected into a
+   * VectorizedArray and TensorProductMatrixSymmetricSum computes the
+   * generalized eigendecomposition lane by lane. The application runs through
+   * MatrixFree::cell_loop() and hence uses the same vectorization, threading,
+   * and ghost exchange as the matrix-free operator itself. For discontinuous
+   * elements, the cell patches do not overlap and the preconditioner is a
+   * block-Jacobi method with exact (or approximate, for non-Cartesian cells)
+   * cell-block inverses. For continuous elements, contributions on shared
+   * degrees of freedom are added up, which typically requires a relaxation
+   * parameter $\omega$ smaller than one.
+   *
+   * The 1D matrices are computed by the function
+   * AdditionalData::compute_1d_matrices. If that function is not set, the
+   * matrices of the cell block of the Laplacian discretized by the symmetric
+   * interior penalty method are used, with the penalty parameter
+   * $\sigma = \text{penalty\_factor}\,(p+1)^2/h$ on all faces of the cell and
+   * the cell extent $h$ in the respective direction. This default requires a
+   * discontinuous element.
+   *
+   * The class provides the interface expected by MGSmootherPrecondition, so
+   * that a multigrid smoother based on the patch inverses can be set up as
+   * @code
+   * using SmootherType =
+   *   MatrixFreeOperators::CellPatchSchwarzSmoother<dim, fe_degree>;
+   * MGSmootherPrecondition<LevelMatrixType, SmootherType, VectorType>
+   *   mg_smoother;
+   * SmootherType::AdditionalData smoother_data;
+   * smoother_data.relaxation = 0.7;
+   * mg_smoother.initialize(mg_matrices, smoother_data);
+   * @endcode
+   * where the level matrices are expected to provide a function
+   * `get_matrix_free()` like the classes derived from
+   * MatrixFreeOperators::Base. Since the preconditioner only provides
+   * vmult(), it can also be used as the inner preconditioner of
+   * PreconditionChebyshev.
+   *
+   * @tparam dim Space dimension.
+   * @tparam fe_degree Polynomial degree of the element, or -1 to select the
+   * degree at run time.
+   * @tparam n_components Number of components of the (primitive) element. The
+   * same scalar inverse is applied to all components.
+   * @tparam Number Scalar type of the vectors and of the MatrixFree object.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_components = 1,
+            typename Number  = double>
+  class CellPatchSchwarzSmoother : public Subscriptor
+  {
+  public:
+    /**
+     * The vectorized number type of the underlying MatrixFree object.
+     */
+    using VectorizedArrayType = VectorizedArray<Number>;
+
+    /**
+     * The type of the cell-local inverse, with compile-time sizes of the 1D
+     * matrices if the degree is known.
+     */
+    using LocalInverseType =
+      TensorProductMatrixSymmetricSum<dim,
+                                      VectorizedArrayType,
+                                      fe_degree == -1 ? -1 : fe_degree + 1>;
+
+    /**
+     * Standardized data struct to pipe additional data to the
+     * preconditioner.
+     */
+    struct AdditionalData
+    {
+      /**
+       * Constructor.
+       */
+      AdditionalData(const double       relaxation        = 1.,
+                     const double       penalty_factor    = 1.,
+                     const unsigned int dof_handler_index = 0,
+                     const unsigned int quad_index        = 0);
+
+      /**
+       * Relaxation parameter $\omega$ multiplied to the result of the
+       * additive Schwarz method.
+       */
+      double relaxation;
+
+      /**
+       * Factor multiplying $(p+1)^2/h$ in the interior penalty parameter of
+       * the default 1D matrices. This value should match the penalty of the
+       * operator to be preconditioned.
+       */
+      double penalty_factor;
+
+      /**
+       * Index of the DoFHandler within the MatrixFree object.
+       */
+      unsigned int dof_handler_index;
+
+      /**
+       * Index of the quadrature formula within the MatrixFree object. The
+       * default 1D matrices are integrated with the 1D quadrature formula of
+       * that index, which must have <tt>fe_degree+1</tt> points per direction
+       * as in the FEEvaluation object used for accessing the vector entries.
+       */
+      unsigned int quad_index;
+
+      /**
+       * A function that fills the 1D mass and derivative matrices in all
+       * directions for the cell batch given as second argument. The tables
+       * are already sized to the number of degrees of freedom per direction
+       * on entry. Each lane of the vectorized matrices represents one cell
+       * of the batch, and lanes beyond
+       * MatrixFree::n_active_entries_per_cell_batch() must be filled with
+       * some invertible data (e.g. a copy of the first lane). If empty, the
+       * interior penalty discretization of the Laplacian described in the
+       * class documentation is used.
+       */
+      std::function<void(
+        const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+        const unsigned int                                  cell_batch,
+        std::array<Table<2, VectorizedArrayType>, dim> &    mass_matrices,
+        std::array<Table<2, VectorizedArrayType>, dim> &    derivative_matrices)>
+        compute_1d_matrices;
+    };
+
+    /**
+     * Set up the cell inverses for all cell batches of the given MatrixFree
+     * object.
+     */
+    void
+    initialize(const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+               const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Set up the cell inverses for the MatrixFree object underlying the given
+     * operator, accessed through `operator.get_matrix_free()`. This is the
+     * interface used by MGSmootherPrecondition.
+     */
+    template <typename OperatorType>
+    void
+    initialize(const OperatorType &  op,
+               const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Release all memory and reset the object.
+     */
+    void
+    clear();
+
+    /**
+     * Apply the preconditioner, i.e., compute $dst = P^{-1} src$.
+     */
+    template <typename VectorType>
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Apply the transpose of the preconditioner. Since the cell inverses are
+     * symmetric, this is the same as vmult().
+     */
+    template <typename VectorType>
+    void
+    Tvmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Return the cell inverse of the given cell batch.
+     */
+    const LocalInverseType &
+    get_local_inverse(const unsigned int cell_batch) const;
+
+    /**
+     * Return the memory consumption of this class in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * Fill the 1D matrices of the interior penalty discretization of the
+     * Laplacian on the cells of the given batch.
+     */
+    void
+    compute_interior_penalty_matrices(
+      const unsigned int                              cell_batch,
+      std::array<Table<2, VectorizedArrayType>, dim> &mass_matrices,
+      std::array<Table<2, VectorizedArrayType>, dim> &derivative_matrices)
+      const;
+
+    /**
+     * Apply the cell inverses on a range of cell batches.
+     */
+    template <typename VectorType>
+    void
+    local_apply(const MatrixFree<dim, Number, VectorizedArrayType> &data,
+                VectorType &                                        dst,
+                const VectorType &                                  src,
+                const std::pair<unsigned int, unsigned int> &cell_range) const;
+
+    /**
+     * Pointer to the MatrixFree object.
+     */
+    SmartPointer<const MatrixFree<dim, Number, VectorizedArrayType>>
+      matrix_free;
+
+    /**
+     * The settings of this object.
+     */
+    AdditionalData additional_data;
+
+    /**
+     * The cell inverses, one per cell batch.
+     */
+    std::vector<LocalInverseType> local_inverses;
+  };
+
+
+
+  // ------------------------- inline functions ----------------------------
+
+#ifndef DOXYGEN
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  inline CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::
+    AdditionalData::AdditionalData(const double       relaxation,
+                                   const double       penalty_factor,
+                                   const unsigned int dof_handler_index,
+                                   const unsigned int quad_index)
+    : relaxation(relaxation)
+    , penalty_factor(penalty_factor)
+    , dof_handler_index(dof_handler_index)
+    , quad_index(quad_index)
+  {}
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  void
+  CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::initialize(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AdditionalData &                              additional_data)
+  {
+    this->matrix_free     = &matrix_free;
+    this->additional_data = additional_data;
+
+    const auto &shape_info =
+      matrix_free.get_shape_info(additional_data.dof_handler_index,
+                                 additional_data.quad_index);
+    const unsigned int n_dofs_1d = shape_info.data[0].fe_degree + 1;
+    Assert(fe_degree == -1 ||
+             static_cast<unsigned int>(fe_degree) ==
+               shape_info.data[0].fe_degree,
+           ExcDimensionMismatch(fe_degree, shape_info.data[0].fe_degree));
+    AssertThrow(shape_info.element_type <=
+                  internal::MatrixFreeFunctions::tensor_symmetric,
+                ExcMessage("The cell patch smoother needs an element with "
+                           "tensor product shape functions that are the "
+                           "same in all directions."));
+    AssertDimension(shape_info.dofs_per_component_on_cell,
+                    Utilities::pow(n_dofs_1d, dim));
+    AssertThrow(additional_data.compute_1d_matrices ||
+                  matrix_free.get_dof_handler(additional_data.dof_handler_index)
+                      .get_fe()
+                      .dofs_per_vertex == 0,
+                ExcMessage("The default interior penalty 1D matrices are "
+                           "only valid for discontinuous elements. Provide "
+                           "AdditionalData::compute_1d_matrices for other "
+                           "elements."));
+
+    local_inverses.resize(matrix_free.n_cell_batches());
+
+    std::array<Table<2, VectorizedArrayType>, dim> mass_matrices;
+    std::array<Table<2, VectorizedArrayType>, dim> derivative_matrices;
+    for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+      {
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            mass_matrices[d].reinit(n_dofs_1d, n_dofs_1d);
+            derivative_matrices[d].reinit(n_dofs_1d, n_dofs_1d);
+          }
+        if (additional_data.compute_1d_matrices)
+          additional_data.compute_1d_matrices(matrix_free,
+                                              cell,
+                                              mass_matrices,
+                                              derivative_matrices);
+        else
+          compute_interior_penalty_matrices(cell,
+                                            mass_matrices,
+                                            derivative_matrices);
+        local_inverses[cell].reinit(mass_matrices, derivative_matrices);
+      }
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  template <typename OperatorType>
+  void
+  CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::initialize(
+    const OperatorType &  op,
+    const AdditionalData &additional_data)
+  {
+    Assert(op.get_matrix_free().get() != nullptr, ExcNotInitialized());
+    initialize(*op.get_matrix_free(), additional_data);
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  void
+  CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::clear()
+  {
+    local_inverses.clear();
+    matrix_free = nullptr;
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  void
+  CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::
+    compute_interior_penalty_matrices(
+      const unsigned int                              cell_batch,
+      std::array<Table<2, VectorizedArrayType>, dim> &mass_matrices,
+      std::array<Table<2, VectorizedArrayType>, dim> &derivative_matrices)
+      const
+  {
+    const auto &shape_data =
+      matrix_free
+        ->get_shape_info(additional_data.dof_handler_index,
+                         additional_data.quad_index)
+        .data[0];
+    const unsigned int n_dofs_1d = shape_data.fe_degree + 1;
+    const unsigned int n_q_1d    = shape_data.n_q_points_1d;
+    Assert(n_q_1d >= n_dofs_1d,
+           ExcMessage("The 1D quadrature formula must integrate the 1D mass "
+                      "matrix exactly."));
+
+    // integrals on the unit interval, the values in the shape data are
+    // broadcast over all lanes, so we read the first one
+    const double penalty =
+      additional_data.penalty_factor * (n_dofs_1d * n_dofs_1d);
+    Table<2, double> ref_mass(n_dofs_1d, n_dofs_1d);
+    Table<2, double> ref_laplace(n_dofs_1d, n_dofs_1d);
+    for (unsigned int i = 0; i < n_dofs_1d; ++i)
+      for (unsigned int j = 0; j < n_dofs_1d; ++j)
+        {
+          double sum_mass = 0, sum_laplace = 0;
+          for (unsigned int q = 0; q < n_q_1d; ++q)
+            {
+              const double w = shape_data.quadrature.weight(q);
+              sum_mass += shape_data.shape_values[i * n_q_1d + q][0] *
+                          shape_data.shape_values[j * n_q_1d + q][0] * w;
+              sum_laplace += shape_data.shape_gradients[i * n_q_1d + q][0] *
+                             shape_data.shape_gradients[j * n_q_1d + q][0] *
+                             w;
+            }
+          ref_mass(i, j) = sum_mass;
+
+          // face terms of the symmetric interior penalty method for test and
+          // trial functions on the same cell, with outer normal -1 at the
+          // left and +1 at the right end point
+          for (unsigned int f = 0; f < 2; ++f)
+            {
+              const double normal = f == 0 ? -1. : 1.;
+              const double v_i    = shape_data.shape_data_on_face[f][i][0];
+              const double v_j    = shape_data.shape_data_on_face[f][j][0];
+              const double d_i =
+                shape_data.shape_data_on_face[f][i + n_dofs_1d][0];
+              const double d_j =
+                shape_data.shape_data_on_face[f][j + n_dofs_1d][0];
+              sum_laplace += penalty * v_i * v_j -
+                             0.5 * normal * (d_i * v_j + d_j * v_i);
+            }
+          ref_laplace(i, j) = sum_laplace;
+        }
+
+    // scale the reference matrices by the cell extents; unused lanes are
+    // filled with the data of the first cell to keep the eigenvalue problem
+    // well-posed
+    const unsigned int n_filled =
+      matrix_free->n_active_entries_per_cell_batch(cell_batch);
+    for (unsigned int v = 0; v < VectorizedArrayType::size(); ++v)
+      {
+        const auto dcell =
+          matrix_free->get_cell_iterator(cell_batch,
+                                         v < n_filled ? v : 0,
+                                         additional_data.dof_handler_index);
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            const double h = dcell->extent_in_direction(d);
+            for (unsigned int i = 0; i < n_dofs_1d; ++i)
+              for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                {
+                  mass_matrices[d](i, j)[v]       = h * ref_mass(i, j);
+                  derivative_matrices[d](i, j)[v] = ref_laplace(i, j) / h;
+                }
+          }
+      }
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  template <typename VectorType>
+  void
+  CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::local_apply(
+    const MatrixFree<dim, Number, VectorizedArrayType> &data,
+    VectorType &                                        dst,
+    const VectorType &                                  src,
+    const std::pair<unsigned int, unsigned int> &       cell_range) const
+  {
+    FEEvaluation<dim, fe_degree, fe_degree + 1, n_components, Number> phi(
+      data, additional_data.dof_handler_index, additional_data.quad_index);
+    const unsigned int dofs_per_component =
+      phi.dofs_per_cell / n_components;
+    AlignedVector<VectorizedArrayType> tmp(dofs_per_component);
+    const VectorizedArrayType          relaxation =
+      make_vectorized_array<Number>(additional_data.relaxation);
+
+    for (unsigned int cell = cell_range.first; cell < cell_range.second;
+         ++cell)
+      {
+        phi.reinit(cell);
+        phi.read_dof_values(src);
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            VectorizedArrayType *dof_values =
+              phi.begin_dof_values() + c * dofs_per_component;
+            for (unsigned int i = 0; i < dofs_per_component; ++i)
+              tmp[i] = dof_values[i];
+            local_inverses[cell].apply_inverse(
+              make_array_view(dof_values, dof_values + dofs_per_component),
+              make_array_view(tmp.begin(), tmp.end()));
+            for (unsigned int i = 0; i < dofs_per_component; ++i)
+              dof_values[i] *= relaxation;
+          }
+        phi.distribute_local_to_global(dst);
+      }
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  template <typename VectorType>
+  void
+  CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::vmult(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    Assert(matrix_free.get() != nullptr, ExcNotInitialized());
+    matrix_free->cell_loop(&CellPatchSchwarzSmoother::local_apply<VectorType>,
+                           this,
+                           dst,
+                           src,
+                           true);
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  template <typename VectorType>
+  void
+  CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::Tvmult(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    vmult(dst, src);
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  inline const typename CellPatchSchwarzSmoother<dim,
+                                                 fe_degree,
+                                                 n_components,
+                                                 Number>::LocalInverseType &
+  CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::
+    get_local_inverse(const unsigned int cell_batch) const
+  {
+    AssertIndexRange(cell_batch, local_inverses.size());
+    return local_inverses[cell_batch];
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  std::size_t
+  CellPatchSchwarzSmoother<dim, fe_degree, n_components, Number>::
+    memory_consumption() const
+  {
+    std::size_t memory = sizeof(*this);
+    if (!local_inverses.empty())
+      {
+        const unsigned int n_dofs_1d =
+          matrix_free
+            ->get_shape_info(additional_data.dof_handler_index,
+                             additional_data.quad_index)
+            .data[0]
+            .fe_degree +
+          1;
+        // two input matrices, the eigenvectors and the eigenvalues per
+        // direction
+        memory += local_inverses.size() *
+                  (sizeof(LocalInverseType) +
+                   dim * (3 * n_dofs_1d + 1) * n_dofs_1d *
+                     sizeof(VectorizedArrayType));
+      }
+    return memory;
+  }
+
+#endif // DOXYGEN
+
+} // end of namespace MatrixFreeOperators
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
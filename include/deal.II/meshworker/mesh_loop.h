@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/graph_coloring.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/work_stream.h>
 
@@ -33,6 +34,7 @@
 
 #include <functional>
 #include <type_traits>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -96,224 +98,115 @@ namespace MeshWorker
       // remove the template layers to retrieve the underlying iterator type.
       using type = typename CellIteratorBaseType<CellIteratorType>::type;
     };
-  } // namespace internal
 
-  /**
-   * This function extends the WorkStream concept to work on meshes
-   * (cells and/or faces) and handles the complicated logic for
-   * work on adaptively refined faces
-   * and parallel computation (work on faces to ghost neighbors for example).
-   * The @p mesh_loop can be used to simplify operations on cells (for example
-   * assembly), on boundaries (Neumann type boundary conditions), or on
-   * interior faces (for example in discontinuous Galerkin methods).
-   *
-   * For uniformly refined meshes, it would be relatively easy to use
-   * WorkStream::run() with a @p cell_worker that also loops over faces, and
-   * takes care of assembling face terms depending on the current and neighbor
-   * cell. All user codes that do these loops would then need to insert
-   * manually the logic that identifies, for every face of the current cell,
-   * the neighboring cell, and the face index on the neighboring cell that
-   * corresponds to the current face.
-   *
-   * This is more complicated if local refinement is enabled and the current or
-   * neighbor cells have hanging nodes. In this case it is also necessary to
-   * identify the corresponding subface on either the current or the neighbor
-   * faces.
-   *
-   * This method externalizes that logic (which is independent from user codes)
-   * and separates the assembly of face terms (internal faces, boundary faces,
-   * or faces between different subdomain ids on parallel computations) from
-   * the assembling on cells, allowing the user to specify two additional
-   * workers (a @p cell_worker, a @p boundary_worker, and a @p face_worker) that
-   * are called automatically in each @p cell, according to the specific
-   * AssembleFlags @p flags that are passed. The @p cell_worker is passed the
-   * cell identifier, a ScratchData object, and a CopyData object, following
-   * the same principles of WorkStream::run(). Internally the function passes to
-   * @p boundary_worker, in addition to the above, also a @p face_no parameter
-   * that identifies the face on which the integration should be performed. The
-   * @p face_worker instead needs to identify the current face unambiguously
-   * both on the cell and on the neighboring cell, and it is therefore called
-   * with six arguments (three for each cell: the actual cell, the face index,
-   * and the subface_index. If no subface integration is needed, then the
-   * subface_index is numbers::invalid_unsigned_int) in addition to the usual
-   * ScratchData and CopyData objects.
-   *
-   * If the flag AssembleFlags::assemble_own_cells is passed, then the default
-   * behavior is to first loop over faces and do the work there, and then
-   * compute the actual work on the cell. It is possible to perform the
-   * integration on the cells after working on faces, by adding the flag
-   * AssembleFlags::cells_after_faces.
-   *
-   * If the flag AssembleFlags::assemble_own_interior_faces_once is specified,
-   * then each interior face is visited only once, and the @p face_worker is
-   * assumed to integrate all face terms at once (and add contributions to both
-   * sides of the face in a discontinuous Galerkin setting).
-   *
-   * This method is equivalent to the WorkStream::run() method when
-   * AssembleFlags contains only @p assemble_own_cells, and can be used as a
-   * drop-in replacement for that method.
-   *
-   * The two data types ScratchData and CopyData need to have a working copy
-   * constructor. ScratchData is only used in the worker function, while
-   * CopyData is the object passed from the worker to the copier. The CopyData
-   * object is reset to the value provided to this function every time this
-   * function visits a new cell (where it then calls the cell and face
-   * workers). In other words, no state carries over between calling the
-   * `copier` on one cell and the `cell_worker`/`face_worker`/`boundary_worker`
-   * functions on the next cell, and user code needs not reset the copy
-   * object either at the beginning of the cell integration or end of the
-   * copy operation. Resetting the state of the `copier ` inside of a
-   * `face_worker` or `boundary_worker` constitutes a bug, and may lead to
-   * some unexpected results. The following example shows what is not
-   * permissible, as the copier is potentially shared among numerous faces
-   * on a cell:
-   * @code
-   *
-   * using ScratchData      = MeshWorker::ScratchData<dim, spacedim>;
-   * using CopyData         = MeshWorker::CopyData<1, 1, 1>;
-   * using CellIteratorType = decltype(dof_handler.begin_active());
-   *
-   * ScratchData            scratch(...);
-   * CopyData               copy(...);
-   *
-   * std::function<void(const CellIteratorType &, ScratchData &, CopyData &)>
-   *   empty_cell_worker;
-   *
-   * auto boundary_worker = [...] (
-   *   const CellIteratorType &cell,
-   *   const unsigned int      face,
-   *   ScratchData            &scratch_data,
-   *   CopyData               &copy_data)
-   * {
-   *  const auto &fe_face_values = scratch_data.reinit(cell, face);
-   *  copy_data = CopyData(...); // This is an error, as we lose the
-   *                             // accumulation that has been performed on
-   *                             // other boundary faces of the same cell.
-   *
-   *  for (unsigned int q_point = 0;
-   *       q_point < fe_face_values.n_quadrature_points;
-   *       ++q_point)
-   *    {
-   *      copy_data.vectors[0][0] += 1.0 * fe_face_values.JxW(q_point);
-   *    }
-   * };
-   *
-   * double value = 0;
-   * auto copier = [...](const CopyData &copy_data)
-   * {
-   *   value += copy_data.vectors[0][0]; // Contributions from some faces may
-   *                                     // be missing.
-   * };
-   *
-   * MeshWorker::mesh_loop(dof_handler.active_cell_iterators(),
-   *                       empty_cell_worker, copier,
-   *                       scratch, copy,
-   *                       MeshWorker::assemble_boundary_faces,
-   *                       boundary_worker);
-   * @endcode
-   *
-   * The queue_length argument indicates the number of items that can be live at
-   * any given time. Each item consists of chunk_size elements of the input
-   * stream that will be worked on by the worker and copier functions one after
-   * the other on the same thread.
-   *
-   * If your data objects are large, or their constructors are expensive, it is
-   * helpful to keep in mind that queue_length copies of the ScratchData object
-   * and `queue_length*chunk_size` copies of the CopyData object are generated.
-   *
-   * @note More information about requirements on template types and meaning
-   * of @p queue_length and @p chunk_size can be found in the documentation of the
-   * WorkStream namespace and its members.
-   *
-   * @ingroup MeshWorker
-   * @author Luca Heltai and Timo Heister, 2017
-   */
-  template <class CellIteratorType,
-            class ScratchData,
-            class CopyData,
-            class CellIteratorBaseType =
-              typename internal::CellIteratorBaseType<CellIteratorType>::type>
-  void
-  mesh_loop(
-    const CellIteratorType &                         begin,
-    const typename identity<CellIteratorType>::type &end,
-
-    const typename identity<std::function<
-      void(const CellIteratorBaseType &, ScratchData &, CopyData &)>>::type
-      &cell_worker,
-    const typename identity<std::function<void(const CopyData &)>>::type
-      &copier,
-
-    const ScratchData &sample_scratch_data,
-    const CopyData &   sample_copy_data,
-
-    const AssembleFlags flags = assemble_own_cells,
-
-    const typename identity<std::function<void(const CellIteratorBaseType &,
-                                               const unsigned int,
-                                               ScratchData &,
-                                               CopyData &)>>::type
-      &boundary_worker = std::function<void(const CellIteratorBaseType &,
-                                            const unsigned int,
-                                            ScratchData &,
-                                            CopyData &)>(),
+    /**
+     * Append the conflict indices of @p cell used by make_cell_coloring() to
+     * @p indices. This overload is selected for cells of a DoFHandler and
+     * uses the (active or level) degree of freedom indices of the cell, i.e.,
+     * the entries of global matrices and vectors the copier writes into.
+     */
+    template <class CellIteratorBaseType>
+    auto
+    append_conflict_indices(const CellIteratorBaseType &          cell,
+                            std::vector<types::global_dof_index> &indices,
+                            const int)
+      -> decltype(cell->get_active_or_mg_dof_indices(indices))
+    {
+      std::vector<types::global_dof_index> dof_indices(
+        cell->get_fe().dofs_per_cell);
+      cell->get_active_or_mg_dof_indices(dof_indices);
+      indices.insert(indices.end(), dof_indices.begin(), dof_indices.end());
+    }
 
-    const typename identity<std::function<void(const CellIteratorBaseType &,
-                                               const unsigned int,
-                                               const unsigned int,
-                                               const CellIteratorBaseType &,
-                                               const unsigned int,
-                                               const unsigned int,
-                                               ScratchData &,
-                                               CopyData &)>>::type
-      &face_worker = std::function<void(const CellIteratorBaseType &,
-                                        const unsigned int,
-                                        const unsigned int,
-                                        const CellIteratorBaseType &,
-                                        const unsigned int,
-                                        const unsigned int,
-                                        ScratchData &,
-                                        CopyData &)>(),
+    /**
+     * Same as above, but for cells without degrees of freedom. As it is not
+     * known which data the copier writes into, the vertex indices of the
+     * cell are used, such that cells sharing a vertex are in conflict.
+     */
+    template <class CellIteratorBaseType>
+    void
+    append_conflict_indices(const CellIteratorBaseType &          cell,
+                            std::vector<types::global_dof_index> &indices,
+                            const long)
+    {
+      for (const unsigned int v :
+           GeometryInfo<CellIteratorBaseType::AccessorType::dimension>::
+             vertex_indices())
+        indices.push_back(cell->vertex_index(v));
+    }
 
-    const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
-    const unsigned int chunk_size   = 8)
-  {
-    Assert(
-      (!cell_worker) == !(flags & work_on_cells),
-      ExcMessage(
-        "If you specify a cell_worker, you need to set assemble_own_cells or assemble_ghost_cells."));
-
-    Assert(
-      (flags &
-       (assemble_own_interior_faces_once | assemble_own_interior_faces_both)) !=
-        (assemble_own_interior_faces_once | assemble_own_interior_faces_both),
-      ExcMessage(
-        "You can only specify assemble_own_interior_faces_once OR assemble_own_interior_faces_both."));
-
-    Assert(
-      (flags & (assemble_ghost_faces_once | assemble_ghost_faces_both)) !=
-        (assemble_ghost_faces_once | assemble_ghost_faces_both),
-      ExcMessage(
-        "You can only specify assemble_ghost_faces_once OR assemble_ghost_faces_both."));
-
-    Assert(
-      !(flags & cells_after_faces) ||
-        (flags & (assemble_own_cells | assemble_ghost_cells)),
-      ExcMessage(
-        "The option cells_after_faces only makes sense if you assemble on cells."));
-
-    Assert((!face_worker) == !(flags & work_on_faces),
-           ExcMessage(
-             "If you specify a face_worker, assemble_face_* needs to be set."));
-
-    Assert(
-      (!boundary_worker) == !(flags & assemble_boundary_faces),
-      ExcMessage(
-        "If you specify a boundary_worker, assemble_boundary_faces needs to be set."));
+    /**
+     * Check that the combination of @p flags and of the worker functions
+     * given to mesh_loop() is consistent.
+     */
+    template <class CellWorker, class BoundaryWorker, class FaceWorker>
+    void
+    check_mesh_loop_arguments(const AssembleFlags   flags,
+                              const CellWorker &    cell_worker,
+                              const BoundaryWorker &boundary_worker,
+                              const FaceWorker &    face_worker)
+    {
+      Assert(
+        (!cell_worker) == !(flags & work_on_cells),
+        ExcMessage(
+          "If you specify a cell_worker, you need to set assemble_own_cells or assemble_ghost_cells."));
+
+      Assert(
+        (flags & (assemble_own_interior_faces_once |
+                  assemble_own_interior_faces_both)) !=
+          (assemble_own_interior_faces_once | assemble_own_interior_faces_both),
+        ExcMessage(
+          "You can only specify assemble_own_interior_faces_once OR assemble_own_interior_faces_both."));
+
+      Assert(
+        (flags & (assemble_ghost_faces_once | assemble_ghost_faces_both)) !=
+          (assemble_ghost_faces_once | assemble_ghost_faces_both),
+        ExcMessage(
+          "You can only specify assemble_ghost_faces_once OR assemble_ghost_faces_both."));
+
+      Assert(
+        !(flags & cells_after_faces) ||
+          (flags & (assemble_own_cells | assemble_ghost_cells)),
+        ExcMessage(
+          "The option cells_after_faces only makes sense if you assemble on cells."));
+
+      Assert(
+        (!face_worker) == !(flags & work_on_faces),
+        ExcMessage(
+          "If you specify a face_worker, assemble_face_* needs to be set."));
+
+      Assert(
+        (!boundary_worker) == !(flags & assemble_boundary_faces),
+        ExcMessage(
+          "If you specify a boundary_worker, assemble_boundary_faces needs to be set."));
+
+      (void)flags;
+      (void)cell_worker;
+      (void)boundary_worker;
+      (void)face_worker;
+    }
 
-    auto cell_action = [&](const CellIteratorBaseType &cell,
-                           ScratchData &               scratch,
-                           CopyData &                  copy) {
+    /**
+     * Do the work of mesh_loop() on a single cell, i.e., call the
+     * @p cell_worker and the @p boundary_worker and @p face_worker on the
+     * faces of the cell that are selected by @p flags.
+     */
+    template <class CellIteratorBaseType,
+              class ScratchData,
+              class CopyData,
+              class CellWorker,
+              class BoundaryWorker,
+              class FaceWorker>
+    void
+    mesh_loop_cell_action(const CellIteratorBaseType &cell,
+                          ScratchData &               scratch,
+                          CopyData &                  copy,
+                          const CopyData &            sample_copy_data,
+                          const AssembleFlags         flags,
+                          const CellWorker &          cell_worker,
+                          const BoundaryWorker &      boundary_worker,
+                          const FaceWorker &          face_worker)
+    {
       // First reset the CopyData class to the empty copy_data given by the
       // user.
       copy = sample_copy_data;
@@ -497,6 +390,205 @@ namespace MeshWorker
           (((flags & assemble_own_cells) && own_cell) ||
            ((flags & assemble_ghost_cells) && !own_cell)))
         cell_worker(cell, scratch, copy);
+    }
+  } // namespace internal
+
+  /**
+   * This function extends the WorkStream concept to work on meshes
+   * (cells and/or faces) and handles the complicated logic for
+   * work on adaptively refined faces
+   * and parallel computation (work on faces to ghost neighbors for example).
+   * The @p mesh_loop can be used to simplify operations on cells (for example
+   * assembly), on boundaries (Neumann type boundary conditions), or on
+   * interior faces (for example in discontinuous Galerkin methods).
+   *
+   * For uniformly refined meshes, it would be relatively easy to use
+   * WorkStream::run() with a @p cell_worker that also loops over faces, and
+   * takes care of assembling face terms depending on the current and neighbor
+   * cell. All user codes that do these loops would then need to insert
+   * manually the logic that identifies, for every face of the current cell,
+   * the neighboring cell, and the face index on the neighboring cell that
+   * corresponds to the current face.
+   *
+   * This is more complicated if local refinement is enabled and the current or
+   * neighbor cells have hanging nodes. In this case it is also necessary to
+   * identify the corresponding subface on either the current or the neighbor
+   * faces.
+   *
+   * This method externalizes that logic (which is independent from user codes)
+   * and separates the assembly of face terms (internal faces, boundary faces,
+   * or faces between different subdomain ids on parallel computations) from
+   * the assembling on cells, allowing the user to specify two additional
+   * workers (a @p cell_worker, a @p boundary_worker, and a @p face_worker) that
+   * are called automatically in each @p cell, according to the specific
+   * AssembleFlags @p flags that are passed. The @p cell_worker is passed the
+   * cell identifier, a ScratchData object, and a CopyData object, following
+   * the same principles of WorkStream::run(). Internally the function passes to
+   * @p boundary_worker, in addition to the above, also a @p face_no parameter
+   * that identifies the face on which the integration should be performed. The
+   * @p face_worker instead needs to identify the current face unambiguously
+   * both on the cell and on the neighboring cell, and it is therefore called
+   * with six arguments (three for each cell: the actual cell, the face index,
+   * and the subface_index. If no subface integration is needed, then the
+   * subface_index is numbers::invalid_unsigned_int) in addition to the usual
+   * ScratchData and CopyData objects.
+   *
+   * If the flag AssembleFlags::assemble_own_cells is passed, then the default
+   * behavior is to first loop over faces and do the work there, and then
+   * compute the actual work on the cell. It is possible to perform the
+   * integration on the cells after working on faces, by adding the flag
+   * AssembleFlags::cells_after_faces.
+   *
+   * If the flag AssembleFlags::assemble_own_interior_faces_once is specified,
+   * then each interior face is visited only once, and the @p face_worker is
+   * assumed to integrate all face terms at once (and add contributions to both
+   * sides of the face in a discontinuous Galerkin setting).
+   *
+   * This method is equivalent to the WorkStream::run() method when
+   * AssembleFlags contains only @p assemble_own_cells, and can be used as a
+   * drop-in replacement for that method.
+   *
+   * The two data types ScratchData and CopyData need to have a working copy
+   * constructor. ScratchData is only used in the worker function, while
+   * CopyData is the object passed from the worker to the copier. The CopyData
+   * object is reset to the value provided to this function every time this
+   * function visits a new cell (where it then calls the cell and face
+   * workers). In other words, no state carries over between calling the
+   * `copier` on one cell and the `cell_worker`/`face_worker`/`boundary_worker`
+   * functions on the next cell, and user code needs not reset the copy
+   * object either at the beginning of the cell integration or end of the
+   * copy operation. Resetting the state of the `copier ` inside of a
+   * `face_worker` or `boundary_worker` constitutes a bug, and may lead to
+   * some unexpected results. The following example shows what is not
+   * permissible, as the copier is potentially shared among numerous faces
+   * on a cell:
+   * @code
+   *
+   * using ScratchData      = MeshWorker::ScratchData<dim, spacedim>;
+   * using CopyData         = MeshWorker::CopyData<1, 1, 1>;
+   * using CellIteratorType = decltype(dof_handler.begin_active());
+   *
+   * ScratchData            scratch(...);
+   * CopyData               copy(...);
+   *
+   * std::function<void(const CellIteratorType &, ScratchData &, CopyData &)>
+   *   empty_cell_worker;
+   *
+   * auto boundary_worker = [...] (
+   *   const CellIteratorType &cell,
+   *   const unsigned int      face,
+   *   ScratchData            &scratch_data,
+   *   CopyData               &copy_data)
+   * {
+   *  const auto &fe_face_values = scratch_data.reinit(cell, face);
+   *  copy_data = CopyData(...); // This is an error, as we lose the
+   *                             // accumulation that has been performed on
+   *                             // other boundary faces of the same cell.
+   *
+   *  for (unsigned int q_point = 0;
+   *       q_point < fe_face_values.n_quadrature_points;
+   *       ++q_point)
+   *    {
+   *      copy_data.vectors[0][0] += 1.0 * fe_face_values.JxW(q_point);
+   *    }
+   * };
+   *
+   * double value = 0;
+   * auto copier = [...](const CopyData &copy_data)
+   * {
+   *   value += copy_data.vectors[0][0]; // Contributions from some faces may
+   *                                     // be missing.
+   * };
+   *
+   * MeshWorker::mesh_loop(dof_handler.active_cell_iterators(),
+   *                       empty_cell_worker, copier,
+   *                       scratch, copy,
+   *                       MeshWorker::assemble_boundary_faces,
+   *                       boundary_worker);
+   * @endcode
+   *
+   * The queue_length argument indicates the number of items that can be live at
+   * any given time. Each item consists of chunk_size elements of the input
+   * stream that will be worked on by the worker and copier functions one after
+   * the other on the same thread.
+   *
+   * If your data objects are large, or their constructors are expensive, it is
+   * helpful to keep in mind that queue_length copies of the ScratchData object
+   * and `queue_length*chunk_size` copies of the CopyData object are generated.
+   *
+   * @note More information about requirements on template types and meaning
+   * of @p queue_length and @p chunk_size can be found in the documentation of the
+   * WorkStream namespace and its members.
+   *
+   * @ingroup MeshWorker
+   * @author Luca Heltai and Timo Heister, 2017
+   */
+  template <class CellIteratorType,
+            class ScratchData,
+            class CopyData,
+            class CellIteratorBaseType =
+              typename internal::CellIteratorBaseType<CellIteratorType>::type>
+  void
+  mesh_loop(
+    const CellIteratorType &                         begin,
+    const typename identity<CellIteratorType>::type &end,
+
+    const typename identity<std::function<
+      void(const CellIteratorBaseType &, ScratchData &, CopyData &)>>::type
+      &cell_worker,
+    const typename identity<std::function<void(const CopyData &)>>::type
+      &copier,
+
+    const ScratchData &sample_scratch_data,
+    const CopyData &   sample_copy_data,
+
+    const AssembleFlags flags = assemble_own_cells,
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &boundary_worker = std::function<void(const CellIteratorBaseType &,
+                                            const unsigned int,
+                                            ScratchData &,
+                                            CopyData &)>(),
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &face_worker = std::function<void(const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        ScratchData &,
+                                        CopyData &)>(),
+
+    const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
+    const unsigned int chunk_size   = 8)
+  {
+    internal::check_mesh_loop_arguments(flags,
+                                        cell_worker,
+                                        boundary_worker,
+                                        face_worker);
+
+    auto cell_action = [&](const CellIteratorBaseType &cell,
+                           ScratchData &               scratch,
+                           CopyData &                  copy) {
+      internal::mesh_loop_cell_action(cell,
+                                      scratch,
+                                      copy,
+                                      sample_copy_data,
+                                      flags,
+                                      cell_worker,
+                                      boundary_worker,
+                                      face_worker);
     };
 
     // Submit to workstream
@@ -644,6 +736,230 @@ namespace MeshWorker
                                     chunk_size);
   }
 
+  /**
+   * Partition the cells in the range from @p begin to @p end into colors such
+   * that the copier calls of mesh_loop() for two cells of the same color do
+   * not write into the same global data. The result can be passed to the
+   * variant of mesh_loop() that takes colored cells, which then runs the
+   * workers and the copier of all cells of one color concurrently.
+   *
+   * For cells of a DoFHandler, two cells are in conflict if they share a
+   * degree of freedom, as computed by
+   * DoFCellAccessor::get_active_or_mg_dof_indices(). This covers continuous
+   * elements, where the copier adds to the entries of degrees of freedom on
+   * common vertices, edges, and faces. For other cell iterators, two cells
+   * are in conflict if they share a vertex. If @p flags contains any of the
+   * flags for interior faces, the conflict indices of the face neighbors of
+   * a cell are added to the ones of the cell, because the @p face_worker of
+   * either cell may add contributions to the neighbor. In the case of
+   * discontinuous elements, this means that two cells are in conflict if
+   * they are face neighbors or share a face neighbor.
+   *
+   * @note The conflicts are computed from the degrees of freedom of the
+   * cells. If the copier distributes the local contributions through an
+   * AffineConstraints object whose constraints couple degrees of freedom of
+   * cells that do not share any degree of freedom, the coloring must be
+   * computed with GraphColoring::make_graph_coloring() and the constrained
+   * indices instead.
+   *
+   * @ingroup MeshWorker
+   */
+  template <class CellIteratorType,
+            class CellIteratorBaseType =
+              typename internal::CellIteratorBaseType<CellIteratorType>::type>
+  std::vector<std::vector<CellIteratorBaseType>>
+  make_cell_coloring(const CellIteratorType &                         begin,
+                     const typename identity<CellIteratorType>::type &end,
+                     const AssembleFlags flags = assemble_own_cells)
+  {
+    std::vector<std::vector<CellIteratorBaseType>> colored_cells;
+
+    // collect the cells first, because the coloring algorithm needs to
+    // compare the iterators, which is not possible for all iterator types
+    std::vector<CellIteratorBaseType> cells;
+    for (CellIteratorType it = begin; it != end; ++it)
+      cells.push_back(it);
+    if (cells.empty())
+      return colored_cells;
+
+    const bool work_on_interior_faces =
+      flags & (assemble_own_interior_faces_once |
+               assemble_own_interior_faces_both | assemble_ghost_faces_once |
+               assemble_ghost_faces_both);
+
+    using VectorIterator =
+      typename std::vector<CellIteratorBaseType>::const_iterator;
+    const auto get_conflict_indices = [&](const VectorIterator &it) {
+      const CellIteratorBaseType &         cell = *it;
+      std::vector<types::global_dof_index> conflict_indices;
+      internal::append_conflict_indices(cell, conflict_indices, 0);
+      if (work_on_interior_faces)
+        for (const unsigned int face_no :
+             GeometryInfo<CellIteratorBaseType::AccessorType::Container::
+                            dimension>::face_indices())
+          {
+            if (cell->at_boundary(face_no) &&
+                !cell->has_periodic_neighbor(face_no))
+              continue;
+
+            const bool periodic_neighbor = cell->has_periodic_neighbor(face_no);
+            const auto neighbor = cell->neighbor_or_periodic_neighbor(face_no);
+            if (dealii::internal::is_active_iterator(cell) &&
+                neighbor->has_children())
+              {
+                // the face worker is called from the finer side, which may
+                // write into this cell
+                const unsigned int n_subfaces =
+                  periodic_neighbor ?
+                    neighbor->face(cell->periodic_neighbor_face_no(face_no))
+                      ->n_children() :
+                    cell->face(face_no)->n_children();
+                for (unsigned int subface = 0; subface < n_subfaces; ++subface)
+                  internal::append_conflict_indices(
+                    periodic_neighbor ?
+                      cell->periodic_neighbor_child_on_subface(face_no,
+                                                               subface) :
+                      cell->neighbor_child_on_subface(face_no, subface),
+                    conflict_indices,
+                    0);
+              }
+            else if (!neighbor->is_artificial())
+              internal::append_conflict_indices(neighbor, conflict_indices, 0);
+          }
+      return conflict_indices;
+    };
+
+    const auto colors = GraphColoring::make_graph_coloring(
+      cells.cbegin(),
+      cells.cend(),
+      std::function<std::vector<types::global_dof_index>(
+        const VectorIterator &)>(get_conflict_indices));
+
+    colored_cells.resize(colors.size());
+    for (unsigned int color = 0; color < colors.size(); ++color)
+      {
+        colored_cells[color].reserve(colors[color].size());
+        for (const auto &it : colors[color])
+          colored_cells[color].push_back(*it);
+      }
+    return colored_cells;
+  }
+
+  /**
+   * Same as the function above, but for iterator ranges (and, therefore,
+   * filtered iterators).
+   *
+   * @ingroup MeshWorker
+   */
+  template <class CellIteratorType,
+            class CellIteratorBaseType =
+              typename internal::CellIteratorBaseType<CellIteratorType>::type>
+  std::vector<std::vector<CellIteratorBaseType>>
+  make_cell_coloring(IteratorRange<CellIteratorType> iterator_range,
+                     const AssembleFlags flags = assemble_own_cells)
+  {
+    return make_cell_coloring<
+      typename IteratorRange<CellIteratorType>::IteratorOverIterators,
+      CellIteratorBaseType>(iterator_range.begin(),
+                            iterator_range.end(),
+                            flags);
+  }
+
+  /**
+   * A variant of the mesh_loop() function that works on cells partitioned
+   * into colors, for example by make_cell_coloring(). The colors are
+   * processed one after the other. Within one color, both the workers and the
+   * @p copier are called concurrently on several threads, using the colored
+   * variant of WorkStream::run(). This removes the serialization of the
+   * copier, which otherwise limits the parallel scalability of the assembly
+   * in particular for discontinuous Galerkin methods with their cheap
+   * face integrals and large copy operations.
+   *
+   * The coloring must guarantee that the copier calls for two cells of the
+   * same color do not write into the same global data, including the
+   * contributions of the @p face_worker to the neighbors of a cell. For
+   * flags like assemble_own_interior_faces_once, this means that the face
+   * terms are still computed by one of the two adjacent cells, but the
+   * copying of the face contributions of different colors happens in
+   * parallel without any locks.
+   *
+   * All other arguments have the same meaning as in the function above.
+   *
+   * @ingroup MeshWorker
+   */
+  template <class CellIteratorBaseType, class ScratchData, class CopyData>
+  void
+  mesh_loop(
+    const std::vector<std::vector<CellIteratorBaseType>> &colored_cells,
+
+    const typename identity<std::function<
+      void(const CellIteratorBaseType &, ScratchData &, CopyData &)>>::type
+      &cell_worker,
+    const typename identity<std::function<void(const CopyData &)>>::type
+      &copier,
+
+    const ScratchData &sample_scratch_data,
+    const CopyData &   sample_copy_data,
+
+    const AssembleFlags flags = assemble_own_cells,
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &boundary_worker = std::function<void(const CellIteratorBaseType &,
+                                            const unsigned int,
+                                            ScratchData &,
+                                            CopyData &)>(),
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &face_worker = std::function<void(const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        ScratchData &,
+                                        CopyData &)>(),
+
+    const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
+    const unsigned int chunk_size   = 8)
+  {
+    internal::check_mesh_loop_arguments(flags,
+                                        cell_worker,
+                                        boundary_worker,
+                                        face_worker);
+
+    auto cell_action = [&](const CellIteratorBaseType &cell,
+                           ScratchData &               scratch,
+                           CopyData &                  copy) {
+      internal::mesh_loop_cell_action(cell,
+                                      scratch,
+                                      copy,
+                                      sample_copy_data,
+                                      flags,
+                                      cell_worker,
+                                      boundary_worker,
+                                      face_worker);
+    };
+
+    // Submit to the colored variant of workstream
+    WorkStream::run(colored_cells,
+                    cell_action,
+                    copier,
+                    sample_scratch_data,
+                    sample_copy_data,
+                    queue_length,
+                    chunk_size);
+  }
+
   /**
    * This is a variant of the mesh_loop() function, that can be used for worker
    * and copier functions that are member functions of a class.
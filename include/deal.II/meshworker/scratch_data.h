@@ -20,6 +20,9 @@
 
 #include <deal.II/algorithms/general_data_storage.h>
 
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/table.h>
+
 #include <deal.II/differentiation/ad.h>
 
 #include <deal.II/fe/fe_values.h>
@@ -212,6 +215,33 @@ namespace MeshWorker
    * }
    * @endcode
    *
+   * The functions above identify solution vectors by strings and store their
+   * results in a GeneralDataStorage object, which involves the construction
+   * of strings and a lookup in a map on each call. For fast assembly loops,
+   * in particular with low order elements where the cost per cell is small,
+   * the fields can instead be registered once by register_field(), which
+   * returns an integer index. The local values extracted with that index are
+   * kept in pre-allocated tables, and evaluate_fields() computes the values
+   * and gradients of all components of all registered fields in a single
+   * pass over the shape functions:
+   * @code
+   * const unsigned int u_old = scratch.register_field("old_solution");
+   * const unsigned int u     = scratch.register_field("solution");
+   *
+   * for (const auto &cell : dof_handler.active_cell_iterators())
+   *   {
+   *     scratch.reinit(cell);
+   *     scratch.extract_local_dof_values(u_old, old_solution);
+   *     scratch.extract_local_dof_values(u, solution);
+   *     scratch.evaluate_fields();
+   *
+   *     const ArrayView<const double> values = scratch.get_field_values(u);
+   *     const ArrayView<const Tensor<1, spacedim>> old_gradients =
+   *       scratch.get_field_gradients(u_old);
+   *     ...
+   *   }
+   * @endcode
+   *
    * When using this class, please cite
    * @code{.bib}
    * @article{SartoriGiulianiBardelloni-2018-a,
@@ -760,6 +790,87 @@ namespace MeshWorker
 
     /** @} */ // CurrentCellEvaluation
 
+    /**
+     * @name Integer-indexed evaluation of finite element fields on the current cell
+     */
+    /** @{ */ // CurrentCellFieldEvaluation
+
+    /**
+     * Register a finite element field with the name @p global_vector_name
+     * and return the index under which its local dof values and its values
+     * and gradients are stored. If a field with the same name has been
+     * registered before, its index is returned.
+     *
+     * All fields should be registered before the first call to
+     * extract_local_dof_values() with an integer index, since registering a
+     * new field invalidates the data stored for the other fields. Copies of
+     * this object, as created by WorkStream::run() and
+     * MeshWorker::mesh_loop(), share the same indices.
+     */
+    unsigned int
+    register_field(const std::string &global_vector_name);
+
+    /**
+     * Return the number of fields registered by register_field().
+     */
+    unsigned int
+    n_fields() const;
+
+    /**
+     * Extract the local dof values of @p input_vector on the internally
+     * initialized cell into the storage of the field with index
+     * @p field_index. Contrary to the variant of this function taking a
+     * string, no memory is allocated and no names are looked up. Only
+     * double values are supported, i.e., the local values cannot be
+     * automatic differentiation numbers.
+     */
+    template <typename VectorType>
+    void
+    extract_local_dof_values(const unsigned int field_index,
+                             const VectorType & input_vector);
+
+    /**
+     * Return the local dof values of the field with index @p field_index as
+     * stored by the last call to extract_local_dof_values().
+     */
+    ArrayView<const double>
+    get_local_dof_values(const unsigned int field_index) const;
+
+    /**
+     * Compute the values and/or gradients (as selected by @p update_flags)
+     * of all components of all registered fields at the quadrature points of
+     * the FEValues object returned by get_current_fe_values(). The shape
+     * functions are visited only once for all fields, and the result is
+     * stored in tables that are only re-allocated if the number of
+     * quadrature points changes, e.g. between cells and faces.
+     *
+     * The local dof values of all fields must have been extracted on the
+     * current cell before calling this function.
+     */
+    void
+    evaluate_fields(const UpdateFlags update_flags = update_values |
+                                                     update_gradients);
+
+    /**
+     * Return the values of the given @p component of the field with index
+     * @p field_index at the quadrature points, as computed by the last call
+     * to evaluate_fields().
+     */
+    ArrayView<const double>
+    get_field_values(const unsigned int field_index,
+                     const unsigned int component = 0) const;
+
+    /**
+     * Return the gradients of the given @p component of the field with index
+     * @p field_index at the quadrature points, as computed by the last call
+     * to evaluate_fields().
+     */
+    ArrayView<const Tensor<1, spacedim>>
+    get_field_gradients(const unsigned int field_index,
+                        const unsigned int component = 0) const;
+
+    /** @} */ // CurrentCellFieldEvaluation
+
     /**
      * Return a reference to the used mapping.
      */
@@ -895,6 +1006,29 @@ namespace MeshWorker
      * object on the neighbor cell.
      */
     SmartPointer<FEValuesBase<dim, spacedim>> current_neighbor_fe_values;
+
+    /**
+     * Names of the fields registered by register_field().
+     */
+    std::vector<std::string> field_names;
+
+    /**
+     * Local dof values of the registered fields, with the field index as
+     * first and the local dof index as second index.
+     */
+    Table<2, double> field_dof_values;
+
+    /**
+     * Values of the registered fields, indexed by the field, the component,
+     * and the quadrature point.
+     */
+    Table<3, double> field_values;
+
+    /**
+     * Gradients of the registered fields, indexed by the field, the
+     * component, and the quadrature point.
+     */
+    Table<3, Tensor<1, spacedim>> field_gradients;
   };
 
 #ifndef DOXYGEN
@@ -964,6 +1098,24 @@ namespace MeshWorker
 
 
 
+  template <int dim, int spacedim>
+  template <typename VectorType>
+  void
+  ScratchData<dim, spacedim>::extract_local_dof_values(
+    const unsigned int field_index,
+    const VectorType & input_vector)
+  {
+    AssertIndexRange(field_index, field_names.size());
+    const unsigned int n_dofs = get_current_fe_values().get_fe().dofs_per_cell;
+    AssertDimension(field_dof_values.size(1), n_dofs);
+
+    double *dof_values = &field_dof_values(field_index, 0);
+    for (unsigned int i = 0; i < n_dofs; ++i)
+      dof_values[i] = input_vector(local_dof_indices[i]);
+  }
+
+
+
   template <int dim, int spacedim>
   template <typename Number>
   const std::vector<Number> &
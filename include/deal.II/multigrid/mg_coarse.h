@@ -19,12 +19,21 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/householder.h>
 #include <deal.II/lac/linear_operator.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
 
 #include <deal.II/multigrid/mg_base.h>
 
+#include <memory>
+
 DEAL_II_NAMESPACE_OPEN
 
 /*!@addtogroup mg */
@@ -329,6 +338,147 @@ private:
   LAPACKFullMatrix<number> matrix;
 };
 
+/**
+ * Coarse grid solver using a sparse direct factorization of the coarse grid
+ * matrix.
+ *
+ * Upon initialization, the rows of the matrix owned by the individual
+ * processes are gathered on the first process of the given communicator,
+ * which assembles them into a SparseMatrix and computes its factorization
+ * with an object of type @p DirectSolverType. The factorization is computed
+ * only once and reused in all applications of the coarse grid solver, i.e.,
+ * in all cycles of the multigrid method. The same holds for the
+ * communication pattern: operator() only gathers the locally owned entries
+ * of the right hand side on the first process with a single collective
+ * operation and scatters the solution back in the same way. Compared to an
+ * iterative coarse grid solver, this replaces the global reductions of each
+ * iteration by one gather and one scatter operation per application, and
+ * compared to MGCoarseGridHouseholder and MGCoarseGridSVD it avoids dense
+ * matrices, which makes it suitable for coarse problems with tens of
+ * thousands of unknowns.
+ *
+ * The type @p MatrixType of the matrix passed to initialize() needs to
+ * provide the functions <code>m()</code>, <code>n()</code>, and row
+ * iterators <code>begin(row)</code> and <code>end(row)</code> for all locally
+ * owned rows, whose entries provide <code>column()</code> and
+ * <code>value()</code>. This is the case for SparseMatrix and
+ * TrilinosWrappers::SparseMatrix. The type @p DirectSolverType needs to
+ * provide the functions <code>initialize(const SparseMatrix<double> &)</code>
+ * and <code>vmult(Vector<double> &, const Vector<double> &) const</code>.
+ *
+ * @note Since all rows are gathered on a single process, the size of the
+ * coarse problem is limited by the memory of one process, and all other
+ * processes are idle while the coarse problem is solved.
+ */
+template <class VectorType       = Vector<double>,
+          class DirectSolverType = SparseDirectUMFPACK>
+class MGCoarseGridSparseDirect : public MGCoarseGridBase<VectorType>
+{
+public:
+  /**
+   * Constructor leaving an uninitialized object.
+   */
+  MGCoarseGridSparseDirect();
+
+  /**
+   * Gather the locally owned rows @p locally_owned_rows of @p matrix on the
+   * first process of @p communicator and factorize the matrix there.
+   */
+  template <typename MatrixType>
+  void
+  initialize(const MatrixType &matrix,
+             const IndexSet &  locally_owned_rows,
+             const MPI_Comm &  communicator);
+
+  /**
+   * Initialize for a matrix that is completely stored on the current
+   * process.
+   */
+  template <typename MatrixType>
+  void
+  initialize(const MatrixType &matrix);
+
+  /**
+   * Release the factorization and all other memory.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the inverse of the coarse grid matrix to @p src and store the
+   * result in @p dst.
+   */
+  void
+  operator()(const unsigned int level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+private:
+  /**
+   * The communicator over which the matrix is distributed.
+   */
+  MPI_Comm communicator;
+
+  /**
+   * The rows owned by the current process, in the order in which they are
+   * sent to the first process.
+   */
+  std::vector<types::global_dof_index> owned_rows;
+
+  /**
+   * The number of rows sent by each process. Only set on the first process.
+   */
+  std::vector<int> n_rows_per_process;
+
+  /**
+   * The offsets of the rows of each process in the gathered data. Only set
+   * on the first process.
+   */
+  std::vector<int> row_offsets;
+
+  /**
+   * The global row indices of the gathered data. Only set on the first
+   * process.
+   */
+  std::vector<types::global_dof_index> gathered_rows;
+
+  /**
+   * Sparsity pattern of the gathered matrix.
+   */
+  SparsityPattern sparsity_pattern;
+
+  /**
+   * The gathered matrix. Only set on the first process.
+   */
+  SparseMatrix<double> coarse_matrix;
+
+  /**
+   * The direct solver holding the factorization. Only set on the first
+   * process.
+   */
+  std::unique_ptr<DirectSolverType> direct_solver;
+
+  /**
+   * Buffer for the locally owned entries of the vectors.
+   */
+  mutable std::vector<double> local_values;
+
+  /**
+   * Buffer for the gathered entries of the vectors.
+   */
+  mutable std::vector<double> gathered_values;
+
+  /**
+   * Right hand side of the gathered problem.
+   */
+  mutable Vector<double> coarse_rhs;
+
+  /**
+   * Solution of the gathered problem.
+   */
+  mutable Vector<double> coarse_solution;
+};
+
 /*@}*/
 
 #ifndef DOXYGEN
@@ -588,6 +738,200 @@ operator()(const unsigned int /*level*/,
   householder.least_squares(dst, src);
 }
 
+/* ------------------ Functions for MGCoarseGridSparseDirect ----------- */
+
+template <class VectorType, class DirectSolverType>
+MGCoarseGridSparseDirect<VectorType, DirectSolverType>::
+  MGCoarseGridSparseDirect()
+  : communicator(MPI_COMM_SELF)
+{}
+
+
+
+template <class VectorType, class DirectSolverType>
+template <typename MatrixType>
+void
+MGCoarseGridSparseDirect<VectorType, DirectSolverType>::initialize(
+  const MatrixType &matrix)
+{
+  initialize(matrix, complete_index_set(matrix.m()), MPI_COMM_SELF);
+}
+
+
+
+template <class VectorType, class DirectSolverType>
+template <typename MatrixType>
+void
+MGCoarseGridSparseDirect<VectorType, DirectSolverType>::initialize(
+  const MatrixType &matrix,
+  const IndexSet &  locally_owned_rows,
+  const MPI_Comm &  communicator)
+{
+  AssertDimension(matrix.m(), matrix.n());
+  AssertDimension(locally_owned_rows.size(), matrix.m());
+
+  clear();
+  this->communicator = communicator;
+  locally_owned_rows.fill_index_vector(owned_rows);
+
+  // Pack the locally owned rows in the format
+  // [row, n_entries, column_0, ..., column_{n_entries-1}] for the pattern
+  // and the values separately
+  std::vector<types::global_dof_index> local_pattern;
+  std::vector<double>                  local_matrix_values;
+  for (const types::global_dof_index row : owned_rows)
+    {
+      local_pattern.push_back(row);
+      const std::size_t n_entries_position = local_pattern.size();
+      local_pattern.push_back(0);
+      for (auto entry = matrix.begin(row); entry != matrix.end(row); ++entry)
+        {
+          local_pattern.push_back(entry->column());
+          local_matrix_values.push_back(entry->value());
+          ++local_pattern[n_entries_position];
+        }
+    }
+
+  const std::vector<std::vector<types::global_dof_index>> all_patterns =
+    Utilities::MPI::gather(communicator, local_pattern);
+  const std::vector<std::vector<double>> all_values =
+    Utilities::MPI::gather(communicator, local_matrix_values);
+
+  local_values.resize(owned_rows.size());
+
+  if (Utilities::MPI::this_mpi_process(communicator) != 0)
+    return;
+
+  // Build the sparsity pattern and remember the global row of each entry in
+  // the gathered vectors
+  DynamicSparsityPattern dsp(matrix.m(), matrix.n());
+  n_rows_per_process.resize(all_patterns.size());
+  row_offsets.resize(all_patterns.size());
+  for (unsigned int p = 0; p < all_patterns.size(); ++p)
+    {
+      row_offsets[p] = gathered_rows.size();
+      for (std::size_t i = 0; i < all_patterns[p].size();)
+        {
+          const types::global_dof_index row       = all_patterns[p][i];
+          const types::global_dof_index n_entries = all_patterns[p][i + 1];
+          gathered_rows.push_back(row);
+          dsp.add_entries(row,
+                          all_patterns[p].begin() + i + 2,
+                          all_patterns[p].begin() + i + 2 + n_entries);
+          i += 2 + n_entries;
+        }
+      n_rows_per_process[p] = gathered_rows.size() - row_offsets[p];
+    }
+  AssertDimension(gathered_rows.size(), matrix.m());
+
+  sparsity_pattern.copy_from(dsp);
+  coarse_matrix.reinit(sparsity_pattern);
+  for (unsigned int p = 0; p < all_patterns.size(); ++p)
+    {
+      std::size_t value_index = 0;
+      for (std::size_t i = 0; i < all_patterns[p].size();)
+        {
+          const types::global_dof_index row       = all_patterns[p][i];
+          const types::global_dof_index n_entries = all_patterns[p][i + 1];
+          for (types::global_dof_index j = 0; j < n_entries; ++j)
+            coarse_matrix.add(row,
+                              all_patterns[p][i + 2 + j],
+                              all_values[p][value_index++]);
+          i += 2 + n_entries;
+        }
+    }
+
+  direct_solver = std::make_unique<DirectSolverType>();
+  direct_solver->initialize(coarse_matrix);
+
+  gathered_values.resize(gathered_rows.size());
+  coarse_rhs.reinit(matrix.m());
+  coarse_solution.reinit(matrix.m());
+}
+
+
+
+template <class VectorType, class DirectSolverType>
+void
+MGCoarseGridSparseDirect<VectorType, DirectSolverType>::clear()
+{
+  owned_rows.clear();
+  n_rows_per_process.clear();
+  row_offsets.clear();
+  gathered_rows.clear();
+  direct_solver.reset();
+  coarse_matrix.clear();
+  sparsity_pattern.reinit(0, 0, 0);
+  local_values.clear();
+  gathered_values.clear();
+  coarse_rhs.reinit(0);
+  coarse_solution.reinit(0);
+}
+
+
+
+template <class VectorType, class DirectSolverType>
+void
+MGCoarseGridSparseDirect<VectorType, DirectSolverType>::
+operator()(const unsigned int /*level*/,
+           VectorType &      dst,
+           const VectorType &src) const
+{
+  Assert(local_values.size() == owned_rows.size(), ExcNotInitialized());
+
+  for (std::size_t i = 0; i < owned_rows.size(); ++i)
+    local_values[i] = src(owned_rows[i]);
+
+#ifdef DEAL_II_WITH_MPI
+  if (Utilities::MPI::n_mpi_processes(communicator) > 1)
+    {
+      const bool is_root = Utilities::MPI::this_mpi_process(communicator) == 0;
+
+      int ierr = MPI_Gatherv(local_values.data(),
+                             local_values.size(),
+                             MPI_DOUBLE,
+                             gathered_values.data(),
+                             n_rows_per_process.data(),
+                             row_offsets.data(),
+                             MPI_DOUBLE,
+                             0,
+                             communicator);
+      AssertThrowMPI(ierr);
+
+      if (is_root)
+        {
+          for (std::size_t i = 0; i < gathered_rows.size(); ++i)
+            coarse_rhs(gathered_rows[i]) = gathered_values[i];
+          direct_solver->vmult(coarse_solution, coarse_rhs);
+          for (std::size_t i = 0; i < gathered_rows.size(); ++i)
+            gathered_values[i] = coarse_solution(gathered_rows[i]);
+        }
+
+      ierr = MPI_Scatterv(gathered_values.data(),
+                          n_rows_per_process.data(),
+                          row_offsets.data(),
+                          MPI_DOUBLE,
+                          local_values.data(),
+                          local_values.size(),
+                          MPI_DOUBLE,
+                          0,
+                          communicator);
+      AssertThrowMPI(ierr);
+    }
+  else
+#endif
+    {
+      for (std::size_t i = 0; i < owned_rows.size(); ++i)
+        coarse_rhs(owned_rows[i]) = local_values[i];
+      direct_solver->vmult(coarse_solution, coarse_rhs);
+      for (std::size_t i = 0; i < owned_rows.size(); ++i)
+        local_values[i] = coarse_solution(owned_rows[i]);
+    }
+
+  for (std::size_t i = 0; i < owned_rows.size(); ++i)
+    dst(owned_rows[i]) = local_values[i];
+}
+
 //---------------------------------------------------------------------------
 
 
@@ -117,8 +117,35 @@ namespace mg
  *
  * The function which starts a multigrid cycle on the finest level is cycle().
  * Depending on the cycle type chosen with the constructor (see enum Cycle),
- * this function triggers one of the cycles level_v_step() or level_step(),
- * where the latter one can do different types of cycles.
+ * this function triggers one of the cycles level_v_step(), level_step(), or
+ * level_additive_step(), where level_step() can do different types of
+ * multiplicative cycles.
+ *
+ * <h3>Additive and hybrid cycles</h3>
+ *
+ * In the multiplicative cycles, the levels are visited one after the other,
+ * and the work on the coarse levels, which often leaves most processors
+ * idle in parallel computations, lies on the critical path of every cycle.
+ * In the additive cycle (Cycle::additive_cycle), the defect is first
+ * restricted to all levels. Then, the smoother is applied to the restricted
+ * defect on every level and the coarse grid solver is applied on the coarsest
+ * level. Since these operations are independent of each other, they can be
+ * run concurrently, see set_concurrent_levels(). Finally, the corrections are
+ * prolongated and summed up from the coarsest to the finest level. This
+ * corresponds to a BPX-type preconditioner with smoothers on each level,
+ * which is symmetric if the smoother is symmetric, but usually needs more
+ * iterations of the outer solver than a V-cycle.
+ *
+ * The hybrid cycle (Cycle::hybrid_cycle) combines both approaches: the levels
+ * above the level set by set_hybrid_level() are treated as in a V-cycle, and
+ * the remaining coarse levels, including the coarse grid solver, are treated
+ * additively. This keeps the robustness of the V-cycle on the fine levels
+ * where most of the work is done, and removes the sequential dependency
+ * between the coarse levels, which are latency-dominated.
+ *
+ * @note Additive cycles do not support the edge matrices set by
+ * set_edge_matrices() and set_edge_flux_matrices() on the levels treated
+ * additively.
  *
  * Using this class, it is expected that the right hand side has been
  * converted from a vector living on the locally finest level to a multilevel
@@ -147,7 +174,12 @@ public:
     /// The W-cycle
     w_cycle,
     /// The F-cycle
-    f_cycle
+    f_cycle,
+    /// The additive cycle, see level_additive_step()
+    additive_cycle,
+    /// A V-cycle on the fine levels with an additive cycle on the coarse
+    /// levels, see set_hybrid_level()
+    hybrid_cycle
   };
 
   using vector_type       = VectorType;
@@ -272,6 +304,31 @@ public:
    */
   void set_cycle(Cycle);
 
+  /**
+   * Set the finest level that is treated additively in the hybrid cycle.
+   * Levels above @p level are treated as in a V-cycle. By default, this is
+   * the coarsest level, such that the hybrid cycle is identical to the
+   * V-cycle.
+   */
+  void
+  set_hybrid_level(const unsigned int level);
+
+  /**
+   * Select whether the independent operations on the different levels of an
+   * additive cycle, i.e., the smoothers and the coarse grid solver, are run
+   * concurrently as tasks. By default, they are run one after the other.
+   *
+   * @note This requires the smoothers, the level matrices and the coarse
+   * grid solver to be thread-safe with respect to operations on different
+   * levels. In particular, the communication of parallel vectors on different
+   * levels must not interfere, which is not guaranteed for MPI communication
+   * issued concurrently from different threads. Only enable this option if
+   * the level operations do not communicate or use separate communicators
+   * on each level.
+   */
+  void
+  set_concurrent_levels(const bool concurrent_levels);
+
   /**
    * Connect a function to mg::Signals::coarse_solve.
    */
@@ -332,11 +389,36 @@ private:
   void
   level_step(const unsigned int level, Cycle cycle);
 
+  /**
+   * The additive multigrid method on all levels between #minlevel and
+   * <tt>level</tt>. The defect on <tt>level</tt> is restricted to all coarser
+   * levels, the smoother (or the coarse grid solver on #minlevel) is applied
+   * on each level independently, and the corrections are prolongated and
+   * added up.
+   */
+  void
+  level_additive_step(const unsigned int level);
+
   /**
    * Cycle type performed by the method cycle().
    */
   Cycle cycle_type;
 
+  /**
+   * Finest level treated additively in the hybrid cycle.
+   */
+  unsigned int hybrid_level;
+
+  /**
+   * Finest level treated additively by level_v_step() in the current cycle.
+   */
+  unsigned int additive_level;
+
+  /**
+   * Flag whether the levels of the additive cycle are run concurrently.
+   */
+  bool concurrent_levels;
+
   /**
    * Level for coarse grid solution.
    */
@@ -602,6 +684,9 @@ Multigrid<VectorType>::Multigrid(const MGMatrixBase<VectorType> &    matrix,
                                  const unsigned int                max_level,
                                  Cycle                             cycle)
   : cycle_type(cycle)
+  , hybrid_level(min_level)
+  , additive_level(min_level)
+  , concurrent_levels(false)
   , matrix(&matrix, typeid(*this).name())
   , coarse(&coarse, typeid(*this).name())
   , transfer(&transfer, typeid(*this).name())
@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/multigrid/multigrid.h>
 
@@ -74,6 +75,24 @@ Multigrid<VectorType>::set_cycle(typename Multigrid<VectorType>::Cycle c)
 
 
 
+template <typename VectorType>
+void
+Multigrid<VectorType>::set_hybrid_level(const unsigned int level)
+{
+  hybrid_level = level;
+}
+
+
+
+template <typename VectorType>
+void
+Multigrid<VectorType>::set_concurrent_levels(const bool concurrent)
+{
+  concurrent_levels = concurrent;
+}
+
+
+
 template <typename VectorType>
 void
 Multigrid<VectorType>::set_edge_matrices(const MGMatrixBase<VectorType> &down,
@@ -109,6 +128,13 @@ Multigrid<VectorType>::level_v_step(const unsigned int level)
       return;
     }
 
+  // the coarse levels of the hybrid cycle are treated additively
+  if (level <= additive_level)
+    {
+      level_additive_step(level);
+      return;
+    }
+
   // smoothing of the residual
   this->signals.pre_smoother_step(true, level);
   pre_smooth->apply(level, solution[level], defect[level]);
@@ -246,6 +272,64 @@ Multigrid<VectorType>::level_step(const unsigned int level, Cycle cycle)
 
 
 
+template <typename VectorType>
+void
+Multigrid<VectorType>::level_additive_step(const unsigned int level)
+{
+  Assert(edge_out == nullptr && edge_in == nullptr && edge_down == nullptr &&
+           edge_up == nullptr,
+         ExcMessage("Edge matrices are not supported by additive cycles."));
+
+  // Restrict the defect to all coarser levels. Since the contributions
+  // from copy_to_mg are already in the defect vectors of the coarser
+  // levels, the restriction is added to them.
+  for (unsigned int l = level; l > minlevel; --l)
+    {
+      this->signals.restriction(true, l);
+      transfer->restrict_and_add(l, defect[l - 1], defect[l]);
+      this->signals.restriction(false, l);
+    }
+
+  // The smoothers on all levels and the coarse grid solver are independent
+  // of each other
+  const auto smooth_level = [this](const unsigned int l) {
+    if (l == minlevel)
+      {
+        this->signals.coarse_solve(true, l);
+        (*coarse)(l, solution[l], defect[l]);
+        this->signals.coarse_solve(false, l);
+      }
+    else
+      {
+        this->signals.pre_smoother_step(true, l);
+        pre_smooth->apply(l, solution[l], defect[l]);
+        this->signals.pre_smoother_step(false, l);
+      }
+  };
+
+  if (concurrent_levels)
+    {
+      Threads::TaskGroup<> tasks;
+      for (unsigned int l = minlevel; l <= level; ++l)
+        tasks += Threads::new_task([&smooth_level, l]() { smooth_level(l); });
+      tasks.join_all();
+    }
+  else
+    for (unsigned int l = minlevel; l <= level; ++l)
+      smooth_level(l);
+
+  // Sum up the corrections from the coarsest to the finest level
+  for (unsigned int l = minlevel + 1; l <= level; ++l)
+    {
+      this->signals.prolongation(true, l);
+      transfer->prolongate(l, t[l], solution[l - 1]);
+      this->signals.prolongation(false, l);
+      solution[l] += t[l];
+    }
+}
+
+
+
 template <typename VectorType>
 void
 Multigrid<VectorType>::cycle()
@@ -254,7 +338,7 @@ Multigrid<VectorType>::cycle()
   // other vectors.
   solution.resize(minlevel, maxlevel);
   t.resize(minlevel, maxlevel);
-  if (cycle_type != v_cycle)
+  if (cycle_type == w_cycle || cycle_type == f_cycle)
     defect2.resize(minlevel, maxlevel);
 
   for (unsigned int level = minlevel; level <= maxlevel; ++level)
@@ -263,12 +347,20 @@ Multigrid<VectorType>::cycle()
       // method of the smoother -> do not force them to be zeroed out here
       solution[level].reinit(defect[level], level > minlevel);
       t[level].reinit(defect[level], level > minlevel);
-      if (cycle_type != v_cycle)
+      if (cycle_type == w_cycle || cycle_type == f_cycle)
         defect2[level].reinit(defect[level]);
     }
 
-  if (cycle_type == v_cycle)
-    level_v_step(maxlevel);
+  if (cycle_type == v_cycle || cycle_type == hybrid_cycle)
+    {
+      additive_level =
+        (cycle_type == hybrid_cycle) ?
+          std::min(std::max(hybrid_level, minlevel), maxlevel) :
+          minlevel;
+      level_v_step(maxlevel);
+    }
+  else if (cycle_type == additive_cycle)
+    level_additive_step(maxlevel);
   else
     level_step(maxlevel, cycle_type);
 }
@@ -289,6 +381,7 @@ Multigrid<VectorType>::vcycle()
       solution[level].reinit(defect[level], level > minlevel);
       t[level].reinit(defect[level], level > minlevel);
     }
+  additive_level = minlevel;
   level_v_step(maxlevel);
 }
 
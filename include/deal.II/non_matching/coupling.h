@@ -82,10 +82,20 @@ namespace NonMatching
    * For both spaces, it is possible to specify a custom Mapping, which
    * defaults to StaticMappingQ1 for both.
    *
-   * This function will also work in parallel, provided that the immersed
-   * triangulation is of type parallel::shared::Triangulation<dim1,spacedim>.
-   * An exception is thrown if you use an immersed
-   * parallel::distributed::Triangulation<dim1,spacedim>.
+   * This function will also work in parallel. If the immersed triangulation
+   * is of type parallel::shared::Triangulation<dim1,spacedim>, every process
+   * loops over all immersed cells and only keeps the contributions of its
+   * locally owned cells of the embedding triangulation. If the immersed
+   * triangulation is a parallel::distributed::Triangulation<dim1,spacedim>,
+   * every process computes the quadrature points of its locally owned
+   * immersed cells and sends them to the processes whose locally owned cells
+   * of the embedding triangulation might contain them. In this case, both
+   * triangulations must use the same MPI communicator.
+   *
+   * The cells of the embedding triangulation are found by querying the
+   * r-tree of their bounding boxes, the inverse mappings of all points in a
+   * cell are computed together by Mapping::transform_points_real_to_unit_cell(),
+   * and the immersed cells are processed in parallel with WorkStream.
    *
    * See the tutorial program step-60 for an example on how to use this
    * function.
@@ -174,10 +184,20 @@ namespace NonMatching
    * For both spaces, it is possible to specify a custom Mapping, which
    * defaults to StaticMappingQ1 for both.
    *
-   * This function will also work in parallel, provided that the immersed
-   * triangulation is of type parallel::shared::Triangulation<dim1,spacedim>.
-   * An exception is thrown if you use an immersed
-   * parallel::distributed::Triangulation<dim1,spacedim>.
+   * This function will also work in parallel. If the immersed triangulation
+   * is of type parallel::shared::Triangulation<dim1,spacedim>, every process
+   * loops over all immersed cells and only keeps the contributions of its
+   * locally owned cells of the embedding triangulation. If the immersed
+   * triangulation is a parallel::distributed::Triangulation<dim1,spacedim>,
+   * every process computes the quadrature points of its locally owned
+   * immersed cells and sends them to the processes whose locally owned cells
+   * of the embedding triangulation might contain them. In this case, both
+   * triangulations must use the same MPI communicator.
+   *
+   * The cells of the embedding triangulation are found by querying the
+   * r-tree of their bounding boxes, the inverse mappings of all points in a
+   * cell are computed together by Mapping::transform_points_real_to_unit_cell(),
+   * and the immersed cells are processed in parallel with WorkStream.
    *
    * See the tutorial program step-60 for an example on how to use this
    * function.
@@ -353,6 +373,42 @@ namespace NonMatching
       AffineConstraints<typename Matrix::value_type>(),
     const ComponentMask &comps0 = ComponentMask(),
     const ComponentMask &comps1 = ComponentMask());
+
+  namespace internal
+  {
+    /**
+     * Given a cloud of @p points in real space, typically the quadrature
+     * points of one cell of an immersed triangulation, find the locally owned
+     * cells of the embedding triangulation stored in @p cache that contain
+     * them, together with the reference coordinates of the points in each of
+     * these cells.
+     *
+     * Candidate cells are identified by querying the r-tree of the cell
+     * bounding boxes of @p cache with the bounding box of @p points. The
+     * candidates are then sorted by their CellId, and the inverse mapping is
+     * computed for all the points of the cloud that lie within the bounding
+     * box of a candidate at once, using
+     * Mapping::transform_points_real_to_unit_cell(). A point lying on the
+     * interface between two cells is assigned to the first of them in this
+     * order, which is the same on all processes of a parallel triangulation.
+     * Only cells that are locally owned are returned.
+     *
+     * On exit, @p cells contains the cells found, and for each of them
+     * @p unit_points and @p point_indices contain the reference coordinates
+     * and the indices within @p points of the points it contains. This
+     * function is thread-safe, provided the r-tree of @p cache has already
+     * been built.
+     */
+    template <int dim0, int spacedim>
+    void
+    locate_points_in_owned_cells(
+      const GridTools::Cache<dim0, spacedim> &cache,
+      const std::vector<Point<spacedim>> &    points,
+      std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>
+        &                                     cells,
+      std::vector<std::vector<Point<dim0>>> & unit_points,
+      std::vector<std::vector<unsigned int>> &point_indices);
+  } // namespace internal
 } // namespace NonMatching
 DEAL_II_NAMESPACE_CLOSE
 
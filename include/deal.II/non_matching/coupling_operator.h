@@ -0,0 +1,495 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_non_matching_coupling_operator
+#define dealii_non_matching_coupling_operator
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_operation.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+namespace NonMatching
+{
+  /**
+   * A matrix-free implementation of the coupling mass matrix assembled by
+   * create_coupling_mass_matrix(), i.e., of the operator
+   * \f[
+   * M_{ij} \dealcoloneq \int_{B} v_i(x) w_j(x) dx,
+   * \f]
+   * where $v_i$ are the basis functions of the finite element space on the
+   * embedding (space) triangulation and $w_j$ those on the immersed
+   * triangulation, and the integral is approximated by a quadrature on the
+   * cells of the immersed triangulation.
+   *
+   * In reinit(), the quadrature points of all immersed cells are located in
+   * the locally owned cells of the space triangulation, and for each pair of
+   * an immersed cell and a space cell, the reference coordinates of the
+   * points, together with the values of the one-dimensional shape functions
+   * of the space element in these points, are stored. The functions vmult()
+   * and Tvmult() then evaluate the space basis functions as tensor products
+   * of these one-dimensional values directly in the stored points, without
+   * ever forming the matrix. The setup cost and the memory consumption are
+   * proportional to the number of quadrature points, as opposed to the
+   * number of nonzero entries of the assembled matrix.
+   *
+   * When the immersed domain moves, e.g., because it is described by a
+   * MappingQEulerian with a new displacement, update_points() recomputes the
+   * locations of the quadrature points. Each point is first searched for in
+   * the space cells it was found in before, and only the points that left
+   * these cells are located through the r-tree of the GridTools::Cache, so
+   * that small movements are cheap.
+   *
+   * The finite element on the space triangulation must be a scalar element
+   * with a tensor product polynomial basis, such as FE_Q or FE_DGQ, or an
+   * FESystem of copies of such an element. The element on the immersed
+   * triangulation must be primitive, and both elements must have the same
+   * number of vector components, which are coupled one by one. Constraints
+   * of the space degrees of freedom are taken into account as in
+   * AffineConstraints::distribute_local_to_global(), i.e., the operator
+   * represents the matrix assembled by create_coupling_mass_matrix() with
+   * the same constraints.
+   *
+   * The vectors passed to vmult() and Tvmult() must give read access to all
+   * the degrees of freedom of the cells used in the coupling, and write
+   * access to the degrees of freedom of the result vector, which is
+   * compressed with VectorOperation::add at the end.
+   */
+  template <int dim0, int dim1, int spacedim, typename Number = double>
+  class CouplingOperator : public Subscriptor
+  {
+  public:
+    /**
+     * Constructor. Create an empty operator, which needs to be initialized
+     * by reinit().
+     */
+    CouplingOperator() = default;
+
+    /**
+     * Initialize the operator for the space DoFHandler @p space_dh, whose
+     * triangulation and mapping are those of @p cache, and the immersed
+     * DoFHandler @p immersed_dh with the quadrature @p quadrature and the
+     * mapping @p immersed_mapping. The constraints @p space_constraints are
+     * applied to the space degrees of freedom. All the arguments need to be
+     * kept alive as long as this object is used, except for the quadrature
+     * and the immersed mapping, which are only used in this function.
+     */
+    void
+    reinit(const GridTools::Cache<dim0, spacedim> &cache,
+           const DoFHandler<dim0, spacedim> &      space_dh,
+           const DoFHandler<dim1, spacedim> &      immersed_dh,
+           const Quadrature<dim1> &                quadrature,
+           const AffineConstraints<Number> &       space_constraints,
+           const Mapping<dim1, spacedim> &         immersed_mapping =
+             StaticMappingQ1<dim1, spacedim>::mapping);
+
+    /**
+     * Recompute the positions of the quadrature points of the immersed
+     * triangulation with the mapping @p immersed_mapping, and locate them in
+     * the space triangulation, reusing the cells found before where
+     * possible.
+     */
+    void
+    update_points(const Mapping<dim1, spacedim> &immersed_mapping);
+
+    /**
+     * Release all memory and return to a state just like after having
+     * called the default constructor.
+     */
+    void
+    clear();
+
+    /**
+     * Return the number of rows of the operator, i.e., the number of degrees
+     * of freedom of the space DoFHandler.
+     */
+    types::global_dof_index
+    m() const;
+
+    /**
+     * Return the number of columns of the operator, i.e., the number of
+     * degrees of freedom of the immersed DoFHandler.
+     */
+    types::global_dof_index
+    n() const;
+
+    /**
+     * Return the number of quadrature points of the immersed triangulation
+     * that were found in locally owned cells of the space triangulation.
+     */
+    unsigned int
+    n_located_points() const;
+
+    /**
+     * Matrix-vector multiplication $dst = M src$, where @p src is a vector on
+     * the immersed DoFHandler and @p dst a vector on the space DoFHandler.
+     */
+    template <typename VectorType>
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Matrix-vector multiplication $dst += M src$.
+     */
+    template <typename VectorType>
+    void
+    vmult_add(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Matrix-vector multiplication $dst = M^T src$, where @p src is a vector
+     * on the space DoFHandler and @p dst a vector on the immersed
+     * DoFHandler.
+     */
+    template <typename VectorType>
+    void
+    Tvmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Matrix-vector multiplication $dst += M^T src$.
+     */
+    template <typename VectorType>
+    void
+    Tvmult_add(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Return an estimate for the memory consumption, in bytes, of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * Compute the products of the one-dimensional shape values of the space
+     * element in the point with index @p point, in lexicographic order.
+     */
+    void
+    compute_tensor_product_values(const unsigned int   point,
+                                  std::vector<Number> &values) const;
+
+    /**
+     * The cache of the space triangulation.
+     */
+    SmartPointer<const GridTools::Cache<dim0, spacedim>> cache;
+
+    /**
+     * The space DoFHandler.
+     */
+    SmartPointer<const DoFHandler<dim0, spacedim>> space_dh;
+
+    /**
+     * The immersed DoFHandler.
+     */
+    SmartPointer<const DoFHandler<dim1, spacedim>> immersed_dh;
+
+    /**
+     * The constraints of the space degrees of freedom.
+     */
+    SmartPointer<const AffineConstraints<Number>> space_constraints;
+
+    /**
+     * The quadrature on the cells of the immersed triangulation.
+     */
+    Quadrature<dim1> quadrature;
+
+    /**
+     * The number of vector components of the two finite elements.
+     */
+    unsigned int n_components = 0;
+
+    /**
+     * A Lagrange basis in the Gauss-Lobatto points, in which the
+     * one-dimensional polynomials of the scalar base element of the space
+     * finite element are expressed.
+     */
+    std::vector<Polynomials::Polynomial<double>> lagrange_basis;
+
+    /**
+     * The coefficients of the one-dimensional polynomials of the space
+     * finite element, in lexicographic order, with respect to the Lagrange
+     * basis.
+     */
+    FullMatrix<double> space_polynomial_coefficients;
+
+    /**
+     * For each vector component and each scalar shape function in
+     * lexicographic order, the index of the shape function of the space
+     * finite element.
+     */
+    std::vector<unsigned int> space_dof_numbering;
+
+    /**
+     * The values of the shape functions of the immersed finite element in
+     * the quadrature points on the reference cell.
+     */
+    FullMatrix<Number> immersed_shape_values;
+
+    /**
+     * The vector component of each shape function of the immersed finite
+     * element.
+     */
+    std::vector<unsigned int> immersed_shape_components;
+
+    /**
+     * The degrees of freedom of all immersed cells, one cell after the
+     * other.
+     */
+    std::vector<types::global_dof_index> immersed_dof_indices;
+
+    /**
+     * The quadrature weights times the Jacobian determinant in the
+     * quadrature points of all immersed cells, one cell after the other.
+     */
+    std::vector<Number> JxW;
+
+    /**
+     * For each pair of an immersed cell and a space cell containing at least
+     * one of its quadrature points, the index of the immersed cell. The pairs
+     * are sorted by the index of the immersed cell.
+     */
+    std::vector<unsigned int> pair_immersed_cells;
+
+    /**
+     * The space cell of each pair.
+     */
+    std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>
+      pair_space_cells;
+
+    /**
+     * The degrees of freedom of the space cell of each pair, one pair after
+     * the other.
+     */
+    std::vector<types::global_dof_index> pair_space_dof_indices;
+
+    /**
+     * The range of points belonging to each pair, with the points of pair
+     * <tt>p</tt> in the range <tt>[pair_point_offsets[p],
+     * pair_point_offsets[p+1])</tt>.
+     */
+    std::vector<unsigned int> pair_point_offsets;
+
+    /**
+     * The index of each point within the quadrature of its immersed cell.
+     */
+    std::vector<unsigned int> point_quadrature_indices;
+
+    /**
+     * The reference coordinates of each point in its space cell.
+     */
+    std::vector<Point<dim0>> point_unit_coordinates;
+
+    /**
+     * The values of the one-dimensional polynomials of the space element in
+     * the coordinates of each point, with <tt>dim0</tt> times the number of
+     * polynomials entries per point.
+     */
+    std::vector<Number> point_shape_values;
+  };
+
+
+
+#ifndef DOXYGEN
+
+  /*---------------------- Inline functions ---------------------------------*/
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  template <typename VectorType>
+  void
+  CouplingOperator<dim0, dim1, spacedim, Number>::vmult(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    dst = 0;
+    vmult_add(dst, src);
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  template <typename VectorType>
+  void
+  CouplingOperator<dim0, dim1, spacedim, Number>::vmult_add(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    Assert(space_dh != nullptr, ExcNotInitialized());
+
+    const unsigned int n_q_points         = quadrature.size();
+    const unsigned int immersed_dofs      = immersed_shape_values.m();
+    const unsigned int space_dofs         = space_dof_numbering.size();
+    const unsigned int n_scalar_functions = space_dofs / n_components;
+
+    std::vector<Number> local_src(immersed_dofs);
+    std::vector<Number> values_at_points(n_q_points * n_components);
+    Vector<Number>      local_dst(space_dofs);
+    std::vector<Number> tensor_values(n_scalar_functions);
+    std::vector<types::global_dof_index> dof_indices(space_dofs);
+
+    unsigned int current_cell = numbers::invalid_unsigned_int;
+    for (unsigned int p = 0; p < pair_immersed_cells.size(); ++p)
+      {
+        // Evaluate the immersed function in the quadrature points, once per
+        // immersed cell
+        if (pair_immersed_cells[p] != current_cell)
+          {
+            current_cell = pair_immersed_cells[p];
+            for (unsigned int j = 0; j < immersed_dofs; ++j)
+              local_src[j] =
+                src(immersed_dof_indices[current_cell * immersed_dofs + j]);
+
+            std::fill(values_at_points.begin(), values_at_points.end(), 0.);
+            for (unsigned int j = 0; j < immersed_dofs; ++j)
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                values_at_points[q * n_components +
+                                 immersed_shape_components[j]] +=
+                  immersed_shape_values(j, q) * local_src[j];
+          }
+
+        // Test with the space basis functions in the points of the pair
+        local_dst = 0;
+        for (unsigned int i = pair_point_offsets[p];
+             i < pair_point_offsets[p + 1];
+             ++i)
+          {
+            const unsigned int q = point_quadrature_indices[i];
+            compute_tensor_product_values(i, tensor_values);
+            for (unsigned int c = 0; c < n_components; ++c)
+              {
+                const Number value = values_at_points[q * n_components + c] *
+                                     JxW[current_cell * n_q_points + q];
+                const unsigned int *numbering =
+                  &space_dof_numbering[c * n_scalar_functions];
+                for (unsigned int k = 0; k < n_scalar_functions; ++k)
+                  local_dst(numbering[k]) += value * tensor_values[k];
+              }
+          }
+
+        std::copy(&pair_space_dof_indices[p * space_dofs],
+                  &pair_space_dof_indices[p * space_dofs] + space_dofs,
+                  dof_indices.begin());
+        space_constraints->distribute_local_to_global(local_dst,
+                                                      dof_indices,
+                                                      dst);
+      }
+
+    dst.compress(VectorOperation::add);
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  template <typename VectorType>
+  void
+  CouplingOperator<dim0, dim1, spacedim, Number>::Tvmult(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    dst = 0;
+    Tvmult_add(dst, src);
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  template <typename VectorType>
+  void
+  CouplingOperator<dim0, dim1, spacedim, Number>::Tvmult_add(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    Assert(space_dh != nullptr, ExcNotInitialized());
+
+    const unsigned int n_q_points         = quadrature.size();
+    const unsigned int immersed_dofs      = immersed_shape_values.m();
+    const unsigned int space_dofs         = space_dof_numbering.size();
+    const unsigned int n_scalar_functions = space_dofs / n_components;
+
+    std::vector<Number> local_src(space_dofs);
+    std::vector<Number> values_at_points(n_q_points * n_components);
+    std::vector<Number> tensor_values(n_scalar_functions);
+
+    for (unsigned int p = 0; p < pair_immersed_cells.size();)
+      {
+        const unsigned int cell = pair_immersed_cells[p];
+        std::fill(values_at_points.begin(), values_at_points.end(), 0.);
+
+        // Evaluate the space function in the points of all pairs of the
+        // current immersed cell
+        for (; p < pair_immersed_cells.size() && pair_immersed_cells[p] == cell;
+             ++p)
+          {
+            space_constraints->get_dof_values(
+              src,
+              pair_space_dof_indices.begin() + p * space_dofs,
+              local_src.begin(),
+              local_src.end());
+
+            for (unsigned int i = pair_point_offsets[p];
+                 i < pair_point_offsets[p + 1];
+                 ++i)
+              {
+                const unsigned int q = point_quadrature_indices[i];
+                compute_tensor_product_values(i, tensor_values);
+                for (unsigned int c = 0; c < n_components; ++c)
+                  {
+                    const unsigned int *numbering =
+                      &space_dof_numbering[c * n_scalar_functions];
+                    Number value = 0;
+                    for (unsigned int k = 0; k < n_scalar_functions; ++k)
+                      value += local_src[numbering[k]] * tensor_values[k];
+                    values_at_points[q * n_components + c] +=
+                      value * JxW[cell * n_q_points + q];
+                  }
+              }
+          }
+
+        // Test with the immersed basis functions
+        for (unsigned int j = 0; j < immersed_dofs; ++j)
+          {
+            Number value = 0;
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              value += immersed_shape_values(j, q) *
+                       values_at_points[q * n_components +
+                                        immersed_shape_components[j]];
+            dst(immersed_dof_indices[cell * immersed_dofs + j]) += value;
+          }
+      }
+
+    dst.compress(VectorOperation::add);
+  }
+
+#endif // DOXYGEN
+
+} // namespace NonMatching
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,407 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_non_matching_quadrature_generator
+#define dealii_non_matching_quadrature_generator
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/non_matching/immersed_surface_quadrature.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <string>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+namespace NonMatching
+{
+  /**
+   * The location of a cell relative to the zero contour of a level set
+   * function $\psi$: a cell is inside if $\psi < 0$ on the whole cell,
+   * outside if $\psi > 0$ on the whole cell, and intersected otherwise. The
+   * value unassigned denotes cells for which no information is available.
+   */
+  enum class LocationToLevelSet
+  {
+    inside,
+    outside,
+    intersected,
+    unassigned
+  };
+
+
+
+  /**
+   * Parameters controlling the generation of quadrature rules on cells
+   * intersected by the zero contour of a level set function, used by
+   * DiscreteQuadratureGenerator.
+   */
+  struct AdditionalQGeneratorData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalQGeneratorData(const unsigned int max_box_splits = 4,
+                             const double       root_tolerance = 1e-12);
+
+    /**
+     * The number of times a box is allowed to be split into $2^{dim}$
+     * children when no coordinate direction can be found in which the level
+     * set function is monotone. When this limit is reached, the remaining
+     * box is integrated by a tensor product rule whose points are sorted
+     * into the inside and outside regions according to the sign of the level
+     * set function, which only gives a low-order approximation.
+     */
+    unsigned int max_box_splits;
+
+    /**
+     * The tolerance, relative to the length of the interval searched, to
+     * which the roots of the level set function along the lines of the
+     * generated quadratures are computed. Roots closer than this to each
+     * other or to the ends of the interval are merged.
+     */
+    double root_tolerance;
+  };
+
+
+
+  /**
+   * This class creates high-order quadrature rules for the regions
+   * $\{\psi < 0\}$ and $\{\psi > 0\}$ of every cell of a DoFHandler, as well
+   * as an ImmersedSurfaceQuadrature for the zero contour $\{\psi = 0\}$,
+   * where the level set function $\psi$ is given as a finite element field on
+   * the DoFHandler. All the quadratures are defined on the reference cell,
+   * and can be used to initialize FEValues and FEImmersedSurfaceValues type
+   * objects for the assembly of cut finite element methods.
+   *
+   * The quadratures are constructed by the algorithm of
+   * @code{.bib}
+   * @article{saye_2015,
+   *   author  = {Saye, R. I.},
+   *   title   = {High-Order Quadrature Methods for Implicitly Defined
+   *              Surfaces and Volumes in Hyperrectangles},
+   *   journal = {SIAM Journal on Scientific Computing},
+   *   volume  = {37},
+   *   number  = {2},
+   *   pages   = {A993-A1019},
+   *   year    = {2015},
+   *   doi     = {10.1137/140966290}
+   * }
+   * @endcode
+   * On each cell, the level set function is converted to a tensor product
+   * Bernstein polynomial on the reference cell, whose coefficients give
+   * cheap bounds of the function and of its derivatives over a box. If the
+   * level set function is monotone in a coordinate direction over the box,
+   * the box is reduced to a (dim-1)-dimensional problem on the face
+   * orthogonal to this direction: the points of the lower-dimensional
+   * quadrature are lifted to lines in the height direction, which are split
+   * at the roots of the level set function, and a one-dimensional
+   * quadrature is applied on each piece. Otherwise, the box is split into
+   * $2^{dim}$ children. The one-dimensional quadrature passed to the
+   * constructor is used on all lines and all leaf boxes, so that the
+   * quadratures generated have the same order as the tensor product of this
+   * quadrature on the non-intersected cells.
+   *
+   * The quadratures are computed for all locally owned cells in reinit(),
+   * in parallel using the task scheduler, and stored together with the
+   * values of the level set function on each cell. A subsequent call to
+   * reinit() only recomputes the quadratures of the cells on which the
+   * values of the level set function have changed, which makes it cheap to
+   * call reinit() in each step of a time-dependent problem where the
+   * interface only moves through a small part of the mesh. The cache is
+   * emptied when the triangulation changes.
+   *
+   * The typical use is as follows:
+   * @code
+   * NonMatching::DiscreteQuadratureGenerator<dim> quadrature_generator(
+   *   QGauss<1>(fe_degree + 1), level_set_dof_handler);
+   * quadrature_generator.reinit(level_set);
+   *
+   * for (const auto &cell : dof_handler.active_cell_iterators())
+   *   if (quadrature_generator.location_to_level_set(cell) ==
+   *       NonMatching::LocationToLevelSet::intersected)
+   *     {
+   *       FEValues<dim> fe_values(
+   *         fe,
+   *         quadrature_generator.get_inside_quadrature(cell),
+   *         update_values | update_gradients | update_JxW_values);
+   *       ...
+   *     }
+   * @endcode
+   *
+   * @note The finite element used for the level set function must be a
+   * scalar element whose shape functions are tensor product polynomials of
+   * degree at most FiniteElement::degree in each coordinate direction, such
+   * as FE_Q or FE_DGQ. Zero contours that coincide with faces of the cells
+   * are not resolved by the surface quadratures.
+   */
+  template <int dim>
+  class DiscreteQuadratureGenerator : public Subscriptor
+  {
+  public:
+    /**
+     * Constructor. The level set functions passed to reinit() are described
+     * by the degrees of freedom of @p dof_handler, which needs to be kept
+     * alive as long as this object is used.
+     */
+    DiscreteQuadratureGenerator(
+      const Quadrature<1> &           quadrature_1D,
+      const DoFHandler<dim> &         dof_handler,
+      const AdditionalQGeneratorData &additional_data =
+        AdditionalQGeneratorData());
+
+    /**
+     * Copy constructor. Objects of this type can not be copied, because the
+     * connection to the signal of the triangulation refers to the object it
+     * was created by, and consequently this constructor is deleted.
+     */
+    DiscreteQuadratureGenerator(const DiscreteQuadratureGenerator &) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~DiscreteQuadratureGenerator() override;
+
+    /**
+     * Copy assignment. Objects of this type can not be copied, and
+     * consequently this operator is deleted.
+     */
+    DiscreteQuadratureGenerator &
+    operator=(const DiscreteQuadratureGenerator &) = delete;
+
+    /**
+     * Compute the quadratures on all locally owned cells for the level set
+     * function described by the vector @p level_set, which must contain the
+     * values of the degrees of freedom on all locally owned cells. Cells on
+     * which the level set function did not change since the last call to
+     * this function reuse the quadratures computed before.
+     */
+    template <typename VectorType>
+    void
+    reinit(const VectorType &level_set);
+
+    /**
+     * Delete all cached quadratures.
+     */
+    void
+    clear();
+
+    /**
+     * Return the location of @p cell relative to the zero contour of the
+     * level set function passed to the last call of reinit(). Cells that
+     * are not locally owned return LocationToLevelSet::unassigned.
+     */
+    LocationToLevelSet
+    location_to_level_set(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadrature for the region $\{\psi < 0\}$ of @p cell. This
+     * is the tensor product of the one-dimensional quadrature for cells that
+     * are inside, and an empty quadrature for cells that are outside.
+     */
+    const Quadrature<dim> &
+    get_inside_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadrature for the region $\{\psi > 0\}$ of @p cell. This
+     * is the tensor product of the one-dimensional quadrature for cells that
+     * are outside, and an empty quadrature for cells that are inside.
+     */
+    const Quadrature<dim> &
+    get_outside_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadrature for the zero contour $\{\psi = 0\}$ in @p cell,
+     * whose normals point from the region $\{\psi < 0\}$ towards the region
+     * $\{\psi > 0\}$. The quadrature is empty for cells that are not
+     * intersected.
+     */
+    const ImmersedSurfaceQuadrature<dim> &
+    get_surface_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the number of cells whose quadratures were recomputed in the
+     * last call to reinit().
+     */
+    unsigned int
+    n_updated_cells() const;
+
+    /**
+     * Return an estimate for the memory consumption, in bytes, of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * Compute the matrix that transforms the values of the degrees of
+     * freedom on a cell into the coefficients of the level set function in
+     * the tensor product Bernstein basis on the reference cell.
+     */
+    void
+    initialize_bernstein_transformation();
+
+    /**
+     * Compare the values of the level set function in @p new_dof_values with
+     * the cached ones, and recompute the quadratures of the cells where they
+     * differ. Only the cells flagged in @p owned_cells are considered.
+     */
+    void
+    update_cells(const Table<2, double> & new_dof_values,
+                 const std::vector<bool> &owned_cells);
+
+    /**
+     * The one-dimensional quadrature all generated quadratures are based on.
+     */
+    const Quadrature<1> quadrature_1D;
+
+    /**
+     * The DoFHandler describing the level set function.
+     */
+    SmartPointer<const DoFHandler<dim>> dof_handler;
+
+    /**
+     * Parameters of the quadrature generation.
+     */
+    const AdditionalQGeneratorData additional_data;
+
+    /**
+     * The tensor product of the one-dimensional quadrature, returned for
+     * cells that are not intersected.
+     */
+    const Quadrature<dim> full_quadrature;
+
+    /**
+     * An empty quadrature, returned for cells that are not intersected.
+     */
+    const Quadrature<dim> empty_quadrature;
+
+    /**
+     * An empty surface quadrature, returned for cells that are not
+     * intersected.
+     */
+    const ImmersedSurfaceQuadrature<dim> empty_surface_quadrature;
+
+    /**
+     * The name of the finite element the transformation matrix was computed
+     * for.
+     */
+    std::string fe_name;
+
+    /**
+     * The transformation from the values of the degrees of freedom on a cell
+     * to the tensor product Bernstein coefficients of the level set function.
+     */
+    FullMatrix<double> bernstein_transformation;
+
+    /**
+     * The values of the degrees of freedom of the level set function on each
+     * active cell the cached quadratures were computed for.
+     */
+    Table<2, double> level_set_dof_values;
+
+    /**
+     * Scratch arrays used by reinit() to collect the values of the degrees
+     * of freedom of the level set function on each active cell and to mark
+     * the locally owned cells. They are kept to avoid reallocating them in
+     * every call.
+     */
+    Table<2, double>  new_level_set_dof_values;
+    std::vector<bool> cell_is_owned;
+
+    /**
+     * The location of each active cell relative to the zero contour.
+     */
+    std::vector<LocationToLevelSet> cell_locations;
+
+    /**
+     * The quadratures of the intersected cells, indexed by the active cell
+     * index.
+     */
+    std::vector<Quadrature<dim>> inside_quadratures;
+    std::vector<Quadrature<dim>> outside_quadratures;
+    std::vector<ImmersedSurfaceQuadrature<dim>> surface_quadratures;
+
+    /**
+     * The number of cells updated in the last call to reinit().
+     */
+    unsigned int n_updated;
+
+    /**
+     * The connection to the signal of the triangulation that empties the
+     * cache when the mesh changes.
+     */
+    boost::signals2::connection tria_listener;
+  };
+
+
+
+#ifndef DOXYGEN
+
+  /*---------------------- Inline functions ---------------------------------*/
+
+
+  template <int dim>
+  template <typename VectorType>
+  void
+  DiscreteQuadratureGenerator<dim>::reinit(const VectorType &level_set)
+  {
+    initialize_bernstein_transformation();
+
+    const unsigned int dofs_per_cell = dof_handler->get_fe().dofs_per_cell;
+    const unsigned int n_cells =
+      dof_handler->get_triangulation().n_active_cells();
+
+    if (new_level_set_dof_values.size(0) != n_cells ||
+        new_level_set_dof_values.size(1) != dofs_per_cell)
+      new_level_set_dof_values.reinit(n_cells, dofs_per_cell);
+    cell_is_owned.assign(n_cells, false);
+
+    Vector<typename VectorType::value_type> local_values(dofs_per_cell);
+    for (const auto &cell : dof_handler->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const unsigned int index = cell->active_cell_index();
+          cell->get_dof_values(level_set, local_values);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            new_level_set_dof_values(index, i) = local_values(i);
+          cell_is_owned[index] = true;
+        }
+
+    update_cells(new_level_set_dof_values, cell_is_owned);
+  }
+
+#endif // DOXYGEN
+
+} // namespace NonMatching
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -18,6 +18,9 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/table.h>
+
+#include <deal.II/lac/multi_vector_operations.h>
 #include <deal.II/lac/solver.h>
 
 #include <deal.II/numerics/history.h>
@@ -52,6 +55,27 @@ DEAL_II_NAMESPACE_OPEN
  * for a symmetric positive definite $H$. Limited memory variant is
  * implemented via the two-loop recursion.
  *
+ * Alternatively, if AdditionalData::compact_representation is set, the
+ * search direction is computed from the compact representation of the
+ * limited memory matrix of Byrd, Nocedal, and Schnabel (Math. Program. 63,
+ * 1994),
+ * @f{align*}{
+ * H g = g + \begin{bmatrix} S & Y \end{bmatrix}
+ * \begin{bmatrix}
+ * R^{-T}(D + Y^TY)R^{-1} & -R^{-T} \\ -R^{-1} & 0
+ * \end{bmatrix}
+ * \begin{bmatrix} S^Tg \\ Y^Tg \end{bmatrix},
+ * @f}
+ * where the columns of $S$ and $Y$ are the stored increments, $R$ is the
+ * upper triangular part of $S^TY$, and $D$ its diagonal. The small matrices
+ * $S^TY$ and $Y^TY$ are updated incrementally, such that all inner products
+ * needed in an iteration are computed in one sweep over the vectors, and
+ * the direction is formed in a second sweep as a linear combination of all
+ * history vectors. For LinearAlgebra::distributed::Vector, this replaces the
+ * $2m$ global reductions of the two-loop recursion by a single one; for
+ * other vector types the same products are computed by individual inner
+ * products. The two variants are mathematically equivalent.
+ *
  * @author Denis Davydov, 2018
  */
 template <typename VectorType>
@@ -72,8 +96,9 @@ public:
     /**
      * Constructor.
      */
-    explicit AdditionalData(const unsigned int max_history_size = 5,
-                            const bool         debug_output     = false);
+    explicit AdditionalData(const unsigned int max_history_size       = 5,
+                            const bool         debug_output           = false,
+                            const bool         compact_representation = false);
 
     /**
      * Maximum history size.
@@ -84,6 +109,14 @@ public:
      * Print extra debug output to deallog.
      */
     bool debug_output;
+
+    /**
+     * Compute the search direction from the compact representation of the
+     * limited memory matrix instead of the two-loop recursion. Since the
+     * compact representation assumes a multiple of the identity as the
+     * initial matrix, no preconditioner slot may be connected in this case.
+     */
+    bool compact_representation;
   };
 
 
@@ -187,9 +220,11 @@ protected:
 template <typename VectorType>
 SolverBFGS<VectorType>::AdditionalData::AdditionalData(
   const unsigned int max_history_size_,
-  const bool         debug_output_)
+  const bool         debug_output_,
+  const bool         compact_representation_)
   : max_history_size(max_history_size_)
   , debug_output(debug_output_)
+  , compact_representation(compact_representation_)
 {}
 
 
@@ -323,6 +358,27 @@ SolverBFGS<VectorType>::solve(
   unsigned int m = 0;
   Number       f;
 
+  // data for the compact representation: the inner products s_i*y_j (for
+  // i<=j) and y_i*y_j of the history vectors in chronological order, i.e.,
+  // with the oldest pair at index 0, and whether a pair was added in the
+  // previous iteration whose products still need to be computed
+  const bool compact = additional_data.compact_representation;
+  Assert(!compact || preconditioner_signal.empty(),
+         ExcMessage("The compact representation of the limited memory "
+                    "matrix does not support a preconditioner slot."));
+  Table<2, Number>                s_dot_y;
+  Table<2, Number>                y_dot_y;
+  std::vector<Number>             dots, q, coefficients;
+  std::vector<const VectorType *> left, right, vectors;
+  bool                            new_pair = false;
+  if (compact)
+    {
+      s_dot_y.reinit(additional_data.max_history_size,
+                     additional_data.max_history_size);
+      y_dot_y.reinit(additional_data.max_history_size,
+                     additional_data.max_history_size);
+    }
+
   SolverControl::State conv = SolverControl::iterate;
   unsigned int         k    = 0;
 
@@ -338,27 +394,94 @@ SolverBFGS<VectorType>::solve(
         deallog << "Iteration " << k << " history " << m << std::endl
                 << "f=" << f << std::endl;
 
-      // 1. Two loop recursion to calculate p = - H*g
-      c1.resize(m);
-      p = g;
-      // first loop:
-      for (unsigned int i = 0; i < m; ++i)
+      if (compact)
         {
-          c1[i] = rho[i] * (s[i] * p);
-          p.add(-c1[i], y[i]);
+          // 1. Compact representation to calculate p = - H*g. Compute the
+          // products of all history vectors with g and, if a pair was just
+          // added, with the newest y in one go
+          left.resize(2 * m);
+          for (unsigned int t = 0; t < m; ++t)
+            {
+              left[t]     = &s[m - 1 - t];
+              left[m + t] = &y[m - 1 - t];
+            }
+          right.assign(1, &g);
+          if (new_pair)
+            right.push_back(&y[0]);
+          internal::MultiVectorOperations::multi_dot(left, right, dots);
+
+          const unsigned int n_right = right.size();
+          if (new_pair)
+            {
+              for (unsigned int t = 0; t < m; ++t)
+                {
+                  s_dot_y(t, m - 1) = dots[t * n_right + 1];
+                  y_dot_y(t, m - 1) = dots[(m + t) * n_right + 1];
+                  y_dot_y(m - 1, t) = y_dot_y(t, m - 1);
+                }
+              new_pair = false;
+            }
+
+          // q = R^{-1} S^T g by backward substitution
+          q.resize(m);
+          for (int i = m - 1; i >= 0; --i)
+            {
+              Number sum = dots[i * n_right];
+              for (unsigned int j = i + 1; j < m; ++j)
+                sum -= s_dot_y(i, j) * q[j];
+              q[i] = sum / s_dot_y(i, i);
+            }
+
+          // coefficients of s: R^{-T} ((D + Y^T Y) q - Y^T g) by forward
+          // substitution, coefficients of y: -q
+          coefficients.resize(2 * m + 1);
+          for (unsigned int i = 0; i < m; ++i)
+            {
+              Number sum = s_dot_y(i, i) * q[i] - dots[(m + i) * n_right];
+              for (unsigned int j = 0; j < m; ++j)
+                sum += y_dot_y(i, j) * q[j];
+              for (unsigned int j = 0; j < i; ++j)
+                sum -= s_dot_y(j, i) * coefficients[1 + j];
+              coefficients[1 + i] = sum / s_dot_y(i, i);
+            }
+
+          // p = -(g + S c_s - Y q)
+          vectors.resize(2 * m + 1);
+          vectors[0]      = &g;
+          coefficients[0] = -1.;
+          for (unsigned int t = 0; t < m; ++t)
+            {
+              vectors[1 + t]          = left[t];
+              vectors[1 + m + t]      = left[m + t];
+              coefficients[1 + t]     = -coefficients[1 + t];
+              coefficients[1 + m + t] = q[t];
+            }
+          internal::MultiVectorOperations::multi_add(p, vectors, coefficients);
         }
-      // H0
-      if (!preconditioner_signal.empty())
-        preconditioner_signal(p, s, y);
-
-      // second loop:
-      for (int i = m - 1; i >= 0; --i)
+      else
         {
-          Assert(i >= 0, ExcInternalError());
-          const Number c2 = rho[i] * (y[i] * p);
-          p.add(c1[i] - c2, s[i]);
+          // 1. Two loop recursion to calculate p = - H*g
+          c1.resize(m);
+          p = g;
+          // first loop:
+          for (unsigned int i = 0; i < m; ++i)
+            {
+              c1[i] = rho[i] * (s[i] * p);
+              p.add(-c1[i], y[i]);
+            }
+          // H0
+          if (!preconditioner_signal.empty())
+            preconditioner_signal(p, s, y);
+
+          // second loop:
+          for (int i = m - 1; i >= 0; --i)
+            {
+              Assert(i >= 0, ExcInternalError());
+              const Number c2 = rho[i] * (y[i] * p);
+              p.add(c1[i] - c2, s[i]);
+            }
+          p *= -1.;
         }
-      p *= -1.;
 
       // 2. Line search
       s_k                = x;
@@ -385,6 +508,18 @@ SolverBFGS<VectorType>::solve(
 
       if (curvature > 0. && additional_data.max_history_size > 0)
         {
+          // in the compact representation, drop the products of the oldest
+          // pair if it is about to be removed from the history. the
+          // products of the new pair are computed in the next iteration
+          if (compact && m == additional_data.max_history_size)
+            for (unsigned int i = 1; i < m; ++i)
+              for (unsigned int j = 1; j < m; ++j)
+                {
+                  s_dot_y(i - 1, j - 1) = s_dot_y(i, j);
+                  y_dot_y(i - 1, j - 1) = y_dot_y(i, j);
+                }
+          new_pair = true;
+
           s.add(s_k);
           y.add(y_k);
           rho.add(1. / curvature);
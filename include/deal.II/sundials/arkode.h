@@ -872,16 +872,6 @@ namespace SUNDIALS
      */
     void *arkode_mem;
 
-    /**
-     * ARKode solution vector.
-     */
-    N_Vector yy;
-
-    /**
-     * ARKode absolute tolerances vector.
-     */
-    N_Vector abs_tolls;
-
     /**
      * MPI communicator. SUNDIALS solver runs happily in
      * parallel. Note that if the library is compiled without MPI
@@ -24,6 +24,7 @@
 #    include <nvector/nvector_parallel.h>
 #  endif
 #  include <deal.II/lac/block_vector.h>
+#  include <deal.II/lac/la_parallel_vector.h>
 #  include <deal.II/lac/vector.h>
 
 #  include <nvector/nvector_serial.h>
@@ -73,6 +74,11 @@ namespace SUNDIALS
 
 #  endif
 
+    void
+    copy(LinearAlgebra::distributed::Vector<double> &dst, const N_Vector &src);
+    void
+    copy(N_Vector &dst, const LinearAlgebra::distributed::Vector<double> &src);
+
     void
     copy(BlockVector<double> &dst, const N_Vector &src);
     void
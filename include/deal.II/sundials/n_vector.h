@@ -0,0 +1,131 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2020 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#ifndef dealii_sundials_n_vector_h
+#define dealii_sundials_n_vector_h
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <sundials/sundials_nvector.h>
+
+#  include <functional>
+#  include <memory>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    /**
+     * A view of a deal.II vector as a SUNDIALS N_Vector. The N_Vector
+     * stores a pointer to the deal.II vector, and all N_Vector operations
+     * are implemented by the functions of the deal.II vector class, so no
+     * data is copied between SUNDIALS and deal.II. Vectors that SUNDIALS
+     * creates by cloning the view are deal.II vectors of the same type,
+     * allocated from a GrowingVectorMemory pool.
+     *
+     * Objects of this class are created by make_nvector_view() and
+     * implicitly convert to N_Vector, so they can be passed to the SUNDIALS
+     * functions. The view must not outlive the vector it refers to, and the
+     * deal.II vector inside an N_Vector handed to a callback is obtained by
+     * unwrap_nvector() or unwrap_nvector_const().
+     *
+     * The template argument can be Vector<double>, BlockVector<double>,
+     * LinearAlgebra::distributed::Vector<double>,
+     * LinearAlgebra::distributed::BlockVector<double>, and the MPI vector and
+     * block vector classes of the PETSc and Trilinos wrappers.
+     */
+    template <typename VectorType>
+    class NVectorView
+    {
+    public:
+      /**
+       * Default constructor. The object is not a valid view until it is
+       * assigned one created by make_nvector_view().
+       */
+      NVectorView() = default;
+
+      /**
+       * Constructor. Create a view of @p vector.
+       */
+      NVectorView(VectorType &vector);
+
+      /**
+       * Move constructor.
+       */
+      NVectorView(NVectorView &&) noexcept = default;
+
+      /**
+       * Move assignment.
+       */
+      NVectorView &
+      operator=(NVectorView &&) noexcept = default;
+
+      /**
+       * Implicit conversion to N_Vector.
+       */
+      operator N_Vector() const;
+
+      /**
+       * Access to the N_Vector that is viewed by this object.
+       */
+      N_Vector operator->() const;
+
+    private:
+      /**
+       * The N_Vector, which is destroyed together with this object. The
+       * viewed deal.II vector is left untouched.
+       */
+      std::unique_ptr<_generic_N_Vector, std::function<void(N_Vector)>>
+        vector_ptr;
+    };
+
+
+
+    /**
+     * Create an N_Vector that refers to @p vector. If @p VectorType is a
+     * const type, SUNDIALS can only read from the returned N_Vector, and
+     * calling unwrap_nvector() on it throws an exception.
+     */
+    template <typename VectorType>
+    NVectorView<VectorType>
+    make_nvector_view(VectorType &vector);
+
+    /**
+     * Return a pointer to the deal.II vector stored in the N_Vector @p v,
+     * which must have been created by make_nvector_view() for a non-const
+     * vector of type @p VectorType or cloned from such a view.
+     */
+    template <typename VectorType>
+    VectorType *
+    unwrap_nvector(N_Vector v);
+
+    /**
+     * Same as above, but for read-only access. This function also accepts
+     * views of const vectors.
+     */
+    template <typename VectorType>
+    const VectorType *
+    unwrap_nvector_const(N_Vector v);
+  } // namespace internal
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
+#endif // dealii_sundials_n_vector_h
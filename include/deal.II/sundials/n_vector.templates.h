@@ -0,0 +1,777 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2020 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#ifndef dealii_sundials_n_vector_templates_h
+#define dealii_sundials_n_vector_templates_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/sundials/n_vector.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <deal.II/base/array_view.h>
+#  include <deal.II/base/exceptions.h>
+#  include <deal.II/base/mpi.h>
+#  include <deal.II/base/std_cxx14/memory.h>
+
+#  include <deal.II/lac/block_vector.h>
+#  include <deal.II/lac/la_parallel_block_vector.h>
+#  include <deal.II/lac/la_parallel_vector.h>
+#  include <deal.II/lac/vector.h>
+#  include <deal.II/lac/vector_memory.h>
+#  ifdef DEAL_II_WITH_TRILINOS
+#    include <deal.II/lac/trilinos_parallel_block_vector.h>
+#    include <deal.II/lac/trilinos_vector.h>
+#  endif
+#  ifdef DEAL_II_WITH_PETSC
+#    include <deal.II/lac/petsc_block_vector.h>
+#    include <deal.II/lac/petsc_vector.h>
+#  endif
+
+#  include <sundials/sundials_math.h>
+
+#  include <algorithm>
+#  include <cmath>
+#  include <functional>
+#  include <limits>
+#  include <memory>
+#  include <type_traits>
+#  include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    /**
+     * The content of the N_Vector objects created by this module: a pointer
+     * to a deal.II vector that is either owned, for vectors that SUNDIALS
+     * creates by cloning, or only viewed.
+     */
+    template <typename VectorType>
+    class NVectorContent
+    {
+    public:
+      /**
+       * Constructor. Allocate a new vector from the memory pool and
+       * reinitialize it with the layout of @p model.
+       */
+      NVectorContent(const VectorType &model)
+        : vector(typename VectorMemory<VectorType>::Pointer(memory))
+        , is_const(false)
+      {
+        vector->reinit(model, /*omit_zeroing_entries=*/true);
+      }
+
+      /**
+       * Constructor. Create a view of a vector that may be modified.
+       */
+      NVectorContent(VectorType *vector)
+        : vector(vector, [](VectorType *) {})
+        , is_const(false)
+      {}
+
+      /**
+       * Constructor. Create a view of a vector that must not be modified.
+       */
+      NVectorContent(const VectorType *vector)
+        : vector(const_cast<VectorType *>(vector), [](VectorType *) {})
+        , is_const(true)
+      {}
+
+      /**
+       * Return the stored vector.
+       */
+      VectorType *
+      get()
+      {
+        AssertThrow(!is_const,
+                    ExcMessage("Tried to modify a vector that SUNDIALS "
+                               "only received for reading."));
+        return vector.get();
+      }
+
+      /**
+       * Return the stored vector for reading.
+       */
+      const VectorType *
+      get() const
+      {
+        return vector.get();
+      }
+
+    private:
+      /**
+       * Memory pool for the vectors owned by this class. It is declared
+       * before the vector pointer so that it outlives the vector.
+       */
+      GrowingVectorMemory<VectorType> memory;
+
+      /**
+       * The vector, with a deleter that returns it to the memory pool if
+       * it is owned and does nothing otherwise.
+       */
+      std::unique_ptr<VectorType, std::function<void(VectorType *)>> vector;
+
+      /**
+       * Whether the vector was given as a const object.
+       */
+      const bool is_const;
+    };
+
+
+
+    /**
+     * Implementation of the N_Vector operations in terms of the functions
+     * of the deal.II vector classes.
+     */
+    namespace NVectorOperations
+    {
+#  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
+      using IndexType = long int;
+#  else
+      using IndexType = sunindextype;
+#  endif
+
+      /**
+       * Set up an N_Vector with the content @p content and the operations
+       * of the given vector type.
+       */
+      template <typename VectorType>
+      N_Vector
+      create_nvector(NVectorContent<VectorType> *content);
+
+      /**
+       * Create an N_Vector around a newly allocated vector of the same
+       * layout as the one in @p v.
+       */
+      template <typename VectorType>
+      N_Vector
+      clone(N_Vector v)
+      {
+        return create_nvector(
+          new NVectorContent<VectorType>(*unwrap_nvector_const<VectorType>(v)));
+      }
+
+
+
+      /**
+       * Create an N_Vector without a vector. SUNDIALS uses such vectors
+       * only for its own data, which we do not support.
+       */
+      template <typename VectorType>
+      N_Vector
+      clone_empty(N_Vector)
+      {
+        return create_nvector(
+          new NVectorContent<VectorType>(static_cast<VectorType *>(nullptr)));
+      }
+
+
+
+      template <typename VectorType>
+      void
+      destroy(N_Vector v)
+      {
+        if (v == nullptr)
+          return;
+        delete static_cast<NVectorContent<VectorType> *>(v->content);
+        delete v->ops;
+        delete v;
+      }
+
+
+
+      inline N_Vector_ID
+      get_vector_id(N_Vector)
+      {
+        return SUNDIALS_NVEC_CUSTOM;
+      }
+
+
+
+      template <typename VectorType>
+      void
+      space(N_Vector v, IndexType *lrw, IndexType *liw)
+      {
+        *lrw = unwrap_nvector_const<VectorType>(v)->size();
+        *liw = 0;
+      }
+
+
+
+      /**
+       * Return the communicator of a vector, which is MPI_COMM_SELF for
+       * serial vectors and the communicator of the first block for block
+       * vectors.
+       */
+      template <typename VectorType>
+      MPI_Comm
+      get_communicator(const VectorType &, std::true_type /*is_serial*/)
+      {
+        return MPI_COMM_SELF;
+      }
+
+      template <typename VectorType>
+      MPI_Comm
+      get_communicator(const VectorType &v, std::false_type /*is_serial*/);
+
+      template <typename VectorType>
+      MPI_Comm
+      get_block_communicator(const VectorType &v, std::true_type /*is_block*/)
+      {
+        return get_communicator(v.block(0), std::false_type());
+      }
+
+      template <typename VectorType>
+      MPI_Comm
+      get_block_communicator(const VectorType &v, std::false_type /*is_block*/)
+      {
+        return v.get_mpi_communicator();
+      }
+
+      template <typename VectorType>
+      MPI_Comm
+      get_communicator(const VectorType &v, std::false_type /*is_serial*/)
+      {
+        return get_block_communicator(
+          v, std::integral_constant<bool, IsBlockVector<VectorType>::value>());
+      }
+
+      template <typename VectorType>
+      MPI_Comm
+      get_communicator(const VectorType &v)
+      {
+        return get_communicator(
+          v,
+          std::integral_constant<bool, is_serial_vector<VectorType>::value>());
+      }
+
+
+
+      /**
+       * Append the arrays of locally owned entries of a vector to @p
+       * chunks. Vectors with the same parallel layout result in arrays of
+       * the same lengths, so the operations below can loop over
+       * corresponding entries of several vectors. The functions in @p
+       * cleanup have to be called when the arrays are no longer needed.
+       */
+      inline void
+      append_local_arrays(::dealii::Vector<double> &      v,
+                          std::vector<ArrayView<double>> &chunks,
+                          std::vector<std::function<void()>> &)
+      {
+        chunks.emplace_back(v.begin(), v.size());
+      }
+
+      inline void
+      append_local_arrays(LinearAlgebra::distributed::Vector<double> &v,
+                          std::vector<ArrayView<double>> &            chunks,
+                          std::vector<std::function<void()>> &)
+      {
+        chunks.emplace_back(v.begin(), v.local_size());
+      }
+
+#  ifdef DEAL_II_WITH_TRILINOS
+      inline void
+      append_local_arrays(TrilinosWrappers::MPI::Vector & v,
+                          std::vector<ArrayView<double>> &chunks,
+                          std::vector<std::function<void()>> &)
+      {
+        chunks.emplace_back(v.begin(), v.local_size());
+      }
+#  endif
+
+#  if defined(DEAL_II_WITH_PETSC) && !defined(PETSC_USE_COMPLEX)
+      inline void
+      append_local_arrays(PETScWrappers::VectorBase &         v,
+                          std::vector<ArrayView<double>> &    chunks,
+                          std::vector<std::function<void()>> &cleanup)
+      {
+        PetscScalar *  values = nullptr;
+        PetscErrorCode ierr   = VecGetArray(v, &values);
+        AssertThrow(ierr == 0, ExcPETScError(ierr));
+        chunks.emplace_back(values, v.local_size());
+        cleanup.emplace_back([&v, values]() mutable {
+          const PetscErrorCode ierr = VecRestoreArray(v, &values);
+          AssertNothrow(ierr == 0, ExcPETScError(ierr));
+          (void)ierr;
+        });
+      }
+#  endif
+
+      template <typename BlockType>
+      void
+      append_local_arrays(BlockVectorBase<BlockType> &        v,
+                          std::vector<ArrayView<double>> &    chunks,
+                          std::vector<std::function<void()>> &cleanup)
+      {
+        for (unsigned int b = 0; b < v.n_blocks(); ++b)
+          append_local_arrays(v.block(b), chunks, cleanup);
+      }
+
+
+
+      /**
+       * Direct access to the locally owned entries of a vector, as a list
+       * of contiguous arrays.
+       */
+      template <typename VectorType>
+      class LocalArrays
+      {
+      public:
+        LocalArrays(const VectorType &vector)
+        {
+          append_local_arrays(const_cast<VectorType &>(vector),
+                              chunks,
+                              cleanup);
+        }
+
+        ~LocalArrays()
+        {
+          for (const auto &function : cleanup)
+            function();
+        }
+
+        std::vector<ArrayView<double>> chunks;
+
+      private:
+        std::vector<std::function<void()>> cleanup;
+      };
+
+
+
+      template <typename VectorType>
+      void
+      linear_sum(realtype a, N_Vector x, realtype b, N_Vector y, N_Vector z)
+      {
+        const VectorType &x_dealii = *unwrap_nvector_const<VectorType>(x);
+        const VectorType &y_dealii = *unwrap_nvector_const<VectorType>(y);
+        VectorType &      z_dealii = *unwrap_nvector<VectorType>(z);
+
+        if (z == x)
+          z_dealii.sadd(a, b, y_dealii);
+        else if (z == y)
+          z_dealii.sadd(b, a, x_dealii);
+        else
+          {
+            z_dealii.equ(a, x_dealii);
+            z_dealii.add(b, y_dealii);
+          }
+      }
+
+
+
+      template <typename VectorType>
+      void
+      set_constant(realtype c, N_Vector z)
+      {
+        *unwrap_nvector<VectorType>(z) = c;
+      }
+
+
+
+      template <typename VectorType>
+      void
+      elementwise_product(N_Vector x, N_Vector y, N_Vector z)
+      {
+        VectorType &z_dealii = *unwrap_nvector<VectorType>(z);
+        if (z == y)
+          z_dealii.scale(*unwrap_nvector_const<VectorType>(x));
+        else
+          {
+            if (z != x)
+              z_dealii = *unwrap_nvector_const<VectorType>(x);
+            z_dealii.scale(*unwrap_nvector_const<VectorType>(y));
+          }
+      }
+
+
+
+      template <typename VectorType>
+      void
+      elementwise_div(N_Vector x, N_Vector y, N_Vector z)
+      {
+        const LocalArrays<VectorType> x_local(
+          *unwrap_nvector_const<VectorType>(x));
+        const LocalArrays<VectorType> y_local(
+          *unwrap_nvector_const<VectorType>(y));
+        const LocalArrays<VectorType> z_local(*unwrap_nvector<VectorType>(z));
+        for (unsigned int c = 0; c < z_local.chunks.size(); ++c)
+          for (unsigned int i = 0; i < z_local.chunks[c].size(); ++i)
+            z_local.chunks[c][i] = x_local.chunks[c][i] / y_local.chunks[c][i];
+      }
+
+
+
+      template <typename VectorType>
+      void
+      scale(realtype c, N_Vector x, N_Vector z)
+      {
+        VectorType &z_dealii = *unwrap_nvector<VectorType>(z);
+        if (z == x)
+          z_dealii *= c;
+        else
+          z_dealii.equ(c, *unwrap_nvector_const<VectorType>(x));
+      }
+
+
+
+      template <typename VectorType>
+      void
+      elementwise_abs(N_Vector x, N_Vector z)
+      {
+        const LocalArrays<VectorType> x_local(
+          *unwrap_nvector_const<VectorType>(x));
+        const LocalArrays<VectorType> z_local(*unwrap_nvector<VectorType>(z));
+        for (unsigned int c = 0; c < z_local.chunks.size(); ++c)
+          for (unsigned int i = 0; i < z_local.chunks[c].size(); ++i)
+            z_local.chunks[c][i] = std::abs(x_local.chunks[c][i]);
+      }
+
+
+
+      template <typename VectorType>
+      void
+      elementwise_inv(N_Vector x, N_Vector z)
+      {
+        const LocalArrays<VectorType> x_local(
+          *unwrap_nvector_const<VectorType>(x));
+        const LocalArrays<VectorType> z_local(*unwrap_nvector<VectorType>(z));
+        for (unsigned int c = 0; c < z_local.chunks.size(); ++c)
+          for (unsigned int i = 0; i < z_local.chunks[c].size(); ++i)
+            z_local.chunks[c][i] = 1. / x_local.chunks[c][i];
+      }
+
+
+
+      template <typename VectorType>
+      void
+      add_constant(N_Vector x, realtype b, N_Vector z)
+      {
+        const LocalArrays<VectorType> x_local(
+          *unwrap_nvector_const<VectorType>(x));
+        const LocalArrays<VectorType> z_local(*unwrap_nvector<VectorType>(z));
+        for (unsigned int c = 0; c < z_local.chunks.size(); ++c)
+          for (unsigned int i = 0; i < z_local.chunks[c].size(); ++i)
+            z_local.chunks[c][i] = x_local.chunks[c][i] + b;
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      dot_product(N_Vector x, N_Vector y)
+      {
+        return *unwrap_nvector_const<VectorType>(x) *
+               *unwrap_nvector_const<VectorType>(y);
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      max_norm(N_Vector x)
+      {
+        return unwrap_nvector_const<VectorType>(x)->linfty_norm();
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      l1_norm(N_Vector x)
+      {
+        return unwrap_nvector_const<VectorType>(x)->l1_norm();
+      }
+
+
+
+      /**
+       * Return the global sum of $(x_i w_i)^2$ over all entries with
+       * positive mask, or over all entries if no mask is given.
+       */
+      template <typename VectorType>
+      double
+      weighted_square_sum(N_Vector x, N_Vector w, N_Vector mask)
+      {
+        const VectorType &x_dealii = *unwrap_nvector_const<VectorType>(x);
+        const LocalArrays<VectorType> x_local(x_dealii);
+        const LocalArrays<VectorType> w_local(
+          *unwrap_nvector_const<VectorType>(w));
+        std::unique_ptr<LocalArrays<VectorType>> mask_local;
+        if (mask != nullptr)
+          mask_local = std_cxx14::make_unique<LocalArrays<VectorType>>(
+            *unwrap_nvector_const<VectorType>(mask));
+
+        double sum = 0.;
+        for (unsigned int c = 0; c < x_local.chunks.size(); ++c)
+          for (unsigned int i = 0; i < x_local.chunks[c].size(); ++i)
+            if (mask == nullptr || mask_local->chunks[c][i] > 0.)
+              {
+                const double product =
+                  x_local.chunks[c][i] * w_local.chunks[c][i];
+                sum += product * product;
+              }
+        return Utilities::MPI::sum(sum, get_communicator(x_dealii));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      weighted_rms_norm(N_Vector x, N_Vector w)
+      {
+        return std::sqrt(weighted_square_sum<VectorType>(x, w, nullptr) /
+                         unwrap_nvector_const<VectorType>(x)->size());
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      weighted_rms_norm_mask(N_Vector x, N_Vector w, N_Vector mask)
+      {
+        return std::sqrt(weighted_square_sum<VectorType>(x, w, mask) /
+                         unwrap_nvector_const<VectorType>(x)->size());
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      weighted_l2_norm(N_Vector x, N_Vector w)
+      {
+        return std::sqrt(weighted_square_sum<VectorType>(x, w, nullptr));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      min_element(N_Vector x)
+      {
+        const VectorType &x_dealii = *unwrap_nvector_const<VectorType>(x);
+        const LocalArrays<VectorType> x_local(x_dealii);
+        double minimum = std::numeric_limits<double>::max();
+        for (const ArrayView<double> &chunk : x_local.chunks)
+          for (const double value : chunk)
+            minimum = std::min(minimum, value);
+        return Utilities::MPI::min(minimum, get_communicator(x_dealii));
+      }
+
+
+
+      template <typename VectorType>
+      void
+      elementwise_compare(realtype c, N_Vector x, N_Vector z)
+      {
+        const LocalArrays<VectorType> x_local(
+          *unwrap_nvector_const<VectorType>(x));
+        const LocalArrays<VectorType> z_local(*unwrap_nvector<VectorType>(z));
+        for (unsigned int ch = 0; ch < z_local.chunks.size(); ++ch)
+          for (unsigned int i = 0; i < z_local.chunks[ch].size(); ++i)
+            z_local.chunks[ch][i] =
+              std::abs(x_local.chunks[ch][i]) >= c ? 1. : 0.;
+      }
+
+
+
+      template <typename VectorType>
+      booleantype
+      elementwise_inv_test(N_Vector x, N_Vector z)
+      {
+        const VectorType &x_dealii = *unwrap_nvector_const<VectorType>(x);
+        const LocalArrays<VectorType> x_local(x_dealii);
+        const LocalArrays<VectorType> z_local(*unwrap_nvector<VectorType>(z));
+        unsigned int                  n_zeros = 0;
+        for (unsigned int c = 0; c < z_local.chunks.size(); ++c)
+          for (unsigned int i = 0; i < z_local.chunks[c].size(); ++i)
+            if (x_local.chunks[c][i] == 0.)
+              ++n_zeros;
+            else
+              z_local.chunks[c][i] = 1. / x_local.chunks[c][i];
+        return Utilities::MPI::sum(n_zeros, get_communicator(x_dealii)) == 0;
+      }
+
+
+
+      template <typename VectorType>
+      booleantype
+      constraint_mask(N_Vector c, N_Vector x, N_Vector m)
+      {
+        const VectorType &x_dealii = *unwrap_nvector_const<VectorType>(x);
+        const LocalArrays<VectorType> c_local(
+          *unwrap_nvector_const<VectorType>(c));
+        const LocalArrays<VectorType> x_local(x_dealii);
+        const LocalArrays<VectorType> m_local(*unwrap_nvector<VectorType>(m));
+        unsigned int                  n_violations = 0;
+        for (unsigned int ch = 0; ch < m_local.chunks.size(); ++ch)
+          for (unsigned int i = 0; i < m_local.chunks[ch].size(); ++i)
+            {
+              // the constraints are x_i > 0 (2), x_i >= 0 (1), x_i <= 0
+              // (-1), x_i < 0 (-2), or none (0)
+              const double constraint = c_local.chunks[ch][i];
+              const double value      = x_local.chunks[ch][i];
+              const bool   violated   = (constraint == 2. && value <= 0.) ||
+                                    (constraint == 1. && value < 0.) ||
+                                    (constraint == -1. && value > 0.) ||
+                                    (constraint == -2. && value >= 0.);
+              m_local.chunks[ch][i] = violated ? 1. : 0.;
+              if (violated)
+                ++n_violations;
+            }
+        return Utilities::MPI::sum(n_violations, get_communicator(x_dealii)) ==
+               0;
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      min_quotient(N_Vector num, N_Vector denom)
+      {
+        const VectorType &num_dealii = *unwrap_nvector_const<VectorType>(num);
+        const LocalArrays<VectorType> num_local(num_dealii);
+        const LocalArrays<VectorType> denom_local(
+          *unwrap_nvector_const<VectorType>(denom));
+        double minimum = BIG_REAL;
+        for (unsigned int c = 0; c < num_local.chunks.size(); ++c)
+          for (unsigned int i = 0; i < num_local.chunks[c].size(); ++i)
+            if (denom_local.chunks[c][i] != 0.)
+              minimum =
+                std::min(minimum,
+                         num_local.chunks[c][i] / denom_local.chunks[c][i]);
+        return Utilities::MPI::min(minimum, get_communicator(num_dealii));
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      create_nvector(NVectorContent<VectorType> *content)
+      {
+        N_Vector v = new _generic_N_Vector;
+        v->content = content;
+
+        // value-initialize to set all operations SUNDIALS may add in
+        // newer versions to nullptr
+        v->ops = new _generic_N_Vector_Ops();
+
+        v->ops->nvgetvectorid     = &get_vector_id;
+        v->ops->nvclone           = &clone<VectorType>;
+        v->ops->nvcloneempty      = &clone_empty<VectorType>;
+        v->ops->nvdestroy         = &destroy<VectorType>;
+        v->ops->nvspace           = &space<VectorType>;
+        v->ops->nvgetarraypointer = nullptr;
+        v->ops->nvsetarraypointer = nullptr;
+        v->ops->nvlinearsum       = &linear_sum<VectorType>;
+        v->ops->nvconst           = &set_constant<VectorType>;
+        v->ops->nvprod            = &elementwise_product<VectorType>;
+        v->ops->nvdiv             = &elementwise_div<VectorType>;
+        v->ops->nvscale           = &scale<VectorType>;
+        v->ops->nvabs             = &elementwise_abs<VectorType>;
+        v->ops->nvinv             = &elementwise_inv<VectorType>;
+        v->ops->nvaddconst        = &add_constant<VectorType>;
+        v->ops->nvdotprod         = &dot_product<VectorType>;
+        v->ops->nvmaxnorm         = &max_norm<VectorType>;
+        v->ops->nvwrmsnorm        = &weighted_rms_norm<VectorType>;
+        v->ops->nvwrmsnormmask    = &weighted_rms_norm_mask<VectorType>;
+        v->ops->nvmin             = &min_element<VectorType>;
+        v->ops->nvwl2norm         = &weighted_l2_norm<VectorType>;
+        v->ops->nvl1norm          = &l1_norm<VectorType>;
+        v->ops->nvcompare         = &elementwise_compare<VectorType>;
+        v->ops->nvinvtest         = &elementwise_inv_test<VectorType>;
+        v->ops->nvconstrmask      = &constraint_mask<VectorType>;
+        v->ops->nvminquotient     = &min_quotient<VectorType>;
+
+        return v;
+      }
+    } // namespace NVectorOperations
+
+
+
+    template <typename VectorType>
+    NVectorView<VectorType>::NVectorView(VectorType &vector)
+      : vector_ptr(
+          NVectorOperations::create_nvector(
+            new NVectorContent<typename std::remove_const<VectorType>::type>(
+              &vector)),
+          [](N_Vector v) {
+            NVectorOperations::destroy<
+              typename std::remove_const<VectorType>::type>(v);
+          })
+    {}
+
+
+
+    template <typename VectorType>
+    NVectorView<VectorType>::operator N_Vector() const
+    {
+      Assert(vector_ptr != nullptr, ExcNotInitialized());
+      return vector_ptr.get();
+    }
+
+
+
+    template <typename VectorType>
+    N_Vector
+    NVectorView<VectorType>::operator->() const
+    {
+      Assert(vector_ptr != nullptr, ExcNotInitialized());
+      return vector_ptr.get();
+    }
+
+
+
+    template <typename VectorType>
+    NVectorView<VectorType>
+    make_nvector_view(VectorType &vector)
+    {
+      return NVectorView<VectorType>(vector);
+    }
+
+
+
+    template <typename VectorType>
+    VectorType *
+    unwrap_nvector(N_Vector v)
+    {
+      Assert(v != nullptr && v->content != nullptr, ExcNotInitialized());
+      Assert(N_VGetVectorID(v) == SUNDIALS_NVEC_CUSTOM,
+             ExcMessage("The N_Vector was not created by deal.II."));
+      return static_cast<NVectorContent<VectorType> *>(v->content)->get();
+    }
+
+
+
+    template <typename VectorType>
+    const VectorType *
+    unwrap_nvector_const(N_Vector v)
+    {
+      Assert(v != nullptr && v->content != nullptr, ExcNotInitialized());
+      Assert(N_VGetVectorID(v) == SUNDIALS_NVEC_CUSTOM,
+             ExcMessage("The N_Vector was not created by deal.II."));
+      return static_cast<const NVectorContent<VectorType> *>(v->content)->get();
+    }
+  } // namespace internal
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
+#endif // dealii_sundials_n_vector_templates_h
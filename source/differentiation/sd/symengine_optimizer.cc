@@ -17,13 +17,45 @@
 
 #ifdef DEAL_II_WITH_SYMENGINE
 
+#  include <deal.II/base/mpi.h>
+#  include <deal.II/base/utilities.h>
+
 #  include <deal.II/differentiation/sd/symengine_optimizer.h>
 #  include <deal.II/differentiation/sd/symengine_utilities.h>
 
 #  include <boost/archive/text_iarchive.hpp>
 #  include <boost/archive/text_oarchive.hpp>
 
+#  include <symengine/symengine_config.h>
+
+// The code generated by the LLVM optimizer depends on the LLVM version and
+// the host CPU, which can only be queried if the LLVM headers are found
+#  ifdef HAVE_SYMENGINE_LLVM
+#    ifdef __has_include
+#      if __has_include(<llvm/Config/llvm-config.h>)
+#        include <llvm/Config/llvm-config.h>
+#        if __has_include(<llvm/TargetParser/Host.h>)
+#          include <llvm/ADT/StringMap.h>
+#          include <llvm/TargetParser/Host.h>
+#          define DEAL_II_SD_HAVE_LLVM_HOST_INFO
+#        elif __has_include(<llvm/Support/Host.h>)
+#          include <llvm/ADT/StringMap.h>
+#          include <llvm/Support/Host.h>
+#          define DEAL_II_SD_HAVE_LLVM_HOST_INFO
+#        endif
+#      endif
+#    endif
+#  endif
+
+#  include <algorithm>
+#  include <cstdint>
+#  include <cstdio>
+#  include <fstream>
+#  include <iomanip>
+#  include <sstream>
+#  include <string>
 #  include <utility>
+#  include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -372,6 +404,171 @@ namespace Differentiation
 
 
 
+    namespace
+    {
+      /**
+       * Return the 64-bit FNV-1a hash of the string @p s. Contrary to
+       * std::hash, the result does not depend on the platform or the
+       * standard library, which makes it suitable to name files that
+       * persist between runs of a program.
+       */
+      std::uint64_t
+      stable_hash(const std::string &s)
+      {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (const char c : s)
+          {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+          }
+        return hash;
+      }
+
+
+
+      /**
+       * Return a description of everything the machine code generated by the
+       * LLVM optimizer depends on besides the symbolic expressions: the
+       * versions of SymEngine and LLVM, and the name and features of the host
+       * CPU. If the LLVM headers are not available to query the latter, an
+       * empty string is returned.
+       */
+      std::string
+      llvm_environment_description()
+      {
+#  ifdef DEAL_II_SD_HAVE_LLVM_HOST_INFO
+        std::ostringstream description;
+        description << "SymEngine " << SYMENGINE_MAJOR_VERSION << '.'
+                    << SYMENGINE_MINOR_VERSION << '.'
+                    << SYMENGINE_PATCH_VERSION << '\n'
+                    << "LLVM " << LLVM_VERSION_STRING << '\n'
+                    << "CPU " << llvm::sys::getHostCPUName().str() << '\n';
+
+#    if LLVM_VERSION_MAJOR >= 19
+        const llvm::StringMap<bool> features =
+          llvm::sys::getHostCPUFeatures();
+#    else
+        llvm::StringMap<bool> features;
+        llvm::sys::getHostCPUFeatures(features);
+#    endif
+        // the order of a StringMap is unspecified, so sort the features
+        std::vector<std::string> enabled_features;
+        for (const auto &feature : features)
+          if (feature.getValue())
+            enabled_features.push_back(feature.getKey().str());
+        std::sort(enabled_features.begin(), enabled_features.end());
+        for (const auto &feature : enabled_features)
+          description << feature << ' ';
+        description << '\n';
+
+        return description.str();
+#  else
+        return std::string();
+#  endif
+      }
+    } // namespace
+
+
+
+    template <typename ReturnType>
+    bool
+    BatchOptimizer<ReturnType>::optimize(const std::string &cache_directory)
+    {
+      Assert(optimized() == false,
+             ExcMessage("Cannot call optimize() more than once."));
+
+      // All optimizers other than the LLVM one repeat the optimization when
+      // they are deserialized, so there is nothing to gain from a cache.
+      // The compiled code of the LLVM optimizer must only be loaded in the
+      // same environment it was generated in, so we do not use the cache if
+      // we cannot identify the environment.
+      const std::string environment = llvm_environment_description();
+      if (optimization_method() != OptimizerType::llvm || environment.empty())
+        {
+          optimize();
+          return false;
+        }
+
+      // Everything that determines the optimized functions enters the key.
+      // The key itself is stored in the file to guard against hash
+      // collisions.
+      std::ostringstream key;
+      key << environment;
+      key << static_cast<int>(optimization_method()) << ' '
+          << static_cast<int>(optimization_flags()) << ' '
+          << sizeof(ReturnType) << ' ' << boost::is_complex<ReturnType>::value
+          << '\n';
+      for (const auto &symbol :
+           Utilities::extract_symbols(independent_variables_symbols))
+        key << symbol << '\n';
+      key << '\n';
+      for (const auto &function : dependent_variables_functions)
+        key << function << '\n';
+
+      std::ostringstream filename;
+      filename << cache_directory << "/batch_optimizer_" << std::hex
+               << std::setw(16) << std::setfill('0') << stable_hash(key.str())
+               << ".txt";
+
+      {
+        std::ifstream file(filename.str());
+        if (file)
+          {
+            boost::archive::text_iarchive ia(file, boost::archive::no_header);
+            std::string                   stored_key;
+            ia >> stored_key;
+            if (stored_key == key.str())
+              {
+                // Deserialization requires an object without registered
+                // symbols and functions; they are restored from the file
+                independent_variables_symbols.clear();
+                dependent_variables_functions.clear();
+                map_dep_expr_vec_entry.clear();
+                ia >> *this;
+
+                AssertThrow(optimized() == true,
+                            ExcMessage("The optimizer could not be loaded "
+                                       "from the file " +
+                                       filename.str() + "."));
+                return true;
+              }
+          }
+      }
+
+      optimize();
+
+      // Write to a temporary file first, so that other processes never see
+      // an incomplete file
+      const std::string temporary_filename =
+        filename.str() + "." +
+        dealii::Utilities::int_to_string(
+          dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)) +
+        ".tmp";
+      bool written = false;
+      {
+        std::ofstream file(temporary_filename);
+        if (!file)
+          return false;
+
+        boost::archive::text_oarchive oa(file, boost::archive::no_header);
+        const std::string             key_string = key.str();
+        oa << key_string;
+        oa << *this;
+        file.flush();
+        written = static_cast<bool>(file);
+      }
+
+      // Do not leave the temporary file behind if it could not be completed
+      // or moved to its final place. The optimizer is usable either way.
+      if (!written ||
+          std::rename(temporary_filename.c_str(), filename.str().c_str()) != 0)
+        std::remove(temporary_filename.c_str());
+
+      return false;
+    }
+
+
+
     template <typename ReturnType>
     void
     BatchOptimizer<ReturnType>::substitute(
@@ -506,6 +703,64 @@ namespace Differentiation
 
 
 
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::evaluate(
+      const ArrayView<const ReturnType> &substitution_values,
+      const ArrayView<ReturnType> &      output_values,
+      const unsigned int                 n_points) const
+    {
+      Assert(
+        optimized() == true,
+        ExcMessage(
+          "The optimizer is not configured to perform substitution. "
+          "This action can only performed after optimize() has been called."));
+      Assert(optimizer, ExcNotInitialized());
+      AssertDimension(substitution_values.size(),
+                      n_independent_variables() * n_points);
+      AssertDimension(output_values.size(), n_dependent_variables() * n_points);
+
+      // Determine the type of the optimizer once for all points
+      if (typename internal::DictionaryOptimizer<ReturnType>::OptimizerType
+            *opt = dynamic_cast<typename internal::DictionaryOptimizer<
+              ReturnType>::OptimizerType *>(optimizer.get()))
+        {
+          Assert(optimization_method() == OptimizerType::dictionary,
+                 ExcInternalError());
+          internal::substitute_batch<ReturnType,
+                                     internal::DictionaryOptimizer<ReturnType>>(
+            opt, output_values, substitution_values, n_points);
+        }
+      else if (typename internal::LambdaOptimizer<ReturnType>::OptimizerType
+                 *opt = dynamic_cast<typename internal::LambdaOptimizer<
+                   ReturnType>::OptimizerType *>(optimizer.get()))
+        {
+          Assert(optimization_method() == OptimizerType::lambda,
+                 ExcInternalError());
+          internal::substitute_batch<ReturnType,
+                                     internal::LambdaOptimizer<ReturnType>>(
+            opt, output_values, substitution_values, n_points);
+        }
+#  ifdef HAVE_SYMENGINE_LLVM
+      else if (typename internal::LLVMOptimizer<ReturnType>::OptimizerType
+                 *opt = dynamic_cast<typename internal::LLVMOptimizer<
+                   ReturnType>::OptimizerType *>(optimizer.get()))
+        {
+          Assert(optimization_method() == OptimizerType::llvm,
+                 ExcInternalError());
+          internal::substitute_batch<ReturnType,
+                                     internal::LLVMOptimizer<ReturnType>>(
+            opt, output_values, substitution_values, n_points);
+        }
+#  endif
+      else
+        {
+          AssertThrow(false, ExcNotImplemented());
+        }
+    }
+
+
+
     template <typename ReturnType>
     const std::vector<ReturnType> &
     BatchOptimizer<ReturnType>::evaluate() const
@@ -17,6 +17,7 @@
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/derivative_form.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/quadrature_lib.h>
@@ -44,6 +45,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -2205,6 +2207,92 @@ namespace internal
               }
           }
       }
+
+      /**
+       * Evaluate the Lagrange polynomials with the given nodes and their
+       * first derivatives at the point @p x, using the product form of the
+       * polynomials.
+       */
+      template <typename Number>
+      void
+      evaluate_lagrange_basis_1d(const std::vector<double> &nodes,
+                                 const Number &             x,
+                                 Number *                   values,
+                                 Number *                   derivatives)
+      {
+        const unsigned int n_nodes = nodes.size();
+        for (unsigned int i = 0; i < n_nodes; ++i)
+          {
+            Number value      = 1.;
+            Number derivative = 0.;
+            for (unsigned int j = 0; j < n_nodes; ++j)
+              if (j != i)
+                {
+                  const double inverse_distance = 1. / (nodes[i] - nodes[j]);
+                  const Number factor = (x - nodes[j]) * inverse_distance;
+                  derivative = derivative * factor + value * inverse_distance;
+                  value *= factor;
+                }
+            values[i]      = value;
+            derivatives[i] = derivative;
+          }
+      }
+
+
+
+      /**
+       * Evaluate the position and the Jacobian of the tensor-product mapping
+       * described by the support points @p lexicographic_points, given in
+       * lexicographic order, at the unit point @p p_unit. This is the
+       * vectorized analogue of compute_mapped_location_of_point() together
+       * with the derivatives used in do_transform_real_to_unit_cell_internal().
+       */
+      template <int dim, int spacedim, typename Number>
+      void
+      compute_mapped_location_and_jacobian(
+        const std::vector<double> &         nodes,
+        const std::vector<Point<spacedim>> &lexicographic_points,
+        const Point<dim, Number> &          p_unit,
+        Point<spacedim, Number> &           p_real,
+        Tensor<2, spacedim, Number> &       jacobian)
+      {
+        const unsigned int  n_nodes = nodes.size();
+        std::vector<Number> values(dim * n_nodes), derivatives(dim * n_nodes);
+        for (unsigned int d = 0; d < dim; ++d)
+          evaluate_lagrange_basis_1d(nodes,
+                                     p_unit[d],
+                                     values.data() + d * n_nodes,
+                                     derivatives.data() + d * n_nodes);
+
+        p_real   = Point<spacedim, Number>();
+        jacobian = Tensor<2, spacedim, Number>();
+        for (unsigned int i = 0; i < lexicographic_points.size(); ++i)
+          {
+            unsigned int indices[dim];
+            for (unsigned int d = 0, rest = i; d < dim; ++d, rest /= n_nodes)
+              indices[d] = rest % n_nodes;
+
+            Number value = values[indices[0]];
+            for (unsigned int d = 1; d < dim; ++d)
+              value *= values[d * n_nodes + indices[d]];
+            Tensor<1, dim, Number> gradient;
+            for (unsigned int j = 0; j < dim; ++j)
+              {
+                gradient[j] = derivatives[j * n_nodes + indices[j]];
+                for (unsigned int d = 0; d < dim; ++d)
+                  if (d != j)
+                    gradient[j] *= values[d * n_nodes + indices[d]];
+              }
+
+            const Point<spacedim> &point = lexicographic_points[i];
+            for (unsigned int c = 0; c < spacedim; ++c)
+              {
+                p_real[c] += point[c] * value;
+                for (unsigned int j = 0; j < dim; ++j)
+                  jacobian[c][j] += point[c] * gradient[j];
+              }
+          }
+      }
     } // namespace
   }   // namespace MappingQGenericImplementation
 } // namespace internal
@@ -2212,7 +2300,8 @@ namespace internal
 
 
 template <int dim, int spacedim>
-MappingQGeneric<dim, spacedim>::MappingQGeneric(const unsigned int p)
+MappingQGeneric<dim, spacedim>::MappingQGeneric(const unsigned int p,
+                                                const bool cache_support_points)
   : polynomial_degree(p)
   , line_support_points(this->polynomial_degree + 1)
   , support_point_weights_perimeter_to_interior(
@@ -2223,6 +2312,9 @@ MappingQGeneric<dim, spacedim>::MappingQGeneric(const unsigned int p)
   , support_point_weights_cell(
       internal::MappingQGenericImplementation::
         compute_support_point_weights_cell<dim>(this->polynomial_degree))
+  , support_point_cache(cache_support_points ?
+                          std::make_shared<SupportPointCache>() :
+                          nullptr)
 {
   Assert(p >= 1,
          ExcMessage("It only makes sense to create polynomial mappings "
@@ -2239,10 +2331,40 @@ MappingQGeneric<dim, spacedim>::MappingQGeneric(
   , support_point_weights_perimeter_to_interior(
       mapping.support_point_weights_perimeter_to_interior)
   , support_point_weights_cell(mapping.support_point_weights_cell)
+  , support_point_cache(mapping.support_point_cache)
 {}
 
 
 
+template <int dim, int spacedim>
+MappingQGeneric<dim, spacedim>::SupportPointCache::~SupportPointCache()
+{
+  clear_signal.disconnect();
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::SupportPointCache::attach(
+  const Triangulation<dim, spacedim> &tria)
+{
+  clear_signal.disconnect();
+  points.clear();
+  triangulation = &tria;
+
+  // the 'clear' signal is also triggered from the destructor of the
+  // triangulation, so detach from the triangulation here as well to not
+  // mistake a new triangulation created at the same address for this one
+  clear_signal = tria.signals.any_change.connect([this]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    points.clear();
+    triangulation = nullptr;
+  });
+}
+
+
+
 template <int dim, int spacedim>
 std::unique_ptr<Mapping<dim, spacedim>>
 MappingQGeneric<dim, spacedim>::clone() const
@@ -2611,6 +2733,202 @@ MappingQGeneric<dim, spacedim>::transform_real_to_unit_cell(
 
 
 
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>> &                    real_points,
+  const ArrayView<Point<dim>> &                               unit_points) const
+{
+  AssertDimension(real_points.size(), unit_points.size());
+
+  // the vectorized Newton iteration below only covers the case where the
+  // initial guess can be computed from the vertices of the cell and where
+  // the Jacobian is square
+  if (dim != spacedim || this->preserves_vertex_locations() == false)
+    {
+      Mapping<dim, spacedim>::transform_points_real_to_unit_cell(cell,
+                                                                 real_points,
+                                                                 unit_points);
+      return;
+    }
+
+  // compute the support points of the cell once for all points and bring
+  // them into the lexicographic order of the tensor-product polynomials
+  const std::vector<unsigned int> renumber =
+    FETools::hierarchic_to_lexicographic_numbering<dim>(polynomial_degree);
+  const std::vector<Point<spacedim>> support_points =
+    this->compute_mapping_support_points(cell);
+  std::vector<Point<spacedim>> lexicographic_points(support_points.size());
+  for (unsigned int i = 0; i < support_points.size(); ++i)
+    lexicographic_points[renumber[i]] = support_points[i];
+
+  std::vector<double> nodes(polynomial_degree + 1);
+  for (unsigned int i = 0; i <= polynomial_degree; ++i)
+    nodes[i] = line_support_points.point(i)[0];
+
+  using VectorizedDouble         = VectorizedArray<double>;
+  constexpr unsigned int n_lanes = VectorizedDouble::size();
+
+  // the tolerances of the scalar Newton iteration in
+  // do_transform_real_to_unit_cell_internal()
+  const double       eps                    = 1.e-11;
+  const unsigned int newton_iteration_limit = 20;
+  const double       diameter               = cell->diameter();
+
+  for (unsigned int start = 0; start < real_points.size(); start += n_lanes)
+    {
+      const unsigned int n_filled =
+        std::min<unsigned int>(n_lanes, real_points.size() - start);
+
+      // Start from the projection of the affine approximation into the
+      // unit cell as transform_real_to_unit_cell() does. Unused lanes repeat
+      // the last point and are marked as finished right away.
+      Point<spacedim, VectorizedDouble> p;
+      Point<dim, VectorizedDouble>      p_unit;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const Point<spacedim> &point =
+            real_points[start + std::min(v, n_filled - 1)];
+          const Point<dim> initial_p_unit =
+            GeometryInfo<dim>::project_to_unit_cell(
+              cell->real_to_unit_cell_affine_approximation(point));
+          for (unsigned int d = 0; d < spacedim; ++d)
+            p[d][v] = point[d];
+          for (unsigned int d = 0; d < dim; ++d)
+            p_unit[d][v] = initial_p_unit[d];
+        }
+
+      Point<spacedim, VectorizedDouble>     p_real;
+      Tensor<2, spacedim, VectorizedDouble> df;
+      internal::MappingQGenericImplementation::
+        compute_mapped_location_and_jacobian<dim, spacedim>(
+          nodes, lexicographic_points, p_unit, p_real, df);
+      Tensor<1, spacedim, VectorizedDouble> f = p_real - p;
+
+      // per lane, whether the iteration has converged or failed
+      bool         converged[n_lanes], failed[n_lanes];
+      unsigned int newton_iteration[n_lanes];
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          double f_norm_square = 0.;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            f_norm_square += f[d][v] * f[d][v];
+          converged[v] =
+            (v >= n_filled || f_norm_square < 1e-24 * diameter * diameter);
+          failed[v]           = false;
+          newton_iteration[v] = 0;
+        }
+
+      const auto all_lanes_done = [&]() {
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          if (converged[v] == false && failed[v] == false)
+            return false;
+        return true;
+      };
+
+      while (all_lanes_done() == false)
+        {
+          // Solve [f'(x)]d=f(x) in all lanes, the ones that are done are
+          // simply not updated below
+          const VectorizedDouble                      det = determinant(df);
+          const Tensor<2, spacedim, VectorizedDouble> df_inverse = invert(df);
+          const Tensor<1, spacedim, VectorizedDouble> delta = df_inverse * f;
+          const VectorizedDouble                      f_norm = f.norm();
+
+          bool in_line_search[n_lanes];
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              in_line_search[v] = (converged[v] == false && failed[v] == false);
+              if (in_line_search[v] && !(det[v] > 0))
+                {
+                  failed[v]         = true;
+                  in_line_search[v] = false;
+                }
+            }
+
+          // do a line search, with the step length halved in those lanes
+          // that do not make progress
+          VectorizedDouble step_length = 1.;
+          while (true)
+            {
+              bool any_in_line_search = false;
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                any_in_line_search |= in_line_search[v];
+              if (any_in_line_search == false)
+                break;
+
+              Point<dim, VectorizedDouble> p_unit_trial = p_unit;
+              for (unsigned int i = 0; i < dim; ++i)
+                p_unit_trial[i] -= step_length * delta[i];
+
+              Point<spacedim, VectorizedDouble>     p_real_trial;
+              Tensor<2, spacedim, VectorizedDouble> df_trial;
+              internal::MappingQGenericImplementation::
+                compute_mapped_location_and_jacobian<dim, spacedim>(
+                  nodes, lexicographic_points, p_unit_trial, p_real_trial,
+                  df_trial);
+              const Tensor<1, spacedim, VectorizedDouble> f_trial =
+                p_real_trial - p;
+              const VectorizedDouble f_trial_norm = f_trial.norm();
+
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                if (in_line_search[v])
+                  {
+                    if (f_trial_norm[v] < f_norm[v])
+                      {
+                        for (unsigned int d = 0; d < dim; ++d)
+                          p_unit[d][v] = p_unit_trial[d][v];
+                        for (unsigned int d = 0; d < spacedim; ++d)
+                          {
+                            f[d][v] = f_trial[d][v];
+                            for (unsigned int e = 0; e < spacedim; ++e)
+                              df[d][e][v] = df_trial[d][e][v];
+                          }
+                        in_line_search[v] = false;
+
+                        // check for convergence in the norm induced by the
+                        // Jacobian of the previous iterate, as in the scalar
+                        // code
+                        Tensor<1, spacedim> f_lane;
+                        Tensor<2, spacedim> df_inverse_lane;
+                        for (unsigned int d = 0; d < spacedim; ++d)
+                          {
+                            f_lane[d] = f[d][v];
+                            for (unsigned int e = 0; e < spacedim; ++e)
+                              df_inverse_lane[d][e] = df_inverse[d][e][v];
+                          }
+                        ++newton_iteration[v];
+                        if (newton_iteration[v] > newton_iteration_limit)
+                          failed[v] = true;
+                        else if ((df_inverse_lane * f_lane).norm() <= eps)
+                          converged[v] = true;
+                      }
+                    else if (step_length[v] > 0.05)
+                      step_length[v] /= 2;
+                    else
+                      {
+                        failed[v]         = true;
+                        in_line_search[v] = false;
+                      }
+                  }
+            }
+        }
+
+      for (unsigned int v = 0; v < n_filled; ++v)
+        if (failed[v])
+          {
+            unit_points[start + v]    = Point<dim>();
+            unit_points[start + v][0] = std::numeric_limits<double>::infinity();
+          }
+        else
+          for (unsigned int d = 0; d < dim; ++d)
+            unit_points[start + v][d] = p_unit[d][v];
+    }
+}
+
+
+
 template <int dim, int spacedim>
 UpdateFlags
 MappingQGeneric<dim, spacedim>::requires_update_flags(
@@ -4003,6 +4321,105 @@ template <int dim, int spacedim>
 std::vector<Point<spacedim>>
 MappingQGeneric<dim, spacedim>::compute_mapping_support_points(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+{
+  // for linear mappings, the support points are simply the vertices which
+  // are cheaper to fetch from the cell than from the cache
+  if (support_point_cache.get() != nullptr && polynomial_degree > 1)
+    return get_cached_support_points(cell);
+  else
+    return compute_support_points_from_manifolds(cell);
+}
+
+
+
+template <int dim, int spacedim>
+std::vector<Point<spacedim>>
+MappingQGeneric<dim, spacedim>::get_cached_support_points(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+{
+  SupportPointCache &cache = *support_point_cache;
+
+  const Triangulation<dim, spacedim> &tria  = cell->get_triangulation();
+  const unsigned int                  level = cell->level();
+  const unsigned int                  index = cell->index();
+
+  // the number of cells following the given one on the same level for which
+  // we compute the support points along with those of the given cell
+  const unsigned int batch_size = 64;
+
+  std::vector<typename Triangulation<dim, spacedim>::cell_iterator> batch;
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.triangulation != &tria)
+      cache.attach(tria);
+
+    if (cache.points.size() < tria.n_levels())
+      cache.points.resize(tria.n_levels());
+    std::vector<std::vector<Point<spacedim>>> &level_points =
+      cache.points[level];
+    if (level_points.size() < tria.n_raw_cells(level))
+      level_points.resize(tria.n_raw_cells(level));
+
+    if (!level_points[index].empty())
+      return level_points[index];
+
+    // collect the cells to work on. we only look ahead for active cells
+    // since these are the ones typically visited in a loop, skipping the
+    // artificial cells of parallel triangulations for which the manifolds
+    // might not be able to compute anything
+    batch.push_back(cell);
+    if (cell->is_active())
+      for (unsigned int i = index + 1;
+           i < std::min<unsigned int>(index + batch_size, level_points.size());
+           ++i)
+        if (level_points[i].empty())
+          {
+            const TriaRawIterator<CellAccessor<dim, spacedim>> raw_cell(&tria,
+                                                                        level,
+                                                                        i);
+            if (raw_cell->used())
+              {
+                const typename Triangulation<dim, spacedim>::cell_iterator
+                  next_cell(raw_cell);
+                if (next_cell->is_active() && !next_cell->is_artificial())
+                  batch.push_back(next_cell);
+              }
+          }
+  }
+
+  // compute the support points outside the lock, distributed over several
+  // threads. each cell is computed independently so the result does not
+  // depend on the composition of the batch
+  std::vector<std::vector<Point<spacedim>>> batch_points(batch.size());
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(batch.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        batch_points[i] = compute_support_points_from_manifolds(batch[i]);
+    },
+    8);
+
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  // store the points unless the cache has been invalidated or attached to
+  // another triangulation in the meantime
+  if (cache.triangulation == &tria && level < cache.points.size())
+    for (unsigned int i = 0; i < batch.size(); ++i)
+      {
+        const unsigned int cell_index = batch[i]->index();
+        if (cell_index < cache.points[level].size())
+          cache.points[level][cell_index] = batch_points[i];
+      }
+
+  return batch_points[0];
+}
+
+
+
+template <int dim, int spacedim>
+std::vector<Point<spacedim>>
+MappingQGeneric<dim, spacedim>::compute_support_points_from_manifolds(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
 {
   // get the vertices first
   std::vector<Point<spacedim>> a;
@@ -138,6 +138,30 @@ Manifold<dim, spacedim>::get_new_points(
 
 
 
+template <int dim, int spacedim>
+void
+Manifold<dim, spacedim>::get_new_points_batched(
+  const ArrayView<const Point<spacedim>> &surrounding_points,
+  const ArrayView<const double> &         weights,
+  ArrayView<Point<spacedim>>              new_points) const
+{
+  AssertDimension(surrounding_points.size(), weights.size());
+  if (new_points.size() == 0)
+    return;
+  const unsigned int n_points = surrounding_points.size() / new_points.size();
+  AssertDimension(surrounding_points.size(), n_points * new_points.size());
+
+  for (unsigned int i = 0; i < new_points.size(); ++i)
+    new_points[i] =
+      get_new_point(make_array_view(surrounding_points.begin() + i * n_points,
+                                    surrounding_points.begin() +
+                                      (i + 1) * n_points),
+                    make_array_view(weights.begin() + i * n_points,
+                                    weights.begin() + (i + 1) * n_points));
+}
+
+
+
 template <>
 Tensor<1, 2>
 Manifold<2, 2>::normal_vector(const Triangulation<2, 2>::face_iterator &face,
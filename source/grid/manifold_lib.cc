@@ -15,6 +15,7 @@
 
 #include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/mapping.h>
 
@@ -25,7 +26,9 @@
 
 #include <deal.II/lac/vector.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -598,6 +601,97 @@ SphericalManifold<dim, spacedim>::get_new_point(
 
 
 
+template <int dim, int spacedim>
+void
+SphericalManifold<dim, spacedim>::get_new_points_batched(
+  const ArrayView<const Point<spacedim>> &surrounding_points,
+  const ArrayView<const double> &         weights,
+  ArrayView<Point<spacedim>>              new_points) const
+{
+  AssertDimension(surrounding_points.size(), weights.size());
+  if (new_points.size() == 0)
+    return;
+
+  // only the interpolation between two points is done with SIMD arithmetic
+  if (spacedim == 1 || surrounding_points.size() != 2 * new_points.size())
+    {
+      Manifold<dim, spacedim>::get_new_points_batched(surrounding_points,
+                                                      weights,
+                                                      new_points);
+      return;
+    }
+
+  using VectorizedDouble           = VectorizedArray<double>;
+  constexpr unsigned int n_lanes   = VectorizedDouble::size();
+  const double           tolerance = 1e-10;
+  const double cos_tolerance       = 8. * std::numeric_limits<double>::epsilon();
+
+  for (unsigned int start = 0; start < new_points.size(); start += n_lanes)
+    {
+      const unsigned int n_filled =
+        std::min<unsigned int>(n_lanes, new_points.size() - start);
+
+      // Gather the two points relative to the center and the weight of the
+      // second point into the lanes. Unused lanes repeat the last point, so
+      // that all arithmetic below is done on valid data.
+      Tensor<1, spacedim, VectorizedDouble> v1, v2;
+      VectorizedDouble                      w;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int i = start + std::min(v, n_filled - 1);
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              v1[d][v] = surrounding_points[2 * i][d] - center[d];
+              v2[d][v] = surrounding_points[2 * i + 1][d] - center[d];
+            }
+          w[v] = weights[2 * i + 1];
+        }
+
+      // This is the same algorithm as in get_intermediate_point(): rotate
+      // the direction of the first point towards the second one in the plane
+      // spanned by both directions, and interpolate the radius linearly.
+      const VectorizedDouble                      r1 = v1.norm();
+      const VectorizedDouble                      r2 = v2.norm();
+      const Tensor<1, spacedim, VectorizedDouble> e1 = v1 / r1;
+      const Tensor<1, spacedim, VectorizedDouble> e2 = v2 / r2;
+      const VectorizedDouble                      cosgamma = e1 * e2;
+
+      VectorizedDouble sigma;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        sigma[v] = w[v] * std::acos(std::max(-1., std::min(1., cosgamma[v])));
+
+      Tensor<1, spacedim, VectorizedDouble> n = v2 - (v2 * e1) * e1;
+      n /= n.norm();
+
+      const Tensor<1, spacedim, VectorizedDouble> P =
+        std::cos(sigma) * e1 + std::sin(sigma) * n;
+      const VectorizedDouble radius = w * r2 + (1.0 - w) * r1;
+
+      // Write back the results, and let get_intermediate_point() deal with
+      // the special cases where the formula above is not valid. This
+      // includes points at the center, for which the lanes above hold
+      // invalid numbers and get_intermediate_point() raises an error.
+      for (unsigned int v = 0; v < n_filled; ++v)
+        {
+          const unsigned int     i  = start + v;
+          const Point<spacedim> &p1 = surrounding_points[2 * i];
+          const Point<spacedim> &p2 = surrounding_points[2 * i + 1];
+          if ((p1 - p2).norm_square() < tolerance * tolerance ||
+              std::abs(w[v]) < tolerance ||
+              std::abs(w[v] - 1.0) < tolerance || r1[v] <= tolerance ||
+              r2[v] <= tolerance ||
+              cosgamma[v] < -1. + cos_tolerance ||
+              cosgamma[v] > 1. - cos_tolerance)
+            new_points[i] = get_intermediate_point(p1, p2, w[v]);
+          else
+            for (unsigned int d = 0; d < spacedim; ++d)
+              new_points[i][d] = center[d] + radius[v] * P[d][v];
+        }
+    }
+}
+
+
+
 template <int dim, int spacedim>
 void
 SphericalManifold<dim, spacedim>::get_new_points(
@@ -1108,6 +1202,147 @@ CylindricalManifold<dim, spacedim>::get_new_point(
 
 
 
+template <int dim, int spacedim>
+void
+CylindricalManifold<dim, spacedim>::get_new_points_batched(
+  const ArrayView<const Point<spacedim>> &surrounding_points,
+  const ArrayView<const double> &         weights,
+  ArrayView<Point<spacedim>>              new_points) const
+{
+  AssertDimension(surrounding_points.size(), weights.size());
+  if (new_points.size() == 0)
+    return;
+
+  // let get_new_point() complain about the wrong space dimension
+  if (spacedim != 3)
+    {
+      Manifold<dim, spacedim>::get_new_points_batched(surrounding_points,
+                                                      weights,
+                                                      new_points);
+      return;
+    }
+
+  const unsigned int n_points = surrounding_points.size() / new_points.size();
+  AssertDimension(surrounding_points.size(), n_points * new_points.size());
+
+  using VectorizedDouble         = VectorizedArray<double>;
+  constexpr unsigned int n_lanes = VectorizedDouble::size();
+
+  // the periodicity of the angle, as set in the constructor
+  const double              period = 2. * numbers::PI;
+  const Tensor<1, spacedim> dxn = cross_product_3d(direction, normal_direction);
+
+  // the cylindrical coordinates (r, phi, lambda) of the surrounding points
+  std::vector<std::array<VectorizedDouble, 3>> chart_points(n_points);
+  std::vector<VectorizedDouble>                chart_weights(n_points);
+
+  for (unsigned int start = 0; start < new_points.size(); start += n_lanes)
+    {
+      const unsigned int n_filled =
+        std::min<unsigned int>(n_lanes, new_points.size() - start);
+
+      // Gather the surrounding points into the lanes and compute their
+      // weighted average in space as well as their pull-backs with the same
+      // operations as get_new_point() and pull_back(). Unused lanes repeat
+      // the last new point, so that all arithmetic below is done on valid
+      // data.
+      Tensor<1, spacedim, VectorizedDouble> middle;
+      VectorizedDouble                      average_length = 0.;
+      for (unsigned int i = 0; i < n_points; ++i)
+        {
+          Tensor<1, spacedim, VectorizedDouble> x;
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              const unsigned int index =
+                (start + std::min(v, n_filled - 1)) * n_points + i;
+              for (unsigned int d = 0; d < spacedim; ++d)
+                x[d][v] = surrounding_points[index][d];
+              chart_weights[i][v] = weights[index];
+            }
+          middle += x * chart_weights[i];
+          average_length += x.norm_square() * chart_weights[i];
+
+          Tensor<1, spacedim, VectorizedDouble> normalized_point;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            normalized_point[d] = x[d] - point_on_axis[d];
+          VectorizedDouble lambda = 0.;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            lambda += normalized_point[d] * direction[d];
+          Tensor<1, spacedim, VectorizedDouble> p_diff;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            p_diff[d] = x[d] - (point_on_axis[d] + direction[d] * lambda);
+
+          VectorizedDouble dot = 0.;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            dot += normal_direction[d] * p_diff[d];
+          VectorizedDouble det = 0.;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              const unsigned int d1 = (d + 1) % spacedim;
+              const unsigned int d2 = (d + 2) % spacedim;
+              det += direction[d] * (normal_direction[d1] * p_diff[d2] -
+                                     normal_direction[d2] * p_diff[d1]);
+            }
+          VectorizedDouble phi;
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            phi[v] = std::atan2(det[v], dot[v]);
+
+          chart_points[i] = {{p_diff.norm(), phi, lambda}};
+        }
+
+      // Interpolate in the chart space as done by the FlatManifold with
+      // periodic angle that ChartManifold::get_new_point() uses: points
+      // whose angle is more than half a period above the smallest one are
+      // shifted down by one period.
+      VectorizedDouble min_phi = period;
+      for (unsigned int i = 0; i < n_points; ++i)
+        min_phi = std::min(min_phi, chart_points[i][1]);
+      std::array<VectorizedDouble, 3> p_chart;
+      p_chart.fill(VectorizedDouble(0.));
+      for (unsigned int i = 0; i < n_points; ++i)
+        {
+          VectorizedDouble phi = chart_points[i][1];
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            if (phi[v] - min_phi[v] > period / 2.0)
+              phi[v] -= period;
+          p_chart[0] += chart_points[i][0] * chart_weights[i];
+          p_chart[1] += phi * chart_weights[i];
+          p_chart[2] += chart_points[i][2] * chart_weights[i];
+        }
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        if (p_chart[1][v] < 0)
+          p_chart[1][v] += period;
+
+      // push forward as in push_forward()
+      const VectorizedDouble sine_r   = std::sin(p_chart[1]) * p_chart[0];
+      const VectorizedDouble cosine_r = std::cos(p_chart[1]) * p_chart[0];
+      Tensor<1, spacedim, VectorizedDouble> result;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        result[d] = point_on_axis[d] + direction[d] * p_chart[2] +
+                    (normal_direction[d] * cosine_r + dxn[d] * sine_r);
+
+      // Write back the results. If the average in space lies on the axis,
+      // the new point is its projection to the axis as in get_new_point().
+      for (unsigned int v = 0; v < n_filled; ++v)
+        {
+          Tensor<1, spacedim> middle_lane;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            middle_lane[d] = middle[d][v] - point_on_axis[d];
+          const double lambda = middle_lane * direction;
+
+          Point<spacedim> &new_point = new_points[start + v];
+          if ((middle_lane - direction * lambda).norm_square() <
+              tolerance * average_length[v])
+            new_point = point_on_axis + direction * lambda;
+          else
+            for (unsigned int d = 0; d < spacedim; ++d)
+              new_point[d] = result[d][v];
+        }
+    }
+}
+
+
+
 template <int dim, int spacedim>
 Point<3>
 CylindricalManifold<dim, spacedim>::pull_back(
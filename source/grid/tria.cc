@@ -16,12 +16,14 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/fe/mapping_q1.h>
 
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/magic_numbers.h>
 #include <deal.II/grid/manifold.h>
+#include <deal.II/grid/manifold_lib.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_accessor.h>
 #include <deal.II/grid/tria_faces.h>
@@ -39,6 +41,7 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <typeinfo>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -4177,6 +4180,148 @@ namespace internal
       }
 
 
+      /**
+       * Return whether the given manifold is one of the manifold classes of
+       * the library that compute new points without calling into other
+       * manifolds or user code. Any other class, including classes derived
+       * from the ones listed here, might override get_new_point_on_line(),
+       * get_new_point_on_quad(), or get_new_point_on_hex(), and need not be
+       * thread-safe.
+       */
+      template <int dim, int spacedim>
+      static bool
+      manifold_is_thread_safe(const Manifold<dim, spacedim> &manifold)
+      {
+        const std::type_info &type = typeid(manifold);
+        return (type == typeid(FlatManifold<dim, spacedim>) ||
+                type == typeid(SphericalManifold<dim, spacedim>) ||
+                type == typeid(PolarManifold<dim, spacedim>) ||
+                type == typeid(CylindricalManifold<dim, spacedim>) ||
+                type == typeid(EllipticalManifold<dim, spacedim>));
+      }
+
+
+      /**
+       * Return whether the new vertices on the given manifold can be
+       * computed by concurrent calls to Manifold::get_new_points_batched()
+       * during refinement. This is the case for the manifolds accepted by
+       * manifold_is_thread_safe(). A TransfiniteInterpolationManifold
+       * evaluates the manifolds attached to the lines and quads of the coarse
+       * cells of the triangulation, so it is only accepted if all manifolds
+       * set in the triangulation are either accepted by
+       * manifold_is_thread_safe() or are themselves transfinite interpolation
+       * manifolds.
+       */
+      template <int dim, int spacedim>
+      static bool
+      manifold_allows_batched_refinement(
+        const Manifold<dim, spacedim> &     manifold,
+        const Triangulation<dim, spacedim> &triangulation)
+      {
+        if (manifold_is_thread_safe(manifold))
+          return true;
+
+        if (typeid(manifold) !=
+            typeid(TransfiniteInterpolationManifold<dim, spacedim>))
+          return false;
+
+        // manifold ids without a manifold object use the flat manifold, so
+        // it is enough to check the manifolds set in the triangulation
+        for (const auto &other : triangulation.manifold)
+          if (manifold_is_thread_safe(*other.second) == false &&
+              typeid(*other.second) !=
+                typeid(TransfiniteInterpolationManifold<dim, spacedim>))
+            return false;
+        return true;
+      }
+
+
+      /**
+       * Compute the locations of the new vertices in the center of the
+       * given lines, quads, or hexes, as they are needed when refining
+       * these objects. The objects are grouped by their manifold. If
+       * manifold_allows_batched_refinement() returns true, the new points
+       * of a group are computed in parallel by batched calls to
+       * Manifold::get_new_points_batched(), using the surrounding points and
+       * weights returned by Manifolds::get_default_points_and_weights().
+       * Otherwise, the new points are computed one after the other by
+       * TriaAccessor::center(), which calls the manifold in the same way as
+       * the refinement of a single object.
+       *
+       * The returned vector holds the new vertex of <code>objects[i]</code>
+       * in its $i$th entry.
+       */
+      template <int structdim, int dim, int spacedim>
+      static std::vector<Point<spacedim>>
+      compute_new_vertices(
+        const std::vector<
+          TriaRawIterator<TriaAccessor<structdim, dim, spacedim>>> &objects,
+        const bool use_interpolation)
+      {
+        using IteratorType =
+          TriaRawIterator<TriaAccessor<structdim, dim, spacedim>>;
+        constexpr unsigned int n_surrounding_points =
+          Manifolds::n_default_points_per_cell<IteratorType>();
+
+        std::vector<Point<spacedim>> new_vertices(objects.size());
+
+        std::map<types::manifold_id, std::vector<unsigned int>>
+          objects_by_manifold;
+        for (unsigned int i = 0; i < objects.size(); ++i)
+          objects_by_manifold[objects[i]->manifold_id()].push_back(i);
+
+        for (const auto &group : objects_by_manifold)
+          {
+            const std::vector<unsigned int> &indices = group.second;
+            const Manifold<dim, spacedim> &  manifold =
+              objects[indices[0]]->get_manifold();
+
+            if (manifold_allows_batched_refinement(
+                  manifold, objects[indices[0]]->get_triangulation()) == false)
+              {
+                for (const unsigned int i : indices)
+                  new_vertices[i] = objects[i]->center(true, use_interpolation);
+                continue;
+              }
+
+            parallel::apply_to_subranges(
+              0U,
+              static_cast<unsigned int>(indices.size()),
+              [&](const unsigned int begin, const unsigned int end) {
+                std::vector<Point<spacedim>> points((end - begin) *
+                                                    n_surrounding_points);
+                std::vector<double>          weights(points.size());
+                std::vector<Point<spacedim>> batch_vertices(end - begin);
+                for (unsigned int i = begin; i < end; ++i)
+                  {
+                    const auto points_and_weights =
+                      Manifolds::get_default_points_and_weights(
+                        objects[indices[i]], use_interpolation);
+                    std::copy(points_and_weights.first.begin(),
+                              points_and_weights.first.end(),
+                              points.begin() +
+                                (i - begin) * n_surrounding_points);
+                    std::copy(points_and_weights.second.begin(),
+                              points_and_weights.second.end(),
+                              weights.begin() +
+                                (i - begin) * n_surrounding_points);
+                  }
+
+                manifold.get_new_points_batched(make_array_view(points),
+                                                make_array_view(weights),
+                                                make_array_view(
+                                                  batch_vertices));
+
+                for (unsigned int i = begin; i < end; ++i)
+                  new_vertices[indices[i]] = batch_vertices[i - begin];
+              },
+              64);
+          }
+
+        return new_vertices;
+      }
+
+
       /**
        * Create the children of a 2d
        * cell. The arguments indicate
@@ -4193,6 +4338,11 @@ namespace internal
        * lines, quads and cells have to
        * be passed, which point at (or
        * "before") the reserved space.
+       *
+       * The last argument is the location
+       * of the new vertex in the center
+       * of the cell, which is only used
+       * for isotropic refinement.
        */
       template <int spacedim>
       static void create_children(
@@ -4202,7 +4352,8 @@ namespace internal
           &next_unused_line,
         typename Triangulation<2, spacedim>::raw_cell_iterator
           &                                                 next_unused_cell,
-        typename Triangulation<2, spacedim>::cell_iterator &cell)
+        typename Triangulation<2, spacedim>::cell_iterator &cell,
+        const Point<spacedim> &                             new_center_vertex)
       {
         const unsigned int dim = 2;
         // clear refinement flag
@@ -4329,49 +4480,11 @@ namespace internal
 
             new_vertices[8] = next_unused_vertex;
 
-            // if this quad lives
-            // in 2d, then we can
-            // compute the new
-            // central vertex
-            // location just from
-            // the surrounding
-            // ones. If this is
-            // not the case, then
-            // we need to ask a
-            // boundary object
-            if (dim == spacedim)
-              {
-                // triangulation.vertices[next_unused_vertex] = new_point;
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-
-                // if the user_flag is set, i.e. if the cell is at the
-                // boundary, use a different calculation of the middle vertex
-                // here. this is of advantage if the boundary is strongly
-                // curved (whereas the cell is not) and the cell has a high
-                // aspect ratio.
-                if (cell->user_flag_set())
-                  {
-                    // first reset the user_flag and then refine
-                    cell->clear_user_flag();
-                    triangulation.vertices[next_unused_vertex] =
-                      cell->center(true, true);
-                  }
-              }
-            else
-              {
-                // if this quad lives in a higher dimensional space
-                // then we don't need to worry if it is at the
-                // boundary of the manifold -- we always have to use
-                // the boundary object anyway; so ignore whether the
-                // user flag is set or not
-                cell->clear_user_flag();
-
-                // determine middle vertex by transfinite interpolation to be
-                // consistent with what happens to quads in a Triangulation<3,
-                // 3> when they are refined
-                triangulation.vertices[next_unused_vertex] =
-                  cell->center(true, true);
-              }
+            // the location of the new central vertex has been computed by
+            // the caller, so we only need to reset the user flag that
+            // indicates a cell at the boundary
+            cell->clear_user_flag();
+            triangulation.vertices[next_unused_vertex] = new_center_vertex;
           }
 
 
@@ -4732,6 +4845,17 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_cell_iterator
               next_unused_cell = triangulation.begin_raw(level + 1);
 
+            // compute the new vertices of all flagged cells on this level
+            // at once, and use them in the order of the loop below
+            std::vector<TriaRawIterator<TriaAccessor<dim, dim, spacedim>>>
+              cells_to_refine;
+            for (auto c = cell; (c != endc) && (c->level() == level); ++c)
+              if (c->refine_flag_set())
+                cells_to_refine.emplace_back(c);
+            const std::vector<Point<spacedim>> new_cell_vertices =
+              compute_new_vertices(cells_to_refine, false);
+            unsigned int n_refined_cells = 0;
+
             for (; (cell != endc) && (cell->level() == level); ++cell)
               if (cell->refine_flag_set())
                 {
@@ -4748,11 +4872,13 @@ namespace internal
                     ExcMessage(
                       "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
 
-                  // Now we always ask the cell itself where to put
-                  // the new point. The cell in turn will query the
-                  // manifold object internally.
+                  // The new point was computed above by the manifold of
+                  // the cell.
+                  Assert(cells_to_refine[n_refined_cells]->index() ==
+                           cell->index(),
+                         ExcInternalError());
                   triangulation.vertices[next_unused_vertex] =
-                    cell->center(true);
+                    new_cell_vertices[n_refined_cells++];
 
                   triangulation.vertices_used[next_unused_vertex] = true;
 
@@ -5055,6 +5181,17 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // compute the midpoints of all flagged lines at once, and use
+          // them in the order of the loop below
+          std::vector<TriaRawIterator<TriaAccessor<1, dim, spacedim>>>
+            lines_to_refine;
+          for (auto l = line; l != endl; ++l)
+            if (l->user_flag_set())
+              lines_to_refine.emplace_back(l);
+          const std::vector<Point<spacedim>> new_line_vertices =
+            compute_new_vertices(lines_to_refine, false);
+          unsigned int n_refined_lines = 0;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5070,7 +5207,11 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                Assert(lines_to_refine[n_refined_lines]->index() ==
+                         line->index(),
+                       ExcInternalError());
+                triangulation.vertices[next_unused_vertex] =
+                  new_line_vertices[n_refined_lines++];
 
                 // now that we created the right point, make up the
                 // two child lines.  To this end, find a pair of
@@ -5165,9 +5306,48 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_cell_iterator
               next_unused_cell = triangulation.begin_raw(level + 1);
 
+            // compute the central vertices of all cells on this level that
+            // are refined isotropically. if the quad lives in 2d and is not
+            // at the boundary, the central vertex is computed from the four
+            // vertices and the four midpoints of the lines with equal
+            // weights. if the cell is at the boundary, use transfinite
+            // interpolation instead, which is of advantage if the boundary is
+            // strongly curved (whereas the cell is not) and the cell has a
+            // high aspect ratio. if the quad lives in a higher dimensional
+            // space, always use transfinite interpolation to be consistent
+            // with what happens to quads in a Triangulation<3,3> when they
+            // are refined.
+            std::vector<TriaRawIterator<TriaAccessor<dim, dim, spacedim>>>
+                                      cells_to_refine[2];
+            std::vector<unsigned int> cell_positions[2];
+            unsigned int              n_isotropic_cells = 0;
+            for (auto c = cell; c != endc; ++c)
+              if (c->refine_flag_set() == RefinementCase<dim>::cut_xy)
+                {
+                  const bool use_interpolation =
+                    (dim != spacedim) || c->at_boundary();
+                  cells_to_refine[use_interpolation].emplace_back(c);
+                  cell_positions[use_interpolation].push_back(
+                    n_isotropic_cells++);
+                }
+            std::vector<Point<spacedim>> new_cell_vertices(n_isotropic_cells);
+            for (unsigned int i = 0; i < 2; ++i)
+              {
+                const std::vector<Point<spacedim>> vertices =
+                  compute_new_vertices(cells_to_refine[i], i == 1);
+                for (unsigned int j = 0; j < vertices.size(); ++j)
+                  new_cell_vertices[cell_positions[i][j]] = vertices[j];
+              }
+            unsigned int n_refined_isotropic_cells = 0;
+
             for (; cell != endc; ++cell)
               if (cell->refine_flag_set())
                 {
+                  const Point<spacedim> new_center_vertex =
+                    (cell->refine_flag_set() == RefinementCase<dim>::cut_xy ?
+                       new_cell_vertices[n_refined_isotropic_cells++] :
+                       Point<spacedim>());
+
                   // set the user flag to indicate, that at least one
                   // line is at the boundary
 
@@ -5183,7 +5363,8 @@ namespace internal
                                   next_unused_vertex,
                                   next_unused_line,
                                   next_unused_cell,
-                                  cell);
+                                  cell,
+                                  new_center_vertex);
 
                   if ((check_for_distorted_cells == true) &&
                       has_distorted_children(
@@ -5533,6 +5714,17 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // compute the midpoints of all flagged lines at once, and use
+          // them in the order of the loop below
+          std::vector<TriaRawIterator<TriaAccessor<1, dim, spacedim>>>
+            lines_to_refine;
+          for (auto l = line; l != endl; ++l)
+            if (l->user_flag_set())
+              lines_to_refine.emplace_back(l);
+          const std::vector<Point<spacedim>> new_line_vertices =
+            compute_new_vertices(lines_to_refine, false);
+          unsigned int n_refined_lines = 0;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5548,7 +5740,11 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                Assert(lines_to_refine[n_refined_lines]->index() ==
+                         line->index(),
+                       ExcInternalError());
+                triangulation.vertices[next_unused_vertex] =
+                  new_line_vertices[n_refined_lines++];
 
                 // now that we created the right point, make up the
                 // two child lines (++ takes care of the end of the
@@ -5632,6 +5828,33 @@ namespace internal
         // anisotropically (this is transformed to case c), however we
         // might have to renumber/rename children...)
 
+        // compute the central vertices of all quads that are refined
+        // isotropically (i.e., case a) above) at once, and store for each
+        // quad index the position of its vertex in new_quad_vertices. as
+        // quads might be renumbered in case e), we also keep the vertex
+        // indices of each quad to make sure we later look at the same quad
+        std::vector<TriaRawIterator<TriaAccessor<2, dim, spacedim>>>
+                                  quads_to_refine;
+        std::vector<unsigned int> quad_vertex_positions(
+          triangulation.n_raw_quads(), numbers::invalid_unsigned_int);
+        std::vector<std::array<unsigned int, 4>> quad_vertex_indices;
+        for (typename Triangulation<dim, spacedim>::quad_iterator quad =
+               triangulation.begin_quad();
+             quad != triangulation.end_quad();
+             ++quad)
+          if (quad->user_flag_set() && quad->user_index() == 0 &&
+              quad->has_children() == false)
+            {
+              quad_vertex_positions[quad->index()] = quads_to_refine.size();
+              quads_to_refine.emplace_back(quad);
+              quad_vertex_indices.push_back({{quad->vertex_index(0),
+                                              quad->vertex_index(1),
+                                              quad->vertex_index(2),
+                                              quad->vertex_index(3)}});
+            }
+        const std::vector<Point<spacedim>> new_quad_vertices =
+          compute_new_vertices(quads_to_refine, true);
+
         // we need a loop in cases c) and d), as the anisotropic
         // children migt have a lower index than the mother quad
         for (unsigned int loop = 0; loop < 2; ++loop)
@@ -6315,9 +6538,25 @@ namespace internal
                     // minimize the distortion of the four new quads from the
                     // optimal shape. their description uses the formulas
                     // underlying the TransfiniteInterpolationManifold
-                    // implementation
-                    triangulation.vertices[next_unused_vertex] =
-                      quad->center(true, true);
+                    // implementation. the vertex was usually computed
+                    // above together with the ones of the other quads.
+                    const unsigned int position =
+                      (static_cast<std::size_t>(quad->index()) <
+                           quad_vertex_positions.size() ?
+                         quad_vertex_positions[quad->index()] :
+                         numbers::invalid_unsigned_int);
+                    if (position != numbers::invalid_unsigned_int &&
+                        quad_vertex_indices[position] ==
+                          std::array<unsigned int, 4>{
+                            {quad->vertex_index(0),
+                             quad->vertex_index(1),
+                             quad->vertex_index(2),
+                             quad->vertex_index(3)}})
+                      triangulation.vertices[next_unused_vertex] =
+                        new_quad_vertices[position];
+                    else
+                      triangulation.vertices[next_unused_vertex] =
+                        quad->center(true, true);
                     triangulation.vertices_used[next_unused_vertex] = true;
 
                     // now that we created the right point, make up
@@ -6584,6 +6823,18 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_hex_iterator
               next_unused_hex = triangulation.begin_raw_hex(level + 1);
 
+            // compute the central vertices of all hexes on this level that
+            // are refined isotropically at once, and use them in the order
+            // of the loop below
+            std::vector<TriaRawIterator<TriaAccessor<3, dim, spacedim>>>
+              hexes_to_refine;
+            for (auto h = hex; h != endh; ++h)
+              if (h->refine_flag_set() == RefinementCase<dim>::cut_xyz)
+                hexes_to_refine.emplace_back(h);
+            const std::vector<Point<spacedim>> new_hex_vertices =
+              compute_new_vertices(hexes_to_refine, true);
+            unsigned int n_refined_hexes = 0;
+
             for (; hex != endh; ++hex)
               if (hex->refine_flag_set())
                 {
@@ -8881,11 +9132,13 @@ namespace internal
                           // the new vertex is definitely in the interior,
                           // so we need not worry about the
                           // boundary. However we need to worry about
-                          // Manifolds. Let the cell compute its own
-                          // center, by querying the underlying manifold
-                          // object.
+                          // Manifolds. The vertex has been computed above
+                          // by the underlying manifold object.
+                          Assert(hexes_to_refine[n_refined_hexes]->index() ==
+                                   hex->index(),
+                                 ExcInternalError());
                           triangulation.vertices[next_unused_vertex] =
-                            hex->center(true, true);
+                            new_hex_vertices[n_refined_hexes++];
 
                           // set the data of the six lines.  first collect
                           // the indices of the seven vertices (consider
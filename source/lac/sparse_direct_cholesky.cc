@@ -0,0 +1,1240 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/lapack_support.h>
+#include <deal.II/lac/lapack_templates.h>
+#include <deal.II/lac/sparse_direct_cholesky.h>
+#include <deal.II/lac/sparsity_tools.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace
+{
+  using size_type = SparseDirectCholesky::size_type;
+
+  /**
+   * The minimal estimated number of floating point operations in a subtree
+   * of supernodes for it to be processed as a task of its own.
+   */
+  const double minimum_work_per_task = 1e6;
+
+  /**
+   * The position stored for matrix entries that are not assembled into any
+   * frontal matrix.
+   */
+  const std::size_t skipped_entry = std::numeric_limits<std::size_t>::max();
+
+  /**
+   * Solve $U^T X = B$ (if @p transpose is true) or $U X = B$ for the
+   * upper triangular @p n by @p n matrix $U$ and the @p n by @p n_rhs
+   * matrix $B$, both stored column major with the given leading dimensions.
+   */
+  void
+  triangular_solve(const bool        transpose,
+                   const bool        unit_diagonal,
+                   const std::size_t n,
+                   const std::size_t n_rhs,
+                   const double *    U,
+                   const std::size_t ldu,
+                   double *          B,
+                   const std::size_t ldb)
+  {
+    if (n == 0 || n_rhs == 0)
+      return;
+
+#ifdef DEAL_II_WITH_LAPACK
+    const types::blas_int n_ = n, n_rhs_ = n_rhs, ldu_ = ldu, ldb_ = ldb;
+    types::blas_int       info = 0;
+    trtrs("U",
+          transpose ? "T" : "N",
+          unit_diagonal ? "U" : "N",
+          &n_,
+          &n_rhs_,
+          U,
+          &ldu_,
+          B,
+          &ldb_,
+          &info);
+    Assert(info == 0, LAPACKSupport::ExcErrorCode("trtrs", info));
+#else
+    for (std::size_t q = 0; q < n_rhs; ++q)
+      {
+        double *b = B + q * ldb;
+        if (transpose)
+          for (std::size_t i = 0; i < n; ++i)
+            {
+              double sum = b[i];
+              for (std::size_t p = 0; p < i; ++p)
+                sum -= U[p + i * ldu] * b[p];
+              b[i] = unit_diagonal ? sum : sum / U[i + i * ldu];
+            }
+        else
+          for (std::size_t i = n; i-- > 0;)
+            {
+              double sum = b[i];
+              for (std::size_t p = i + 1; p < n; ++p)
+                sum -= U[i + p * ldu] * b[p];
+              b[i] = unit_diagonal ? sum : sum / U[i + i * ldu];
+            }
+      }
+#endif
+  }
+
+
+
+  /**
+   * Compute $C \leftarrow C - A^T B$ (if @p transpose is true) or
+   * $C \leftarrow C - A B$ for the @p m by @p n matrix $C$ and the matrices
+   * $A$ and $B$ with inner dimension @p k, all stored column major.
+   */
+  void
+  subtract_product(const bool        transpose,
+                   const std::size_t m,
+                   const std::size_t n,
+                   const std::size_t k,
+                   const double *    A,
+                   const std::size_t lda,
+                   const double *    B,
+                   const std::size_t ldb,
+                   double *          C,
+                   const std::size_t ldc)
+  {
+    if (m == 0 || n == 0 || k == 0)
+      return;
+
+#ifdef DEAL_II_WITH_LAPACK
+    const types::blas_int m_ = m, n_ = n, k_ = k, lda_ = lda, ldb_ = ldb,
+                          ldc_  = ldc;
+    const double          alpha = -1., beta = 1.;
+    gemm(transpose ? "T" : "N",
+         "N",
+         &m_,
+         &n_,
+         &k_,
+         &alpha,
+         A,
+         &lda_,
+         B,
+         &ldb_,
+         &beta,
+         C,
+         &ldc_);
+#else
+    for (std::size_t j = 0; j < n; ++j)
+      for (std::size_t p = 0; p < k; ++p)
+        {
+          const double b = B[p + j * ldb];
+          if (transpose)
+            for (std::size_t i = 0; i < m; ++i)
+              C[i + j * ldc] -= A[p + i * lda] * b;
+          else
+            for (std::size_t i = 0; i < m; ++i)
+              C[i + j * ldc] -= A[i + p * lda] * b;
+        }
+#endif
+  }
+
+
+
+  /**
+   * Compute the upper triangle of $C \leftarrow C - A^T A$ for the @p n by
+   * @p n matrix $C$ and the @p k by @p n matrix $A$, both stored column
+   * major.
+   */
+  void
+  subtract_symmetric_product(const std::size_t n,
+                             const std::size_t k,
+                             const double *    A,
+                             const std::size_t lda,
+                             double *          C,
+                             const std::size_t ldc)
+  {
+    if (n == 0 || k == 0)
+      return;
+
+#ifdef DEAL_II_WITH_LAPACK
+    const types::blas_int n_ = n, k_ = k, lda_ = lda, ldc_ = ldc;
+    const double          alpha = -1., beta = 1.;
+    syrk("U", "T", &n_, &k_, &alpha, A, &lda_, &beta, C, &ldc_);
+#else
+    for (std::size_t j = 0; j < n; ++j)
+      for (std::size_t i = 0; i <= j; ++i)
+        {
+          double sum = 0.;
+          for (std::size_t p = 0; p < k; ++p)
+            sum += A[p + i * lda] * A[p + j * lda];
+          C[i + j * ldc] -= sum;
+        }
+#endif
+  }
+
+
+
+  /**
+   * Eliminate the first @p n_pivots rows and columns of the symmetric
+   * @p n by @p n matrix whose upper triangle is stored column major in
+   * @p F. Upon return, the first @p n_pivots rows of @p F hold the
+   * corresponding rows of the factor $U$, and the trailing block holds the
+   * Schur complement. For an $LDL^T$ factorization, the pivots are stored
+   * in @p D. The work is done in blocks of columns, so that most of it is
+   * done in matrix-matrix products.
+   *
+   * Return the index of the pivot at which the factorization broke down, or
+   * @p n_pivots if it succeeded.
+   */
+  std::size_t
+  partial_factorization(double *          F,
+                        const std::size_t n,
+                        const std::size_t n_pivots,
+                        const bool        ldlt,
+                        double *          D)
+  {
+    const std::size_t block_size = 64;
+
+    std::vector<double> scaled_panel;
+    for (std::size_t k0 = 0; k0 < n_pivots; k0 += block_size)
+      {
+        const std::size_t n_block  = std::min(block_size, n_pivots - k0);
+        double *const     diagonal = F + k0 + k0 * n;
+
+        // factorize the diagonal block column by column
+        for (std::size_t j = 0; j < n_block; ++j)
+          {
+            double *column = diagonal + j * n;
+            for (std::size_t i = 0; i < j; ++i)
+              {
+                double sum = column[i];
+                for (std::size_t p = 0; p < i; ++p)
+                  sum -= diagonal[p + i * n] * column[p];
+                column[i] = ldlt ? sum : sum / diagonal[i + i * n];
+              }
+
+            double pivot = column[j];
+            if (ldlt)
+              {
+                // column[p] holds (D U)_pj so far, divide by the pivots
+                for (std::size_t p = 0; p < j; ++p)
+                  {
+                    const double u = column[p] / D[k0 + p];
+                    pivot -= u * column[p];
+                    column[p] = u;
+                  }
+                if (pivot == 0.)
+                  return k0 + j;
+                D[k0 + j] = pivot;
+                column[j] = 1.;
+              }
+            else
+              {
+                for (std::size_t p = 0; p < j; ++p)
+                  pivot -= column[p] * column[p];
+                if (!(pivot > 0.))
+                  return k0 + j;
+                column[j] = std::sqrt(pivot);
+              }
+          }
+
+        // compute the remaining entries of the rows of the block, and update
+        // the trailing matrix
+        const std::size_t n_trailing = n - k0 - n_block;
+        if (n_trailing == 0)
+          continue;
+
+        double *const panel    = diagonal + n_block * n;
+        double *const trailing = panel + n_block;
+        triangular_solve(
+          true, ldlt, n_block, n_trailing, diagonal, n, panel, n);
+
+        if (ldlt)
+          {
+            // the panel now holds D U_12. keep a copy, scale the panel to
+            // U_12, and subtract U_12^T D U_12 from the upper triangle of the
+            // trailing matrix in slabs of columns
+            scaled_panel.resize(n_block * n_trailing);
+            for (std::size_t j = 0; j < n_trailing; ++j)
+              for (std::size_t i = 0; i < n_block; ++i)
+                {
+                  scaled_panel[i + j * n_block] = panel[i + j * n];
+                  panel[i + j * n] /= D[k0 + i];
+                }
+
+            const std::size_t slab_size = 256;
+            for (std::size_t j0 = 0; j0 < n_trailing; j0 += slab_size)
+              {
+                const std::size_t n_slab = std::min(slab_size, n_trailing - j0);
+                subtract_product(true,
+                                 j0 + n_slab,
+                                 n_slab,
+                                 n_block,
+                                 panel,
+                                 n,
+                                 scaled_panel.data() + j0 * n_block,
+                                 n_block,
+                                 trailing + j0 * n,
+                                 n);
+              }
+          }
+        else
+          subtract_symmetric_product(
+            n_trailing, n_block, panel, n, trailing, n);
+      }
+
+    return n_pivots;
+  }
+
+
+
+  /**
+   * Build the adjacency graph of the symmetrized sparsity pattern in the
+   * numbering given by @p new_indices, without the diagonal, in compressed
+   * row storage with sorted rows.
+   */
+  void
+  build_permuted_graph(const SparsityPattern &       sparsity_pattern,
+                       const std::vector<size_type> &new_indices,
+                       std::vector<std::size_t> &    graph_start,
+                       std::vector<size_type> &      graph)
+  {
+    const size_type n = sparsity_pattern.n_rows();
+
+    graph_start.assign(n + 1, 0);
+    for (size_type row = 0; row < n; ++row)
+      for (auto it = sparsity_pattern.begin(row);
+           it != sparsity_pattern.end(row);
+           ++it)
+        if (it->column() != row)
+          {
+            ++graph_start[new_indices[row] + 1];
+            ++graph_start[new_indices[it->column()] + 1];
+          }
+    std::partial_sum(graph_start.begin(),
+                     graph_start.end(),
+                     graph_start.begin());
+
+    graph.resize(graph_start[n]);
+    std::vector<std::size_t> fill(graph_start.begin(), graph_start.end() - 1);
+    for (size_type row = 0; row < n; ++row)
+      for (auto it = sparsity_pattern.begin(row);
+           it != sparsity_pattern.end(row);
+           ++it)
+        if (it->column() != row)
+          {
+            const size_type i = new_indices[row];
+            const size_type j = new_indices[it->column()];
+            graph[fill[i]++]  = j;
+            graph[fill[j]++]  = i;
+          }
+
+    std::size_t n_entries = 0;
+    for (size_type i = 0; i < n; ++i)
+      {
+        const auto begin = graph.begin() + graph_start[i];
+        const auto end   = graph.begin() + graph_start[i + 1];
+        std::sort(begin, end);
+        const auto new_end = std::unique(begin, end);
+
+        graph_start[i] = n_entries;
+        n_entries =
+          std::copy(begin, new_end, graph.begin() + n_entries) - graph.begin();
+      }
+    graph_start[n] = n_entries;
+    graph.resize(n_entries);
+  }
+
+
+
+  /**
+   * Decide whether two adjacent supernodes are merged into one with
+   * @p n_columns columns and @p n_rows rows below the diagonal block, given
+   * the number @p n_nonzero of actual nonzero entries in these columns of
+   * the factor. Small supernodes are merged even if this introduces many
+   * explicit zeros, since the dense kernels are inefficient for them.
+   */
+  bool
+  merge_supernodes(const size_type   n_columns,
+                   const size_type   n_rows,
+                   const std::size_t n_nonzero)
+  {
+    const double n_dense = 0.5 * n_columns * (n_columns + 1.) +
+                           static_cast<double>(n_columns) * n_rows;
+    const double fraction_of_zeros = (n_dense - n_nonzero) / n_dense;
+
+    return (n_columns <= 4) || (n_columns <= 16 && fraction_of_zeros < 0.8) ||
+           (n_columns <= 48 && fraction_of_zeros < 0.1) ||
+           (fraction_of_zeros < 0.05);
+  }
+} // namespace
+
+
+
+SparseDirectCholesky::AdditionalData::AdditionalData(
+  const Factorization factorization,
+  const Ordering      ordering)
+  : factorization(factorization)
+  , ordering(ordering)
+{}
+
+
+
+SparseDirectCholesky::SparseDirectCholesky(
+  const AdditionalData &additional_data)
+  : additional_data(additional_data)
+  , n_rows(0)
+  , analyzed_ordering(additional_data.ordering)
+  , is_factorized(false)
+{}
+
+
+
+void
+SparseDirectCholesky::clear()
+{
+  n_rows        = 0;
+  is_factorized = false;
+
+  std::vector<std::size_t>().swap(analyzed_row_start);
+  std::vector<size_type>().swap(analyzed_column_indices);
+
+  std::vector<size_type>().swap(permutation);
+  std::vector<size_type>().swap(supernode_start);
+  std::vector<unsigned int>().swap(supernode_parent);
+  std::vector<unsigned int>().swap(child_start);
+  std::vector<unsigned int>().swap(children);
+  std::vector<unsigned int>().swap(first_descendant);
+  std::vector<double>().swap(subtree_work);
+  std::vector<std::size_t>().swap(row_start);
+  std::vector<size_type>().swap(rows);
+  std::vector<unsigned int>().swap(parent_positions);
+  std::vector<std::size_t>().swap(assembly_start);
+  std::vector<std::size_t>().swap(assembly_positions);
+  std::vector<std::size_t>().swap(factor_start);
+  std::vector<double>().swap(factor_values);
+  std::vector<double>().swap(diagonal);
+}
+
+
+
+void
+SparseDirectCholesky::analyze(const SparsityPattern &sparsity_pattern)
+{
+  Assert(sparsity_pattern.n_rows() == sparsity_pattern.n_cols(),
+         ExcDimensionMismatch(sparsity_pattern.n_rows(),
+                              sparsity_pattern.n_cols()));
+  Assert(sparsity_pattern.is_compressed(),
+         SparsityPattern::ExcNotCompressed());
+
+  clear();
+
+  const size_type n = sparsity_pattern.n_rows();
+  n_rows            = n;
+
+  // compute the fill reducing ordering
+  std::vector<size_type> new_indices(n);
+  if (additional_data.ordering == Ordering::nested_dissection)
+    SparsityTools::reorder_nested_dissection(sparsity_pattern, new_indices);
+  else
+    std::iota(new_indices.begin(), new_indices.end(), size_type(0));
+
+  std::vector<std::size_t> graph_start;
+  std::vector<size_type>   graph;
+  build_permuted_graph(sparsity_pattern, new_indices, graph_start, graph);
+
+  // compute the elimination tree with Liu's algorithm, using path
+  // compression on the ancestors
+  std::vector<size_type> parent(n, numbers::invalid_size_type);
+  {
+    std::vector<size_type> ancestor(n, numbers::invalid_size_type);
+    for (size_type k = 0; k < n; ++k)
+      for (std::size_t e = graph_start[k];
+           e < graph_start[k + 1] && graph[e] < k;
+           ++e)
+        {
+          size_type i = graph[e];
+          while (ancestor[i] != numbers::invalid_size_type &&
+                 ancestor[i] != k)
+            {
+              const size_type next = ancestor[i];
+              ancestor[i]          = k;
+              i                    = next;
+            }
+          if (ancestor[i] == numbers::invalid_size_type)
+            {
+              ancestor[i] = k;
+              parent[i]   = k;
+            }
+        }
+  }
+
+  // renumber in a postorder of the elimination tree, so that the subtrees
+  // and the supernodes consist of consecutive indices
+  {
+    std::vector<size_type> first_child(n, numbers::invalid_size_type),
+      next_sibling(n, numbers::invalid_size_type);
+    for (size_type k = n; k-- > 0;)
+      if (parent[k] != numbers::invalid_size_type)
+        {
+          next_sibling[k]        = first_child[parent[k]];
+          first_child[parent[k]] = k;
+        }
+
+    std::vector<size_type> postorder(n), stack;
+    size_type              next_index = 0;
+    for (size_type root = 0; root < n; ++root)
+      if (parent[root] == numbers::invalid_size_type)
+        {
+          stack.push_back(root);
+          while (stack.empty() == false)
+            {
+              const size_type k = stack.back();
+              if (first_child[k] != numbers::invalid_size_type)
+                {
+                  stack.push_back(first_child[k]);
+                  first_child[k] = next_sibling[first_child[k]];
+                }
+              else
+                {
+                  postorder[k] = next_index++;
+                  stack.pop_back();
+                }
+            }
+        }
+    Assert(next_index == n, ExcInternalError());
+
+    std::vector<size_type> postordered_parent(n);
+    for (size_type k = 0; k < n; ++k)
+      postordered_parent[postorder[k]] =
+        (parent[k] == numbers::invalid_size_type ?
+           numbers::invalid_size_type :
+           postorder[parent[k]]);
+    parent.swap(postordered_parent);
+
+    for (size_type i = 0; i < n; ++i)
+      new_indices[i] = postorder[new_indices[i]];
+  }
+
+  permutation.resize(n);
+  for (size_type i = 0; i < n; ++i)
+    permutation[new_indices[i]] = i;
+
+  build_permuted_graph(sparsity_pattern, new_indices, graph_start, graph);
+
+  // compute the number of entries in each row of U, including the diagonal,
+  // by traversing the subtrees of the elimination tree that the
+  // sparsity pattern of each column of U consists of
+  std::vector<size_type> row_count(n, 1);
+  {
+    std::vector<size_type> marker(n, numbers::invalid_size_type);
+    for (size_type k = 0; k < n; ++k)
+      {
+        marker[k] = k;
+        for (std::size_t e = graph_start[k];
+             e < graph_start[k + 1] && graph[e] < k;
+             ++e)
+          for (size_type i = graph[e]; marker[i] != k; i = parent[i])
+            {
+              ++row_count[i];
+              marker[i] = k;
+            }
+      }
+  }
+
+  // find the fundamental supernodes, i.e., chains of rows in which each row
+  // has the same pattern as the next one plus the diagonal entry, and merge
+  // them into larger supernodes where that does not add too many zeros
+  {
+    std::vector<unsigned int> n_children(n, 0);
+    for (size_type k = 0; k < n; ++k)
+      if (parent[k] != numbers::invalid_size_type)
+        ++n_children[parent[k]];
+
+    std::vector<size_type> fundamental_start;
+    for (size_type k = 0; k < n; ++k)
+      if (k == 0 || parent[k - 1] != k ||
+          row_count[k - 1] != row_count[k] + 1 || n_children[k] != 1)
+        fundamental_start.push_back(k);
+    fundamental_start.push_back(n);
+
+    const auto n_nonzero = [&](const size_type begin, const size_type end) {
+      return std::accumulate(row_count.begin() + begin,
+                             row_count.begin() + end,
+                             std::size_t(0));
+    };
+
+    for (unsigned int f = 0; f + 1 < fundamental_start.size(); ++f)
+      {
+        const size_type begin = fundamental_start[f];
+        const size_type end   = fundamental_start[f + 1];
+        if (f > 0 && parent[begin - 1] == begin &&
+            merge_supernodes(end - supernode_start.back(),
+                             row_count[begin] - (end - begin),
+                             n_nonzero(supernode_start.back(), end)))
+          continue;
+        supernode_start.push_back(begin);
+      }
+    supernode_start.push_back(n);
+  }
+
+  const unsigned int n_supernodes = supernode_start.size() - 1;
+  std::vector<unsigned int> column_supernode(n);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    std::fill(column_supernode.begin() + supernode_start[s],
+              column_supernode.begin() + supernode_start[s + 1],
+              s);
+
+  supernode_parent.resize(n_supernodes);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    {
+      const size_type last = supernode_start[s + 1] - 1;
+      supernode_parent[s] = (parent[last] == numbers::invalid_size_type ?
+                               numbers::invalid_unsigned_int :
+                               column_supernode[parent[last]]);
+      Assert(supernode_parent[s] == numbers::invalid_unsigned_int ||
+               supernode_parent[s] > s,
+             ExcInternalError());
+    }
+
+  // the tree of supernodes, with the roots as children of an additional
+  // supernode
+  child_start.assign(n_supernodes + 2, 0);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    ++child_start[(supernode_parent[s] == numbers::invalid_unsigned_int ?
+                     n_supernodes :
+                     supernode_parent[s]) +
+                  1];
+  std::partial_sum(child_start.begin(),
+                   child_start.end(),
+                   child_start.begin());
+  children.resize(n_supernodes);
+  {
+    std::vector<unsigned int> fill(child_start.begin(), child_start.end() - 1);
+    for (unsigned int s = 0; s < n_supernodes; ++s)
+      children[fill[supernode_parent[s] == numbers::invalid_unsigned_int ?
+                      n_supernodes :
+                      supernode_parent[s]]++] = s;
+  }
+
+  // the rows below the diagonal block of each supernode are those of the
+  // matrix entries in its columns and those of its children
+  row_start.assign(n_supernodes + 1, 0);
+  {
+    std::vector<unsigned int> marker(n, numbers::invalid_unsigned_int);
+    std::vector<size_type>    structure;
+    for (unsigned int s = 0; s < n_supernodes; ++s)
+      {
+        const size_type last = supernode_start[s + 1] - 1;
+        structure.clear();
+        for (size_type k = supernode_start[s]; k <= last; ++k)
+          for (std::size_t e = graph_start[k]; e < graph_start[k + 1]; ++e)
+            if (graph[e] > last && marker[graph[e]] != s)
+              {
+                marker[graph[e]] = s;
+                structure.push_back(graph[e]);
+              }
+        for (unsigned int c = child_start[s]; c < child_start[s + 1]; ++c)
+          for (std::size_t e = row_start[children[c]];
+               e < row_start[children[c] + 1];
+               ++e)
+            if (rows[e] > last && marker[rows[e]] != s)
+              {
+                marker[rows[e]] = s;
+                structure.push_back(rows[e]);
+              }
+        std::sort(structure.begin(), structure.end());
+        rows.insert(rows.end(), structure.begin(), structure.end());
+        row_start[s + 1] = rows.size();
+      }
+  }
+
+  // position of each row in the frontal matrix of the parent
+  const auto front_position = [&](const unsigned int s,
+                                  const size_type    row) -> std::size_t {
+    const size_type first = supernode_start[s];
+    const size_type end   = supernode_start[s + 1];
+    if (row < end)
+      return row - first;
+    else
+      return (end - first) +
+             (std::lower_bound(rows.begin() + row_start[s],
+                               rows.begin() + row_start[s + 1],
+                               row) -
+              (rows.begin() + row_start[s]));
+  };
+
+  parent_positions.resize(rows.size());
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    for (std::size_t e = row_start[s]; e < row_start[s + 1]; ++e)
+      parent_positions[e] = front_position(supernode_parent[s], rows[e]);
+
+  // positions of the matrix entries in the frontal matrices, the storage of
+  // the factor, and the estimated work for each subtree
+  assembly_start.resize(n_supernodes + 1);
+  assembly_positions.resize(sparsity_pattern.n_nonzero_elements());
+  factor_start.resize(n_supernodes + 1);
+  subtree_work.assign(n_supernodes, 0.);
+  first_descendant.resize(n_supernodes);
+  std::iota(first_descendant.begin(), first_descendant.end(), 0U);
+
+  std::size_t position = 0;
+  assembly_start[0]    = 0;
+  factor_start[0]      = 0;
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    {
+      const std::size_t n_columns =
+        supernode_start[s + 1] - supernode_start[s];
+      const std::size_t n_front = n_columns + (row_start[s + 1] - row_start[s]);
+      for (size_type k = supernode_start[s]; k < supernode_start[s + 1]; ++k)
+        for (auto it = sparsity_pattern.begin(permutation[k]);
+             it != sparsity_pattern.end(permutation[k]);
+             ++it, ++position)
+          {
+            const size_type column = new_indices[it->column()];
+            assembly_positions[position] =
+              (column >= k ? (k - supernode_start[s]) +
+                               front_position(s, column) * n_front :
+                             skipped_entry);
+          }
+      assembly_start[s + 1] = position;
+      factor_start[s + 1]   = factor_start[s] + n_columns * n_front;
+
+      subtree_work[s] += 1. * n_columns * n_front * n_front;
+      if (supernode_parent[s] != numbers::invalid_unsigned_int)
+        {
+          subtree_work[supernode_parent[s]] += subtree_work[s];
+          first_descendant[supernode_parent[s]] =
+            std::min(first_descendant[supernode_parent[s]],
+                     first_descendant[s]);
+        }
+    }
+
+  // keep a copy of the structure of the pattern, such that factorize() can
+  // detect changes of the pattern
+  analyzed_row_start.resize(n_rows + 1);
+  analyzed_row_start[0] = 0;
+  analyzed_column_indices.resize(sparsity_pattern.n_nonzero_elements());
+  for (size_type row = 0; row < n_rows; ++row)
+    {
+      std::size_t position = analyzed_row_start[row];
+      for (auto it = sparsity_pattern.begin(row);
+           it != sparsity_pattern.end(row);
+           ++it, ++position)
+        analyzed_column_indices[position] = it->column();
+      analyzed_row_start[row + 1] = position;
+    }
+  analyzed_ordering = additional_data.ordering;
+}
+
+
+
+bool
+SparseDirectCholesky::analysis_matches(
+  const SparsityPattern &sparsity_pattern) const
+{
+  if (analyzed_ordering != additional_data.ordering ||
+      sparsity_pattern.n_rows() != n_rows ||
+      analyzed_row_start.size() != n_rows + 1 ||
+      sparsity_pattern.n_nonzero_elements() != analyzed_column_indices.size())
+    return false;
+
+  for (size_type row = 0; row < n_rows; ++row)
+    {
+      if (sparsity_pattern.row_length(row) !=
+          analyzed_row_start[row + 1] - analyzed_row_start[row])
+        return false;
+
+      std::size_t position = analyzed_row_start[row];
+      for (auto it = sparsity_pattern.begin(row);
+           it != sparsity_pattern.end(row);
+           ++it, ++position)
+        if (it->column() != analyzed_column_indices[position])
+          return false;
+    }
+  return true;
+}
+
+
+
+template <typename Worker>
+void
+SparseDirectCholesky::traverse_bottom_up(const unsigned int supernode,
+                                         const Worker &     worker) const
+{
+  // descend along the path of supernodes with a single child that is worth
+  // a task of its own, processing all other subtrees on the way directly,
+  // until reaching a supernode with several such children. these are then
+  // processed as concurrent tasks, and the supernodes on the path
+  // afterwards. the additional supernode n_supernodes() is the root of the
+  // whole tree and is not processed itself
+  std::vector<unsigned int> path;
+  unsigned int              current = supernode;
+  while (true)
+    {
+      path.push_back(current);
+
+      std::vector<unsigned int> large_children;
+      for (unsigned int c = child_start[current]; c < child_start[current + 1];
+           ++c)
+        if (MultithreadInfo::n_threads() > 1 &&
+            subtree_work[children[c]] > minimum_work_per_task)
+          large_children.push_back(children[c]);
+        else
+          for (unsigned int s = first_descendant[children[c]];
+               s <= children[c];
+               ++s)
+            worker(s);
+
+      if (large_children.size() == 1)
+        {
+          current = large_children[0];
+          continue;
+        }
+
+      std::vector<Threads::Task<void>> tasks;
+      for (unsigned int c = 1; c < large_children.size(); ++c)
+        tasks.push_back(
+          Threads::new_task([this, &worker, &large_children, c]() {
+            traverse_bottom_up(large_children[c], worker);
+          }));
+      if (large_children.size() > 0)
+        traverse_bottom_up(large_children[0], worker);
+      for (const auto &task : tasks)
+        task.join();
+      break;
+    }
+
+  for (auto s = path.rbegin(); s != path.rend(); ++s)
+    if (*s != n_supernodes())
+      worker(*s);
+}
+
+
+
+template <typename Worker>
+void
+SparseDirectCholesky::traverse_top_down(const unsigned int supernode,
+                                        const Worker &     worker) const
+{
+  // the same as above in reverse order: process the supernodes along the
+  // path of single large children first, and the subtrees after their root
+  unsigned int current = supernode;
+  while (true)
+    {
+      if (current != n_supernodes())
+        worker(current);
+
+      std::vector<unsigned int> large_children;
+      for (unsigned int c = child_start[current]; c < child_start[current + 1];
+           ++c)
+        if (MultithreadInfo::n_threads() > 1 &&
+            subtree_work[children[c]] > minimum_work_per_task)
+          large_children.push_back(children[c]);
+        else
+          for (unsigned int s = children[c] + 1;
+               s-- > first_descendant[children[c]];)
+            worker(s);
+
+      if (large_children.size() == 1)
+        {
+          current = large_children[0];
+          continue;
+        }
+
+      std::vector<Threads::Task<void>> tasks;
+      for (unsigned int c = 1; c < large_children.size(); ++c)
+        tasks.push_back(
+          Threads::new_task([this, &worker, &large_children, c]() {
+            traverse_top_down(large_children[c], worker);
+          }));
+      if (large_children.size() > 0)
+        traverse_top_down(large_children[0], worker);
+      for (const auto &task : tasks)
+        task.join();
+      break;
+    }
+}
+
+
+
+template <typename number>
+void
+SparseDirectCholesky::factorize(const SparseMatrix<number> &matrix)
+{
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+
+  const SparsityPattern &sparsity_pattern = matrix.get_sparsity_pattern();
+  if (analysis_matches(sparsity_pattern) == false)
+    analyze(sparsity_pattern);
+
+  const bool ldlt = (additional_data.factorization == Factorization::ldlt);
+
+  is_factorized = false;
+  factor_values.resize(factor_start.back());
+  if (ldlt)
+    diagonal.resize(n_rows);
+  else
+    std::vector<double>().swap(diagonal);
+
+  // the update matrices that the supernodes pass on to their parents, and
+  // the original index of a pivot at which the factorization broke down
+  std::vector<std::vector<double>> update_matrices(n_supernodes());
+  std::atomic<size_type> failed_pivot(numbers::invalid_size_type);
+
+  traverse_bottom_up(n_supernodes(), [&](const unsigned int s) {
+    if (failed_pivot != numbers::invalid_size_type)
+      return;
+
+    const size_type   first     = supernode_start[s];
+    const std::size_t n_columns = supernode_start[s + 1] - first;
+    const std::size_t n_below   = row_start[s + 1] - row_start[s];
+    const std::size_t n_front   = n_columns + n_below;
+
+    // assemble the frontal matrix from the matrix entries and the update
+    // matrices of the children
+    std::vector<double> front(n_front * n_front);
+    std::size_t         position = assembly_start[s];
+    for (size_type k = first; k < first + n_columns; ++k)
+      for (auto it = matrix.begin(permutation[k]);
+           it != matrix.end(permutation[k]);
+           ++it, ++position)
+        if (assembly_positions[position] != skipped_entry)
+          front[assembly_positions[position]] += it->value();
+
+    for (unsigned int c = child_start[s]; c < child_start[s + 1]; ++c)
+      {
+        std::vector<double> &update = update_matrices[children[c]];
+        const std::size_t    begin  = row_start[children[c]];
+        const std::size_t    n_update = row_start[children[c] + 1] - begin;
+        const unsigned int *const positions = &parent_positions[begin];
+        for (std::size_t j = 0; j < n_update; ++j)
+          {
+            double *const destination =
+              &front[std::size_t(positions[j]) * n_front];
+            const double *const source = &update[j * n_update];
+            for (std::size_t i = 0; i <= j; ++i)
+              destination[positions[i]] += source[i];
+          }
+        std::vector<double>().swap(update);
+      }
+
+    const std::size_t failed =
+      partial_factorization(front.data(),
+                            n_front,
+                            n_columns,
+                            ldlt,
+                            ldlt ? &diagonal[first] : nullptr);
+    if (failed < n_columns)
+      {
+        size_type no_failure = numbers::invalid_size_type;
+        failed_pivot.compare_exchange_strong(no_failure,
+                                             permutation[first + failed]);
+        return;
+      }
+
+    // keep the rows of the factor and pass the Schur complement on
+    double *const block = &factor_values[factor_start[s]];
+    for (std::size_t j = 0; j < n_front; ++j)
+      std::copy(&front[j * n_front],
+                &front[j * n_front] + n_columns,
+                block + j * n_columns);
+
+    if (n_below > 0)
+      {
+        std::vector<double> &update = update_matrices[s];
+        update.resize(n_below * n_below);
+        for (std::size_t j = 0; j < n_below; ++j)
+          std::copy(&front[n_columns + (n_columns + j) * n_front],
+                    &front[n_columns + (n_columns + j) * n_front] + j + 1,
+                    &update[j * n_below]);
+      }
+  });
+
+  const size_type failed = failed_pivot;
+  if (ldlt)
+    {
+      AssertThrow(failed == numbers::invalid_size_type, ExcZeroPivot(failed));
+    }
+  else
+    {
+      AssertThrow(failed == numbers::invalid_size_type,
+                  ExcNotPositiveDefinite(failed));
+    }
+
+  is_factorized = true;
+}
+
+
+
+template <typename number>
+void
+SparseDirectCholesky::initialize(const SparseMatrix<number> &matrix,
+                                 const AdditionalData &      additional_data)
+{
+  this->additional_data = additional_data;
+  factorize(matrix);
+}
+
+
+
+void
+SparseDirectCholesky::solve_permuted(std::vector<double> &values,
+                                     const unsigned int   n_rhs) const
+{
+  Assert(is_factorized,
+         ExcMessage("You need to call factorize() before solving."));
+  AssertDimension(values.size(), n_rows * n_rhs);
+
+  const bool      ldlt = (additional_data.factorization == Factorization::ldlt);
+  const std::size_t n    = n_rows;
+
+  // forward substitution with U^T: each supernode solves for its own rows
+  // and passes the contributions to the rows below its diagonal block on to
+  // its parent, like in the factorization
+  std::vector<std::vector<double>> updates(n_supernodes());
+  traverse_bottom_up(n_supernodes(), [&](const unsigned int s) {
+    const size_type   first     = supernode_start[s];
+    const std::size_t n_columns = supernode_start[s + 1] - first;
+    const std::size_t n_below   = row_start[s + 1] - row_start[s];
+    double *const     x         = values.data() + first;
+
+    std::vector<double> &update = updates[s];
+    update.assign(n_below * n_rhs, 0.);
+    for (unsigned int c = child_start[s]; c < child_start[s + 1]; ++c)
+      {
+        const std::vector<double> &child_update = updates[children[c]];
+        const std::size_t          begin        = row_start[children[c]];
+        const std::size_t n_update = row_start[children[c] + 1] - begin;
+        for (unsigned int q = 0; q < n_rhs; ++q)
+          for (std::size_t i = 0; i < n_update; ++i)
+            {
+              const std::size_t position = parent_positions[begin + i];
+              if (position < n_columns)
+                x[position + q * n] += child_update[i + q * n_update];
+              else
+                update[position - n_columns + q * n_below] +=
+                  child_update[i + q * n_update];
+            }
+        std::vector<double>().swap(updates[children[c]]);
+      }
+
+    const double *const block = &factor_values[factor_start[s]];
+    triangular_solve(true, ldlt, n_columns, n_rhs, block, n_columns, x, n);
+    subtract_product(true,
+                     n_below,
+                     n_rhs,
+                     n_columns,
+                     block + n_columns * n_columns,
+                     n_columns,
+                     x,
+                     n,
+                     update.data(),
+                     n_below);
+
+    if (ldlt)
+      for (unsigned int q = 0; q < n_rhs; ++q)
+        for (std::size_t i = 0; i < n_columns; ++i)
+          x[i + q * n] /= diagonal[first + i];
+  });
+
+  // backward substitution with U: each supernode needs the solution in the
+  // rows below its diagonal block, which belong to its ancestors
+  traverse_top_down(n_supernodes(), [&](const unsigned int s) {
+    const size_type   first     = supernode_start[s];
+    const std::size_t n_columns = supernode_start[s + 1] - first;
+    const std::size_t n_below   = row_start[s + 1] - row_start[s];
+    double *const     x         = values.data() + first;
+
+    const double *const block = &factor_values[factor_start[s]];
+    if (n_below > 0)
+      {
+        std::vector<double> x_below(n_below * n_rhs);
+        for (unsigned int q = 0; q < n_rhs; ++q)
+          for (std::size_t i = 0; i < n_below; ++i)
+            x_below[i + q * n_below] = values[rows[row_start[s] + i] + q * n];
+        subtract_product(false,
+                         n_columns,
+                         n_rhs,
+                         n_below,
+                         block + n_columns * n_columns,
+                         n_columns,
+                         x_below.data(),
+                         n_below,
+                         x,
+                         n);
+      }
+    triangular_solve(false, ldlt, n_columns, n_rhs, block, n_columns, x, n);
+  });
+}
+
+
+
+void
+SparseDirectCholesky::solve(Vector<double> &rhs_and_solution) const
+{
+  AssertDimension(rhs_and_solution.size(), n_rows);
+
+  std::vector<double> values(n_rows);
+  for (size_type i = 0; i < n_rows; ++i)
+    values[i] = rhs_and_solution(permutation[i]);
+  solve_permuted(values, 1);
+  for (size_type i = 0; i < n_rows; ++i)
+    rhs_and_solution(permutation[i]) = values[i];
+}
+
+
+
+void
+SparseDirectCholesky::solve(FullMatrix<double> &rhs_and_solution) const
+{
+  AssertDimension(rhs_and_solution.m(), n_rows);
+
+  const unsigned int  n_rhs = rhs_and_solution.n();
+  std::vector<double> values(n_rows * n_rhs);
+  for (size_type i = 0; i < n_rows; ++i)
+    for (unsigned int q = 0; q < n_rhs; ++q)
+      values[i + q * n_rows] = rhs_and_solution(permutation[i], q);
+  solve_permuted(values, n_rhs);
+  for (size_type i = 0; i < n_rows; ++i)
+    for (unsigned int q = 0; q < n_rhs; ++q)
+      rhs_and_solution(permutation[i], q) = values[i + q * n_rows];
+}
+
+
+
+void
+SparseDirectCholesky::solve(
+  std::vector<Vector<double>> &rhs_and_solution) const
+{
+  const unsigned int  n_rhs = rhs_and_solution.size();
+  std::vector<double> values(n_rows * n_rhs);
+  for (unsigned int q = 0; q < n_rhs; ++q)
+    {
+      AssertDimension(rhs_and_solution[q].size(), n_rows);
+      for (size_type i = 0; i < n_rows; ++i)
+        values[i + q * n_rows] = rhs_and_solution[q](permutation[i]);
+    }
+  solve_permuted(values, n_rhs);
+  for (unsigned int q = 0; q < n_rhs; ++q)
+    for (size_type i = 0; i < n_rows; ++i)
+      rhs_and_solution[q](permutation[i]) = values[i + q * n_rows];
+}
+
+
+
+void
+SparseDirectCholesky::vmult(Vector<double> &      dst,
+                            const Vector<double> &src) const
+{
+  dst = src;
+  solve(dst);
+}
+
+
+
+void
+SparseDirectCholesky::Tvmult(Vector<double> &      dst,
+                             const Vector<double> &src) const
+{
+  dst = src;
+  solve(dst);
+}
+
+
+
+SparseDirectCholesky::size_type
+SparseDirectCholesky::m() const
+{
+  return n_rows;
+}
+
+
+
+SparseDirectCholesky::size_type
+SparseDirectCholesky::n() const
+{
+  return n_rows;
+}
+
+
+
+std::size_t
+SparseDirectCholesky::n_nonzero_elements() const
+{
+  std::size_t n_nonzero = 0;
+  for (unsigned int s = 0; s < n_supernodes(); ++s)
+    {
+      const std::size_t n_columns = supernode_start[s + 1] - supernode_start[s];
+      n_nonzero += n_columns * (n_columns + 1) / 2 +
+                   n_columns * (row_start[s + 1] - row_start[s]);
+    }
+  return n_nonzero;
+}
+
+
+
+unsigned int
+SparseDirectCholesky::n_supernodes() const
+{
+  return supernode_parent.size();
+}
+
+
+
+std::size_t
+SparseDirectCholesky::memory_consumption() const
+{
+  return sizeof(*this) +
+         MemoryConsumption::memory_consumption(analyzed_row_start) +
+         MemoryConsumption::memory_consumption(analyzed_column_indices) +
+         MemoryConsumption::memory_consumption(permutation) +
+         MemoryConsumption::memory_consumption(supernode_start) +
+         MemoryConsumption::memory_consumption(supernode_parent) +
+         MemoryConsumption::memory_consumption(child_start) +
+         MemoryConsumption::memory_consumption(children) +
+         MemoryConsumption::memory_consumption(first_descendant) +
+         MemoryConsumption::memory_consumption(subtree_work) +
+         MemoryConsumption::memory_consumption(row_start) +
+         MemoryConsumption::memory_consumption(rows) +
+         MemoryConsumption::memory_consumption(parent_positions) +
+         MemoryConsumption::memory_consumption(assembly_start) +
+         MemoryConsumption::memory_consumption(assembly_positions) +
+         MemoryConsumption::memory_consumption(factor_start) +
+         MemoryConsumption::memory_consumption(factor_values) +
+         MemoryConsumption::memory_consumption(diagonal);
+}
+
+
+
+// explicit instantiations
+#define InstantiateCholesky(number)                                      \
+  template void SparseDirectCholesky::factorize(                         \
+    const SparseMatrix<number> &);                                       \
+  template void SparseDirectCholesky::initialize(                        \
+    const SparseMatrix<number> &, const SparseDirectCholesky::AdditionalData &)
+
+InstantiateCholesky(double);
+InstantiateCholesky(float);
+
+#undef InstantiateCholesky
+
+DEAL_II_NAMESPACE_CLOSE
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <set>
 
@@ -910,6 +911,339 @@ namespace SparsityTools
 
 
 
+  namespace
+  {
+    using size_type = types::global_dof_index;
+
+    /**
+     * Build the adjacency graph of the symmetrized sparsity pattern, without
+     * the diagonal, in compressed row storage with sorted rows.
+     */
+    template <typename SparsityPatternType>
+    void
+    build_symmetric_graph(const SparsityPatternType &sparsity,
+                          std::vector<size_type> &   row_start,
+                          std::vector<size_type> &   neighbors)
+    {
+      const size_type n = sparsity.n_rows();
+
+      row_start.assign(n + 1, 0);
+      for (size_type row = 0; row < n; ++row)
+        for (auto it = sparsity.begin(row); it != sparsity.end(row); ++it)
+          if (it->column() != row)
+            {
+              ++row_start[row + 1];
+              ++row_start[it->column() + 1];
+            }
+      for (size_type row = 0; row < n; ++row)
+        row_start[row + 1] += row_start[row];
+
+      neighbors.resize(row_start[n]);
+      std::vector<size_type> fill(row_start.begin(), row_start.end() - 1);
+      for (size_type row = 0; row < n; ++row)
+        for (auto it = sparsity.begin(row); it != sparsity.end(row); ++it)
+          if (it->column() != row)
+            {
+              neighbors[fill[row]++]          = it->column();
+              neighbors[fill[it->column()]++] = row;
+            }
+
+      // sort the rows and remove the duplicates that stem from entries that
+      // are present in both triangles, compressing the arrays as we go
+      size_type n_entries = 0;
+      for (size_type row = 0; row < n; ++row)
+        {
+          const auto begin = neighbors.begin() + row_start[row];
+          const auto end   = neighbors.begin() + row_start[row + 1];
+          std::sort(begin, end);
+          const auto new_end = std::unique(begin, end);
+
+          row_start[row] = n_entries;
+          n_entries =
+            std::copy(begin, new_end, neighbors.begin() + n_entries) -
+            neighbors.begin();
+        }
+      row_start[n] = n_entries;
+      neighbors.resize(n_entries);
+    }
+
+
+
+    /**
+     * Compute a nested dissection ordering of the graph given in compressed
+     * row storage, see reorder_nested_dissection() for the algorithm.
+     */
+    void
+    nested_dissection(const std::vector<size_type> &row_start,
+                      const std::vector<size_type> &neighbors,
+                      std::vector<size_type> &      new_indices)
+    {
+      const size_type n = row_start.size() - 1;
+
+#ifdef DEAL_II_WITH_METIS
+      AssertThrow(n <= static_cast<size_type>(
+                         std::numeric_limits<idx_t>::max()) &&
+                    neighbors.size() <= static_cast<size_type>(
+                                          std::numeric_limits<idx_t>::max()),
+                  ExcMessage("The graph is too large for the index type of "
+                             "METIS."));
+
+      idx_t              n_nodes = static_cast<idx_t>(n);
+      std::vector<idx_t> int_row_start(row_start.begin(), row_start.end());
+      std::vector<idx_t> int_neighbors(neighbors.begin(), neighbors.end());
+      std::vector<idx_t> permutation(n), inverse_permutation(n);
+
+      idx_t options[METIS_NOPTIONS];
+      METIS_SetDefaultOptions(options);
+      options[METIS_OPTION_NUMBERING] = 0;
+
+      const int ierr = METIS_NodeND(&n_nodes,
+                                    int_row_start.data(),
+                                    int_neighbors.data(),
+                                    nullptr,
+                                    options,
+                                    permutation.data(),
+                                    inverse_permutation.data());
+      AssertThrow(ierr == 1, ExcMETISError(ierr));
+
+      std::copy(inverse_permutation.begin(),
+                inverse_permutation.end(),
+                new_indices.begin());
+#else
+      // parts with at most this many nodes are not split any further
+      const size_type max_leaf_size = 64;
+
+      // the part a node currently belongs to; nodes that have been given
+      // their final number are marked with an invalid part
+      std::vector<size_type> part(n, 0);
+      size_type              n_parts = 1;
+
+      // scratch arrays for the breadth-first searches, which are restricted
+      // to the nodes of one part. visited[i] stores the number of the last
+      // search that reached node i
+      std::vector<size_type> level(n), visited(n, numbers::invalid_size_type);
+      size_type              n_searches = 0;
+
+      // run a breadth-first search from the given node within its part,
+      // store the nodes in the order in which they are reached, and return
+      // the number of levels
+      const auto search = [&](const size_type          start,
+                              std::vector<size_type> & order) -> size_type {
+        const size_type this_part = part[start];
+        const size_type stamp     = n_searches++;
+
+        order.clear();
+        order.push_back(start);
+        visited[start] = stamp;
+        level[start]   = 0;
+        for (size_type i = 0; i < order.size(); ++i)
+          {
+            const size_type node = order[i];
+            for (size_type k = row_start[node]; k < row_start[node + 1]; ++k)
+              {
+                const size_type neighbor = neighbors[k];
+                if (part[neighbor] == this_part && visited[neighbor] != stamp)
+                  {
+                    visited[neighbor] = stamp;
+                    level[neighbor]   = level[node] + 1;
+                    order.push_back(neighbor);
+                  }
+              }
+          }
+        return level[order.back()] + 1;
+      };
+
+      // the parts still to be split, each with the nodes it contains and
+      // the first new index assigned to them
+      std::vector<std::pair<std::vector<size_type>, size_type>> parts_to_split;
+      parts_to_split.emplace_back(std::vector<size_type>(n), 0);
+      for (size_type i = 0; i < n; ++i)
+        parts_to_split.back().first[i] = i;
+
+      std::vector<size_type> order, next_order;
+      while (parts_to_split.empty() == false)
+        {
+          const std::vector<size_type> nodes =
+            std::move(parts_to_split.back().first);
+          const size_type first_index = parts_to_split.back().second;
+          parts_to_split.pop_back();
+
+          const auto number_consecutively =
+            [&](const std::vector<size_type> &nodes_to_number,
+                const size_type               first) {
+              for (size_type i = 0; i < nodes_to_number.size(); ++i)
+                {
+                  new_indices[nodes_to_number[i]] = first + i;
+                  part[nodes_to_number[i]]        = numbers::invalid_size_type;
+                }
+            };
+
+          if (nodes.size() <= max_leaf_size)
+            {
+              number_consecutively(nodes, first_index);
+              continue;
+            }
+
+          // find a pseudo-peripheral node by repeated searches from a node
+          // of small degree in the last level of the previous search
+          const auto degree = [&](const size_type node) {
+            return row_start[node + 1] - row_start[node];
+          };
+          size_type start =
+            *std::min_element(nodes.begin(),
+                              nodes.end(),
+                              [&](const size_type a, const size_type b) {
+                                return degree(a) < degree(b);
+                              });
+          size_type n_levels = search(start, order);
+
+          // if the part is not connected, give each of its components a
+          // new part of its own
+          if (order.size() < nodes.size())
+            {
+              const size_type first_search = n_searches - 1;
+              size_type       next_index   = first_index;
+              for (const size_type node : nodes)
+                if (visited[node] == numbers::invalid_size_type ||
+                    visited[node] < first_search)
+                  {
+                    search(node, next_order);
+                    for (const size_type i : next_order)
+                      part[i] = n_parts;
+                    ++n_parts;
+                    parts_to_split.emplace_back(next_order, next_index);
+                    next_index += next_order.size();
+                  }
+              for (const size_type i : order)
+                part[i] = n_parts;
+              ++n_parts;
+              parts_to_split.emplace_back(order, next_index);
+              continue;
+            }
+
+          for (unsigned int iteration = 0; iteration < 5; ++iteration)
+            {
+              const size_type level_of_last = level[order.back()];
+              size_type       candidate     = order.back();
+              for (auto it = order.rbegin();
+                   it != order.rend() && level[*it] == level_of_last;
+                   ++it)
+                if (degree(*it) < degree(candidate))
+                  candidate = *it;
+
+              const size_type n_candidate_levels =
+                search(candidate, next_order);
+              if (n_candidate_levels <= n_levels)
+                {
+                  // restore the level information of the last search
+                  search(start, order);
+                  break;
+                }
+              start    = candidate;
+              n_levels = n_candidate_levels;
+              order.swap(next_order);
+            }
+
+          // parts that are too compact to be split well are not split at
+          // all
+          if (n_levels < 3)
+            {
+              number_consecutively(order, first_index);
+              continue;
+            }
+
+          // take the level at which half of the nodes have been reached as
+          // separator, and the levels before and after it as the two parts
+          size_type separator_level = level[order[order.size() / 2]];
+          separator_level =
+            std::min(std::max<size_type>(separator_level, 1), n_levels - 2);
+
+          std::vector<size_type> first_part, second_part, separator;
+          for (const size_type node : order)
+            if (level[node] < separator_level)
+              first_part.push_back(node);
+            else if (level[node] > separator_level)
+              second_part.push_back(node);
+            else
+              {
+                // nodes of the separator level that are not coupled to the
+                // next level are not needed to separate the two parts
+                bool is_coupled_to_next_level = false;
+                for (size_type k = row_start[node]; k < row_start[node + 1];
+                     ++k)
+                  if (part[neighbors[k]] == part[node] &&
+                      level[neighbors[k]] > separator_level)
+                    {
+                      is_coupled_to_next_level = true;
+                      break;
+                    }
+
+                if (is_coupled_to_next_level)
+                  separator.push_back(node);
+                else
+                  first_part.push_back(node);
+              }
+
+          number_consecutively(separator,
+                               first_index + first_part.size() +
+                                 second_part.size());
+
+          for (const size_type node : first_part)
+            part[node] = n_parts;
+          ++n_parts;
+          for (const size_type node : second_part)
+            part[node] = n_parts;
+          ++n_parts;
+
+          const size_type second_index = first_index + first_part.size();
+          parts_to_split.emplace_back(std::move(first_part), first_index);
+          parts_to_split.emplace_back(std::move(second_part), second_index);
+        }
+#endif
+    }
+  } // namespace
+
+
+
+  void
+  reorder_nested_dissection(
+    const SparsityPattern &                  sparsity,
+    std::vector<SparsityPattern::size_type> &new_indices)
+  {
+    Assert(sparsity.n_rows() == sparsity.n_cols(),
+           ExcDimensionMismatch(sparsity.n_rows(), sparsity.n_cols()));
+    Assert(sparsity.n_rows() == new_indices.size(),
+           ExcDimensionMismatch(sparsity.n_rows(), new_indices.size()));
+    Assert(sparsity.is_compressed(), SparsityPattern::ExcNotCompressed());
+
+    std::vector<size_type> row_start, neighbors;
+    build_symmetric_graph(sparsity, row_start, neighbors);
+    nested_dissection(row_start, neighbors, new_indices);
+  }
+
+
+
+  void
+  reorder_nested_dissection(
+    const DynamicSparsityPattern &                  sparsity,
+    std::vector<DynamicSparsityPattern::size_type> &new_indices)
+  {
+    Assert(sparsity.n_rows() == sparsity.n_cols(),
+           ExcDimensionMismatch(sparsity.n_rows(), sparsity.n_cols()));
+    Assert(sparsity.n_rows() == new_indices.size(),
+           ExcDimensionMismatch(sparsity.n_rows(), new_indices.size()));
+    Assert(sparsity.row_index_set().size() == 0 ||
+             sparsity.row_index_set().size() == sparsity.n_rows(),
+           ExcMessage(
+             "Only valid for sparsity patterns which store all rows."));
+
+    std::vector<size_type> row_start, neighbors;
+    build_symmetric_graph(sparsity, row_start, neighbors);
+    nested_dissection(row_start, neighbors, new_indices);
+  }
+
+
+
 #ifdef DEAL_II_WITH_MPI
 
   void
@@ -15,6 +15,7 @@
 
 #include <deal.II/meshworker/scratch_data.h>
 
+#include <algorithm>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -120,6 +121,8 @@ namespace MeshWorker
     , neighbor_dof_indices(scratch.neighbor_dof_indices)
     , user_data_storage(scratch.user_data_storage)
     , internal_data_storage(scratch.internal_data_storage)
+    , field_names(scratch.field_names)
+    , field_dof_values(scratch.field_dof_values)
   {}
 
 
@@ -346,6 +349,169 @@ namespace MeshWorker
     return *mapping;
   }
 
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  ScratchData<dim, spacedim>::register_field(
+    const std::string &global_vector_name)
+  {
+    const auto it =
+      std::find(field_names.begin(), field_names.end(), global_vector_name);
+    if (it != field_names.end())
+      return it - field_names.begin();
+
+    field_names.push_back(global_vector_name);
+    field_dof_values.reinit(field_names.size(), fe->dofs_per_cell);
+    field_values.reinit(TableIndices<3>());
+    field_gradients.reinit(TableIndices<3>());
+    return field_names.size() - 1;
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  ScratchData<dim, spacedim>::n_fields() const
+  {
+    return field_names.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const double>
+  ScratchData<dim, spacedim>::get_local_dof_values(
+    const unsigned int field_index) const
+  {
+    AssertIndexRange(field_index, field_names.size());
+    return make_array_view(field_dof_values, field_index);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ScratchData<dim, spacedim>::evaluate_fields(const UpdateFlags update_flags)
+  {
+    const FEValuesBase<dim, spacedim> &fev = get_current_fe_values();
+
+    const unsigned int n_q_points     = fev.n_quadrature_points;
+    const unsigned int n_dofs         = fev.dofs_per_cell;
+    const unsigned int n_components   = fe->n_components();
+    const unsigned int n_fields       = field_names.size();
+    const bool         need_values    = update_flags & update_values;
+    const bool         need_gradients = update_flags & update_gradients;
+
+    Assert(!need_values || (fev.get_update_flags() & update_values),
+           ExcMessage("Evaluating the values of fields requires the FEValues "
+                      "object to be initialized with update_values."));
+    Assert(!need_gradients || (fev.get_update_flags() & update_gradients),
+           ExcMessage("Evaluating the gradients of fields requires the "
+                      "FEValues object to be initialized with "
+                      "update_gradients."));
+    AssertDimension(field_dof_values.size(1), n_dofs);
+
+    const TableIndices<3> sizes(n_fields, n_components, n_q_points);
+    if (need_values)
+      {
+        if (field_values.size() != sizes)
+          field_values.reinit(sizes);
+        else
+          field_values.fill(0.);
+      }
+    if (need_gradients)
+      {
+        if (field_gradients.size() != sizes)
+          field_gradients.reinit(sizes);
+        else
+          field_gradients.fill(Tensor<1, spacedim>());
+      }
+
+    // run through the shape functions only once and add their contribution
+    // to all fields at the same time. for primitive shape functions, the
+    // loop over the quadrature points is innermost, as both the shape values
+    // and the field values are contiguous in the quadrature point index
+    for (unsigned int i = 0; i < n_dofs; ++i)
+      {
+        if (fe->is_primitive(i))
+          {
+            const unsigned int c = fe->system_to_component_index(i).first;
+            for (unsigned int f = 0; f < n_fields; ++f)
+              {
+                const double dof_value = field_dof_values(f, i);
+                if (need_values)
+                  {
+                    double *values = &field_values(f, c, 0);
+                    for (unsigned int q = 0; q < n_q_points; ++q)
+                      values[q] += dof_value * fev.shape_value(i, q);
+                  }
+                if (need_gradients)
+                  {
+                    Tensor<1, spacedim> *gradients = &field_gradients(f, c, 0);
+                    for (unsigned int q = 0; q < n_q_points; ++q)
+                      gradients[q] += dof_value * fev.shape_grad(i, q);
+                  }
+              }
+          }
+        else
+          {
+            // the components of non-primitive shape functions are expensive
+            // to compute, so compute them only once for all fields
+            const ComponentMask &nonzero = fe->get_nonzero_components(i);
+            for (unsigned int c = 0; c < n_components; ++c)
+              if (nonzero[c])
+                {
+                  if (need_values)
+                    for (unsigned int q = 0; q < n_q_points; ++q)
+                      {
+                        const double value = fev.shape_value_component(i, q, c);
+                        for (unsigned int f = 0; f < n_fields; ++f)
+                          field_values(f, c, q) +=
+                            field_dof_values(f, i) * value;
+                      }
+                  if (need_gradients)
+                    for (unsigned int q = 0; q < n_q_points; ++q)
+                      {
+                        const Tensor<1, spacedim> gradient =
+                          fev.shape_grad_component(i, q, c);
+                        for (unsigned int f = 0; f < n_fields; ++f)
+                          field_gradients(f, c, q) +=
+                            field_dof_values(f, i) * gradient;
+                      }
+                }
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const double>
+  ScratchData<dim, spacedim>::get_field_values(
+    const unsigned int field_index,
+    const unsigned int component) const
+  {
+    AssertIndexRange(field_index, field_values.size(0));
+    AssertIndexRange(component, field_values.size(1));
+    return ArrayView<const double>(&field_values(field_index, component, 0),
+                                   field_values.size(2));
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const Tensor<1, spacedim>>
+  ScratchData<dim, spacedim>::get_field_gradients(
+    const unsigned int field_index,
+    const unsigned int component) const
+  {
+    AssertIndexRange(field_index, field_gradients.size(0));
+    AssertIndexRange(component, field_gradients.size(1));
+    return ArrayView<const Tensor<1, spacedim>>(
+      &field_gradients(field_index, component, 0), field_gradients.size(2));
+  }
+
 } // namespace MeshWorker
 DEAL_II_NAMESPACE_CLOSE
 
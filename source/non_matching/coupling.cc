@@ -14,8 +14,11 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -37,95 +40,310 @@
 
 #include <deal.II/non_matching/coupling.h>
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 namespace NonMatching
 {
   namespace internal
   {
+    template <int dim0, int spacedim>
+    void
+    locate_points_in_owned_cells(
+      const GridTools::Cache<dim0, spacedim> &cache,
+      const std::vector<Point<spacedim>> &    points,
+      std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>
+        &                                     cells,
+      std::vector<std::vector<Point<dim0>>> & unit_points,
+      std::vector<std::vector<unsigned int>> &point_indices)
+    {
+      cells.clear();
+      unit_points.clear();
+      point_indices.clear();
+      if (points.empty())
+        return;
+
+      using CandidateType =
+        std::pair<BoundingBox<spacedim>,
+                  typename Triangulation<dim0, spacedim>::active_cell_iterator>;
+
+      std::vector<CandidateType> candidates;
+      cache.get_cell_bounding_boxes_rtree().query(
+        boost::geometry::index::intersects(BoundingBox<spacedim>(points)),
+        std::back_inserter(candidates));
+
+      // Artificial cells of a distributed triangulation may be coarser than
+      // the cells the owning process sees at the same place, so their CellId
+      // does not give the same order on all processes. Only the locally owned
+      // cells and the ghost cells, which are known with the same CellId to
+      // their owner, take part in the search. A point inside a locally owned
+      // cell can only lie in one of these cells.
+      candidates.erase(std::remove_if(candidates.begin(),
+                                      candidates.end(),
+                                      [](const CandidateType &candidate) {
+                                        return candidate.second
+                                          ->is_artificial();
+                                      }),
+                       candidates.end());
+
+      // If none of the candidates is locally owned, there is nothing to do
+      if (std::none_of(candidates.begin(),
+                       candidates.end(),
+                       [](const CandidateType &candidate) {
+                         return candidate.second->is_locally_owned();
+                       }))
+        return;
+
+      std::sort(candidates.begin(),
+                candidates.end(),
+                [](const CandidateType &a, const CandidateType &b) {
+                  return a.second->id() < b.second->id();
+                });
+
+      std::vector<bool>            point_found(points.size(), false);
+      unsigned int                 n_points_found = 0;
+      std::vector<Point<spacedim>> candidate_points;
+      std::vector<Point<dim0>>     candidate_unit_points;
+      std::vector<unsigned int>    candidate_indices;
+
+      for (const auto &candidate : candidates)
+        {
+          if (n_points_found == points.size())
+            break;
+
+          // Collect all the points that have not been assigned yet and may
+          // lie within the current cell
+          candidate_points.clear();
+          candidate_indices.clear();
+          for (unsigned int i = 0; i < points.size(); ++i)
+            if (!point_found[i] && candidate.first.point_inside(points[i]))
+              {
+                candidate_points.push_back(points[i]);
+                candidate_indices.push_back(i);
+              }
+          if (candidate_points.empty())
+            continue;
+
+          candidate_unit_points.resize(candidate_points.size());
+          cache.get_mapping().transform_points_real_to_unit_cell(
+            candidate.second,
+            make_array_view(candidate_points),
+            make_array_view(candidate_unit_points));
+
+          std::vector<Point<dim0>>  cell_unit_points;
+          std::vector<unsigned int> cell_point_indices;
+          for (unsigned int i = 0; i < candidate_points.size(); ++i)
+            if (GeometryInfo<dim0>::is_inside_unit_cell(
+                  candidate_unit_points[i], 1e-10))
+              {
+                point_found[candidate_indices[i]] = true;
+                ++n_points_found;
+                cell_unit_points.push_back(candidate_unit_points[i]);
+                cell_point_indices.push_back(candidate_indices[i]);
+              }
+
+          if (!cell_point_indices.empty() &&
+              candidate.second->is_locally_owned())
+            {
+              cells.push_back(candidate.second);
+              unit_points.push_back(std::move(cell_unit_points));
+              point_indices.push_back(std::move(cell_point_indices));
+            }
+        }
+    }
+
+
+
     /**
-     * Given two triangulations, the first immersed inside the other, this
-     * function computes and returns the real-space quadrature points of the
-     * immersed triangulation.
-     *
-     * For reference:
-     * cache->triangulation() is the imbdedding triangulation, which contains
-     * immersed_dh->get_triangulation() the embedded triangulation
-     *
-     * Mapping and quadrature are those of this second triangulation.
+     * The data of one cell of the immersed triangulation that is needed to
+     * assemble its coupling terms: the quadrature points in real space, the
+     * dof indices, and (only for the mass matrix) the values of the shape
+     * functions times the JxW values, stored as <code>values[j * n_q +
+     * q]</code> for shape function $j$ and quadrature point $q$. For a
+     * distributed immersed triangulation, these data are sent to the
+     * processes that own the cells of the embedding triangulation around the
+     * quadrature points.
+     */
+    template <int spacedim, typename number>
+    struct ImmersedCellData
+    {
+      std::vector<Point<spacedim>>         points;
+      std::vector<types::global_dof_index> dofs;
+      std::vector<number>                  values;
+
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int)
+      {
+        ar &points &dofs &values;
+      }
+    };
+
+
+
+    /**
+     * Fill @p data from @p fe_values, which must have been reinitialized
+     * with @p cell. The shape function values are only computed if
+     * @p compute_values is true.
+     */
+    template <int dim1, int spacedim, typename number>
+    void
+    fill_immersed_cell_data(
+      const FEValues<dim1, spacedim> &                                fe_values,
+      const typename DoFHandler<dim1, spacedim>::active_cell_iterator &cell,
+      const bool                          compute_values,
+      ImmersedCellData<spacedim, number> &data)
+    {
+      data.points = fe_values.get_quadrature_points();
+      data.dofs.resize(fe_values.get_fe().dofs_per_cell);
+      cell->get_dof_indices(data.dofs);
+
+      const unsigned int n_q_points = fe_values.n_quadrature_points;
+      data.values.clear();
+      if (compute_values)
+        {
+          data.values.resize(data.dofs.size() * n_q_points);
+          for (unsigned int j = 0; j < data.dofs.size(); ++j)
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              data.values[j * n_q_points + q] =
+                fe_values.shape_value(j, q) * fe_values.JxW(q);
+        }
+    }
+
+
+
+    /**
+     * For a distributed immersed triangulation, compute the data of the
+     * locally owned cells of @p immersed_dh and send them to all processes
+     * whose locally owned cells of the embedding triangulation of @p cache
+     * might contain some of the quadrature points. Each process describes its
+     * locally owned cells by a single bounding box, which is made available
+     * to all processes by GridTools::build_global_description_tree().
      *
-     * If the triangulation inside @p cache is parallel, only points lying over
-     * locally onwed cells are returned. This is why a vector of unsigned int
-     * is returned: it describes the indices of cells from the immersed
-     * triangulation which have been used (relative to a loop over al cells). If
-     * embedding triangulation is not parallel, all cells shall be used.
+     * Return the data of all immersed cells received by the current process,
+     * including its own ones. This is a collective operation on
+     * @p mpi_communicator.
      */
-    template <int dim0, int dim1, int spacedim>
-    std::pair<std::vector<Point<spacedim>>, std::vector<unsigned int>>
-    qpoints_over_locally_owned_cells(
+    template <int dim0, int dim1, int spacedim, typename number>
+    std::vector<ImmersedCellData<spacedim, number>>
+    exchange_immersed_cell_data(
       const GridTools::Cache<dim0, spacedim> &cache,
       const DoFHandler<dim1, spacedim> &      immersed_dh,
       const Quadrature<dim1> &                quad,
       const Mapping<dim1, spacedim> &         immersed_mapping,
-      const bool                              tria_is_parallel)
+      const bool                              compute_values,
+      const MPI_Comm &                        mpi_communicator)
     {
-      const auto &                 immersed_fe = immersed_dh.get_fe();
-      std::vector<Point<spacedim>> points_over_local_cells;
-      // Keep track of which cells we actually used
-      std::vector<unsigned int> used_cells_ids;
-      {
-        FEValues<dim1, spacedim> fe_v(immersed_mapping,
-                                      immersed_fe,
-                                      quad,
-                                      update_quadrature_points);
-        unsigned int             cell_id = 0;
-        for (const auto &cell : immersed_dh.active_cell_iterators())
+      std::vector<BoundingBox<spacedim>> local_boxes;
+      for (const auto &cell : cache.get_triangulation().active_cell_iterators())
+        if (cell->is_locally_owned())
           {
-            bool use_cell = false;
-            if (tria_is_parallel)
-              {
-                const auto bbox = cell->bounding_box();
-                std::vector<std::pair<
-                  BoundingBox<spacedim>,
-                  typename Triangulation<dim0, spacedim>::active_cell_iterator>>
-                  out_vals;
-                cache.get_cell_bounding_boxes_rtree().query(
-                  boost::geometry::index::intersects(bbox),
-                  std::back_inserter(out_vals));
-                // Each bounding box corresponds to an active cell
-                // of the embedding triangulation: we now check if
-                // the current cell, of the embedded triangulation,
-                // overlaps a locally owned cell of the embedding one
-                for (const auto &bbox_it : out_vals)
-                  if (bbox_it.second->is_locally_owned())
-                    {
-                      use_cell = true;
-                      used_cells_ids.emplace_back(cell_id);
-                      break;
-                    }
-              }
+            const BoundingBox<spacedim> box =
+              cache.get_mapping().get_bounding_box(cell);
+            if (local_boxes.empty())
+              local_boxes.push_back(box);
             else
-              // for sequential triangulations, simply use all cells
-              use_cell = true;
-
-            if (use_cell)
-              {
-                // Reinitialize the cell and the fe_values
-                fe_v.reinit(cell);
-                const std::vector<Point<spacedim>> &x_points =
-                  fe_v.get_quadrature_points();
-
-                // Insert the points to the vector
-                points_over_local_cells.insert(points_over_local_cells.end(),
-                                               x_points.begin(),
-                                               x_points.end());
-              }
-            ++cell_id;
+              local_boxes[0].merge_with(box);
           }
-      }
-      return {std::move(points_over_local_cells), std::move(used_cells_ids)};
+      const auto global_boxes =
+        GridTools::build_global_description_tree(local_boxes,
+                                                 mpi_communicator);
+
+      FEValues<dim1, spacedim> fe_values(
+        immersed_mapping,
+        immersed_dh.get_fe(),
+        quad,
+        update_quadrature_points |
+          (compute_values ? update_values | update_JxW_values :
+                            update_default));
+
+      std::map<unsigned int, std::vector<ImmersedCellData<spacedim, number>>>
+                                                                  data_to_send;
+      ImmersedCellData<spacedim, number>                          data;
+      std::vector<std::pair<BoundingBox<spacedim>, unsigned int>> ranks;
+      for (const auto &cell : immersed_dh.active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            fe_values.reinit(cell);
+            fill_immersed_cell_data(fe_values, cell, compute_values, data);
+
+            ranks.clear();
+            global_boxes.query(boost::geometry::index::intersects(
+                                 BoundingBox<spacedim>(data.points)),
+                               std::back_inserter(ranks));
+            for (const auto &rank : ranks)
+              data_to_send[rank.second].push_back(data);
+          }
+
+      std::map<unsigned int, std::vector<ImmersedCellData<spacedim, number>>>
+        received_data =
+          Utilities::MPI::some_to_some(mpi_communicator, data_to_send);
+
+      std::vector<ImmersedCellData<spacedim, number>> all_data;
+      for (auto &process_data : received_data)
+        std::move(process_data.second.begin(),
+                  process_data.second.end(),
+                  std::back_inserter(all_data));
+      return all_data;
     }
 
 
+
+    /**
+     * Scratch data used by the threaded assembly of the coupling sparsity
+     * pattern and of the coupling mass matrix: it stores an FEValues object
+     * on the immersed triangulation, the data of the current immersed cell,
+     * and the output of locate_points_in_owned_cells() for it.
+     */
+    template <int dim0, int dim1, int spacedim, typename number>
+    struct CouplingScratchData
+    {
+      CouplingScratchData(const Mapping<dim1, spacedim> &      mapping,
+                          const FiniteElement<dim1, spacedim> &fe,
+                          const Quadrature<dim1> &             quad,
+                          const UpdateFlags                    update_flags)
+        : fe_values(mapping, fe, quad, update_flags)
+      {}
+
+      CouplingScratchData(const CouplingScratchData &scratch)
+        : fe_values(scratch.fe_values.get_mapping(),
+                    scratch.fe_values.get_fe(),
+                    scratch.fe_values.get_quadrature(),
+                    scratch.fe_values.get_update_flags())
+      {}
+
+      FEValues<dim1, spacedim> fe_values;
+
+      ImmersedCellData<spacedim, number> immersed_data;
+
+      std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>
+                                             space_cells;
+      std::vector<std::vector<Point<dim0>>>  unit_points;
+      std::vector<std::vector<unsigned int>> point_indices;
+    };
+
+
+
+    /**
+     * Copy data used by the threaded assembly of the coupling sparsity
+     * pattern and of the coupling mass matrix: for one cell of the immersed
+     * triangulation, it stores its dof indices, the dof indices of all the
+     * locally owned cells of the embedding triangulation it overlaps with,
+     * and (only for the mass matrix) the corresponding local matrices.
+     */
+    template <typename number>
+    struct CouplingCopyData
+    {
+      std::vector<types::global_dof_index>              immersed_dofs;
+      std::vector<std::vector<types::global_dof_index>> space_dofs;
+      std::vector<FullMatrix<number>>                   cell_matrices;
+      unsigned int                                      n_cells = 0;
+    };
+
+
     /**
      * Given two ComponentMasks and the corresponding finite element spaces,
      * compute a pairing between the selected components of the first finite
@@ -219,21 +437,10 @@ namespace NonMatching
     AssertDimension(sparsity.n_cols(), immersed_dh.n_dofs());
     Assert(dim1 <= dim0,
            ExcMessage("This function can only work if dim1 <= dim0"));
-    Assert((dynamic_cast<
-              const parallel::distributed::Triangulation<dim1, spacedim> *>(
-              &immersed_dh.get_triangulation()) == nullptr),
-           ExcNotImplemented());
-
-    const bool tria_is_parallel =
-      (dynamic_cast<const parallel::TriangulationBase<dim1, spacedim> *>(
-         &space_dh.get_triangulation()) != nullptr);
+
     const auto &space_fe    = space_dh.get_fe();
     const auto &immersed_fe = immersed_dh.get_fe();
 
-    // Dof indices
-    std::vector<types::global_dof_index> dofs(immersed_fe.dofs_per_cell);
-    std::vector<types::global_dof_index> odofs(space_fe.dofs_per_cell);
-
     // Take care of components
     const ComponentMask space_c =
       (space_comps.size() == 0 ? ComponentMask(space_fe.n_components(), true) :
@@ -261,16 +468,6 @@ namespace NonMatching
       if (immersed_c[i])
         immersed_gtl[i] = j++;
 
-    const unsigned int n_q_points = quad.size();
-    const unsigned int n_active_c =
-      immersed_dh.get_triangulation().n_active_cells();
-
-    const auto qpoints_cells_data = internal::qpoints_over_locally_owned_cells(
-      cache, immersed_dh, quad, immersed_mapping, tria_is_parallel);
-
-    const auto &points_over_local_cells = std::get<0>(qpoints_cells_data);
-    const auto &used_cells_ids          = std::get<1>(qpoints_cells_data);
-
     // [TODO]: when the add_entries_local_to_global below will implement
     // the version with the dof_mask, this should be uncommented.
     //
@@ -291,69 +488,104 @@ namespace NonMatching
     //        }
     //  }
 
+    // The cache is not thread-safe: make sure the r-tree is built before
+    // entering the threaded loop below
+    cache.get_cell_bounding_boxes_rtree();
+
+    using ImmersedData = internal::ImmersedCellData<spacedim, double>;
+    using ScratchData =
+      internal::CouplingScratchData<dim0, dim1, spacedim, double>;
+    using CopyData = internal::CouplingCopyData<number>;
+
+    // For the data of one cell of the immersed triangulation, find the
+    // locally owned cells of the embedding triangulation that contain at
+    // least one of its quadrature points, and collect their dof indices
+    const auto assemble_immersed_cell = [&](const ImmersedData &immersed_data,
+                                            ScratchData &       scratch,
+                                            CopyData &          copy) {
+      internal::locate_points_in_owned_cells(cache,
+                                             immersed_data.points,
+                                             scratch.space_cells,
+                                             scratch.unit_points,
+                                             scratch.point_indices);
+
+      copy.n_cells = scratch.space_cells.size();
+      if (copy.n_cells == 0)
+        return;
 
-    // Get a list of outer cells, qpoints and maps.
-    const auto cpm =
-      GridTools::compute_point_locations(cache, points_over_local_cells);
-    const auto &all_cells = std::get<0>(cpm);
-    const auto &maps      = std::get<2>(cpm);
+      copy.immersed_dofs = immersed_data.dofs;
 
-    std::vector<
-      std::set<typename Triangulation<dim0, spacedim>::active_cell_iterator>>
-      cell_sets(n_active_c);
+      if (copy.space_dofs.size() < copy.n_cells)
+        copy.space_dofs.resize(copy.n_cells);
+      for (unsigned int c = 0; c < copy.n_cells; ++c)
+        {
+          const typename DoFHandler<dim0, spacedim>::active_cell_iterator
+            space_cell(*scratch.space_cells[c], &space_dh);
+          copy.space_dofs[c].resize(space_fe.dofs_per_cell);
+          space_cell->get_dof_indices(copy.space_dofs[c]);
+        }
+    };
 
-    for (unsigned int i = 0; i < maps.size(); ++i)
-      {
-        // Quadrature points should be reasonably clustered:
-        // the following index keeps track of the last id
-        // where the current cell was inserted
-        unsigned int last_id = std::numeric_limits<unsigned int>::max();
-        unsigned int cell_id;
-        for (const unsigned int idx : maps[i])
-          {
-            // Find in which cell of immersed triangulation the point lies
-            if (tria_is_parallel)
-              cell_id = used_cells_ids[idx / n_q_points];
-            else
-              cell_id = idx / n_q_points;
+    const auto copier = [&](const CopyData &copy) {
+      for (unsigned int c = 0; c < copy.n_cells; ++c)
+        // [TODO]: When the following function will be implemented
+        // for the case of non-trivial dof_mask, we should
+        // uncomment the missing part.
+        constraints.add_entries_local_to_global(copy.space_dofs[c],
+                                                copy.immersed_dofs,
+                                                sparsity); //, true, dof_mask);
+    };
 
-            if (last_id != cell_id)
-              {
-                cell_sets[cell_id].insert(all_cells[i]);
-                last_id = cell_id;
-              }
-          }
-      }
+    const ScratchData sample_scratch(immersed_mapping,
+                                     immersed_fe,
+                                     quad,
+                                     update_quadrature_points);
 
-    // Now we run on each cell of the immersed
-    // and build the sparsity
-    unsigned int i = 0;
-    for (const auto &cell : immersed_dh.active_cell_iterators())
+    const auto *distributed_immersed_tria =
+      dynamic_cast<const parallel::distributed::Triangulation<dim1, spacedim>
+                     *>(&immersed_dh.get_triangulation());
+    if (distributed_immersed_tria != nullptr)
       {
-        // Reinitialize the cell
-        cell->get_dof_indices(dofs);
-
-        // List of outer cells
-        const auto &cells = cell_sets[i];
-
-        for (const auto &cell_c : cells)
-          {
-            // Get the ones in the current outer cell
-            typename DoFHandler<dim0, spacedim>::cell_iterator ocell(*cell_c,
-                                                                     &space_dh);
-            // Make sure we act only on locally_owned cells
-            if (ocell->is_locally_owned())
-              {
-                ocell->get_dof_indices(odofs);
-                // [TODO]: When the following function will be implemented
-                // for the case of non-trivial dof_mask, we should
-                // uncomment the missing part.
-                constraints.add_entries_local_to_global(
-                  odofs, dofs, sparsity); //, true, dof_mask);
-              }
-          }
-        ++i;
+        // Each process only knows its locally owned immersed cells, so the
+        // data of these cells are first sent to the processes that may own
+        // cells of the embedding triangulation around them
+        const std::vector<ImmersedData> immersed_data =
+          internal::exchange_immersed_cell_data<dim0, dim1, spacedim, double>(
+            cache,
+            immersed_dh,
+            quad,
+            immersed_mapping,
+            false,
+            distributed_immersed_tria->get_communicator());
+
+        WorkStream::run(
+          immersed_data.begin(),
+          immersed_data.end(),
+          [&](const typename std::vector<ImmersedData>::const_iterator &data,
+              ScratchData &                                             scratch,
+              CopyData &copy) { assemble_immersed_cell(*data, scratch, copy); },
+          copier,
+          sample_scratch,
+          CopyData());
       }
+    else
+      WorkStream::run(
+        immersed_dh.begin_active(),
+        immersed_dh.end(),
+        [&](
+          const typename DoFHandler<dim1, spacedim>::active_cell_iterator &cell,
+          ScratchData &scratch,
+          CopyData &   copy) {
+          scratch.fe_values.reinit(cell);
+          internal::fill_immersed_cell_data(scratch.fe_values,
+                                            cell,
+                                            false,
+                                            scratch.immersed_data);
+          assemble_immersed_cell(scratch.immersed_data, scratch, copy);
+        },
+        copier,
+        sample_scratch,
+        CopyData());
   }
 
 
@@ -403,22 +635,10 @@ namespace NonMatching
     AssertDimension(matrix.n(), immersed_dh.n_dofs());
     Assert(dim1 <= dim0,
            ExcMessage("This function can only work if dim1 <= dim0"));
-    Assert((dynamic_cast<
-              const parallel::distributed::Triangulation<dim1, spacedim> *>(
-              &immersed_dh.get_triangulation()) == nullptr),
-           ExcNotImplemented());
-
-    const bool tria_is_parallel =
-      (dynamic_cast<const parallel::TriangulationBase<dim1, spacedim> *>(
-         &space_dh.get_triangulation()) != nullptr);
 
     const auto &space_fe    = space_dh.get_fe();
     const auto &immersed_fe = immersed_dh.get_fe();
 
-    // Dof indices
-    std::vector<types::global_dof_index> dofs(immersed_fe.dofs_per_cell);
-    std::vector<types::global_dof_index> odofs(space_fe.dofs_per_cell);
-
     // Take care of components
     const ComponentMask space_c =
       (space_comps.size() == 0 ? ComponentMask(space_fe.n_components(), true) :
@@ -445,173 +665,148 @@ namespace NonMatching
       if (immersed_c[i])
         immersed_gtl[i] = j++;
 
-    FullMatrix<typename Matrix::value_type> cell_matrix(
-      space_dh.get_fe().dofs_per_cell, immersed_dh.get_fe().dofs_per_cell);
-
-    FEValues<dim1, spacedim> fe_v(immersed_mapping,
-                                  immersed_dh.get_fe(),
-                                  quad,
-                                  update_JxW_values | update_quadrature_points |
-                                    update_values);
-
-    const unsigned int n_q_points = quad.size();
-    const unsigned int n_active_c =
-      immersed_dh.get_triangulation().n_active_cells();
-
-    const auto used_cells_data = internal::qpoints_over_locally_owned_cells(
-      cache, immersed_dh, quad, immersed_mapping, tria_is_parallel);
-
-    const auto &points_over_local_cells = std::get<0>(used_cells_data);
-    const auto &used_cells_ids          = std::get<1>(used_cells_data);
-
-    // Get a list of outer cells, qpoints and maps.
-    const auto cpm =
-      GridTools::compute_point_locations(cache, points_over_local_cells);
-    const auto &all_cells   = std::get<0>(cpm);
-    const auto &all_qpoints = std::get<1>(cpm);
-    const auto &all_maps    = std::get<2>(cpm);
-
-    std::vector<
-      std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>>
-                                                       cell_container(n_active_c);
-    std::vector<std::vector<std::vector<Point<dim0>>>> qpoints_container(
-      n_active_c);
-    std::vector<std::vector<std::vector<unsigned int>>> maps_container(
-      n_active_c);
-
-    // Cycle over all cells of underling mesh found
-    // call it omesh, elaborating the output
-    for (unsigned int o = 0; o < all_cells.size(); ++o)
-      {
-        for (unsigned int j = 0; j < all_maps[o].size(); ++j)
-          {
-            // Find the index of the "owner" cell and qpoint
-            // with regard to the immersed mesh
-            // Find in which cell of immersed triangulation the point lies
-            unsigned int cell_id;
-            if (tria_is_parallel)
-              cell_id = used_cells_ids[all_maps[o][j] / n_q_points];
-            else
-              cell_id = all_maps[o][j] / n_q_points;
-
-            const unsigned int n_pt = all_maps[o][j] % n_q_points;
-
-            // If there are no cells, we just add our data
-            if (cell_container[cell_id].empty())
-              {
-                cell_container[cell_id].emplace_back(all_cells[o]);
-                qpoints_container[cell_id].emplace_back(
-                  std::vector<Point<dim0>>{all_qpoints[o][j]});
-                maps_container[cell_id].emplace_back(
-                  std::vector<unsigned int>{n_pt});
-              }
-            // If there are already cells, we begin by looking
-            // at the last inserted cell, which is more likely:
-            else if (cell_container[cell_id].back() == all_cells[o])
-              {
-                qpoints_container[cell_id].back().emplace_back(
-                  all_qpoints[o][j]);
-                maps_container[cell_id].back().emplace_back(n_pt);
-              }
-            else
-              {
-                // We don't need to check the last element
-                const auto cell_p = std::find(cell_container[cell_id].begin(),
-                                              cell_container[cell_id].end() - 1,
-                                              all_cells[o]);
-
-                if (cell_p == cell_container[cell_id].end() - 1)
-                  {
-                    cell_container[cell_id].emplace_back(all_cells[o]);
-                    qpoints_container[cell_id].emplace_back(
-                      std::vector<Point<dim0>>{all_qpoints[o][j]});
-                    maps_container[cell_id].emplace_back(
-                      std::vector<unsigned int>{n_pt});
-                  }
-                else
-                  {
-                    const unsigned int pos =
-                      cell_p - cell_container[cell_id].begin();
-                    qpoints_container[cell_id][pos].emplace_back(
-                      all_qpoints[o][j]);
-                    maps_container[cell_id][pos].emplace_back(n_pt);
-                  }
-              }
-          }
-      }
+    // The cache is not thread-safe: make sure the r-tree is built before
+    // entering the threaded loop below
+    cache.get_cell_bounding_boxes_rtree();
+
+    using number       = typename Matrix::value_type;
+    using ImmersedData = internal::ImmersedCellData<spacedim, number>;
+    using ScratchData =
+      internal::CouplingScratchData<dim0, dim1, spacedim, number>;
+    using CopyData = internal::CouplingCopyData<number>;
+
+    // For the data of one cell of the immersed triangulation, find the
+    // locally owned cells of the embedding triangulation that contain at
+    // least one of its quadrature points, and compute the local coupling
+    // matrices
+    const auto assemble_immersed_cell = [&](const ImmersedData &immersed_data,
+                                            ScratchData &       scratch,
+                                            CopyData &          copy) {
+      internal::locate_points_in_owned_cells(cache,
+                                             immersed_data.points,
+                                             scratch.space_cells,
+                                             scratch.unit_points,
+                                             scratch.point_indices);
+
+      copy.n_cells = scratch.space_cells.size();
+      if (copy.n_cells == 0)
+        return;
 
-    typename DoFHandler<dim1, spacedim>::active_cell_iterator
-      cell = immersed_dh.begin_active(),
-      endc = immersed_dh.end();
+      copy.immersed_dofs = immersed_data.dofs;
 
-    for (unsigned int j = 0; cell != endc; ++cell, ++j)
-      {
-        // Reinitialize the cell and the fe_values
-        fe_v.reinit(cell);
-        cell->get_dof_indices(dofs);
+      if (copy.space_dofs.size() < copy.n_cells)
+        {
+          copy.space_dofs.resize(copy.n_cells);
+          copy.cell_matrices.resize(copy.n_cells);
+        }
 
-        // Get a list of outer cells, qpoints and maps.
-        const auto &cells   = cell_container[j];
-        const auto &qpoints = qpoints_container[j];
-        const auto &maps    = maps_container[j];
+      const unsigned int n_q_points = immersed_data.points.size();
+      for (unsigned int c = 0; c < copy.n_cells; ++c)
+        {
+          const typename DoFHandler<dim0, spacedim>::active_cell_iterator ocell(
+            *scratch.space_cells[c], &space_dh);
+          const std::vector<unsigned int> &ids = scratch.point_indices[c];
 
-        for (unsigned int c = 0; c < cells.size(); ++c)
-          {
-            // Get the ones in the current outer cell
-            typename DoFHandler<dim0, spacedim>::active_cell_iterator ocell(
-              *cells[c], &space_dh);
-            // Make sure we act only on locally_owned cells
-            if (ocell->is_locally_owned())
-              {
-                const std::vector<Point<dim0>> & qps = qpoints[c];
-                const std::vector<unsigned int> &ids = maps[c];
+          FEValues<dim0, spacedim> o_fe_v(cache.get_mapping(),
+                                          space_fe,
+                                          Quadrature<dim0>(
+                                            scratch.unit_points[c]),
+                                          update_values);
+          o_fe_v.reinit(ocell);
 
-                FEValues<dim0, spacedim> o_fe_v(cache.get_mapping(),
-                                                space_dh.get_fe(),
-                                                qps,
-                                                update_values);
-                o_fe_v.reinit(ocell);
-                ocell->get_dof_indices(odofs);
+          copy.space_dofs[c].resize(space_fe.dofs_per_cell);
+          ocell->get_dof_indices(copy.space_dofs[c]);
 
-                // Reset the matrices.
-                cell_matrix = typename Matrix::value_type();
+          // Reset the matrices.
+          FullMatrix<number> &cell_matrix = copy.cell_matrices[c];
+          cell_matrix.reinit(space_fe.dofs_per_cell, immersed_fe.dofs_per_cell);
 
-                for (unsigned int i = 0; i < space_dh.get_fe().dofs_per_cell;
-                     ++i)
+          for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
+            {
+              const auto comp_i = space_fe.system_to_component_index(i).first;
+              if (space_gtl[comp_i] != numbers::invalid_unsigned_int)
+                for (unsigned int j = 0; j < immersed_fe.dofs_per_cell; ++j)
                   {
-                    const auto comp_i =
-                      space_dh.get_fe().system_to_component_index(i).first;
-                    if (space_gtl[comp_i] != numbers::invalid_unsigned_int)
-                      for (unsigned int j = 0;
-                           j < immersed_dh.get_fe().dofs_per_cell;
-                           ++j)
+                    const auto comp_j =
+                      immersed_fe.system_to_component_index(j).first;
+                    if (space_gtl[comp_i] == immersed_gtl[comp_j])
+                      for (unsigned int oq = 0;
+                           oq < o_fe_v.n_quadrature_points;
+                           ++oq)
                         {
-                          const auto comp_j = immersed_dh.get_fe()
-                                                .system_to_component_index(j)
-                                                .first;
-                          if (space_gtl[comp_i] == immersed_gtl[comp_j])
-                            for (unsigned int oq = 0;
-                                 oq < o_fe_v.n_quadrature_points;
-                                 ++oq)
-                              {
-                                // Get the corresponding q point
-                                const unsigned int q = ids[oq];
-
-                                cell_matrix(i, j) +=
-                                  (fe_v.shape_value(j, q) *
-                                   o_fe_v.shape_value(i, oq) * fe_v.JxW(q));
-                              }
+                          // Get the corresponding q point
+                          const unsigned int q = ids[oq];
+
+                          cell_matrix(i, j) +=
+                            (immersed_data.values[j * n_q_points + q] *
+                             o_fe_v.shape_value(i, oq));
                         }
                   }
+            }
+        }
+    };
 
-                // Now assemble the matrices
-                constraints.distribute_local_to_global(cell_matrix,
-                                                       odofs,
-                                                       dofs,
-                                                       matrix);
-              }
-          }
+    const auto copier = [&](const CopyData &copy) {
+      // Now assemble the matrices
+      for (unsigned int c = 0; c < copy.n_cells; ++c)
+        constraints.distribute_local_to_global(copy.cell_matrices[c],
+                                               copy.space_dofs[c],
+                                               copy.immersed_dofs,
+                                               matrix);
+    };
+
+    const ScratchData sample_scratch(immersed_mapping,
+                                     immersed_fe,
+                                     quad,
+                                     update_JxW_values |
+                                       update_quadrature_points |
+                                       update_values);
+
+    const auto *distributed_immersed_tria =
+      dynamic_cast<const parallel::distributed::Triangulation<dim1, spacedim>
+                     *>(&immersed_dh.get_triangulation());
+    if (distributed_immersed_tria != nullptr)
+      {
+        // Each process only knows its locally owned immersed cells, so the
+        // data of these cells are first sent to the processes that may own
+        // cells of the embedding triangulation around them
+        const std::vector<ImmersedData> immersed_data =
+          internal::exchange_immersed_cell_data<dim0, dim1, spacedim, number>(
+            cache,
+            immersed_dh,
+            quad,
+            immersed_mapping,
+            true,
+            distributed_immersed_tria->get_communicator());
+
+        WorkStream::run(
+          immersed_data.begin(),
+          immersed_data.end(),
+          [&](const typename std::vector<ImmersedData>::const_iterator &data,
+              ScratchData &                                             scratch,
+              CopyData &copy) { assemble_immersed_cell(*data, scratch, copy); },
+          copier,
+          sample_scratch,
+          CopyData());
       }
+    else
+      WorkStream::run(
+        immersed_dh.begin_active(),
+        immersed_dh.end(),
+        [&](
+          const typename DoFHandler<dim1, spacedim>::active_cell_iterator &cell,
+          ScratchData &scratch,
+          CopyData &   copy) {
+          scratch.fe_values.reinit(cell);
+          internal::fill_immersed_cell_data(scratch.fe_values,
+                                            cell,
+                                            true,
+                                            scratch.immersed_data);
+          assemble_immersed_cell(scratch.immersed_data, scratch, copy);
+        },
+        copier,
+        sample_scratch,
+        CopyData());
   }
 
   template <int dim0,
@@ -0,0 +1,420 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/non_matching/coupling.h>
+#include <deal.II/non_matching/coupling_operator.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+namespace NonMatching
+{
+  template <int dim0, int dim1, int spacedim, typename Number>
+  void
+  CouplingOperator<dim0, dim1, spacedim, Number>::reinit(
+    const GridTools::Cache<dim0, spacedim> &cache,
+    const DoFHandler<dim0, spacedim> &      space_dh,
+    const DoFHandler<dim1, spacedim> &      immersed_dh,
+    const Quadrature<dim1> &                quadrature,
+    const AffineConstraints<Number> &       space_constraints,
+    const Mapping<dim1, spacedim> &         immersed_mapping)
+  {
+    Assert(dim1 <= dim0,
+           ExcMessage("This class can only work if dim1 <= dim0"));
+    Assert((dynamic_cast<
+              const parallel::distributed::Triangulation<dim1, spacedim> *>(
+              &immersed_dh.get_triangulation()) == nullptr),
+           ExcNotImplemented());
+
+    clear();
+    this->cache             = &cache;
+    this->space_dh          = &space_dh;
+    this->immersed_dh       = &immersed_dh;
+    this->space_constraints = &space_constraints;
+    this->quadrature        = quadrature;
+
+    const FiniteElement<dim0, spacedim> &space_fe    = space_dh.get_fe();
+    const FiniteElement<dim1, spacedim> &immersed_fe = immersed_dh.get_fe();
+    AssertDimension(space_fe.n_components(), immersed_fe.n_components());
+    n_components = space_fe.n_components();
+
+    // Extract the one-dimensional polynomials of the space element by
+    // evaluating its shape functions along the line through the support
+    // point of the first shape function in lexicographic order, as done for
+    // the matrix-free evaluation
+    AssertThrow(space_fe.n_base_elements() == 1,
+                ExcMessage("The space finite element must be scalar or "
+                           "consist of copies of a single scalar element."));
+    const FiniteElement<dim0, spacedim> &base = space_fe.base_element(0);
+    const FE_Poly<dim0, spacedim> *      fe_poly =
+      dynamic_cast<const FE_Poly<dim0, spacedim> *>(&base);
+    AssertThrow(fe_poly != nullptr &&
+                  dynamic_cast<const TensorProductPolynomials<dim0> *>(
+                    &fe_poly->get_poly_space()) != nullptr,
+                ExcMessage("The space finite element must be based on tensor "
+                           "product polynomials."));
+
+    const std::vector<unsigned int> lexicographic =
+      fe_poly->get_poly_space_numbering_inverse();
+    const unsigned int n_1d = base.degree + 1;
+    AssertDimension(lexicographic.size(), Utilities::fixed_power<dim0>(n_1d));
+
+    Point<dim0> unit_point;
+    if (base.has_support_points())
+      unit_point = base.get_unit_support_points()[lexicographic[0]];
+    Assert(std::abs(base.shape_value(lexicographic[0], unit_point) - 1.) <
+             1e-13,
+           ExcMessage("Could not decode the 1D shape functions of the element " +
+                      base.get_name()));
+
+    std::vector<Point<1>> nodes(1, Point<1>(0.5));
+    if (n_1d > 1)
+      nodes = QGaussLobatto<1>(n_1d).get_points();
+    lagrange_basis = Polynomials::generate_complete_Lagrange_basis(nodes);
+    space_polynomial_coefficients.reinit(n_1d, n_1d);
+    for (unsigned int i = 0; i < n_1d; ++i)
+      for (unsigned int k = 0; k < n_1d; ++k)
+        {
+          Point<dim0> point = unit_point;
+          point[0]          = nodes[k][0];
+          space_polynomial_coefficients(i, k) =
+            base.shape_value(lexicographic[i], point);
+        }
+
+    space_dof_numbering.resize(space_fe.dofs_per_cell);
+    for (unsigned int c = 0; c < n_components; ++c)
+      for (unsigned int i = 0; i < lexicographic.size(); ++i)
+        space_dof_numbering[c * lexicographic.size() + i] =
+          space_fe.component_to_system_index(c, lexicographic[i]);
+
+    // The immersed shape functions are evaluated on the reference cell
+    Assert(immersed_fe.is_primitive(),
+           ExcMessage("The immersed finite element must be primitive."));
+    immersed_shape_values.reinit(immersed_fe.dofs_per_cell, quadrature.size());
+    immersed_shape_components.resize(immersed_fe.dofs_per_cell);
+    for (unsigned int j = 0; j < immersed_fe.dofs_per_cell; ++j)
+      {
+        immersed_shape_components[j] =
+          immersed_fe.system_to_component_index(j).first;
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          immersed_shape_values(j, q) =
+            immersed_fe.shape_value(j, quadrature.point(q));
+      }
+
+    immersed_dof_indices.resize(
+      immersed_dh.get_triangulation().n_active_cells() *
+      immersed_fe.dofs_per_cell);
+    std::vector<types::global_dof_index> dof_indices(immersed_fe.dofs_per_cell);
+    for (const auto &cell : immersed_dh.active_cell_iterators())
+      {
+        cell->get_dof_indices(dof_indices);
+        std::copy(dof_indices.begin(),
+                  dof_indices.end(),
+                  immersed_dof_indices.begin() +
+                    cell->active_cell_index() * immersed_fe.dofs_per_cell);
+      }
+
+    update_points(immersed_mapping);
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  void
+  CouplingOperator<dim0, dim1, spacedim, Number>::update_points(
+    const Mapping<dim1, spacedim> &immersed_mapping)
+  {
+    Assert(space_dh != nullptr, ExcNotInitialized());
+
+    const FiniteElement<dim0, spacedim> &space_fe   = space_dh->get_fe();
+    const unsigned int                   n_q_points = quadrature.size();
+    const unsigned int n_1d = space_polynomial_coefficients.m();
+
+    // Keep the cells found in the previous call as starting guesses
+    const std::vector<unsigned int> old_pair_immersed_cells =
+      std::move(pair_immersed_cells);
+    const std::vector<
+      typename Triangulation<dim0, spacedim>::active_cell_iterator>
+      old_pair_space_cells = std::move(pair_space_cells);
+
+    pair_immersed_cells.clear();
+    pair_space_cells.clear();
+    pair_space_dof_indices.clear();
+    pair_point_offsets.assign(1, 0);
+    point_quadrature_indices.clear();
+    point_unit_coordinates.clear();
+    point_shape_values.clear();
+    JxW.resize(immersed_dh->get_triangulation().n_active_cells() * n_q_points);
+
+    FEValues<dim1, spacedim> fe_values(immersed_mapping,
+                                       immersed_dh->get_fe(),
+                                       quadrature,
+                                       update_quadrature_points |
+                                         update_JxW_values);
+
+    std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>
+                                           cells, new_cells;
+    std::vector<std::vector<Point<dim0>>>  unit_points, new_unit_points;
+    std::vector<std::vector<unsigned int>> point_indices, new_point_indices;
+    std::vector<bool>                      point_found(n_q_points);
+    std::vector<Point<spacedim>>           remaining_points;
+    std::vector<unsigned int>              remaining_indices;
+    std::vector<Point<dim0>>               remaining_unit_points;
+    std::vector<types::global_dof_index>   dof_indices(space_fe.dofs_per_cell);
+    std::vector<double>                    lagrange_values(n_1d);
+
+    unsigned int old_pair = 0;
+    for (const auto &cell : immersed_dh->active_cell_iterators())
+      {
+        const unsigned int c = cell->active_cell_index();
+        fe_values.reinit(cell);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          JxW[c * n_q_points + q] = fe_values.JxW(q);
+        const std::vector<Point<spacedim>> &points =
+          fe_values.get_quadrature_points();
+
+        cells.clear();
+        unit_points.clear();
+        point_indices.clear();
+        std::fill(point_found.begin(), point_found.end(), false);
+
+        // Try the space cells found for this immersed cell before. Only
+        // points strictly inside are accepted, so that points on the
+        // boundary of a cell are assigned consistently by the search below
+        for (; old_pair < old_pair_immersed_cells.size() &&
+               old_pair_immersed_cells[old_pair] <= c;
+             ++old_pair)
+          if (old_pair_immersed_cells[old_pair] == c)
+            {
+              remaining_points.clear();
+              remaining_indices.clear();
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                if (!point_found[q])
+                  {
+                    remaining_points.push_back(points[q]);
+                    remaining_indices.push_back(q);
+                  }
+              if (remaining_points.empty())
+                break;
+
+              remaining_unit_points.resize(remaining_points.size());
+              cache->get_mapping().transform_points_real_to_unit_cell(
+                old_pair_space_cells[old_pair],
+                make_array_view(remaining_points),
+                make_array_view(remaining_unit_points));
+
+              std::vector<Point<dim0>>  cell_unit_points;
+              std::vector<unsigned int> cell_point_indices;
+              for (unsigned int i = 0; i < remaining_points.size(); ++i)
+                if (GeometryInfo<dim0>::is_inside_unit_cell(
+                      remaining_unit_points[i], -1e-10))
+                  {
+                    point_found[remaining_indices[i]] = true;
+                    cell_unit_points.push_back(remaining_unit_points[i]);
+                    cell_point_indices.push_back(remaining_indices[i]);
+                  }
+              if (!cell_point_indices.empty())
+                {
+                  cells.push_back(old_pair_space_cells[old_pair]);
+                  unit_points.push_back(std::move(cell_unit_points));
+                  point_indices.push_back(std::move(cell_point_indices));
+                }
+            }
+
+        // Locate the remaining points through the r-tree of the cache
+        remaining_points.clear();
+        remaining_indices.clear();
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          if (!point_found[q])
+            {
+              remaining_points.push_back(points[q]);
+              remaining_indices.push_back(q);
+            }
+        internal::locate_points_in_owned_cells(*cache,
+                                               remaining_points,
+                                               new_cells,
+                                               new_unit_points,
+                                               new_point_indices);
+        for (unsigned int n = 0; n < new_cells.size(); ++n)
+          {
+            const auto position =
+              std::find(cells.begin(), cells.end(), new_cells[n]);
+            if (position == cells.end())
+              {
+                cells.push_back(new_cells[n]);
+                unit_points.emplace_back();
+                point_indices.emplace_back();
+              }
+            const unsigned int k = position - cells.begin();
+            unit_points[k].insert(unit_points[k].end(),
+                                  new_unit_points[n].begin(),
+                                  new_unit_points[n].end());
+            for (const unsigned int i : new_point_indices[n])
+              point_indices[k].push_back(remaining_indices[i]);
+          }
+
+        // Store the pairs, together with the values of the one-dimensional
+        // polynomials in the reference coordinates of the points
+        for (unsigned int k = 0; k < cells.size(); ++k)
+          {
+            pair_immersed_cells.push_back(c);
+            pair_space_cells.push_back(cells[k]);
+            typename DoFHandler<dim0, spacedim>::active_cell_iterator
+              space_cell(*cells[k], space_dh);
+            space_cell->get_dof_indices(dof_indices);
+            pair_space_dof_indices.insert(pair_space_dof_indices.end(),
+                                          dof_indices.begin(),
+                                          dof_indices.end());
+
+            for (unsigned int i = 0; i < point_indices[k].size(); ++i)
+              {
+                point_quadrature_indices.push_back(point_indices[k][i]);
+                point_unit_coordinates.push_back(unit_points[k][i]);
+                for (unsigned int d = 0; d < dim0; ++d)
+                  {
+                    for (unsigned int l = 0; l < n_1d; ++l)
+                      lagrange_values[l] =
+                        lagrange_basis[l].value(unit_points[k][i][d]);
+                    for (unsigned int j = 0; j < n_1d; ++j)
+                      {
+                        double value = 0.;
+                        for (unsigned int l = 0; l < n_1d; ++l)
+                          value += space_polynomial_coefficients(j, l) *
+                                   lagrange_values[l];
+                        point_shape_values.push_back(value);
+                      }
+                  }
+              }
+            pair_point_offsets.push_back(point_quadrature_indices.size());
+          }
+      }
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  void
+  CouplingOperator<dim0, dim1, spacedim, Number>::clear()
+  {
+    cache             = nullptr;
+    space_dh          = nullptr;
+    immersed_dh       = nullptr;
+    space_constraints = nullptr;
+    quadrature        = Quadrature<dim1>();
+    n_components      = 0;
+    lagrange_basis.clear();
+    space_polynomial_coefficients.reinit(0, 0);
+    space_dof_numbering.clear();
+    immersed_shape_values.reinit(0, 0);
+    immersed_shape_components.clear();
+    immersed_dof_indices.clear();
+    JxW.clear();
+    pair_immersed_cells.clear();
+    pair_space_cells.clear();
+    pair_space_dof_indices.clear();
+    pair_point_offsets.clear();
+    point_quadrature_indices.clear();
+    point_unit_coordinates.clear();
+    point_shape_values.clear();
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  types::global_dof_index
+  CouplingOperator<dim0, dim1, spacedim, Number>::m() const
+  {
+    Assert(space_dh != nullptr, ExcNotInitialized());
+    return space_dh->n_dofs();
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  types::global_dof_index
+  CouplingOperator<dim0, dim1, spacedim, Number>::n() const
+  {
+    Assert(immersed_dh != nullptr, ExcNotInitialized());
+    return immersed_dh->n_dofs();
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  unsigned int
+  CouplingOperator<dim0, dim1, spacedim, Number>::n_located_points() const
+  {
+    return point_quadrature_indices.size();
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  void
+  CouplingOperator<dim0, dim1, spacedim, Number>::
+    compute_tensor_product_values(const unsigned int   point,
+                                  std::vector<Number> &values) const
+  {
+    const unsigned int n_1d = space_polynomial_coefficients.m();
+    const Number *     shape_values =
+      point_shape_values.data() + point * dim0 * n_1d;
+
+    // Expand the tensor product one direction after the other, with the
+    // first direction running fastest
+    values[0]         = 1.;
+    unsigned int size = 1;
+    for (unsigned int d = 0; d < dim0; ++d, size *= n_1d)
+      for (unsigned int k = n_1d; k-- > 0;)
+        for (unsigned int j = 0; j < size; ++j)
+          values[k * size + j] = values[j] * shape_values[d * n_1d + k];
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Number>
+  std::size_t
+  CouplingOperator<dim0, dim1, spacedim, Number>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(space_dof_numbering) +
+           space_polynomial_coefficients.memory_consumption() +
+           immersed_shape_values.memory_consumption() +
+           MemoryConsumption::memory_consumption(immersed_shape_components) +
+           MemoryConsumption::memory_consumption(immersed_dof_indices) +
+           MemoryConsumption::memory_consumption(JxW) +
+           MemoryConsumption::memory_consumption(pair_immersed_cells) +
+           pair_space_cells.capacity() *
+             sizeof(typename Triangulation<dim0, spacedim>::
+                      active_cell_iterator) +
+           MemoryConsumption::memory_consumption(pair_space_dof_indices) +
+           MemoryConsumption::memory_consumption(pair_point_offsets) +
+           MemoryConsumption::memory_consumption(point_quadrature_indices) +
+           MemoryConsumption::memory_consumption(point_unit_coordinates) +
+           MemoryConsumption::memory_consumption(point_shape_values);
+  }
+} // namespace NonMatching
+
+#include "coupling_operator.inst"
+
+DEAL_II_NAMESPACE_CLOSE
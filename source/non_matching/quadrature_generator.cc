@@ -0,0 +1,1470 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/non_matching/quadrature_generator.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+namespace NonMatching
+{
+  namespace internal
+  {
+    namespace QuadratureGeneratorImplementation
+    {
+      /**
+       * Evaluate the one-dimensional polynomial with the Bernstein
+       * coefficients @p coefficients at @p t by the algorithm of de
+       * Casteljau, returning the value and setting @p derivative to the
+       * derivative with respect to @p t.
+       */
+      double
+      evaluate_bernstein_1d(const std::vector<double> &coefficients,
+                            const double               t,
+                            double &                   derivative)
+      {
+        const unsigned int degree = coefficients.size() - 1;
+        if (degree == 0)
+          {
+            derivative = 0.;
+            return coefficients[0];
+          }
+
+        std::vector<double> tmp(coefficients);
+        for (unsigned int r = 1; r < degree; ++r)
+          for (unsigned int i = 0; i < degree + 1 - r; ++i)
+            tmp[i] = (1. - t) * tmp[i] + t * tmp[i + 1];
+
+        derivative = degree * (tmp[1] - tmp[0]);
+        return (1. - t) * tmp[0] + t * tmp[1];
+      }
+
+
+
+      /**
+       * Split the one-dimensional polynomial with the Bernstein coefficients
+       * @p coefficients at $t=1/2$ by the algorithm of de Casteljau, and
+       * return the Bernstein coefficients of the two halves, each with
+       * respect to its own interval.
+       */
+      void
+      split_bernstein_1d(const std::vector<double> &coefficients,
+                         std::vector<double> &      lower,
+                         std::vector<double> &      upper)
+      {
+        const unsigned int degree = coefficients.size() - 1;
+        lower.resize(degree + 1);
+        upper.resize(degree + 1);
+
+        std::vector<double> tmp(coefficients);
+        lower[0]      = tmp[0];
+        upper[degree] = tmp[degree];
+        for (unsigned int r = 1; r <= degree; ++r)
+          {
+            for (unsigned int i = 0; i < degree + 1 - r; ++i)
+              tmp[i] = 0.5 * (tmp[i] + tmp[i + 1]);
+            lower[r]          = tmp[0];
+            upper[degree - r] = tmp[degree - r];
+          }
+      }
+
+
+
+      /**
+       * Compute the values and the derivatives of the Bernstein basis
+       * polynomials of degree @p degree at @p t.
+       */
+      void
+      compute_bernstein_basis(const unsigned int   degree,
+                              const double         t,
+                              std::vector<double> &values,
+                              std::vector<double> &derivatives)
+      {
+        values.assign(degree + 1, 0.);
+        derivatives.assign(degree + 1, 0.);
+
+        // Build the basis of degree - 1 first, from which the derivatives
+        // are obtained, and then raise the degree by one
+        values[0] = 1.;
+        for (unsigned int k = 1; k < degree; ++k)
+          for (unsigned int j = k + 1; j-- > 0;)
+            values[j] = (1. - t) * values[j] + (j > 0 ? t * values[j - 1] : 0.);
+
+        if (degree > 0)
+          {
+            for (unsigned int j = 0; j <= degree; ++j)
+              derivatives[j] =
+                degree * ((j > 0 ? values[j - 1] : 0.) -
+                          (j < degree ? values[j] : 0.));
+            for (unsigned int j = degree + 1; j-- > 0;)
+              values[j] = (j < degree ? (1. - t) * values[j] : 0.) +
+                          (j > 0 ? t * values[j - 1] : 0.);
+          }
+      }
+
+
+
+      /**
+       * Find the unique root of the one-dimensional polynomial with the
+       * Bernstein coefficients @p coefficients in the interval $[0,1]$,
+       * assuming that the values at the two ends have different signs. The
+       * root is computed by Newton's method, safeguarded by bisection, to
+       * the tolerance @p tolerance.
+       */
+      double
+      find_bracketed_root(const std::vector<double> &coefficients,
+                          const double               tolerance)
+      {
+        Assert(coefficients.front() * coefficients.back() < 0.,
+               ExcInternalError());
+
+        // Orient the bracket such that the function is negative at t_minus
+        double t_minus = coefficients.front() < 0. ? 0. : 1.;
+        double t_plus  = 1. - t_minus;
+        double t       = 0.5;
+        for (unsigned int iteration = 0; iteration < 100; ++iteration)
+          {
+            double       derivative;
+            const double value =
+              evaluate_bernstein_1d(coefficients, t, derivative);
+            if (value == 0.)
+              return t;
+            if (value < 0.)
+              t_minus = t;
+            else
+              t_plus = t;
+
+            double t_new = (derivative != 0.) ? t - value / derivative : -1.;
+            if (t_new <= std::min(t_minus, t_plus) ||
+                t_new >= std::max(t_minus, t_plus))
+              t_new = 0.5 * (t_minus + t_plus);
+
+            if (std::abs(t_new - t) < tolerance ||
+                std::abs(t_plus - t_minus) < tolerance)
+              return t_new;
+            t = t_new;
+          }
+        return t;
+      }
+
+
+
+      /**
+       * Add all roots of the one-dimensional polynomial with the Bernstein
+       * coefficients @p coefficients, defined on the interval $[a,b]$ of the
+       * unit interval, to @p roots. Intervals that may contain more than one
+       * root are split in halves until the roots are isolated. Roots where
+       * the polynomial only touches zero without changing sign are not
+       * necessarily found.
+       */
+      void
+      find_roots(const std::vector<double> &coefficients,
+                 const double               a,
+                 const double               b,
+                 const double               tolerance,
+                 std::vector<double> &      roots)
+      {
+        const auto minmax =
+          std::minmax_element(coefficients.begin(), coefficients.end());
+        if (*minmax.first > 0. || *minmax.second < 0.)
+          return;
+
+        if (coefficients.front() == 0.)
+          roots.push_back(a);
+        if (coefficients.back() == 0.)
+          roots.push_back(b);
+        if (*minmax.first >= 0. || *minmax.second <= 0.)
+          return;
+
+        // By the variation diminishing property of the Bernstein basis, the
+        // number of roots is bounded by the number of sign changes of the
+        // coefficients
+        unsigned int n_sign_changes = 0;
+        double       last_nonzero   = 0.;
+        for (const double c : coefficients)
+          if (c != 0.)
+            {
+              if (last_nonzero * c < 0.)
+                ++n_sign_changes;
+              last_nonzero = c;
+            }
+
+        if (n_sign_changes == 1 &&
+            coefficients.front() * coefficients.back() < 0.)
+          {
+            roots.push_back(
+              a + (b - a) * find_bracketed_root(coefficients,
+                                                tolerance / (b - a)));
+            return;
+          }
+
+        if (b - a < tolerance)
+          {
+            roots.push_back(0.5 * (a + b));
+            return;
+          }
+
+        std::vector<double> lower, upper;
+        split_bernstein_1d(coefficients, lower, upper);
+        find_roots(lower, a, 0.5 * (a + b), tolerance, roots);
+        find_roots(upper, 0.5 * (a + b), b, tolerance, roots);
+      }
+
+
+
+      /**
+       * Sort the roots in @p roots, and remove the roots that are closer
+       * than @p tolerance to each other or to the ends of the unit interval.
+       */
+      void
+      sort_and_merge_roots(std::vector<double> &roots, const double tolerance)
+      {
+        std::sort(roots.begin(), roots.end());
+        std::vector<double> merged;
+        for (const double root : roots)
+          if (root > tolerance && root < 1. - tolerance &&
+              (merged.empty() || root - merged.back() > tolerance))
+            merged.push_back(root);
+        roots.swap(merged);
+      }
+
+
+
+      /**
+       * Return the point of the box @p box with coordinates @p t relative to
+       * the box.
+       */
+      template <int dim>
+      Point<dim>
+      box_point(const BoundingBox<dim> &box, const Point<dim> &t)
+      {
+        Point<dim> point;
+        for (unsigned int d = 0; d < dim; ++d)
+          point[d] = box.lower_bound(d) + t[d] * box.side_length(d);
+        return point;
+      }
+
+
+
+      /**
+       * Return the coordinates relative to the box @p box of the point
+       * @p point.
+       */
+      template <int dim>
+      Point<dim>
+      box_coordinates(const BoundingBox<dim> &box, const Point<dim> &point)
+      {
+        Point<dim> t;
+        for (unsigned int d = 0; d < dim; ++d)
+          t[d] = (point[d] - box.lower_bound(d)) / box.side_length(d);
+        return t;
+      }
+
+
+
+      /**
+       * Return the point in dim dimensions whose coordinates are those of
+       * @p point, with the coordinate @p height inserted in the direction
+       * @p direction.
+       */
+      template <int dim>
+      Point<dim>
+      insert_coordinate(const Point<dim - 1> &point,
+                        const unsigned int    direction,
+                        const double          height)
+      {
+        Point<dim> result;
+        for (unsigned int d = 0, e = 0; d < dim; ++d)
+          result[d] = (d == direction) ? height : point[e++];
+        return result;
+      }
+
+
+
+      /**
+       * Return the face of the box @p box orthogonal to @p direction, as a
+       * box in dim-1 dimensions.
+       */
+      template <int dim>
+      BoundingBox<dim - 1>
+      face_box(const BoundingBox<dim> &box, const unsigned int direction)
+      {
+        Point<dim - 1> lower, upper;
+        for (unsigned int d = 0, e = 0; d < dim; ++d)
+          if (d != direction)
+            {
+              lower[e] = box.lower_bound(d);
+              upper[e] = box.upper_bound(d);
+              ++e;
+            }
+        return BoundingBox<dim - 1>(std::make_pair(lower, upper));
+      }
+
+
+
+      /**
+       * Return the child @p child of the box @p box, where the bits of
+       * @p child select the lower or upper half in each coordinate direction.
+       */
+      template <int dim>
+      BoundingBox<dim>
+      child_box(const BoundingBox<dim> &box, const unsigned int child)
+      {
+        Point<dim> lower, upper;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            const double half = 0.5 * box.side_length(d);
+            lower[d] = box.lower_bound(d) + ((child >> d) & 1 ? half : 0.);
+            upper[d] = lower[d] + half;
+          }
+        return BoundingBox<dim>(std::make_pair(lower, upper));
+      }
+
+
+
+      /**
+       * Add the tensor product of @p quadrature_1D on the box @p box to
+       * @p points and @p weights.
+       */
+      template <int dim>
+      void
+      add_tensor_product_quadrature(const Quadrature<1> &      quadrature_1D,
+                                    const BoundingBox<dim> &   box,
+                                    std::vector<Point<dim>> &  points,
+                                    std::vector<double> &      weights)
+      {
+        const unsigned int n_1d = quadrature_1D.size();
+        const unsigned int n    = Utilities::fixed_power<dim>(n_1d);
+        for (unsigned int q = 0; q < n; ++q)
+          {
+            Point<dim> t;
+            double     weight = 1.;
+            for (unsigned int d = 0, index = q; d < dim; ++d, index /= n_1d)
+              {
+                t[d] = quadrature_1D.point(index % n_1d)[0];
+                weight *= quadrature_1D.weight(index % n_1d) *
+                          box.side_length(d);
+              }
+            points.push_back(box_point(box, t));
+            weights.push_back(weight);
+          }
+      }
+
+
+
+      /**
+       * Add @p quadrature_1D on the subintervals of the unit interval
+       * delimited by @p roots to the points and weights of the line through
+       * @p lower_point in the height direction @p direction of the box
+       * @p box, with the lower-dimensional weight @p lower_weight. Each
+       * subinterval is sent to @p inside or @p outside depending on the
+       * sign of the line polynomial @p line at its midpoint; if @p outside
+       * is a null pointer, all subintervals are added to @p inside.
+       */
+      template <int dim>
+      void
+      add_line_quadrature(const Quadrature<1> &      quadrature_1D,
+                          const BoundingBox<dim> &   box,
+                          const unsigned int         direction,
+                          const Point<dim - 1> &     lower_point,
+                          const double               lower_weight,
+                          const std::vector<double> &roots,
+                          const std::vector<double> *line,
+                          std::vector<Point<dim>> &  inside_points,
+                          std::vector<double> &      inside_weights,
+                          std::vector<Point<dim>> *  outside_points,
+                          std::vector<double> *      outside_weights)
+      {
+        const double lower  = box.lower_bound(direction);
+        const double length = box.side_length(direction);
+        for (unsigned int i = 0; i <= roots.size(); ++i)
+          {
+            const double t0 = (i == 0) ? 0. : roots[i - 1];
+            const double t1 = (i == roots.size()) ? 1. : roots[i];
+
+            bool is_inside = true;
+            if (outside_points != nullptr)
+              {
+                double derivative;
+                is_inside = evaluate_bernstein_1d(*line,
+                                                  0.5 * (t0 + t1),
+                                                  derivative) < 0.;
+              }
+            std::vector<Point<dim>> &points =
+              is_inside ? inside_points : *outside_points;
+            std::vector<double> &weights =
+              is_inside ? inside_weights : *outside_weights;
+
+            for (unsigned int q = 0; q < quadrature_1D.size(); ++q)
+              {
+                const double t = t0 + (t1 - t0) * quadrature_1D.point(q)[0];
+                points.push_back(insert_coordinate<dim>(lower_point,
+                                                        direction,
+                                                        lower + t * length));
+                weights.push_back(lower_weight * quadrature_1D.weight(q) *
+                                  (t1 - t0) * length);
+              }
+          }
+      }
+
+
+
+      /**
+       * A polynomial in dim dimensions, given by its coefficients in the
+       * tensor product Bernstein basis of degree @p degree on a box. The
+       * coefficients are numbered lexicographically with the first
+       * coordinate direction running fastest.
+       *
+       * By the convex hull property of the Bernstein basis, the minimum and
+       * maximum of the coefficients bound the values of the polynomial on
+       * the box, and the differences of neighboring coefficients bound its
+       * derivatives.
+       */
+      template <int dim>
+      class BernsteinPolynomial
+      {
+      public:
+        /**
+         * Constructor. Create a polynomial of the given degree with all
+         * coefficients set to zero.
+         */
+        BernsteinPolynomial(const unsigned int degree = 0)
+          : degree(degree)
+          , coefficients(Utilities::fixed_power<dim>(degree + 1), 0.)
+        {}
+
+        /**
+         * Return the stride of the coefficients in the given direction.
+         */
+        unsigned int
+        stride(const unsigned int direction) const
+        {
+          unsigned int stride = 1;
+          for (unsigned int d = 0; d < direction; ++d)
+            stride *= degree + 1;
+          return stride;
+        }
+
+        /**
+         * Return the index of the coefficient in the given direction.
+         */
+        unsigned int
+        index_in_direction(const unsigned int index,
+                           const unsigned int direction) const
+        {
+          return (index / stride(direction)) % (degree + 1);
+        }
+
+        /**
+         * Return true if the polynomial is nonnegative or nonpositive on the
+         * whole box, as far as can be told from the coefficients, and set
+         * @p sign to the sign of its largest coefficient in absolute value.
+         */
+        bool
+        has_uniform_sign(int &sign) const
+        {
+          const auto minmax =
+            std::minmax_element(coefficients.begin(), coefficients.end());
+          sign = (*minmax.second > -*minmax.first) ? 1 : -1;
+          return (*minmax.first >= 0. || *minmax.second <= 0.);
+        }
+
+        /**
+         * Return +1 or -1 if the derivative in the given direction is
+         * strictly positive or negative on the whole box, as far as can be
+         * told from the coefficients, and zero otherwise.
+         */
+        int
+        derivative_sign(const unsigned int direction) const
+        {
+          if (degree == 0)
+            return 0;
+
+          const unsigned int s        = stride(direction);
+          double             min_diff = std::numeric_limits<double>::max();
+          double max_diff = -std::numeric_limits<double>::max();
+          for (unsigned int i = 0; i < coefficients.size(); ++i)
+            if (index_in_direction(i, direction) < degree)
+              {
+                const double diff = coefficients[i + s] - coefficients[i];
+                min_diff          = std::min(min_diff, diff);
+                max_diff          = std::max(max_diff, diff);
+              }
+          return (min_diff > 0.) ? 1 : ((max_diff < 0.) ? -1 : 0);
+        }
+
+        /**
+         * Evaluate the polynomial at the point @p t relative to the box, and
+         * set @p gradient to its gradient with respect to @p t.
+         */
+        double
+        value_and_gradient(const Point<dim> &t, Tensor<1, dim> &gradient) const
+        {
+          std::array<std::vector<double>, dim> values, derivatives;
+          for (unsigned int d = 0; d < dim; ++d)
+            compute_bernstein_basis(degree, t[d], values[d], derivatives[d]);
+
+          double value = 0.;
+          gradient     = Tensor<1, dim>();
+          for (unsigned int i = 0; i < coefficients.size(); ++i)
+            {
+              unsigned int indices[dim];
+              for (unsigned int d = 0, index = i; d < dim;
+                   ++d, index /= degree + 1)
+                indices[d] = index % (degree + 1);
+
+              double product = coefficients[i];
+              for (unsigned int d = 0; d < dim; ++d)
+                product *= values[d][indices[d]];
+              value += product;
+
+              for (unsigned int k = 0; k < dim; ++k)
+                {
+                  double product_k =
+                    coefficients[i] * derivatives[k][indices[k]];
+                  for (unsigned int d = 0; d < dim; ++d)
+                    if (d != k)
+                      product_k *= values[d][indices[d]];
+                  gradient[k] += product_k;
+                }
+            }
+          return value;
+        }
+
+        /**
+         * Return the restriction of the polynomial to the face of the box
+         * orthogonal to @p direction, at the lower end if @p side is zero and
+         * at the upper end otherwise.
+         */
+        BernsteinPolynomial<dim - 1>
+        restrict_to_face(const unsigned int direction,
+                         const unsigned int side) const
+        {
+          BernsteinPolynomial<dim - 1> face(degree);
+          const unsigned int           face_index = side == 0 ? 0 : degree;
+          unsigned int                 j          = 0;
+          for (unsigned int i = 0; i < coefficients.size(); ++i)
+            if (index_in_direction(i, direction) == face_index)
+              face.coefficients[j++] = coefficients[i];
+          return face;
+        }
+
+        /**
+         * Fill @p line with the one-dimensional Bernstein coefficients of the
+         * restriction of the polynomial to the line through the point @p t
+         * (relative to the box) in the given direction. The coordinate of
+         * @p t in this direction is ignored.
+         */
+        void
+        extract_line(const unsigned int   direction,
+                     const Point<dim> &   t,
+                     std::vector<double> &line) const
+        {
+          std::array<std::vector<double>, dim> values;
+          std::vector<double>                  derivatives;
+          for (unsigned int d = 0; d < dim; ++d)
+            if (d != direction)
+              compute_bernstein_basis(degree, t[d], values[d], derivatives);
+
+          line.assign(degree + 1, 0.);
+          for (unsigned int i = 0; i < coefficients.size(); ++i)
+            {
+              double       product = coefficients[i];
+              unsigned int index   = i;
+              unsigned int i_line  = 0;
+              for (unsigned int d = 0; d < dim; ++d, index /= degree + 1)
+                if (d == direction)
+                  i_line = index % (degree + 1);
+                else
+                  product *= values[d][index % (degree + 1)];
+              line[i_line] += product;
+            }
+        }
+
+        /**
+         * Return the polynomial on the half of the box in the given
+         * direction, the lower half if @p half is zero and the upper half
+         * otherwise, with respect to the half box.
+         */
+        BernsteinPolynomial<dim>
+        split(const unsigned int direction, const unsigned int half) const
+        {
+          BernsteinPolynomial<dim> result(degree);
+          const unsigned int       s = stride(direction);
+          std::vector<double>      line(degree + 1), lower, upper;
+          for (unsigned int i = 0; i < coefficients.size(); ++i)
+            if (index_in_direction(i, direction) == 0)
+              {
+                for (unsigned int j = 0; j <= degree; ++j)
+                  line[j] = coefficients[i + j * s];
+                split_bernstein_1d(line, lower, upper);
+                const std::vector<double> &part = half == 0 ? lower : upper;
+                for (unsigned int j = 0; j <= degree; ++j)
+                  result.coefficients[i + j * s] = part[j];
+              }
+          return result;
+        }
+
+        /**
+         * The polynomial degree in each coordinate direction.
+         */
+        unsigned int degree;
+
+        /**
+         * The Bernstein coefficients.
+         */
+        std::vector<double> coefficients;
+      };
+
+
+
+      /**
+       * Return the coordinate directions ordered by decreasing absolute
+       * value of @p gradient, which are tried in this order as height
+       * directions.
+       */
+      template <int dim>
+      std::array<unsigned int, dim>
+      sort_directions(const Tensor<1, dim> &gradient)
+      {
+        std::array<unsigned int, dim> directions;
+        for (unsigned int d = 0; d < dim; ++d)
+          directions[d] = d;
+        std::stable_sort(directions.begin(),
+                         directions.end(),
+                         [&](const unsigned int a, const unsigned int b) {
+                           return std::abs(gradient[a]) > std::abs(gradient[b]);
+                         });
+        return directions;
+      }
+
+
+
+      /**
+       * Generate a quadrature on a box in dim dimensions for integrands
+       * that are smooth except across the zero contours of a set of
+       * functions. The points are placed such that no piece of the box
+       * between the zero contours contains points of more than one piece.
+       */
+      template <int dim>
+      class PartitionQuadratureGenerator
+      {
+      public:
+        PartitionQuadratureGenerator(const Quadrature<1> &           q1D,
+                                     const AdditionalQGeneratorData &data)
+          : quadrature_1D(q1D)
+          , additional_data(data)
+          , lower_generator(q1D, data)
+        {}
+
+        /**
+         * Add the points and weights of the quadrature on @p box to
+         * @p points and @p weights.
+         */
+        void
+        generate(const std::vector<BernsteinPolynomial<dim>> &functions,
+                 const BoundingBox<dim> &                     box,
+                 const unsigned int                           n_splits,
+                 std::vector<Point<dim>> &                    points,
+                 std::vector<double> &                        weights)
+        {
+          // Functions that do not change sign on the box do not affect the
+          // quadrature
+          std::vector<const BernsteinPolynomial<dim> *> active_functions;
+          for (const auto &function : functions)
+            {
+              int sign;
+              if (!function.has_uniform_sign(sign))
+                active_functions.push_back(&function);
+            }
+          if (active_functions.empty())
+            {
+              add_tensor_product_quadrature(quadrature_1D,
+                                            box,
+                                            points,
+                                            weights);
+              return;
+            }
+
+          // Find a height direction in which all functions are monotone,
+          // trying the directions in which the functions vary most first
+          Point<dim> center;
+          for (unsigned int d = 0; d < dim; ++d)
+            center[d] = 0.5;
+          Tensor<1, dim> sum_of_gradients;
+          for (const auto function : active_functions)
+            {
+              Tensor<1, dim> gradient;
+              function->value_and_gradient(center, gradient);
+              if (gradient.norm() > 0.)
+                for (unsigned int d = 0; d < dim; ++d)
+                  sum_of_gradients[d] +=
+                    std::abs(gradient[d]) * box.side_length(d) /
+                    gradient.norm();
+            }
+
+          unsigned int height_direction = numbers::invalid_unsigned_int;
+          for (const unsigned int d : sort_directions(sum_of_gradients))
+            if (std::all_of(active_functions.begin(),
+                            active_functions.end(),
+                            [d](const BernsteinPolynomial<dim> *function) {
+                              return function->derivative_sign(d) != 0;
+                            }))
+              {
+                height_direction = d;
+                break;
+              }
+
+          if (height_direction == numbers::invalid_unsigned_int)
+            {
+              if (n_splits < additional_data.max_box_splits)
+                for (unsigned int child = 0;
+                     child < GeometryInfo<dim>::max_children_per_cell;
+                     ++child)
+                  {
+                    std::vector<BernsteinPolynomial<dim>> child_functions;
+                    for (const auto function : active_functions)
+                      {
+                        BernsteinPolynomial<dim> child_function = *function;
+                        for (unsigned int d = 0; d < dim; ++d)
+                          child_function =
+                            child_function.split(d, (child >> d) & 1);
+                        child_functions.push_back(std::move(child_function));
+                      }
+                    generate(child_functions,
+                             child_box(box, child),
+                             n_splits + 1,
+                             points,
+                             weights);
+                  }
+              else
+                add_tensor_product_quadrature(quadrature_1D,
+                                              box,
+                                              points,
+                                              weights);
+              return;
+            }
+
+          // Reduce to a problem on the face orthogonal to the height
+          // direction, where the functions restricted to the two faces
+          // delimit the pieces
+          std::vector<BernsteinPolynomial<dim - 1>> face_functions;
+          for (const auto function : active_functions)
+            for (unsigned int side = 0; side < 2; ++side)
+              face_functions.push_back(
+                function->restrict_to_face(height_direction, side));
+
+          const BoundingBox<dim - 1> lower_box =
+            face_box(box, height_direction);
+          std::vector<Point<dim - 1>> lower_points;
+          std::vector<double>         lower_weights;
+          lower_generator.generate(
+            face_functions, lower_box, 0, lower_points, lower_weights);
+
+          // Lift the points to lines in the height direction, which are
+          // split at the roots of the functions
+          std::vector<double> line, roots;
+          for (unsigned int q = 0; q < lower_points.size(); ++q)
+            {
+              const Point<dim> t = box_coordinates(
+                box,
+                insert_coordinate<dim>(lower_points[q],
+                                       height_direction,
+                                       box.lower_bound(height_direction)));
+              roots.clear();
+              for (const auto function : active_functions)
+                {
+                  function->extract_line(height_direction, t, line);
+                  if (line.front() * line.back() < 0.)
+                    roots.push_back(
+                      find_bracketed_root(line,
+                                          additional_data.root_tolerance));
+                }
+              sort_and_merge_roots(roots, additional_data.root_tolerance);
+              add_line_quadrature<dim>(quadrature_1D,
+                                       box,
+                                       height_direction,
+                                       lower_points[q],
+                                       lower_weights[q],
+                                       roots,
+                                       nullptr,
+                                       points,
+                                       weights,
+                                       nullptr,
+                                       nullptr);
+            }
+        }
+
+      private:
+        const Quadrature<1> &                  quadrature_1D;
+        const AdditionalQGeneratorData &       additional_data;
+        PartitionQuadratureGenerator<dim - 1> lower_generator;
+      };
+
+
+
+      /**
+       * Specialization of the class above for one space dimension, where the
+       * interval is simply split at all roots of the functions.
+       */
+      template <>
+      class PartitionQuadratureGenerator<1>
+      {
+      public:
+        PartitionQuadratureGenerator(const Quadrature<1> &           q1D,
+                                     const AdditionalQGeneratorData &data)
+          : quadrature_1D(q1D)
+          , additional_data(data)
+        {}
+
+        void
+        generate(const std::vector<BernsteinPolynomial<1>> &functions,
+                 const BoundingBox<1> &                     box,
+                 const unsigned int,
+                 std::vector<Point<1>> &points,
+                 std::vector<double> &  weights)
+        {
+          std::vector<double> roots;
+          for (const auto &function : functions)
+            find_roots(function.coefficients,
+                       0.,
+                       1.,
+                       additional_data.root_tolerance,
+                       roots);
+          sort_and_merge_roots(roots, additional_data.root_tolerance);
+
+          for (unsigned int i = 0; i <= roots.size(); ++i)
+            {
+              const double t0 = (i == 0) ? 0. : roots[i - 1];
+              const double t1 = (i == roots.size()) ? 1. : roots[i];
+              for (unsigned int q = 0; q < quadrature_1D.size(); ++q)
+                {
+                  const double t = t0 + (t1 - t0) * quadrature_1D.point(q)[0];
+                  points.push_back(box_point(box, Point<1>(t)));
+                  weights.push_back(quadrature_1D.weight(q) * (t1 - t0) *
+                                    box.side_length(0));
+                }
+            }
+        }
+
+      private:
+        const Quadrature<1> &           quadrature_1D;
+        const AdditionalQGeneratorData &additional_data;
+      };
+
+
+
+      /**
+       * The quadratures generated for one cell.
+       */
+      template <int dim>
+      struct CellQuadratures
+      {
+        std::vector<Point<dim>>     inside_points;
+        std::vector<double>         inside_weights;
+        std::vector<Point<dim>>     outside_points;
+        std::vector<double>         outside_weights;
+        std::vector<Point<dim>>     surface_points;
+        std::vector<double>         surface_weights;
+        std::vector<Tensor<1, dim>> surface_normals;
+
+        void
+        clear()
+        {
+          inside_points.clear();
+          inside_weights.clear();
+          outside_points.clear();
+          outside_weights.clear();
+          surface_points.clear();
+          surface_weights.clear();
+          surface_normals.clear();
+        }
+      };
+
+
+
+      /**
+       * Generate the quadratures for the regions where a level set
+       * function is negative and positive, and for its zero contour, on a
+       * box in dim dimensions.
+       */
+      template <int dim>
+      class QuadratureGenerator
+      {
+      public:
+        QuadratureGenerator(const Quadrature<1> &           q1D,
+                            const AdditionalQGeneratorData &data)
+          : quadrature_1D(q1D)
+          , additional_data(data)
+          , lower_generator(q1D, data)
+        {}
+
+        /**
+         * Add the quadratures for the level set function @p level_set on
+         * @p box to @p quadratures.
+         */
+        void
+        generate(const BernsteinPolynomial<dim> &level_set,
+                 const BoundingBox<dim> &        box,
+                 const unsigned int              n_splits,
+                 CellQuadratures<dim> &          quadratures)
+        {
+          int sign;
+          if (level_set.has_uniform_sign(sign))
+            {
+              if (sign < 0)
+                add_tensor_product_quadrature(quadrature_1D,
+                                              box,
+                                              quadratures.inside_points,
+                                              quadratures.inside_weights);
+              else
+                add_tensor_product_quadrature(quadrature_1D,
+                                              box,
+                                              quadratures.outside_points,
+                                              quadratures.outside_weights);
+              return;
+            }
+
+          // Find a height direction in which the level set function is
+          // monotone, trying the directions with the largest derivative at
+          // the center of the box first
+          Point<dim> center;
+          for (unsigned int d = 0; d < dim; ++d)
+            center[d] = 0.5;
+          Tensor<1, dim> gradient;
+          level_set.value_and_gradient(center, gradient);
+          for (unsigned int d = 0; d < dim; ++d)
+            gradient[d] /= box.side_length(d);
+
+          unsigned int height_direction = numbers::invalid_unsigned_int;
+          for (const unsigned int d : sort_directions(gradient))
+            if (level_set.derivative_sign(d) != 0)
+              {
+                height_direction = d;
+                break;
+              }
+
+          if (height_direction == numbers::invalid_unsigned_int)
+            {
+              if (n_splits < additional_data.max_box_splits)
+                for (unsigned int child = 0;
+                     child < GeometryInfo<dim>::max_children_per_cell;
+                     ++child)
+                  {
+                    BernsteinPolynomial<dim> child_level_set = level_set;
+                    for (unsigned int d = 0; d < dim; ++d)
+                      child_level_set =
+                        child_level_set.split(d, (child >> d) & 1);
+                    generate(child_level_set,
+                             child_box(box, child),
+                             n_splits + 1,
+                             quadratures);
+                  }
+              else
+                generate_fallback(level_set, box, quadratures);
+              return;
+            }
+
+          std::vector<BernsteinPolynomial<dim - 1>> face_functions;
+          for (unsigned int side = 0; side < 2; ++side)
+            face_functions.push_back(
+              level_set.restrict_to_face(height_direction, side));
+
+          const BoundingBox<dim - 1> lower_box =
+            face_box(box, height_direction);
+          std::vector<Point<dim - 1>> lower_points;
+          std::vector<double>         lower_weights;
+          lower_generator.generate(
+            face_functions, lower_box, 0, lower_points, lower_weights);
+
+          // Since the level set function is monotone in the height
+          // direction, each line contains at most one root, which defines a
+          // point on the zero contour
+          std::vector<double> line, roots;
+          for (unsigned int q = 0; q < lower_points.size(); ++q)
+            {
+              Point<dim> t = box_coordinates(
+                box,
+                insert_coordinate<dim>(lower_points[q],
+                                       height_direction,
+                                       box.lower_bound(height_direction)));
+              level_set.extract_line(height_direction, t, line);
+
+              roots.clear();
+              if (line.front() * line.back() < 0.)
+                {
+                  roots.push_back(
+                    find_bracketed_root(line, additional_data.root_tolerance));
+
+                  t[height_direction] = roots[0];
+                  Tensor<1, dim> gradient;
+                  level_set.value_and_gradient(t, gradient);
+                  for (unsigned int d = 0; d < dim; ++d)
+                    gradient[d] /= box.side_length(d);
+                  const double gradient_norm = gradient.norm();
+
+                  quadratures.surface_points.push_back(box_point(box, t));
+                  quadratures.surface_weights.push_back(
+                    lower_weights[q] * gradient_norm /
+                    std::abs(gradient[height_direction]));
+                  quadratures.surface_normals.push_back(gradient /
+                                                        gradient_norm);
+                }
+              sort_and_merge_roots(roots, additional_data.root_tolerance);
+
+              add_line_quadrature<dim>(quadrature_1D,
+                                       box,
+                                       height_direction,
+                                       lower_points[q],
+                                       lower_weights[q],
+                                       roots,
+                                       &line,
+                                       quadratures.inside_points,
+                                       quadratures.inside_weights,
+                                       &quadratures.outside_points,
+                                       &quadratures.outside_weights);
+            }
+        }
+
+      private:
+        /**
+         * Integrate the box with a tensor product rule whose points are
+         * sorted by the sign of the level set function. This is only used
+         * when the maximal number of box splits is reached.
+         */
+        void
+        generate_fallback(const BernsteinPolynomial<dim> &level_set,
+                          const BoundingBox<dim> &        box,
+                          CellQuadratures<dim> &          quadratures)
+        {
+          std::vector<Point<dim>> points;
+          std::vector<double>     weights;
+          add_tensor_product_quadrature(quadrature_1D, box, points, weights);
+          for (unsigned int q = 0; q < points.size(); ++q)
+            {
+              Tensor<1, dim> gradient;
+              if (level_set.value_and_gradient(box_coordinates(box, points[q]),
+                                               gradient) < 0.)
+                {
+                  quadratures.inside_points.push_back(points[q]);
+                  quadratures.inside_weights.push_back(weights[q]);
+                }
+              else
+                {
+                  quadratures.outside_points.push_back(points[q]);
+                  quadratures.outside_weights.push_back(weights[q]);
+                }
+            }
+        }
+
+        const Quadrature<1> &                  quadrature_1D;
+        const AdditionalQGeneratorData &       additional_data;
+        PartitionQuadratureGenerator<dim - 1> lower_generator;
+      };
+
+
+
+      /**
+       * Specialization of the class above for one space dimension, where the
+       * interval is split at all roots of the level set function, which
+       * form the zero contour.
+       */
+      template <>
+      class QuadratureGenerator<1>
+      {
+      public:
+        QuadratureGenerator(const Quadrature<1> &           q1D,
+                            const AdditionalQGeneratorData &data)
+          : quadrature_1D(q1D)
+          , additional_data(data)
+        {}
+
+        void
+        generate(const BernsteinPolynomial<1> &level_set,
+                 const BoundingBox<1> &        box,
+                 const unsigned int,
+                 CellQuadratures<1> &quadratures)
+        {
+          std::vector<double> roots;
+          find_roots(level_set.coefficients,
+                     0.,
+                     1.,
+                     additional_data.root_tolerance,
+                     roots);
+          sort_and_merge_roots(roots, additional_data.root_tolerance);
+
+          for (const double root : roots)
+            {
+              double derivative;
+              evaluate_bernstein_1d(level_set.coefficients, root, derivative);
+              quadratures.surface_points.push_back(
+                box_point(box, Point<1>(root)));
+              Tensor<1, 1> normal;
+              normal[0] = derivative < 0. ? -1. : 1.;
+              quadratures.surface_weights.push_back(1.);
+              quadratures.surface_normals.push_back(normal);
+            }
+
+          add_line_quadrature<1>(quadrature_1D,
+                                 box,
+                                 0,
+                                 Point<0>(),
+                                 1.,
+                                 roots,
+                                 &level_set.coefficients,
+                                 quadratures.inside_points,
+                                 quadratures.inside_weights,
+                                 &quadratures.outside_points,
+                                 &quadratures.outside_weights);
+        }
+
+      private:
+        const Quadrature<1> &           quadrature_1D;
+        const AdditionalQGeneratorData &additional_data;
+      };
+    } // namespace QuadratureGeneratorImplementation
+  }   // namespace internal
+
+
+
+  AdditionalQGeneratorData::AdditionalQGeneratorData(
+    const unsigned int max_box_splits,
+    const double       root_tolerance)
+    : max_box_splits(max_box_splits)
+    , root_tolerance(root_tolerance)
+  {}
+
+
+
+  template <int dim>
+  DiscreteQuadratureGenerator<dim>::DiscreteQuadratureGenerator(
+    const Quadrature<1> &           quadrature_1D,
+    const DoFHandler<dim> &         dof_handler,
+    const AdditionalQGeneratorData &additional_data)
+    : quadrature_1D(quadrature_1D)
+    , dof_handler(&dof_handler)
+    , additional_data(additional_data)
+    , full_quadrature(quadrature_1D)
+    , n_updated(0)
+  {
+    tria_listener = dof_handler.get_triangulation().signals.any_change.connect(
+      [this]() { this->clear(); });
+  }
+
+
+
+  template <int dim>
+  DiscreteQuadratureGenerator<dim>::~DiscreteQuadratureGenerator()
+  {
+    tria_listener.disconnect();
+  }
+
+
+
+  template <int dim>
+  void
+  DiscreteQuadratureGenerator<dim>::clear()
+  {
+    fe_name.clear();
+    bernstein_transformation.reinit(0, 0);
+    level_set_dof_values.reinit(0, 0);
+    new_level_set_dof_values.reinit(0, 0);
+    cell_is_owned.clear();
+    cell_locations.clear();
+    inside_quadratures.clear();
+    outside_quadratures.clear();
+    surface_quadratures.clear();
+    n_updated = 0;
+  }
+
+
+
+  template <int dim>
+  void
+  DiscreteQuadratureGenerator<dim>::initialize_bernstein_transformation()
+  {
+    const FiniteElement<dim> &fe = dof_handler->get_fe();
+    Assert(fe.n_components() == 1,
+           ExcMessage("The level set function must be a scalar field."));
+
+    // The cached quadratures are only valid for the element they were
+    // computed with
+    if (fe.get_name() == fe_name)
+      return;
+    clear();
+    fe_name = fe.get_name();
+
+    // Interpolate the shape functions in equidistant points, and transform
+    // the values to Bernstein coefficients by the inverse of the
+    // one-dimensional Bernstein-Vandermonde matrix in each direction
+    const unsigned int degree = fe.degree;
+    const unsigned int n_1d   = degree + 1;
+    const unsigned int n      = Utilities::fixed_power<dim>(n_1d);
+
+    FullMatrix<double>  vandermonde(n_1d, n_1d);
+    std::vector<double> values, derivatives;
+    for (unsigned int i = 0; i < n_1d; ++i)
+      {
+        internal::QuadratureGeneratorImplementation::compute_bernstein_basis(
+          degree,
+          degree == 0 ? 0.5 : static_cast<double>(i) / degree,
+          values,
+          derivatives);
+        for (unsigned int j = 0; j < n_1d; ++j)
+          vandermonde(i, j) = values[j];
+      }
+    vandermonde.gauss_jordan();
+
+    FullMatrix<double> shape_values(n, fe.dofs_per_cell);
+    for (unsigned int i = 0; i < n; ++i)
+      {
+        Point<dim> point;
+        for (unsigned int d = 0, index = i; d < dim; ++d, index /= n_1d)
+          point[d] =
+            degree == 0 ? 0.5 : static_cast<double>(index % n_1d) / degree;
+        for (unsigned int k = 0; k < fe.dofs_per_cell; ++k)
+          shape_values(i, k) = fe.shape_value(k, point);
+      }
+
+    // Apply the inverse in one direction after the other
+    for (unsigned int d = 0, stride = 1; d < dim; ++d, stride *= n_1d)
+      {
+        FullMatrix<double> transformed(n, fe.dofs_per_cell);
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            const unsigned int i_d  = (i / stride) % n_1d;
+            const unsigned int base = i - i_d * stride;
+            for (unsigned int j = 0; j < n_1d; ++j)
+              if (vandermonde(i_d, j) != 0.)
+                for (unsigned int k = 0; k < fe.dofs_per_cell; ++k)
+                  transformed(i, k) +=
+                    vandermonde(i_d, j) * shape_values(base + j * stride, k);
+          }
+        shape_values.swap(transformed);
+      }
+    bernstein_transformation.swap(shape_values);
+  }
+
+
+
+  template <int dim>
+  void
+  DiscreteQuadratureGenerator<dim>::update_cells(
+    const Table<2, double> & new_dof_values,
+    const std::vector<bool> &owned_cells)
+  {
+    using namespace internal::QuadratureGeneratorImplementation;
+
+    const unsigned int n_cells       = new_dof_values.size(0);
+    const unsigned int dofs_per_cell = new_dof_values.size(1);
+    if (cell_locations.size() != n_cells ||
+        level_set_dof_values.size(1) != dofs_per_cell)
+      {
+        level_set_dof_values.reinit(n_cells, dofs_per_cell);
+        cell_locations.assign(n_cells, LocationToLevelSet::unassigned);
+        inside_quadratures.assign(n_cells, Quadrature<dim>());
+        outside_quadratures.assign(n_cells, Quadrature<dim>());
+        surface_quadratures.assign(n_cells, ImmersedSurfaceQuadrature<dim>());
+      }
+
+    std::atomic<unsigned int> n_updated_cells(0);
+    const auto update_range = [&](const unsigned int begin,
+                                  const unsigned int end) {
+      QuadratureGenerator<dim> generator(quadrature_1D, additional_data);
+      BernsteinPolynomial<dim> level_set(dof_handler->get_fe().degree);
+      CellQuadratures<dim>     quadratures;
+
+      BoundingBox<dim> unit_box;
+      for (unsigned int d = 0; d < dim; ++d)
+        unit_box.get_boundary_points().second[d] = 1.;
+
+      for (unsigned int c = begin; c < end; ++c)
+        {
+          if (!owned_cells[c])
+            {
+              cell_locations[c] = LocationToLevelSet::unassigned;
+              continue;
+            }
+
+          // Skip the cell if the level set function did not change
+          if (cell_locations[c] != LocationToLevelSet::unassigned &&
+              std::equal(&new_dof_values(c, 0),
+                         &new_dof_values(c, 0) + dofs_per_cell,
+                         &level_set_dof_values(c, 0)))
+            continue;
+
+          std::copy(&new_dof_values(c, 0),
+                    &new_dof_values(c, 0) + dofs_per_cell,
+                    &level_set_dof_values(c, 0));
+          ++n_updated_cells;
+
+          for (unsigned int i = 0; i < level_set.coefficients.size(); ++i)
+            {
+              double sum = 0.;
+              for (unsigned int k = 0; k < dofs_per_cell; ++k)
+                sum += bernstein_transformation(i, k) * new_dof_values(c, k);
+              level_set.coefficients[i] = sum;
+            }
+
+          inside_quadratures[c]  = Quadrature<dim>();
+          outside_quadratures[c] = Quadrature<dim>();
+          surface_quadratures[c] = ImmersedSurfaceQuadrature<dim>();
+
+          int sign;
+          if (level_set.has_uniform_sign(sign))
+            {
+              cell_locations[c] = sign < 0 ? LocationToLevelSet::inside :
+                                             LocationToLevelSet::outside;
+              continue;
+            }
+
+          quadratures.clear();
+          generator.generate(level_set, unit_box, 0, quadratures);
+
+          if (quadratures.surface_points.empty() &&
+              (quadratures.inside_points.empty() ||
+               quadratures.outside_points.empty()))
+            // The zero contour only touches the cell
+            cell_locations[c] = quadratures.inside_points.empty() ?
+                                  LocationToLevelSet::outside :
+                                  LocationToLevelSet::inside;
+          else
+            {
+              cell_locations[c] = LocationToLevelSet::intersected;
+              inside_quadratures[c] =
+                Quadrature<dim>(quadratures.inside_points,
+                                quadratures.inside_weights);
+              outside_quadratures[c] =
+                Quadrature<dim>(quadratures.outside_points,
+                                quadratures.outside_weights);
+              surface_quadratures[c] =
+                ImmersedSurfaceQuadrature<dim>(quadratures.surface_points,
+                                               quadratures.surface_weights,
+                                               quadratures.surface_normals);
+            }
+        }
+    };
+
+    parallel::apply_to_subranges(0U, n_cells, update_range, 32);
+    n_updated = n_updated_cells;
+  }
+
+
+
+  template <int dim>
+  LocationToLevelSet
+  DiscreteQuadratureGenerator<dim>::location_to_level_set(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    const unsigned int index = cell->active_cell_index();
+    if (index >= cell_locations.size())
+      return LocationToLevelSet::unassigned;
+    return cell_locations[index];
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  DiscreteQuadratureGenerator<dim>::get_inside_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    const LocationToLevelSet location = location_to_level_set(cell);
+    Assert(location != LocationToLevelSet::unassigned,
+           ExcMessage("No quadrature has been computed for this cell."));
+    if (location == LocationToLevelSet::intersected)
+      return inside_quadratures[cell->active_cell_index()];
+    return location == LocationToLevelSet::inside ? full_quadrature :
+                                                    empty_quadrature;
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  DiscreteQuadratureGenerator<dim>::get_outside_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    const LocationToLevelSet location = location_to_level_set(cell);
+    Assert(location != LocationToLevelSet::unassigned,
+           ExcMessage("No quadrature has been computed for this cell."));
+    if (location == LocationToLevelSet::intersected)
+      return outside_quadratures[cell->active_cell_index()];
+    return location == LocationToLevelSet::outside ? full_quadrature :
+                                                     empty_quadrature;
+  }
+
+
+
+  template <int dim>
+  const ImmersedSurfaceQuadrature<dim> &
+  DiscreteQuadratureGenerator<dim>::get_surface_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    const LocationToLevelSet location = location_to_level_set(cell);
+    Assert(location != LocationToLevelSet::unassigned,
+           ExcMessage("No quadrature has been computed for this cell."));
+    if (location == LocationToLevelSet::intersected)
+      return surface_quadratures[cell->active_cell_index()];
+    return empty_surface_quadrature;
+  }
+
+
+
+  template <int dim>
+  unsigned int
+  DiscreteQuadratureGenerator<dim>::n_updated_cells() const
+  {
+    return n_updated;
+  }
+
+
+
+  template <int dim>
+  std::size_t
+  DiscreteQuadratureGenerator<dim>::memory_consumption() const
+  {
+    std::size_t memory =
+      MemoryConsumption::memory_consumption(bernstein_transformation) +
+      MemoryConsumption::memory_consumption(level_set_dof_values) +
+      MemoryConsumption::memory_consumption(new_level_set_dof_values) +
+      MemoryConsumption::memory_consumption(cell_is_owned) +
+      cell_locations.capacity() * sizeof(LocationToLevelSet);
+    for (unsigned int c = 0; c < inside_quadratures.size(); ++c)
+      memory += inside_quadratures[c].memory_consumption() +
+                outside_quadratures[c].memory_consumption() +
+                surface_quadratures[c].memory_consumption();
+    return memory;
+  }
+
+
+
+} // namespace NonMatching
+
+#include "quadrature_generator.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -17,6 +17,8 @@
 
 #ifdef DEAL_II_WITH_SUNDIALS
 
+#  include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 namespace SUNDIALS
 {
@@ -171,6 +173,22 @@ namespace SUNDIALS
 
 #  endif // mpi
 
+    void
+    copy(LinearAlgebra::distributed::Vector<double> &dst, const N_Vector &src)
+    {
+      const std::size_t N = dst.local_size();
+      AssertDimension(N_Vector_length(src), N);
+      const realtype *values = N_VGetArrayPointer(src);
+      std::copy(values, values + N, dst.begin());
+    }
+
+    void
+    copy(N_Vector &dst, const LinearAlgebra::distributed::Vector<double> &src)
+    {
+      AssertDimension(N_Vector_length(dst), src.local_size());
+      std::copy(src.begin(), src.end(), N_VGetArrayPointer(dst));
+    }
+
     void
     copy(BlockVector<double> &dst, const N_Vector &src)
     {
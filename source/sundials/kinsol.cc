@@ -23,6 +23,7 @@
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/lac/block_vector.h>
+#  include <deal.II/lac/la_parallel_vector.h>
 #  ifdef DEAL_II_WITH_TRILINOS
 #    include <deal.II/lac/trilinos_parallel_block_vector.h>
 #    include <deal.II/lac/trilinos_vector.h>
@@ -33,6 +34,7 @@
 #  endif
 
 #  include <deal.II/sundials/copy.h>
+#  include <deal.II/sundials/n_vector.h>
 
 #  include <sundials/sundials_config.h>
 #  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
@@ -60,6 +62,26 @@ namespace SUNDIALS
     {
       KINSOL<VectorType> &solver =
         *static_cast<KINSOL<VectorType> *>(user_data);
+
+      const auto evaluate = [&solver](const VectorType &src_yy,
+                                      VectorType &      dst_FF) {
+        int err = 0;
+        if (solver.residual)
+          err = solver.residual(src_yy, dst_FF);
+        else if (solver.iteration_function)
+          err = solver.iteration_function(src_yy, dst_FF);
+        else
+          Assert(false, ExcInternalError());
+        return err;
+      };
+
+      // The dense linear solver used in the absence of
+      // solve_jacobian_system() works on SUNDIALS' own serial vectors, which
+      // we need to copy. Otherwise, the vectors are deal.II vectors.
+      if (N_VGetVectorID(yy) != SUNDIALS_NVEC_SERIAL)
+        return evaluate(*unwrap_nvector_const<VectorType>(yy),
+                        *unwrap_nvector<VectorType>(FF));
+
       GrowingVectorMemory<VectorType> mem;
 
       typename VectorMemory<VectorType>::Pointer src_yy(mem);
@@ -70,13 +92,7 @@ namespace SUNDIALS
 
       copy(*src_yy, yy);
 
-      int err = 0;
-      if (solver.residual)
-        err = solver.residual(*src_yy, *dst_FF);
-      else if (solver.iteration_function)
-        err = solver.iteration_function(*src_yy, *dst_FF);
-      else
-        Assert(false, ExcInternalError());
+      int err = evaluate(*src_yy, *dst_FF);
 
       copy(FF, *dst_FF);
 
@@ -91,18 +107,10 @@ namespace SUNDIALS
     {
       KINSOL<VectorType> &solver =
         *static_cast<KINSOL<VectorType> *>(kinsol_mem->kin_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_ycur(mem);
-      solver.reinit_vector(*src_ycur);
-
-      typename VectorMemory<VectorType>::Pointer src_fcur(mem);
-      solver.reinit_vector(*src_fcur);
 
-      copy(*src_ycur, kinsol_mem->kin_uu);
-      copy(*src_fcur, kinsol_mem->kin_fval);
-
-      int err = solver.setup_jacobian(*src_ycur, *src_fcur);
+      int err = solver.setup_jacobian(
+        *unwrap_nvector_const<VectorType>(kinsol_mem->kin_uu),
+        *unwrap_nvector_const<VectorType>(kinsol_mem->kin_fval));
       return err;
     }
 
@@ -118,27 +126,12 @@ namespace SUNDIALS
     {
       KINSOL<VectorType> &solver =
         *static_cast<KINSOL<VectorType> *>(kinsol_mem->kin_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_ycur(mem);
-      solver.reinit_vector(*src_ycur);
-
-      typename VectorMemory<VectorType>::Pointer src_fcur(mem);
-      solver.reinit_vector(*src_fcur);
 
-      copy(*src_ycur, kinsol_mem->kin_uu);
-      copy(*src_fcur, kinsol_mem->kin_fval);
-
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
-
-      typename VectorMemory<VectorType>::Pointer dst(mem);
-      solver.reinit_vector(*dst);
-
-      copy(*src, b);
-
-      int err = solver.solve_jacobian_system(*src_ycur, *src_fcur, *src, *dst);
-      copy(x, *dst);
+      int err = solver.solve_jacobian_system(
+        *unwrap_nvector_const<VectorType>(kinsol_mem->kin_uu),
+        *unwrap_nvector_const<VectorType>(kinsol_mem->kin_fval),
+        *unwrap_nvector_const<VectorType>(b),
+        *unwrap_nvector<VectorType>(x));
 
       *sJpnorm = N_VWL2Norm(b, kinsol_mem->kin_fscale);
       N_VProd(b, kinsol_mem->kin_fscale, b);
@@ -154,9 +147,6 @@ namespace SUNDIALS
                              const MPI_Comm        mpi_comm)
     : data(data)
     , kinsol_mem(nullptr)
-    , solution(nullptr)
-    , u_scale(nullptr)
-    , f_scale(nullptr)
     , communicator(is_serial_vector<VectorType>::value ?
                      MPI_COMM_SELF :
                      Utilities::MPI::duplicate_communicator(mpi_comm))
@@ -189,44 +179,46 @@ namespace SUNDIALS
   {
     unsigned int system_size = initial_guess_and_solution.size();
 
-    // The solution is stored in
-    // solution. Here we take only a
-    // view of it.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet is = initial_guess_and_solution.locally_owned_elements();
-        const unsigned int local_system_size = is.n_elements();
+    // With a user-provided linear solver, KINSOL works directly on the
+    // deal.II vectors. The dense linear solver used otherwise needs
+    // SUNDIALS' own serial vectors, into which we copy.
+    const bool use_dense_solver = !solve_jacobian_system;
 
-        solution =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
+    typename VectorMemory<VectorType>::Pointer unit_scaling(mem);
+    reinit_vector(*unit_scaling);
+    *unit_scaling = 1.;
 
-        u_scale = N_VNew_Parallel(communicator, local_system_size, system_size);
-        N_VConst_Parallel(1.e0, u_scale);
-
-        f_scale = N_VNew_Parallel(communicator, local_system_size, system_size);
-        N_VConst_Parallel(1.e0, f_scale);
-      }
-    else
-#  endif
+    NVectorView<VectorType> solution_view, u_scale_view, f_scale_view;
+    N_Vector                solution = nullptr;
+    N_Vector                u_scale  = nullptr;
+    N_Vector                f_scale  = nullptr;
+    if (use_dense_solver)
       {
         Assert(is_serial_vector<VectorType>::value,
-               ExcInternalError(
-                 "Trying to use a serial code with a parallel vector."));
+               ExcMessage("KINSOL's dense linear solver can only be used "
+                          "with serial vectors. Please provide the function "
+                          "solve_jacobian_system()."));
         solution = N_VNew_Serial(system_size);
         u_scale  = N_VNew_Serial(system_size);
-        N_VConst_Serial(1.e0, u_scale);
-        f_scale = N_VNew_Serial(system_size);
-        N_VConst_Serial(1.e0, f_scale);
-      }
-
-    if (get_solution_scaling)
-      copy(u_scale, get_solution_scaling());
-
-    if (get_function_scaling)
-      copy(f_scale, get_function_scaling());
+        f_scale  = N_VNew_Serial(system_size);
 
-    copy(solution, initial_guess_and_solution);
+        copy(u_scale,
+             get_solution_scaling ? get_solution_scaling() : *unit_scaling);
+        copy(f_scale,
+             get_function_scaling ? get_function_scaling() : *unit_scaling);
+        copy(solution, initial_guess_and_solution);
+      }
+    else
+      {
+        solution_view = make_nvector_view(initial_guess_and_solution);
+        u_scale_view  = make_nvector_view(
+          get_solution_scaling ? get_solution_scaling() : *unit_scaling);
+        f_scale_view = make_nvector_view(
+          get_function_scaling ? get_function_scaling() : *unit_scaling);
+        solution = solution_view;
+        u_scale  = u_scale_view;
+        f_scale  = f_scale_view;
+      }
 
     if (kinsol_mem)
       KINFree(&kinsol_mem);
@@ -272,7 +264,7 @@ namespace SUNDIALS
     SUNLinearSolver LS = nullptr;
 #  endif
 
-    if (solve_jacobian_system)
+    if (!use_dense_solver)
       {
         auto KIN_mem        = static_cast<KINMem>(kinsol_mem);
         KIN_mem->kin_lsolve = t_kinsol_solve_jacobian<VectorType>;
@@ -308,19 +300,10 @@ namespace SUNDIALS
     status = KINSol(kinsol_mem, solution, data.strategy, u_scale, f_scale);
     AssertKINSOL(status);
 
-    copy(initial_guess_and_solution, solution);
-
-    // Free the vectors which are no longer used.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        N_VDestroy_Parallel(solution);
-        N_VDestroy_Parallel(u_scale);
-        N_VDestroy_Parallel(f_scale);
-      }
-    else
-#  endif
+    if (use_dense_solver)
       {
+        copy(initial_guess_and_solution, solution);
+
         N_VDestroy_Serial(solution);
         N_VDestroy_Serial(u_scale);
         N_VDestroy_Serial(f_scale);
@@ -350,6 +333,7 @@ namespace SUNDIALS
 
   template class KINSOL<Vector<double>>;
   template class KINSOL<BlockVector<double>>;
+  template class KINSOL<LinearAlgebra::distributed::Vector<double>>;
 
 #  ifdef DEAL_II_WITH_MPI
 
@@ -0,0 +1,60 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2020 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#include <deal.II/sundials/n_vector.templates.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  namespace internal
+  {
+#  define INSTANTIATE(VectorType)                                          \
+    template class NVectorView<VectorType>;                                \
+    template class NVectorView<const VectorType>;                          \
+    template NVectorView<VectorType> make_nvector_view<>(VectorType &);    \
+    template NVectorView<const VectorType> make_nvector_view<>(            \
+      const VectorType &);                                                 \
+    template VectorType *      unwrap_nvector<VectorType>(N_Vector);       \
+    template const VectorType *unwrap_nvector_const<VectorType>(N_Vector)
+
+    INSTANTIATE(Vector<double>);
+    INSTANTIATE(BlockVector<double>);
+    INSTANTIATE(LinearAlgebra::distributed::Vector<double>);
+    INSTANTIATE(LinearAlgebra::distributed::BlockVector<double>);
+
+#  ifdef DEAL_II_WITH_MPI
+#    ifdef DEAL_II_WITH_TRILINOS
+    INSTANTIATE(TrilinosWrappers::MPI::Vector);
+    INSTANTIATE(TrilinosWrappers::MPI::BlockVector);
+#    endif // DEAL_II_WITH_TRILINOS
+
+#    ifdef DEAL_II_WITH_PETSC
+#      ifndef PETSC_USE_COMPLEX
+    INSTANTIATE(PETScWrappers::MPI::Vector);
+    INSTANTIATE(PETScWrappers::MPI::BlockVector);
+#      endif // PETSC_USE_COMPLEX
+#    endif   // DEAL_II_WITH_PETSC
+#  endif     // DEAL_II_WITH_MPI
+
+#  undef INSTANTIATE
+  } // namespace internal
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif